@@ -27,6 +27,7 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <stdarg.h>
+#include <dirent.h>
 
 /****************************************************************************
  * Definitions
@@ -34,21 +35,26 @@
 #define USAGE                                                           \
 	"\n FS R/W Performance Test\n"                                      \
 	"\n Usage :     smartfs_test <operation> <path> <size> <iteration> <print_option>\n"  \
-	"\nOperation :  1.Read/Write / 2.Read / 3.Write / 4. Write/Remove \n"                  \
+	"\nOperation :  1.Read/Write / 2.Read / 3.Write / 4. Write/Remove / 5. Append\n"      \
 	" Path :        Test File Path\n"                                   \
 	" Size :        Write/Read Data size\n"                             \
 	" Iteration :   Number of repetitions\n"                            \
 	" Detail :      Enable(y) or Disable(n) Printing Details Option\n"  \
 	"               (Printing affects at R/W Performance)\n"         \
+	" Append writes <size> bytes in 64 bytes writes and reports the\n"  \
+	" throughput and the block erases of smartfs\n"                    \
 	"\n ex) smartfs_test 1 /mnt/test 4096 30 y\n"
 
 #define FS_RW_ITERATION_MAX 10000
+#define FS_APPEND_CHUNK     64
+#define FS_PROCFS_SMARTFS   "/proc/fs/smartfs"
 
 enum TEST_OPTS {
 	TEST_OPT_WRITEREAD = 1,
 	TEST_OPT_READ = 2,
 	TEST_OPT_WRITE = 3,
 	TEST_OPT_WRITEREMOVE = 4,
+	TEST_OPT_APPEND = 5,
 	TEST_OPT_MAX,
 };
 
@@ -260,6 +266,100 @@ static int write_remove_test(char *filepath, void *buf, int nbytes, int iteratio
 	return OK;
 }
 
+/* Sum of the "Block Erases" of the smartfs volumes, -1 if procfs is not mounted */
+
+static long get_block_erases(void)
+{
+	DIR *dir;
+	struct dirent *entry;
+	FILE *fp;
+	char path[64];
+	char line[64];
+	unsigned int erases;
+	long total = -1;
+
+	dir = opendir(FS_PROCFS_SMARTFS);
+	if (dir == NULL) {
+		return -1;
+	}
+
+	while ((entry = readdir(dir)) != NULL) {
+		snprintf(path, sizeof(path), "%s/%s/status", FS_PROCFS_SMARTFS, entry->d_name);
+		fp = fopen(path, "r");
+		if (fp == NULL) {
+			continue;
+		}
+
+		while (fgets(line, sizeof(line), fp) != NULL) {
+			if (sscanf(line, "Block Erases %u", &erases) == 1) {
+				total = (total < 0 ? 0 : total) + erases;
+			}
+		}
+
+		fclose(fp);
+	}
+
+	closedir(dir);
+	return total;
+}
+
+static int append_test(char *filepath, void *buf, int nbytes, int iteration)
+{
+	int i;
+	int fd;
+	int ret;
+	int chunk;
+	int total_write;
+	long time;
+	long timediff;
+	long erases;
+	long long total_bytes = 0;
+
+	erases = get_block_erases();
+
+	for (i = 0; i < iteration; i++) {
+		fd = open(filepath, O_WRONLY | O_CREAT | O_TRUNC);
+		if (fd < 0) {
+			printf("%s errno: %d\n", __FUNCTION__, errno);
+			return ERROR;
+		}
+
+		time = get_time();
+		for (total_write = 0; total_write < nbytes; total_write += chunk) {
+			chunk = nbytes - total_write;
+			if (chunk > FS_APPEND_CHUNK) {
+				chunk = FS_APPEND_CHUNK;
+			}
+
+			ret = write(fd, (char *)buf + total_write, chunk);
+			if (ret != chunk) {
+				printf("%s errno: %d\n", __FUNCTION__, errno);
+				close(fd);
+				return ERROR;
+			}
+		}
+		timediff = get_time() - time;
+		g_total_time += timediff;
+		print_log("append:%ldms, ", timediff);
+
+		ret = fs_close(fd);
+		if (ret < 0) {
+			return ERROR;
+		}
+		total_bytes += nbytes;
+	}
+
+	if (g_total_time > 0) {
+		printf("throughput: %lld bytes/s\n", total_bytes * 1000 / g_total_time);
+	}
+
+	if (erases >= 0) {
+		printf("block erases: %ld\n", get_block_erases() - erases);
+	}
+
+	return OK;
+}
+
 #ifdef CONFIG_BUILD_KERNEL
 int main(int argc, FAR char *argv[])
 #else
@@ -312,6 +412,9 @@ int smartfs_test_main(int argc, char *argv[])
 		case TEST_OPT_WRITEREMOVE:
 			ret = write_remove_test(filepath, buf, size, iteration);
 			break;
+		case TEST_OPT_APPEND:
+			ret = append_test(filepath, buf, size, iteration);
+			break;
 		}
 		free(buf);
 
@@ -0,0 +1,178 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_sample_internal.h"
+
+#define BENCH_PORT "bench_port"
+#define BENCH_DATA "PING"
+#define BENCH_REPLY "PONG"
+
+#define MSG_PRIO 10
+/* The receiver runs at higher priority, so that it waits for the next message before the sender sends it. */
+#define BENCH_SEND_PRIO 100
+#define BENCH_RECV_PRIO 110
+#define STACKSIZE 2048
+#define BUFFER_SIZE 16
+
+extern int fail_cnt;
+static sem_t g_bench_done;
+
+static uint64_t bench_get_usec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (uint64_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int bench_recv(int argc, FAR char *argv[])
+{
+	int ret;
+	int count;
+	char buf[BUFFER_SIZE];
+	msg_recv_buf_t recv_data;
+	msg_send_data_t reply_data;
+
+	count = atoi(argv[1]);
+
+	reply_data.msg = BENCH_REPLY;
+	reply_data.msglen = sizeof(BENCH_REPLY);
+
+	/* Receive the messages of both uncached and cached runs. */
+	while (count-- > 0) {
+		recv_data.buf = buf;
+		recv_data.buflen = BUFFER_SIZE;
+		ret = messaging_recv_block(BENCH_PORT, &recv_data);
+		if (ret != MSG_REPLY_REQUIRED) {
+			printf("Fail to receive benchmark message.\n");
+			return ERROR;
+		}
+
+		ret = messaging_reply(BENCH_PORT, recv_data.sender_pid, &reply_data);
+		if (ret != OK) {
+			printf("Fail to reply benchmark message.\n");
+			return ERROR;
+		}
+	}
+
+	return OK;
+}
+
+static int bench_round_trip(int count, bool cached)
+{
+	int ret;
+	int idx;
+	char buf[BUFFER_SIZE];
+	msg_send_data_t send_data;
+	msg_recv_buf_t reply_data;
+	uint64_t start;
+	uint64_t elapsed;
+
+	send_data.priority = MSG_PRIO;
+	send_data.msg = BENCH_DATA;
+	send_data.msglen = sizeof(BENCH_DATA);
+
+	start = bench_get_usec();
+	for (idx = 0; idx < count; idx++) {
+		reply_data.buf = buf;
+		reply_data.buflen = BUFFER_SIZE;
+		ret = messaging_send_sync(BENCH_PORT, &send_data, &reply_data);
+		if (ret != OK) {
+			printf("Fail to sync send benchmark message %d.\n", idx);
+			return ERROR;
+		}
+
+		if (!cached) {
+			/* Release the reply port, so that every send sets it up and tears it down again. */
+			(void)messaging_cleanup(BENCH_PORT);
+		}
+	}
+	elapsed = bench_get_usec() - start;
+	(void)messaging_cleanup(BENCH_PORT);
+
+	printf("%-22s : %d round trips, total %u us, average %u us\n", cached ? "reused reply port" : "reply port per message", count, (unsigned int)elapsed, (unsigned int)(elapsed / count));
+	return OK;
+}
+
+static int bench_send(int argc, FAR char *argv[])
+{
+	int count;
+
+	count = atoi(argv[1]);
+
+	if (bench_round_trip(count, false) != OK || bench_round_trip(count, true) != OK) {
+		fail_cnt++;
+	}
+
+	sem_post(&g_bench_done);
+	return OK;
+}
+
+void sync_benchmark_messaging_sample(int count)
+{
+	int ret;
+	int receiver_pid;
+	char count_str[12];
+	char *task_argv[2];
+
+	printf("\n--- Start the Sync round trip benchmark. ---\n");
+#ifndef CONFIG_MESSAGING_REPLY_CACHE
+	printf("CONFIG_MESSAGING_REPLY_CACHE is disabled. Both runs set up the reply port per message.\n");
+#endif
+
+	sem_init(&g_bench_done, 0, 0);
+	task_argv[1] = NULL;
+
+	/* The receiver handles both runs. */
+	snprintf(count_str, sizeof(count_str), "%d", count * 2);
+	task_argv[0] = count_str;
+	receiver_pid = task_create("bench_recv", BENCH_RECV_PRIO, STACKSIZE, bench_recv, task_argv);
+	if (receiver_pid < 0) {
+		fail_cnt++;
+		printf("Fail to create bench_recv task.\n");
+		goto errout;
+	}
+
+	snprintf(count_str, sizeof(count_str), "%d", count);
+	ret = task_create("bench_send", BENCH_SEND_PRIO, STACKSIZE, bench_send, task_argv);
+	if (ret < 0) {
+		fail_cnt++;
+		task_delete(receiver_pid);
+		printf("Fail to create bench_send task.\n");
+		goto errout;
+	}
+
+	while (sem_wait(&g_bench_done) != OK) ;
+
+errout:
+	sem_destroy(&g_bench_done);
+}
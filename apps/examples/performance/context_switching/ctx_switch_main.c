@@ -25,9 +25,39 @@
 #include <sched.h>
 #include <time.h>
 #include <sys/types.h>
+#ifdef CONFIG_EXAMPLES_CTX_SWITCH_WAKEUP
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <tinyara/arch.h>
+#endif
 
 #define SWITCHING_ITERATIONS 1000000
 
+#ifdef CONFIG_EXAMPLES_CTX_SWITCH_WAKEUP
+#define WAKEUP_MAXTASKS      CONFIG_EXAMPLES_CTX_SWITCH_WAKEUP_MAXTASKS
+#define WAKEUP_ROUNDS        32
+#define WAKEUP_PRIORITY      (SCHED_PRIORITY_MAX - 1)
+
+/* The woken tasks have distinct priorities in this range, all lower than
+ * the task which wakes them up.
+ */
+
+#define LOAD_PRIORITY_MIN    50
+#define LOAD_PRIORITY_SPAN   100
+
+static sem_t g_load_sem[WAKEUP_MAXTASKS];
+static pid_t g_load_pid[WAKEUP_MAXTASKS];
+static volatile bool g_load_exit;
+static uint32_t g_wakeup_samples[WAKEUP_ROUNDS * WAKEUP_MAXTASKS];
+static uint16_t g_wakeup_order[WAKEUP_MAXTASKS];
+static uint32_t g_wakeup_seed;
+static sem_t g_wakeup_done;
+#endif
+
 static int yield_task_1(int a, char *b[])
 {
 	int cnt = SWITCHING_ITERATIONS;
@@ -61,12 +91,171 @@ static int yield_task_2(int a, char *b[])
 	return 0;
 }
 
+#ifdef CONFIG_EXAMPLES_CTX_SWITCH_WAKEUP
+static int load_task(int argc, char *argv[])
+{
+	int i = atoi(argv[1]);
+
+	/* Each post makes this task ready to run once */
+
+	while (!g_load_exit) {
+		while (sem_wait(&g_load_sem[i]) != OK) ;
+	}
+
+	return 0;
+}
+
+static uint32_t wakeup_rand(void)
+{
+	g_wakeup_seed ^= g_wakeup_seed << 13;
+	g_wakeup_seed ^= g_wakeup_seed >> 17;
+	g_wakeup_seed ^= g_wakeup_seed << 5;
+	return g_wakeup_seed;
+}
+
+static int wakeup_compare(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+/* Let the lower priority load tasks run until all of them wait again */
+
+static void wakeup_wait_blocked(int n)
+{
+	int value;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		while (sem_getvalue(&g_load_sem[i], &value) == OK && value >= 0) {
+			usleep(1000);
+		}
+	}
+}
+
+/* Wake the n load tasks in random order, WAKEUP_ROUNDS times, and report
+ * the cycles of each sem_post().  The list of ready tasks grows by one with
+ * each of them.
+ */
+
+static void wakeup_run(int n)
+{
+	uint32_t freq = up_perf_getfreq() / 1000;
+	uint32_t start;
+	uint16_t tmp;
+	int nsamples = 0;
+	int round;
+	int i;
+	int j;
+
+	for (round = 0; round < WAKEUP_ROUNDS; round++) {
+		for (i = 0; i < n; i++) {
+			g_wakeup_order[i] = i;
+		}
+		for (i = n - 1; i > 0; i--) {
+			j = wakeup_rand() % (i + 1);
+			tmp = g_wakeup_order[i];
+			g_wakeup_order[i] = g_wakeup_order[j];
+			g_wakeup_order[j] = tmp;
+		}
+
+		for (i = 0; i < n; i++) {
+			start = up_perf_gettime();
+			sem_post(&g_load_sem[g_wakeup_order[i]]);
+			g_wakeup_samples[nsamples++] = up_perf_gettime() - start;
+		}
+
+		wakeup_wait_blocked(n);
+	}
+
+	qsort(g_wakeup_samples, nsamples, sizeof(uint32_t), wakeup_compare);
+	printf("%4d ready tasks : p50 %6u p99 %6u max %6u cycles (max %u ns)\n", n, g_wakeup_samples[nsamples / 2], g_wakeup_samples[(nsamples * 99) / 100], g_wakeup_samples[nsamples - 1], (unsigned int)(((uint64_t)g_wakeup_samples[nsamples - 1] * 1000000) / freq));
+}
+
+static int wakeup_task(int argc, char *argv[])
+{
+	char index[12];
+	char *args[2];
+	int ntasks;
+	int n;
+	int i;
+
+	g_wakeup_seed = 0x5eed;
+	g_load_exit = false;
+	args[0] = index;
+	args[1] = NULL;
+
+	for (ntasks = 0; ntasks < WAKEUP_MAXTASKS; ntasks++) {
+		sem_init(&g_load_sem[ntasks], 0, 0);
+		snprintf(index, sizeof(index), "%d", ntasks);
+		g_load_pid[ntasks] = task_create("ctx_load", LOAD_PRIORITY_MIN + (ntasks * LOAD_PRIORITY_SPAN) / WAKEUP_MAXTASKS, 1024, load_task, args);
+		if (g_load_pid[ntasks] < 0) {
+			sem_destroy(&g_load_sem[ntasks]);
+			printf("Only %d load tasks could be created\n", ntasks);
+			break;
+		}
+	}
+
+	wakeup_wait_blocked(ntasks);
+
+	printf("sem_post() wakeup latency, %d rounds\n", WAKEUP_ROUNDS);
+	for (n = 1; n <= ntasks; n <<= 1) {
+		wakeup_run(n);
+	}
+	if (ntasks > 1 && (ntasks & (ntasks - 1)) != 0) {
+		wakeup_run(ntasks);
+	}
+
+	/* Let the load tasks exit, then release their semaphores */
+
+	g_load_exit = true;
+	for (i = 0; i < ntasks; i++) {
+		sem_post(&g_load_sem[i]);
+	}
+	for (i = 0; i < ntasks; i++) {
+		struct sched_param param;
+
+		while (sched_getparam(g_load_pid[i], &param) == OK) {
+			usleep(1000);
+		}
+		sem_destroy(&g_load_sem[i]);
+	}
+
+	sem_post(&g_wakeup_done);
+	return 0;
+}
+
+static int wakeup_main(void)
+{
+	printf("Wakeup Latency Measurement\n");
+
+	sem_init(&g_wakeup_done, 0, 0);
+	if (task_create("ctx_wakeup", WAKEUP_PRIORITY, 2048, wakeup_task, NULL) < 0) {
+		printf("Failed to create the wakeup task\n");
+		sem_destroy(&g_wakeup_done);
+		return -1;
+	}
+
+	while (sem_wait(&g_wakeup_done) != OK) ;
+	sem_destroy(&g_wakeup_done);
+	return 0;
+}
+#endif
+
 #ifdef CONFIG_BUILD_KERNEL
 int main(int argc, FAR char *argv[])
 #else
 int ctx_switch_main(int argc, char *argv[])
 #endif
 {
+#ifdef CONFIG_EXAMPLES_CTX_SWITCH_WAKEUP
+	if (argc > 1 && strcmp(argv[1], "-w") == 0) {
+		return wakeup_main();
+	}
+#endif
+
 	printf("Context Switching Performance Measurement\n");
 
 	/* Do not context switching until making two tasks */
@@ -0,0 +1,93 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __APPS_EXAMPLES_PERFORMANCE_HEAP_BENCHMARK_HEAP_BENCHMARK_H
+#define __APPS_EXAMPLES_PERFORMANCE_HEAP_BENCHMARK_HEAP_BENCHMARK_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdint.h>
+#include <stddef.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Latencies are kept in a log-linear histogram: 8 buckets per power of two */
+
+#define HB_HIST_SUBSHIFT     3
+#define HB_HIST_BUCKETS      (32 << HB_HIST_SUBSHIFT)
+
+/* Heap state (footprint, largest free chunk) is sampled every
+ * HB_SAMPLE_INTERVAL operations and once per round for the timeline.
+ */
+
+#define HB_SAMPLE_INTERVAL   64
+#define HB_TIMELINE_MAX      32
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+struct hb_stats_s {
+	uint32_t hist[HB_HIST_BUCKETS];	/* Latency histogram of all operations */
+	uint32_t nops;			/* Number of measured operations */
+	uint32_t nfail;			/* Number of failed allocations */
+	uint32_t maxlat;		/* Worst latency */
+	uint32_t ticks;			/* Operations since the last heap sample */
+
+	size_t peak_used;		/* Peak of allocated bytes (mallinfo) */
+	size_t min_largest;		/* Smallest largest free chunk seen */
+	uint32_t worst_frag;		/* Worst external fragmentation, per mille */
+
+	int ntimeline;			/* Largest free chunk at the end of each round */
+	size_t timeline[HB_TIMELINE_MAX];
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/* heap_benchmark_stats.c */
+
+void hb_stats_init(struct hb_stats_s *stats);
+void hb_stats_merge(struct hb_stats_s *dst, const struct hb_stats_s *src);
+void hb_stats_sample(struct hb_stats_s *stats);
+void hb_stats_round(struct hb_stats_s *stats);
+void hb_stats_print(const char *name, const struct hb_stats_s *stats);
+
+void *hb_malloc(struct hb_stats_s *stats, size_t size);
+void *hb_realloc(struct hb_stats_s *stats, void *mem, size_t size);
+void *hb_calloc(struct hb_stats_s *stats, size_t n, size_t size);
+void hb_free(struct hb_stats_s *stats, void *mem);
+
+/* heap_benchmark_workload.c */
+
+void hb_srand(uint32_t seed);
+uint32_t hb_rand(uint32_t min, uint32_t max);
+
+int hb_run_json(struct hb_stats_s *stats, int rounds);
+int hb_run_tls(struct hb_stats_s *stats, int rounds);
+int hb_run_media(struct hb_stats_s *stats, int rounds);
+int hb_run_contention(struct hb_stats_s *stats, int rounds, int ntasks);
+int hb_run_trace(struct hb_stats_s *stats, const char *path);
+
+#endif /* __APPS_EXAMPLES_PERFORMANCE_HEAP_BENCHMARK_HEAP_BENCHMARK_H */
@@ -0,0 +1,208 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file heap_benchmark_main.c
+
+/// @brief Allocator benchmark and fragmentation suite.
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <semaphore.h>
+
+#include <tinyara/arch.h>
+
+#include "heap_benchmark.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define HB_DEFAULT_SEED      0x5eed
+#define HB_DEFAULT_ROUNDS    16
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct hb_config_s {
+	uint32_t seed;
+	int rounds;
+	int ntasks;
+	const char *workload;
+	const char *trace;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static struct hb_config_s g_hb_config;
+static struct hb_stats_s g_hb_stats;
+static sem_t g_hb_finished;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname)
+{
+	printf("Usage: %s [-s seed] [-r rounds] [-t ntasks] <workload>\n", progname);
+	printf("  workload : json | tls | media | contention | all | trace <file>\n");
+	printf("  -s seed   : seed of the random size generator (default %d)\n", HB_DEFAULT_SEED);
+	printf("  -r rounds : rounds per workload, at most %d are kept in the timeline (default %d)\n", HB_TIMELINE_MAX, HB_DEFAULT_ROUNDS);
+	printf("  -t ntasks : tasks of the contention workload (default %d)\n", CONFIG_EXAMPLES_HEAP_BENCHMARK_NTASKS);
+}
+
+static void hb_print_engine(void)
+{
+	printf("Heap engine : %s",
+#ifdef CONFIG_MM_TLSF
+		   "TLSF"
+#else
+		   "best-fit"
+#endif
+		  );
+#ifdef CONFIG_MM_SMALL_CACHE
+	printf(", small object cache %dx%d", CONFIG_MM_SMALL_CACHE_DEPTH, CONFIG_MM_SMALL_CACHE_BATCH);
+#endif
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	printf(", heapinfo");
+#endif
+	printf("\n");
+	printf("Seed %u, %d rounds, %u cycles per second\n\n", g_hb_config.seed, g_hb_config.rounds, up_perf_getfreq());
+}
+
+static int hb_run(const char *name)
+{
+	int ret;
+
+	hb_stats_init(&g_hb_stats);
+	hb_srand(g_hb_config.seed);
+
+	if (strcmp(name, "json") == 0) {
+		ret = hb_run_json(&g_hb_stats, g_hb_config.rounds);
+	} else if (strcmp(name, "tls") == 0) {
+		ret = hb_run_tls(&g_hb_stats, g_hb_config.rounds);
+	} else if (strcmp(name, "media") == 0) {
+		ret = hb_run_media(&g_hb_stats, g_hb_config.rounds);
+	} else if (strcmp(name, "contention") == 0) {
+		ret = hb_run_contention(&g_hb_stats, g_hb_config.rounds, g_hb_config.ntasks);
+	} else if (strcmp(name, "trace") == 0) {
+		ret = hb_run_trace(&g_hb_stats, g_hb_config.trace);
+	} else {
+		printf("Unknown workload %s\n", name);
+		return ERROR;
+	}
+
+	hb_stats_print(name, &g_hb_stats);
+	return ret;
+}
+
+static int heap_benchmark(int argc, char *argv[])
+{
+	static const char *all[] = { "json", "tls", "media", "contention" };
+	int i;
+
+	hb_print_engine();
+
+	if (strcmp(g_hb_config.workload, "all") == 0) {
+		for (i = 0; i < sizeof(all) / sizeof(all[0]); i++) {
+			if (hb_run(all[i]) != OK) {
+				break;
+			}
+		}
+	} else {
+		(void)hb_run(g_hb_config.workload);
+	}
+
+	sem_post(&g_hb_finished);
+	return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int heapbench_main(int argc, char *argv[])
+#endif
+{
+	int opt;
+
+	g_hb_config.seed = HB_DEFAULT_SEED;
+	g_hb_config.rounds = HB_DEFAULT_ROUNDS;
+	g_hb_config.ntasks = CONFIG_EXAMPLES_HEAP_BENCHMARK_NTASKS;
+	g_hb_config.trace = NULL;
+
+	optind = -1;
+	while ((opt = getopt(argc, argv, "s:r:t:")) != -1) {
+		switch (opt) {
+		case 's':
+			g_hb_config.seed = strtoul(optarg, NULL, 0);
+			break;
+		case 'r':
+			g_hb_config.rounds = atoi(optarg);
+			break;
+		case 't':
+			g_hb_config.ntasks = atoi(optarg);
+			break;
+		default:
+			show_usage(argv[0]);
+			return ERROR;
+		}
+	}
+
+	if (optind >= argc || g_hb_config.rounds <= 0 || g_hb_config.ntasks <= 0) {
+		show_usage(argv[0]);
+		return ERROR;
+	}
+
+	g_hb_config.workload = argv[optind];
+	if (strcmp(g_hb_config.workload, "trace") == 0) {
+		if (optind + 1 >= argc) {
+			show_usage(argv[0]);
+			return ERROR;
+		}
+		g_hb_config.trace = argv[optind + 1];
+	}
+
+	/* Run in a task of its own with a known priority and stack so that
+	 * results do not depend on the shell which started the benchmark.
+	 */
+
+	sem_init(&g_hb_finished, 0, 0);
+	if (task_create("heapbench", SCHED_PRIORITY_DEFAULT, 4096, heap_benchmark, NULL) < 0) {
+		printf("Failed to create the benchmark task\n");
+		sem_destroy(&g_hb_finished);
+		return ERROR;
+	}
+
+	while (sem_wait(&g_hb_finished) != 0) ;
+	sem_destroy(&g_hb_finished);
+
+	return OK;
+}
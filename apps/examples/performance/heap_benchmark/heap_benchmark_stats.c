@@ -0,0 +1,263 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file heap_benchmark_stats.c
+
+/// @brief Latency histogram and heap state sampling.
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <tinyara/arch.h>
+
+#include "heap_benchmark.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static int hb_hist_index(uint32_t value)
+{
+	int msb;
+
+	if (value < (1 << HB_HIST_SUBSHIFT)) {
+		return value;
+	}
+
+	msb = 31 - __builtin_clz(value);
+	return ((msb - HB_HIST_SUBSHIFT + 1) << HB_HIST_SUBSHIFT) +
+		((value >> (msb - HB_HIST_SUBSHIFT)) & ((1 << HB_HIST_SUBSHIFT) - 1));
+}
+
+static uint32_t hb_hist_upper(int idx)
+{
+	int msb;
+	uint32_t low;
+
+	if (idx < (1 << HB_HIST_SUBSHIFT)) {
+		return idx;
+	}
+
+	msb = (idx >> HB_HIST_SUBSHIFT) + HB_HIST_SUBSHIFT - 1;
+	low = (uint32_t)((1 << HB_HIST_SUBSHIFT) + (idx & ((1 << HB_HIST_SUBSHIFT) - 1))) << (msb - HB_HIST_SUBSHIFT);
+	return low + (1 << (msb - HB_HIST_SUBSHIFT)) - 1;
+}
+
+static uint32_t hb_percentile(const struct hb_stats_s *stats, int percent)
+{
+	uint32_t target;
+	uint32_t sum = 0;
+	uint32_t upper;
+	int idx;
+
+	if (stats->nops == 0) {
+		return 0;
+	}
+
+	target = (uint32_t)(((uint64_t)stats->nops * percent + 99) / 100);
+	for (idx = 0; idx < HB_HIST_BUCKETS; idx++) {
+		sum += stats->hist[idx];
+		if (sum >= target) {
+			upper = hb_hist_upper(idx);
+			return upper < stats->maxlat ? upper : stats->maxlat;
+		}
+	}
+
+	return stats->maxlat;
+}
+
+static void hb_record(struct hb_stats_s *stats, uint32_t latency)
+{
+	stats->hist[hb_hist_index(latency)]++;
+	stats->nops++;
+	if (latency > stats->maxlat) {
+		stats->maxlat = latency;
+	}
+
+	if (++stats->ticks >= HB_SAMPLE_INTERVAL) {
+		hb_stats_sample(stats);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void hb_stats_init(struct hb_stats_s *stats)
+{
+	memset(stats, 0, sizeof(struct hb_stats_s));
+	stats->min_largest = (size_t)-1;
+}
+
+void hb_stats_merge(struct hb_stats_s *dst, const struct hb_stats_s *src)
+{
+	int idx;
+
+	for (idx = 0; idx < HB_HIST_BUCKETS; idx++) {
+		dst->hist[idx] += src->hist[idx];
+	}
+
+	dst->nops += src->nops;
+	dst->nfail += src->nfail;
+	if (src->maxlat > dst->maxlat) {
+		dst->maxlat = src->maxlat;
+	}
+	if (src->peak_used > dst->peak_used) {
+		dst->peak_used = src->peak_used;
+	}
+	if (src->min_largest < dst->min_largest) {
+		dst->min_largest = src->min_largest;
+	}
+	if (src->worst_frag > dst->worst_frag) {
+		dst->worst_frag = src->worst_frag;
+	}
+}
+
+void hb_stats_sample(struct hb_stats_s *stats)
+{
+	struct mallinfo info;
+	uint32_t frag;
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	info = mallinfo();
+#else
+	(void)mallinfo(&info);
+#endif
+
+	stats->ticks = 0;
+
+	if ((size_t)info.uordblks > stats->peak_used) {
+		stats->peak_used = info.uordblks;
+	}
+	if ((size_t)info.mxordblk < stats->min_largest) {
+		stats->min_largest = info.mxordblk;
+	}
+
+	/* External fragmentation: share of the free memory which is not in the
+	 * largest free chunk.
+	 */
+
+	if (info.fordblks > 0) {
+		frag = 1000 - (uint32_t)(((uint64_t)info.mxordblk * 1000) / info.fordblks);
+		if (frag > stats->worst_frag) {
+			stats->worst_frag = frag;
+		}
+	}
+}
+
+void hb_stats_round(struct hb_stats_s *stats)
+{
+	struct mallinfo info;
+
+	hb_stats_sample(stats);
+
+#ifdef CONFIG_CAN_PASS_STRUCTS
+	info = mallinfo();
+#else
+	(void)mallinfo(&info);
+#endif
+
+	if (stats->ntimeline < HB_TIMELINE_MAX) {
+		stats->timeline[stats->ntimeline++] = info.mxordblk;
+	}
+}
+
+void hb_stats_print(const char *name, const struct hb_stats_s *stats)
+{
+	int i;
+
+	printf("[%s] ops %u, failed %u\n", name, stats->nops, stats->nfail);
+	printf("  latency in cycles : p50 %u, p99 %u, max %u\n",
+		   hb_percentile(stats, 50), hb_percentile(stats, 99), stats->maxlat);
+	printf("  peak used %u bytes, min largest free %u bytes, worst ext. fragmentation %u.%u%%\n",
+		   stats->peak_used, stats->min_largest == (size_t)-1 ? 0 : stats->min_largest,
+		   stats->worst_frag / 10, stats->worst_frag % 10);
+
+	if (stats->ntimeline > 0) {
+		printf("  largest free per round :");
+		for (i = 0; i < stats->ntimeline; i++) {
+			printf(" %u", stats->timeline[i]);
+		}
+		printf("\n");
+	}
+}
+
+void *hb_malloc(struct hb_stats_s *stats, size_t size)
+{
+	uint32_t start;
+	void *mem;
+
+	start = up_perf_gettime();
+	mem = malloc(size);
+	hb_record(stats, up_perf_gettime() - start);
+
+	if (!mem) {
+		stats->nfail++;
+	}
+
+	return mem;
+}
+
+void *hb_realloc(struct hb_stats_s *stats, void *mem, size_t size)
+{
+	uint32_t start;
+	void *newmem;
+
+	start = up_perf_gettime();
+	newmem = realloc(mem, size);
+	hb_record(stats, up_perf_gettime() - start);
+
+	if (!newmem) {
+		stats->nfail++;
+	}
+
+	return newmem;
+}
+
+void *hb_calloc(struct hb_stats_s *stats, size_t n, size_t size)
+{
+	uint32_t start;
+	void *mem;
+
+	start = up_perf_gettime();
+	mem = calloc(n, size);
+	hb_record(stats, up_perf_gettime() - start);
+
+	if (!mem) {
+		stats->nfail++;
+	}
+
+	return mem;
+}
+
+void hb_free(struct hb_stats_s *stats, void *mem)
+{
+	uint32_t start;
+
+	if (!mem) {
+		return;
+	}
+
+	start = up_perf_gettime();
+	free(mem);
+	hb_record(stats, up_perf_gettime() - start);
+}
@@ -0,0 +1,511 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file heap_benchmark_workload.c
+
+/// @brief Synthetic allocation mixes and trace replay.
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <semaphore.h>
+
+#include "heap_benchmark.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* JSON: one document is parsed into up to HB_JSON_NODES small objects.
+ * The first HB_JSON_KEEP nodes of a document stay alive for
+ * HB_JSON_CACHED rounds, like a cached configuration tree.
+ */
+
+#define HB_JSON_NODES        200
+#define HB_JSON_KEEP         16
+#define HB_JSON_CACHED       4
+
+/* TLS: certificates in the chain, small parser temporaries per
+ * certificate, bignum operations and sessions kept in the cache.
+ */
+
+#define HB_TLS_CERTS         3
+#define HB_TLS_ASN1_TMPS     16
+#define HB_TLS_BIGNUM_OPS    32
+#define HB_TLS_SESSIONS      2
+#define HB_TLS_RECORD_OVERHEAD 29
+
+/* Media: a FIFO of HB_MEDIA_DEPTH frames, HB_MEDIA_FRAMES frames per round */
+
+#define HB_MEDIA_DEPTH       16
+#define HB_MEDIA_FRAMES      64
+
+#define HB_TRACE_ROUND_LINES 1024
+#define HB_TRACE_LINE_MAX    64
+
+#define HB_NTASKS_MAX        16
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct hb_frame_s {
+	void *buf;
+	void *meta;
+};
+
+struct hb_worker_s {
+	struct hb_stats_s stats;
+	int rounds;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static uint32_t g_hb_seed = 1;
+
+static struct hb_worker_s g_hb_workers[HB_NTASKS_MAX];
+static sem_t g_hb_start;
+static sem_t g_hb_done;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void hb_json_document(struct hb_stats_s *stats, void **keep)
+{
+	void *nodes[HB_JSON_NODES];
+	size_t size;
+	int nnodes;
+	int i;
+	int j;
+
+	/* Objects, arrays and numbers are small fixed size nodes, every 8th
+	 * node is a string which grows while it is being unescaped.
+	 */
+
+	nnodes = hb_rand(HB_JSON_NODES / 2, HB_JSON_NODES);
+	for (i = 0; i < nnodes; i++) {
+		if ((i & 7) == 7) {
+			size = hb_rand(8, 24);
+			nodes[i] = hb_malloc(stats, size);
+			for (j = 0; j < 3 && nodes[i]; j++) {
+				void *grown;
+
+				size = size * 2 + hb_rand(0, 16);
+				grown = hb_realloc(stats, nodes[i], size);
+				if (!grown) {
+					break;
+				}
+				nodes[i] = grown;
+			}
+		} else {
+			nodes[i] = hb_malloc(stats, hb_rand(8, 96));
+		}
+	}
+
+	for (i = 0; i < HB_JSON_KEEP; i++) {
+		keep[i] = nodes[i];
+	}
+
+	/* cJSON_Delete frees the tree depth first, roughly in reverse order */
+
+	for (i = nnodes - 1; i >= HB_JSON_KEEP; i--) {
+		hb_free(stats, nodes[i]);
+	}
+}
+
+static void hb_json_round(struct hb_stats_s *stats, void *cached[HB_JSON_CACHED][HB_JSON_KEEP], int round)
+{
+	void **slot = cached[round % HB_JSON_CACHED];
+	int burst;
+	int i;
+
+	for (i = 0; i < HB_JSON_KEEP; i++) {
+		hb_free(stats, slot[i]);
+		slot[i] = NULL;
+	}
+
+	/* A burst of documents arrives at once, only the last one is cached */
+
+	burst = hb_rand(1, 4);
+	while (burst-- > 0) {
+		hb_json_document(stats, slot);
+		if (burst > 0) {
+			for (i = 0; i < HB_JSON_KEEP; i++) {
+				hb_free(stats, slot[i]);
+				slot[i] = NULL;
+			}
+		}
+	}
+}
+
+static void hb_json_cleanup(struct hb_stats_s *stats, void *cached[HB_JSON_CACHED][HB_JSON_KEEP])
+{
+	int i;
+	int j;
+
+	for (i = 0; i < HB_JSON_CACHED; i++) {
+		for (j = 0; j < HB_JSON_KEEP; j++) {
+			hb_free(stats, cached[i][j]);
+			cached[i][j] = NULL;
+		}
+	}
+}
+
+static void hb_tls_handshake(struct hb_stats_s *stats, void **session)
+{
+	void *certs[HB_TLS_CERTS];
+	void *tmps[HB_TLS_ASN1_TMPS];
+	void *ctx;
+	void *in;
+	void *out;
+	void *bn;
+	void *grown;
+	int i;
+	int j;
+
+	ctx = hb_malloc(stats, hb_rand(1200, 1600));
+	in = hb_malloc(stats, CONFIG_EXAMPLES_HEAP_BENCHMARK_TLS_RECORD_SIZE + HB_TLS_RECORD_OVERHEAD);
+	out = hb_malloc(stats, CONFIG_EXAMPLES_HEAP_BENCHMARK_TLS_RECORD_SIZE + HB_TLS_RECORD_OVERHEAD);
+
+	/* Parse the certificate chain: the certificates stay until the end of
+	 * the handshake, the ASN.1 temporaries are freed after each one.
+	 */
+
+	for (i = 0; i < HB_TLS_CERTS; i++) {
+		certs[i] = hb_malloc(stats, hb_rand(600, 1400));
+		for (j = 0; j < HB_TLS_ASN1_TMPS; j++) {
+			tmps[j] = hb_malloc(stats, hb_rand(16, 128));
+		}
+		for (j = 0; j < HB_TLS_ASN1_TMPS; j++) {
+			hb_free(stats, tmps[j]);
+		}
+	}
+
+	/* Key exchange and signature verification: bignums are grown with
+	 * realloc while they are computed.
+	 */
+
+	for (i = 0; i < HB_TLS_BIGNUM_OPS; i++) {
+		bn = hb_malloc(stats, hb_rand(64, 256));
+		if (bn) {
+			grown = hb_realloc(stats, bn, hb_rand(256, 520));
+			if (grown) {
+				bn = grown;
+			}
+		}
+		hb_free(stats, bn);
+	}
+
+	for (i = HB_TLS_CERTS - 1; i >= 0; i--) {
+		hb_free(stats, certs[i]);
+	}
+
+	/* The session survives the handshake, the oldest one is evicted */
+
+	hb_free(stats, *session);
+	*session = hb_malloc(stats, hb_rand(160, 240));
+
+	hb_free(stats, in);
+	hb_free(stats, out);
+	hb_free(stats, ctx);
+}
+
+static void hb_media_round(struct hb_stats_s *stats, struct hb_frame_s *ring, int *head, int *count)
+{
+	struct hb_frame_s *frame;
+	uint32_t avg = CONFIG_EXAMPLES_HEAP_BENCHMARK_MEDIA_BUFSIZE;
+	int i;
+
+	for (i = 0; i < HB_MEDIA_FRAMES; i++) {
+		/* Consumer: release the oldest frame when the queue is full or
+		 * randomly when the sink runs faster than the source.
+		 */
+
+		while (*count == HB_MEDIA_DEPTH || (*count > 0 && hb_rand(0, 3) == 0)) {
+			frame = &ring[(*head + HB_MEDIA_DEPTH - *count) % HB_MEDIA_DEPTH];
+			hb_free(stats, frame->buf);
+			hb_free(stats, frame->meta);
+			frame->buf = NULL;
+			frame->meta = NULL;
+			(*count)--;
+		}
+
+		/* Producer: frame sizes vary by +/- 50% around the average */
+
+		frame = &ring[*head];
+		frame->buf = hb_malloc(stats, hb_rand(avg / 2, avg + avg / 2));
+		frame->meta = hb_malloc(stats, hb_rand(24, 64));
+		*head = (*head + 1) % HB_MEDIA_DEPTH;
+		(*count)++;
+	}
+}
+
+static int hb_worker(int argc, char *argv[])
+{
+	struct hb_worker_s *worker;
+
+	worker = &g_hb_workers[atoi(argv[1])];
+
+	while (sem_wait(&g_hb_start) != 0) ;
+	hb_run_json(&worker->stats, worker->rounds);
+	sem_post(&g_hb_done);
+
+	return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+void hb_srand(uint32_t seed)
+{
+	g_hb_seed = seed ? seed : 1;
+}
+
+uint32_t hb_rand(uint32_t min, uint32_t max)
+{
+	/* Numerical Recipes LCG, the high bits are used for the result */
+
+	g_hb_seed = g_hb_seed * 1664525 + 1013904223;
+	return min + ((g_hb_seed >> 8) % (max - min + 1));
+}
+
+int hb_run_json(struct hb_stats_s *stats, int rounds)
+{
+	void *cached[HB_JSON_CACHED][HB_JSON_KEEP];
+	int round;
+
+	memset(cached, 0, sizeof(cached));
+
+	for (round = 0; round < rounds; round++) {
+		hb_json_round(stats, cached, round);
+		hb_stats_round(stats);
+	}
+
+	hb_json_cleanup(stats, cached);
+	return OK;
+}
+
+int hb_run_tls(struct hb_stats_s *stats, int rounds)
+{
+	void *sessions[HB_TLS_SESSIONS];
+	int round;
+	int i;
+
+	memset(sessions, 0, sizeof(sessions));
+
+	for (round = 0; round < rounds; round++) {
+		hb_tls_handshake(stats, &sessions[round % HB_TLS_SESSIONS]);
+		hb_stats_round(stats);
+	}
+
+	for (i = 0; i < HB_TLS_SESSIONS; i++) {
+		hb_free(stats, sessions[i]);
+	}
+
+	return OK;
+}
+
+int hb_run_media(struct hb_stats_s *stats, int rounds)
+{
+	struct hb_frame_s ring[HB_MEDIA_DEPTH];
+	int head = 0;
+	int count = 0;
+	int round;
+	int i;
+
+	memset(ring, 0, sizeof(ring));
+
+	for (round = 0; round < rounds; round++) {
+		hb_media_round(stats, ring, &head, &count);
+		hb_stats_round(stats);
+	}
+
+	for (i = 0; i < HB_MEDIA_DEPTH; i++) {
+		hb_free(stats, ring[i].buf);
+		hb_free(stats, ring[i].meta);
+	}
+
+	return OK;
+}
+
+int hb_run_contention(struct hb_stats_s *stats, int rounds, int ntasks)
+{
+	char index[4];
+	char *argv[2];
+	int ncreated = 0;
+	int i;
+
+	if (ntasks > HB_NTASKS_MAX) {
+		ntasks = HB_NTASKS_MAX;
+	}
+
+	sem_init(&g_hb_start, 0, 0);
+	sem_init(&g_hb_done, 0, 0);
+
+	/* Workers run the JSON mix at different priorities so that the low
+	 * priority ones get preempted while holding the heap semaphore.
+	 * The shared random generator is not protected, the mix only needs to
+	 * be random, not reproducible, here.
+	 */
+
+	argv[0] = index;
+	argv[1] = NULL;
+	for (i = 0; i < ntasks; i++) {
+		hb_stats_init(&g_hb_workers[i].stats);
+		g_hb_workers[i].rounds = rounds;
+
+		snprintf(index, sizeof(index), "%d", i);
+		if (task_create("heapbench_worker", SCHED_PRIORITY_DEFAULT - 10 + (i % 3) * 10, 2048, hb_worker, argv) < 0) {
+			printf("Failed to create worker %d\n", i);
+			break;
+		}
+		ncreated++;
+	}
+
+	for (i = 0; i < ncreated; i++) {
+		sem_post(&g_hb_start);
+	}
+
+	/* The workers finish in any order, merge once all of them are done */
+
+	for (i = 0; i < ncreated; i++) {
+		while (sem_wait(&g_hb_done) != 0) ;
+	}
+
+	for (i = 0; i < ncreated; i++) {
+		hb_stats_merge(stats, &g_hb_workers[i].stats);
+	}
+
+	hb_stats_round(stats);
+
+	sem_destroy(&g_hb_start);
+	sem_destroy(&g_hb_done);
+
+	return ncreated == ntasks ? OK : ERROR;
+}
+
+int hb_run_trace(struct hb_stats_s *stats, const char *path)
+{
+	char line[HB_TRACE_LINE_MAX];
+	void **live;
+	void *grown;
+	FILE *fp;
+	unsigned long id;
+	unsigned long size;
+	unsigned long n;
+	int lineno = 0;
+	int ret = OK;
+
+	fp = fopen(path, "r");
+	if (!fp) {
+		printf("Failed to open trace %s\n", path);
+		return ERROR;
+	}
+
+	live = calloc(CONFIG_EXAMPLES_HEAP_BENCHMARK_TRACE_MAXIDS, sizeof(void *));
+	if (!live) {
+		fclose(fp);
+		return ERROR;
+	}
+
+	/* One operation per line:
+	 *   m <id> <size>       malloc
+	 *   c <id> <n> <size>   calloc
+	 *   r <id> <size>       realloc
+	 *   f <id>              free
+	 */
+
+	while (fgets(line, sizeof(line), fp)) {
+		lineno++;
+		if (line[0] == '#' || line[0] == '\n') {
+			continue;
+		}
+
+		id = strtoul(&line[1], NULL, 10);
+		if (id >= CONFIG_EXAMPLES_HEAP_BENCHMARK_TRACE_MAXIDS) {
+			printf("Trace line %d: id %lu out of range\n", lineno, id);
+			ret = ERROR;
+			break;
+		}
+
+		switch (line[0]) {
+		case 'm':
+			if (sscanf(line, "m %lu %lu", &id, &size) != 2) {
+				goto errout_format;
+			}
+			hb_free(stats, live[id]);
+			live[id] = hb_malloc(stats, size);
+			break;
+
+		case 'c':
+			if (sscanf(line, "c %lu %lu %lu", &id, &n, &size) != 3) {
+				goto errout_format;
+			}
+			hb_free(stats, live[id]);
+			live[id] = hb_calloc(stats, n, size);
+			break;
+
+		case 'r':
+			if (sscanf(line, "r %lu %lu", &id, &size) != 2) {
+				goto errout_format;
+			}
+			grown = hb_realloc(stats, live[id], size);
+			if (grown) {
+				live[id] = grown;
+			}
+			break;
+
+		case 'f':
+			hb_free(stats, live[id]);
+			live[id] = NULL;
+			break;
+
+		default:
+			goto errout_format;
+		}
+
+		if ((lineno % HB_TRACE_ROUND_LINES) == 0) {
+			hb_stats_round(stats);
+		}
+		continue;
+
+errout_format:
+		printf("Trace line %d: bad format\n", lineno);
+		ret = ERROR;
+		break;
+	}
+
+	hb_stats_round(stats);
+
+	for (id = 0; id < CONFIG_EXAMPLES_HEAP_BENCHMARK_TRACE_MAXIDS; id++) {
+		hb_free(stats, live[id]);
+	}
+
+	free(live);
+	fclose(fp);
+	return ret;
+}
@@ -0,0 +1,232 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file string_benchmark_main.c
+
+/// @brief Throughput benchmark of the libc string functions.
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define SB_BYTES             CONFIG_EXAMPLES_STRING_BENCHMARK_BYTES
+#define SB_MAXSIZE           4096
+
+/* Room for the misalignment and the terminating null of strings */
+
+#define SB_BUFSIZE           (SB_MAXSIZE + 16)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+enum sb_func_e {
+	SB_MEMCPY = 0,
+	SB_MEMSET,
+	SB_MEMCMP,
+	SB_STRLEN,
+	SB_STRCHR,
+	SB_NFUNCS
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const char *g_sb_name[SB_NFUNCS] = { "memcpy", "memset", "memcmp", "strlen", "strchr" };
+static const size_t g_sb_size[] = { 8, 32, 128, 1024, SB_MAXSIZE };
+
+static uint32_t g_sb_src[SB_BUFSIZE / 4];
+static uint32_t g_sb_dst[SB_BUFSIZE / 4];
+
+/* The functions are called through these, so that the compiler can neither
+ * inline them nor move calls with the same arguments out of the loops.
+ */
+
+static void *(*volatile g_sb_memcpy)(void *, const void *, size_t) = memcpy;
+static void *(*volatile g_sb_memset)(void *, int, size_t) = memset;
+static int (*volatile g_sb_memcmp)(const void *, const void *, size_t) = memcmp;
+static size_t (*volatile g_sb_strlen)(const char *) = strlen;
+static char *(*volatile g_sb_strchr)(const char *, int) = strchr;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static uint32_t sb_get_usec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	return (uint32_t)ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+/* Prepare the buffers for func and check its result once.  Returns false
+ * if the result is wrong.
+ */
+
+static bool sb_check(enum sb_func_e func, char *dst, char *src, size_t size)
+{
+	size_t i;
+
+	for (i = 0; i < size; i++) {
+		src[i] = 'a' + i % 26;
+	}
+	src[size] = '\0';
+
+	switch (func) {
+	case SB_MEMCPY:
+		g_sb_memset(dst, 0, size);
+		return g_sb_memcpy(dst, src, size) == dst && memcmp(dst, src, size) == 0;
+	case SB_MEMSET:
+		g_sb_memset(dst, 0x5a, size);
+		for (i = 0; i < size; i++) {
+			if (dst[i] != 0x5a) {
+				return false;
+			}
+		}
+		return true;
+	case SB_MEMCMP:
+		/* Equal buffers, so that every byte is compared */
+
+		memcpy(dst, src, size);
+		if (g_sb_memcmp(dst, src, size) != 0) {
+			return false;
+		}
+		dst[size - 1]--;
+		return g_sb_memcmp(dst, src, size) < 0;
+	case SB_STRLEN:
+		return g_sb_strlen(src) == size;
+	case SB_STRCHR:
+		/* The character is not in the string, so that all of it is searched */
+
+		return g_sb_strchr(src, '#') == NULL && g_sb_strchr(src, '\0') == &src[size];
+	default:
+		return false;
+	}
+}
+
+static uint32_t sb_run(enum sb_func_e func, char *dst, char *src, size_t size, int loops)
+{
+	uint32_t start;
+	int i;
+
+	start = sb_get_usec();
+	switch (func) {
+	case SB_MEMCPY:
+		for (i = 0; i < loops; i++) {
+			g_sb_memcpy(dst, src, size);
+		}
+		break;
+	case SB_MEMSET:
+		for (i = 0; i < loops; i++) {
+			g_sb_memset(dst, i, size);
+		}
+		break;
+	case SB_MEMCMP:
+		memcpy(dst, src, size);
+		for (i = 0; i < loops; i++) {
+			g_sb_memcmp(dst, src, size);
+		}
+		break;
+	case SB_STRLEN:
+		for (i = 0; i < loops; i++) {
+			g_sb_strlen(src);
+		}
+		break;
+	case SB_STRCHR:
+		for (i = 0; i < loops; i++) {
+			g_sb_strchr(src, '#');
+		}
+		break;
+	default:
+		break;
+	}
+	return sb_get_usec() - start;
+}
+
+/* Run func for every size with the given misalignments of the destination
+ * and the source.
+ */
+
+static int sb_measure(enum sb_func_e func, int dst_off, int src_off)
+{
+	char *dst = (char *)g_sb_dst + dst_off;
+	char *src = (char *)g_sb_src + src_off;
+	uint32_t elapsed;
+	size_t size;
+	int loops;
+	int i;
+
+	for (i = 0; i < sizeof(g_sb_size) / sizeof(g_sb_size[0]); i++) {
+		size = g_sb_size[i];
+		if (!sb_check(func, dst, src, size)) {
+			printf("%-7s %5u bytes, offsets %d/%d : wrong result\n", g_sb_name[func], (unsigned int)size, dst_off, src_off);
+			return ERROR;
+		}
+
+		loops = SB_BYTES / size;
+		elapsed = sb_run(func, dst, src, size, loops);
+		if (elapsed == 0) {
+			elapsed = 1;
+		}
+
+		printf("%-7s %5u bytes, offsets %d/%d : %8u us, %6u KB/s, %5u ns/call\n", g_sb_name[func], (unsigned int)size, dst_off, src_off, (unsigned int)elapsed, (unsigned int)(((uint64_t)size * loops * 1000000 / 1024) / elapsed), (unsigned int)(((uint64_t)elapsed * 1000) / loops));
+	}
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int strbench_main(int argc, char *argv[])
+#endif
+{
+	int func;
+	int ret = OK;
+
+	printf("libc string benchmark, %d bytes per measurement\n", SB_BYTES);
+
+	for (func = 0; func < SB_NFUNCS; func++) {
+		/* Aligned buffers, then buffers which are not word aligned
+		 * and, for the functions of two buffers, not aligned to each other.
+		 */
+
+		if (sb_measure(func, 0, 0) != OK || sb_measure(func, 1, 3) != OK) {
+			ret = ERROR;
+		}
+	}
+
+	printf("libc string benchmark %s\n", ret == OK ? "done" : "FAILED");
+	return ret;
+}
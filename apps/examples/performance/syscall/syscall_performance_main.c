@@ -28,6 +28,8 @@
 #include <sys/ioctl.h>
 #include <sys/types.h>
 #include <fcntl.h>
+#include <semaphore.h>
+#include <pthread.h>
 
 #define NUM_LOOPS	1000000
 #define SEC_10	10
@@ -173,6 +175,86 @@ static void syscall_perf_timer_settime(void)
 	measure_performance(timer_settime, 4, timer_id, 0, NULL, NULL);
 }
 
+#ifdef CONFIG_SEM_FASTPATH
+/*
+ * The semaphore and the mutex are free at each call, so sem_wait() and
+ * pthread_mutex_lock() take the fast path of libc.  The names in parentheses
+ * call the system calls themselves, for comparison.
+ */
+
+static sem_t g_perf_sem;
+
+static void sem_wait_post_fast(sem_t *sem)
+{
+	sem_wait(sem);
+	sem_post(sem);
+}
+
+static void sem_wait_post_syscall(sem_t *sem)
+{
+	(sem_wait)(sem);
+	(sem_post)(sem);
+}
+
+/*
+ * @fn                   :syscall_perf_sem_fastpath
+ * @description          :Measuring performance for uncontended sem_wait/sem_post
+ * @return               :void
+ */
+static void syscall_perf_sem_fastpath(void)
+{
+	unsigned int nslow;
+
+	sem_init(&g_perf_sem, 0, 1);
+
+	nslow = sem_fastpath_nslow();
+	measure_performance(sem_wait_post_fast, 7, &g_perf_sem);
+	printf("sem_wait_post_fast - system calls made: %u\n", sem_fastpath_nslow() - nslow);
+
+	measure_performance(sem_wait_post_syscall, 8, &g_perf_sem);
+	printf("sem_wait_post_syscall - system calls made: %d\n", 2 * NUM_LOOPS);
+
+	sem_destroy(&g_perf_sem);
+}
+
+#ifdef CONFIG_PTHREAD_MUTEX_UNSAFE
+static pthread_mutex_t g_perf_mutex;
+
+static void mutex_lock_unlock_fast(pthread_mutex_t *mutex)
+{
+	pthread_mutex_lock(mutex);
+	pthread_mutex_unlock(mutex);
+}
+
+static void mutex_lock_unlock_syscall(pthread_mutex_t *mutex)
+{
+	(pthread_mutex_lock)(mutex);
+	(pthread_mutex_unlock)(mutex);
+}
+
+/*
+ * @fn                   :syscall_perf_mutex_fastpath
+ * @description          :Measuring performance for uncontended pthread mutex lock/unlock
+ * @return               :void
+ */
+static void syscall_perf_mutex_fastpath(void)
+{
+	unsigned int nslow;
+
+	pthread_mutex_init(&g_perf_mutex, NULL);
+
+	nslow = sem_fastpath_nslow();
+	measure_performance(mutex_lock_unlock_fast, 9, &g_perf_mutex);
+	printf("mutex_lock_unlock_fast - system calls made: %u\n", sem_fastpath_nslow() - nslow);
+
+	measure_performance(mutex_lock_unlock_syscall, 10, &g_perf_mutex);
+	printf("mutex_lock_unlock_syscall - system calls made: %d\n", 2 * NUM_LOOPS);
+
+	pthread_mutex_destroy(&g_perf_mutex);
+}
+#endif
+#endif
+
 /****************************************************************************
  * Name: Syscall Performance
  ****************************************************************************/
@@ -213,5 +295,19 @@ int syscall_performance_main(void)
 	syscall_perf_mq_open();
 	sched_unlock();
 
+#ifdef CONFIG_SEM_FASTPATH
+	/* System Calls 7 and 8 */
+	sched_lock();
+	syscall_perf_sem_fastpath();
+	sched_unlock();
+
+#ifdef CONFIG_PTHREAD_MUTEX_UNSAFE
+	/* System Calls 9 and 10 */
+	sched_lock();
+	syscall_perf_mutex_fastpath();
+	sched_unlock();
+#endif
+#endif
+
 	return 0;
 }
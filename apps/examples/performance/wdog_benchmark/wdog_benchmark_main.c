@@ -0,0 +1,346 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/// @file wdog_benchmark_main.c
+
+/// @brief Timer storm benchmark of the watchdog timer queue.
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sched.h>
+#include <semaphore.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/wdog.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define WDB_MAXTIMERS        CONFIG_EXAMPLES_WDOG_BENCHMARK_MAXTIMERS
+#define WDB_DEFAULT_SEED     0x5eed
+#define WDB_MIN_TIMERS       16
+
+/* Delays of the timers kept active while measuring, long enough that none
+ * expires during a run.
+ */
+
+#define WDB_LONG_MIN         (2 * TICK_PER_SEC)
+#define WDB_LONG_SPAN        (60 * TICK_PER_SEC)
+
+/* Delays of the storm timers, all expiring within a few ticks */
+
+#define WDB_STORM_SPAN       8
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct wdb_result_s {
+	uint32_t p50;
+	uint32_t p99;
+	uint32_t max;
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static WDOG_ID g_wdb_wdog[WDB_MAXTIMERS];
+static uint32_t g_wdb_samples[WDB_MAXTIMERS];
+static uint16_t g_wdb_order[WDB_MAXTIMERS];
+static uint32_t g_wdb_seed;
+
+static clock_t g_wdb_due[WDB_MAXTIMERS];
+static volatile int g_wdb_fired;
+static volatile clock_t g_wdb_maxlate;
+static volatile int g_wdb_unexpected;
+
+static sem_t g_wdb_finished;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void show_usage(const char *progname)
+{
+	printf("Usage: %s [-s seed] [-n ntimers]\n", progname);
+	printf("  -s seed    : seed of the random delays (default %d)\n", WDB_DEFAULT_SEED);
+	printf("  -n ntimers : largest number of active watchdogs, %d to %d (default %d)\n", WDB_MIN_TIMERS, WDB_MAXTIMERS, WDB_MAXTIMERS);
+}
+
+static uint32_t wdb_rand(void)
+{
+	/* xorshift32, so that runs only depend on the seed */
+
+	g_wdb_seed ^= g_wdb_seed << 13;
+	g_wdb_seed ^= g_wdb_seed >> 17;
+	g_wdb_seed ^= g_wdb_seed << 5;
+	return g_wdb_seed;
+}
+
+static void wdb_shuffle(int n)
+{
+	uint16_t tmp;
+	int i;
+	int j;
+
+	for (i = 0; i < n; i++) {
+		g_wdb_order[i] = i;
+	}
+
+	for (i = n - 1; i > 0; i--) {
+		j = wdb_rand() % (i + 1);
+		tmp = g_wdb_order[i];
+		g_wdb_order[i] = g_wdb_order[j];
+		g_wdb_order[j] = tmp;
+	}
+}
+
+static int wdb_compare(const void *a, const void *b)
+{
+	uint32_t x = *(const uint32_t *)a;
+	uint32_t y = *(const uint32_t *)b;
+
+	return x < y ? -1 : x > y;
+}
+
+static void wdb_result(int n, struct wdb_result_s *result)
+{
+	qsort(g_wdb_samples, n, sizeof(uint32_t), wdb_compare);
+	result->p50 = g_wdb_samples[n / 2];
+	result->p99 = g_wdb_samples[(n * 99) / 100];
+	result->max = g_wdb_samples[n - 1];
+}
+
+static void wdb_long(int argc, uint32_t arg1)
+{
+	/* None of these should expire */
+
+	g_wdb_unexpected++;
+}
+
+static void wdb_storm(int argc, uint32_t arg1)
+{
+	clock_t late = clock_systimer() - g_wdb_due[arg1];
+
+	if (late > g_wdb_maxlate) {
+		g_wdb_maxlate = late;
+	}
+	g_wdb_fired++;
+}
+
+static uint32_t wdb_start(int i, int delay, wdentry_t entry)
+{
+	uint32_t start;
+
+	start = up_perf_gettime();
+	(void)wd_start(g_wdb_wdog[i], delay, entry, 1, (uint32_t)i);
+	return up_perf_gettime() - start;
+}
+
+static uint32_t wdb_cancel(int i)
+{
+	uint32_t start;
+
+	start = up_perf_gettime();
+	(void)wd_cancel(g_wdb_wdog[i]);
+	return up_perf_gettime() - start;
+}
+
+/* Start n watchdogs with random long delays, restart them all in random
+ * order and cancel them all in random order.
+ */
+
+static void wdb_run_queue(int n)
+{
+	struct wdb_result_s start;
+	struct wdb_result_s restart;
+	struct wdb_result_s cancel;
+	int i;
+
+	for (i = 0; i < n; i++) {
+		g_wdb_samples[i] = wdb_start(i, WDB_LONG_MIN + wdb_rand() % WDB_LONG_SPAN, (wdentry_t)wdb_long);
+	}
+	wdb_result(n, &start);
+
+	wdb_shuffle(n);
+	for (i = 0; i < n; i++) {
+		g_wdb_samples[i] = wdb_start(g_wdb_order[i], WDB_LONG_MIN + wdb_rand() % WDB_LONG_SPAN, (wdentry_t)wdb_long);
+	}
+	wdb_result(n, &restart);
+
+	wdb_shuffle(n);
+	for (i = 0; i < n; i++) {
+		g_wdb_samples[i] = wdb_cancel(g_wdb_order[i]);
+	}
+	wdb_result(n, &cancel);
+
+	printf("%8d | %6u %6u %6u | %6u %6u %6u | %6u %6u %6u\n", n,
+		   start.p50, start.p99, start.max,
+		   restart.p50, restart.p99, restart.max,
+		   cancel.p50, cancel.p99, cancel.max);
+}
+
+/* Start half of the watchdogs with long delays and the other half with
+ * delays of a few ticks, and wait for the short ones to expire.
+ */
+
+static void wdb_run_storm(int n)
+{
+	struct wdb_result_s start;
+	int nstorm = n / 2;
+	int delay;
+	int i;
+
+	for (i = nstorm; i < n; i++) {
+		(void)wd_start(g_wdb_wdog[i], WDB_LONG_MIN + wdb_rand() % WDB_LONG_SPAN, (wdentry_t)wdb_long, 1, (uint32_t)i);
+	}
+
+	g_wdb_fired = 0;
+	g_wdb_maxlate = 0;
+
+	for (i = 0; i < nstorm; i++) {
+		delay = 1 + wdb_rand() % WDB_STORM_SPAN;
+		g_wdb_due[i] = clock_systimer() + delay;
+		g_wdb_samples[i] = wdb_start(i, delay, (wdentry_t)wdb_storm);
+	}
+	wdb_result(nstorm, &start);
+
+	usleep(USEC_PER_TICK * (WDB_STORM_SPAN + 2));
+
+	for (i = nstorm; i < n; i++) {
+		(void)wd_cancel(g_wdb_wdog[i]);
+	}
+
+	printf("storm of %d among %d : start p50 %u, p99 %u, max %u, expired %d, latest %u ticks late\n",
+		   nstorm, n, start.p50, start.p99, start.max, g_wdb_fired, (unsigned int)g_wdb_maxlate);
+}
+
+static int wdog_benchmark(int argc, char *argv[])
+{
+	int ntimers = atoi(argv[1]);
+	int n;
+	int i;
+
+	g_wdb_unexpected = 0;
+	for (i = 0; i < ntimers; i++) {
+		g_wdb_wdog[i] = wd_create();
+		if (g_wdb_wdog[i] == NULL) {
+			printf("Failed to create watchdog %d\n", i);
+			ntimers = i;
+			break;
+		}
+	}
+
+	printf("Watchdog queue : %s\n",
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+		   "timing wheel"
+#else
+		   "sorted list"
+#endif
+		  );
+	printf("Seed %u, %u cycles per second\n\n", g_wdb_seed, up_perf_getfreq());
+
+	printf("  active | wd_start (cycles)    | wd_start again       | wd_cancel\n");
+	printf("         |    p50    p99    max |    p50    p99    max |    p50    p99    max\n");
+	for (n = WDB_MIN_TIMERS; n <= ntimers; n *= 2) {
+		wdb_run_queue(n);
+	}
+	printf("\n");
+
+	for (n = WDB_MIN_TIMERS; n <= ntimers; n *= 4) {
+		wdb_run_storm(n);
+	}
+
+	if (g_wdb_unexpected > 0) {
+		printf("\n%d long watchdogs expired during the runs, results are not valid\n", g_wdb_unexpected);
+	}
+
+	for (i = 0; i < ntimers; i++) {
+		(void)wd_delete(g_wdb_wdog[i]);
+	}
+
+	sem_post(&g_wdb_finished);
+	return 0;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+#ifdef CONFIG_BUILD_KERNEL
+int main(int argc, FAR char *argv[])
+#else
+int wdbench_main(int argc, char *argv[])
+#endif
+{
+	char ntimers[12];
+	char *args[2];
+	int opt;
+	int n = WDB_MAXTIMERS;
+
+	g_wdb_seed = WDB_DEFAULT_SEED;
+
+	optind = -1;
+	while ((opt = getopt(argc, argv, "s:n:")) != -1) {
+		switch (opt) {
+		case 's':
+			g_wdb_seed = strtoul(optarg, NULL, 0);
+			break;
+		case 'n':
+			n = atoi(optarg);
+			break;
+		default:
+			show_usage(argv[0]);
+			return ERROR;
+		}
+	}
+
+	if (g_wdb_seed == 0 || n < WDB_MIN_TIMERS || n > WDB_MAXTIMERS) {
+		show_usage(argv[0]);
+		return ERROR;
+	}
+
+	/* Run at the highest priority so that the measurements are only
+	 * disturbed by interrupts.
+	 */
+
+	snprintf(ntimers, sizeof(ntimers), "%d", n);
+	args[0] = ntimers;
+	args[1] = NULL;
+
+	sem_init(&g_wdb_finished, 0, 0);
+	if (task_create("wdbench", SCHED_PRIORITY_MAX - 1, 4096, wdog_benchmark, args) < 0) {
+		printf("Failed to create the benchmark task\n");
+		sem_destroy(&g_wdb_finished);
+		return ERROR;
+	}
+
+	while (sem_wait(&g_wdb_finished) != 0) ;
+	sem_destroy(&g_wdb_finished);
+
+	return OK;
+}
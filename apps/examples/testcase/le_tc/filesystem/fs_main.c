@@ -38,6 +38,12 @@
 #include <poll.h>
 #endif
 #include <errno.h>
+#ifdef CONFIG_FS_AIO
+#include <aio.h>
+#endif
+#ifdef CONFIG_EPOLL
+#include <sys/epoll.h>
+#endif
 #include <sys/ioctl.h>
 #include <sys/mount.h>
 #include <sys/stat.h>
@@ -129,6 +135,12 @@ static char *TMP_MOUNT_DEV_DIR;
 
 #define DEV_RAMDISK_PATH "/dev/ram2"
 
+#define AIO_BENCH_COUNT 8
+
+#define AIO_BENCH_SIZE 512
+
+#define AIO_BENCH_ROUNDS 16
+
 #define LONG_FILE_LOOP_COUNT 24
 
 #if defined(CONFIG_PIPES) && (CONFIG_DEV_PIPE_SIZE > 11)
@@ -2635,6 +2647,334 @@ static void tc_fs_vfs_sendfile_offset_eof_n(void)
 	TC_SUCCESS_RESULT();
 }
 
+#if defined(CONFIG_PIPES) && (CONFIG_DEV_PIPE_SIZE > 14)
+/**
+ * @testcase         tc_fs_vfs_sendfile_pipe_p
+ * @brief            Send file data through two pipes
+ * @scenario         Send a file to a pipe, that pipe to a second one, then the second pipe to another file, and compare the data
+ * @apicovered       pipe, open, sendfile, pread
+ * @precondition     CONFIG_PIPES should be enabled & CONFIG_DEV_PIPE_SIZE must greater than 14
+ * @postcondition    NA
+ */
+static void tc_fs_vfs_sendfile_pipe_p(void)
+{
+	char *src_file = VFS_FILE_PATH;
+	char dest_file[16];
+	char buf[16];
+	char *str = "sendfile test";
+	size_t size = strlen(str);
+	int pipefd[2];
+	int pipefd2[2];
+	int fd1, fd2, ret;
+
+	/* Init */
+	vfs_mount();
+
+	snprintf(dest_file, sizeof(dest_file), "%s_dest", src_file);
+
+	fd1 = open(src_file, O_RDWR | O_CREAT | O_TRUNC);
+	TC_ASSERT_GEQ_CLEANUP("open", fd1, 0, vfs_unmount());
+
+	ret = pwrite(fd1, str, size, 0);
+	TC_ASSERT_EQ_CLEANUP("pwrite", ret, size, close(fd1); vfs_unmount());
+
+	ret = pipe(pipefd);
+	TC_ASSERT_EQ_CLEANUP("pipe", ret, OK, close(fd1); vfs_unmount());
+
+	/* Testcase : file to pipe */
+	ret = sendfile(pipefd[1], fd1, NULL, size);
+	close(pipefd[1]);
+	close(fd1);
+	TC_ASSERT_EQ_CLEANUP("sendfile", ret, size, close(pipefd[0]); vfs_unmount());
+
+	/* Testcase : pipe to pipe, up to the end of the first pipe */
+	ret = pipe(pipefd2);
+	TC_ASSERT_EQ_CLEANUP("pipe", ret, OK, close(pipefd[0]); vfs_unmount());
+
+	ret = sendfile(pipefd2[1], pipefd[0], NULL, sizeof(buf));
+	close(pipefd[0]);
+	close(pipefd2[1]);
+	TC_ASSERT_EQ_CLEANUP("sendfile", ret, size, close(pipefd2[0]); vfs_unmount());
+
+	/* Testcase : pipe to file, up to the end of the pipe */
+	fd2 = open(dest_file, O_RDWR | O_CREAT | O_TRUNC);
+	TC_ASSERT_GEQ_CLEANUP("open", fd2, 0, close(pipefd2[0]); vfs_unmount());
+
+	ret = sendfile(fd2, pipefd2[0], NULL, sizeof(buf));
+	close(pipefd2[0]);
+	TC_ASSERT_EQ_CLEANUP("sendfile", ret, size, close(fd2); vfs_unmount());
+
+	memset(buf, 0, sizeof(buf));
+	ret = pread(fd2, buf, sizeof(buf), 0);
+	close(fd2);
+	TC_ASSERT_EQ_CLEANUP("pread", ret, size, vfs_unmount());
+	TC_ASSERT_EQ_CLEANUP("pread", strncmp(buf, str, size), 0, vfs_unmount());
+
+	/* Deinit */
+	vfs_unmount();
+
+	TC_SUCCESS_RESULT();
+}
+#endif
+
+#ifdef CONFIG_FS_AIO
+/**
+ * @testcase         tc_fs_vfs_aio_listio_p
+ * @brief            Write and read a file with batches of asynchronous I/O
+ * @scenario         Write AIO_BENCH_COUNT contiguous blocks with lio_listio,
+ *                   read them back with lio_listio and compare, and print
+ *                   the throughput of both
+ * @apicovered       lio_listio, aio_error, aio_return
+ * @precondition     NA
+ * @postcondition    NA
+ */
+static void tc_fs_vfs_aio_listio_p(void)
+{
+	static char wbuf[AIO_BENCH_COUNT * AIO_BENCH_SIZE];
+	static char rbuf[AIO_BENCH_COUNT * AIO_BENCH_SIZE];
+	struct aiocb aiocbs[AIO_BENCH_COUNT];
+	struct aiocb *list[AIO_BENCH_COUNT];
+	struct timespec start;
+	struct timespec end;
+	uint32_t wusec = 0;
+	uint32_t rusec = 0;
+	int round;
+	int fd;
+	int ret;
+	int i;
+
+	/* Init */
+	vfs_mount();
+
+	for (i = 0; i < sizeof(wbuf); i++) {
+		wbuf[i] = (char)i;
+	}
+
+	fd = open(VFS_FILE_PATH, O_RDWR | O_CREAT | O_TRUNC);
+	TC_ASSERT_GEQ_CLEANUP("open", fd, 0, vfs_unmount());
+
+	for (round = 0; round < AIO_BENCH_ROUNDS; round++) {
+		/* Testcase : contiguous writes, which may be merged */
+		memset(aiocbs, 0, sizeof(aiocbs));
+		for (i = 0; i < AIO_BENCH_COUNT; i++) {
+			aiocbs[i].aio_sigevent.sigev_notify = SIGEV_NONE;
+			aiocbs[i].aio_buf = &wbuf[i * AIO_BENCH_SIZE];
+			aiocbs[i].aio_offset = i * AIO_BENCH_SIZE;
+			aiocbs[i].aio_nbytes = AIO_BENCH_SIZE;
+			aiocbs[i].aio_fildes = fd;
+			aiocbs[i].aio_lio_opcode = LIO_WRITE;
+			list[i] = &aiocbs[i];
+		}
+
+		clock_gettime(CLOCK_REALTIME, &start);
+		ret = lio_listio(LIO_WAIT, list, AIO_BENCH_COUNT, NULL);
+		clock_gettime(CLOCK_REALTIME, &end);
+		TC_ASSERT_EQ_CLEANUP("lio_listio", ret, OK, close(fd); vfs_unmount());
+		wusec += (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+
+		for (i = 0; i < AIO_BENCH_COUNT; i++) {
+			TC_ASSERT_EQ_CLEANUP("aio_error", aio_error(&aiocbs[i]), OK, close(fd); vfs_unmount());
+			TC_ASSERT_EQ_CLEANUP("aio_return", aio_return(&aiocbs[i]), AIO_BENCH_SIZE, close(fd); vfs_unmount());
+		}
+
+		/* Testcase : contiguous reads, which may be merged */
+		memset(rbuf, 0, sizeof(rbuf));
+		for (i = 0; i < AIO_BENCH_COUNT; i++) {
+			aiocbs[i].aio_buf = &rbuf[i * AIO_BENCH_SIZE];
+			aiocbs[i].aio_lio_opcode = LIO_READ;
+		}
+
+		clock_gettime(CLOCK_REALTIME, &start);
+		ret = lio_listio(LIO_WAIT, list, AIO_BENCH_COUNT, NULL);
+		clock_gettime(CLOCK_REALTIME, &end);
+		TC_ASSERT_EQ_CLEANUP("lio_listio", ret, OK, close(fd); vfs_unmount());
+		rusec += (end.tv_sec - start.tv_sec) * 1000000 + (end.tv_nsec - start.tv_nsec) / 1000;
+
+		for (i = 0; i < AIO_BENCH_COUNT; i++) {
+			TC_ASSERT_EQ_CLEANUP("aio_return", aio_return(&aiocbs[i]), AIO_BENCH_SIZE, close(fd); vfs_unmount());
+		}
+
+		TC_ASSERT_EQ_CLEANUP("lio_listio", memcmp(rbuf, wbuf, sizeof(wbuf)), 0, close(fd); vfs_unmount());
+	}
+
+	close(fd);
+
+	printf("AIO %d x %d bytes: write %u usec, read %u usec per batch\n", AIO_BENCH_COUNT, AIO_BENCH_SIZE, wusec / AIO_BENCH_ROUNDS, rusec / AIO_BENCH_ROUNDS);
+	if (wusec > 0 && rusec > 0) {
+		printf("AIO throughput: write %u KB/s, read %u KB/s\n", (uint32_t)((uint64_t)sizeof(wbuf) * AIO_BENCH_ROUNDS * 1000000 / 1024 / wusec), (uint32_t)((uint64_t)sizeof(rbuf) * AIO_BENCH_ROUNDS * 1000000 / 1024 / rusec));
+	}
+
+	/* Deinit */
+	vfs_unmount();
+
+	TC_SUCCESS_RESULT();
+}
+#endif
+
+#if defined(CONFIG_EPOLL) && defined(CONFIG_PIPES)
+/**
+ * @testcase         tc_fs_vfs_epoll_pipe_p
+ * @brief            Wait for a pipe with epoll
+ * @scenario         Add the read end of a pipe to an epoll instance, and check
+ *                   that it is reported while data is in the pipe, and once
+ *                   per write with EPOLLET
+ * @apicovered       epoll_create, epoll_ctl, epoll_wait
+ * @precondition     NA
+ * @postcondition    NA
+ */
+static void tc_fs_vfs_epoll_pipe_p(void)
+{
+	struct epoll_event ev;
+	struct epoll_event evs[2];
+	int pipefd[2];
+	int epfd;
+	char ch = 'e';
+	int ret;
+
+	ret = pipe(pipefd);
+	TC_ASSERT_EQ("pipe", ret, OK);
+
+	epfd = epoll_create(1);
+	TC_ASSERT_GEQ_CLEANUP("epoll_create", epfd, 0, close(pipefd[0]); close(pipefd[1]));
+
+	ev.events = EPOLLIN;
+	ev.data.fd = pipefd[0];
+	ret = epoll_ctl(epfd, EPOLL_CTL_ADD, pipefd[0], &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, goto errout);
+
+	ret = epoll_ctl(epfd, EPOLL_CTL_ADD, pipefd[0], &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, ERROR, goto errout);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", errno, EEXIST, goto errout);
+
+	/* Testcase : nothing is ready */
+	ret = epoll_wait(epfd, evs, 2, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 0, goto errout);
+
+	/* Testcase : level triggered, reported while data is in the pipe */
+	ret = write(pipefd[1], &ch, 1);
+	TC_ASSERT_EQ_CLEANUP("write", ret, 1, goto errout);
+
+	ret = epoll_wait(epfd, evs, 2, 1000);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 1, goto errout);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", evs[0].data.fd, pipefd[0], goto errout);
+	TC_ASSERT_NEQ_CLEANUP("epoll_wait", evs[0].events & EPOLLIN, 0, goto errout);
+
+	ret = epoll_wait(epfd, evs, 2, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 1, goto errout);
+
+	ret = read(pipefd[0], &ch, 1);
+	TC_ASSERT_EQ_CLEANUP("read", ret, 1, goto errout);
+
+	ret = epoll_wait(epfd, evs, 2, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 0, goto errout);
+
+	/* Testcase : edge triggered, reported once per write */
+	ev.events = EPOLLIN | EPOLLET;
+	ret = epoll_ctl(epfd, EPOLL_CTL_MOD, pipefd[0], &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, goto errout);
+
+	ret = write(pipefd[1], &ch, 1);
+	TC_ASSERT_EQ_CLEANUP("write", ret, 1, goto errout);
+
+	ret = epoll_wait(epfd, evs, 2, 1000);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 1, goto errout);
+
+	ret = epoll_wait(epfd, evs, 2, 0);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 0, goto errout);
+
+	ret = epoll_ctl(epfd, EPOLL_CTL_DEL, pipefd[0], NULL);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, goto errout);
+
+	close(epfd);
+	close(pipefd[0]);
+	close(pipefd[1]);
+	TC_SUCCESS_RESULT();
+	return;
+
+errout:
+	close(epfd);
+	close(pipefd[0]);
+	close(pipefd[1]);
+}
+#endif
+
+#if defined(CONFIG_EPOLL) && defined(CONFIG_PIPES)
+/**
+ * @testcase         tc_fs_vfs_epoll_close_p
+ * @brief            Close a descriptor watched by epoll
+ * @scenario         Close the read end of a pipe added to an epoll instance
+ *                   before EPOLL_CTL_DEL, and replace it with dup2() before
+ *                   the epoll instance is closed
+ * @apicovered       epoll_create, epoll_ctl, epoll_wait, close, dup2
+ * @precondition     NA
+ * @postcondition    NA
+ */
+static void tc_fs_vfs_epoll_close_p(void)
+{
+	struct epoll_event ev;
+	struct epoll_event evs[2];
+	int pipefd[2];
+	int epfd;
+	char ch = 'e';
+	int ret;
+
+	ret = pipe(pipefd);
+	TC_ASSERT_EQ("pipe", ret, OK);
+
+	epfd = epoll_create(1);
+	TC_ASSERT_GEQ_CLEANUP("epoll_create", epfd, 0, close(pipefd[0]); close(pipefd[1]));
+
+	ev.events = EPOLLIN;
+	ev.data.fd = pipefd[0];
+	ret = epoll_ctl(epfd, EPOLL_CTL_ADD, pipefd[0], &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, goto errout);
+
+	/* Testcase : close() drops the descriptor from the interest list */
+	close(pipefd[0]);
+
+	ret = epoll_ctl(epfd, EPOLL_CTL_DEL, pipefd[0], NULL);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, ERROR, goto errout_with_write);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", errno, ENOENT, goto errout_with_write);
+
+	close(pipefd[1]);
+
+	/* Testcase : the reused descriptor can be added again */
+	ret = pipe(pipefd);
+	TC_ASSERT_EQ_CLEANUP("pipe", ret, OK, close(epfd));
+
+	ev.data.fd = pipefd[0];
+	ret = epoll_ctl(epfd, EPOLL_CTL_ADD, pipefd[0], &ev);
+	TC_ASSERT_EQ_CLEANUP("epoll_ctl", ret, OK, goto errout);
+
+	ret = write(pipefd[1], &ch, 1);
+	TC_ASSERT_EQ_CLEANUP("write", ret, 1, goto errout);
+
+	ret = epoll_wait(epfd, evs, 2, 1000);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", ret, 1, goto errout);
+	TC_ASSERT_EQ_CLEANUP("epoll_wait", evs[0].data.fd, pipefd[0], goto errout);
+
+	/* Testcase : the watched descriptor is replaced, then the epoll
+	 * instance is closed and tears down the pipe it was set up with
+	 */
+	ret = dup2(pipefd[1], pipefd[0]);
+	TC_ASSERT_EQ_CLEANUP("dup2", ret, pipefd[0], goto errout);
+
+	ret = close(epfd);
+	TC_ASSERT_EQ_CLEANUP("close", ret, OK, close(pipefd[0]); close(pipefd[1]));
+
+	close(pipefd[0]);
+	close(pipefd[1]);
+	TC_SUCCESS_RESULT();
+	return;
+
+errout:
+	close(pipefd[0]);
+errout_with_write:
+	close(epfd);
+	close(pipefd[1]);
+}
+#endif
+
 /**
  * @testcase         tc_fs_vfs_fcntl_p
  * @brief            Access & control opened file with fcntl
@@ -6223,6 +6563,16 @@ int tc_filesystem_main(int argc, char *argv[])
 	tc_fs_vfs_sendfile_p();
 	tc_fs_vfs_sendfile_invalid_fd_n();
 	tc_fs_vfs_sendfile_offset_eof_n();
+#if defined(CONFIG_PIPES) && (CONFIG_DEV_PIPE_SIZE > 14)
+	tc_fs_vfs_sendfile_pipe_p();
+#endif
+#ifdef CONFIG_FS_AIO
+	tc_fs_vfs_aio_listio_p();
+#endif
+#if defined(CONFIG_EPOLL) && defined(CONFIG_PIPES)
+	tc_fs_vfs_epoll_pipe_p();
+	tc_fs_vfs_epoll_close_p();
+#endif
 	tc_fs_vfs_fcntl_p();
 	tc_fs_vfs_fcntl_invalid_fd_n();
 	tc_fs_vfs_fdopen_p();
@@ -27,9 +27,11 @@
 #include <fcntl.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <tinyara/fs/ioctl.h>
 #include <sys/stat.h>
 #include <sys/statfs.h>
+#include <sys/mman.h>
 #include <dirent.h>
 #include "tc_common.h"
 #include "tc_internal.h"
@@ -243,6 +245,32 @@ static void tc_fs_mops_ioctl(const char *filesystemtype, int fd)
 	TC_ASSERT_EQ_CLEANUP("ioctl", ret, OK, close(fd));
 }
 
+static void tc_fs_mops_mmap(const char *filesystemtype, int fd)
+{
+	int ret = -1;
+	ssize_t len;
+	char read_buf[16];
+	char *addr;
+
+#ifndef CONFIG_FS_RAMMAP
+	/* Only tmpfs and romfs can map a file without reading it */
+
+	if (strcmp(filesystemtype, "smartfs") == 0) {
+		return;
+	}
+#endif
+
+	len = pread(fd, read_buf, sizeof(read_buf), 0);
+	TC_ASSERT_GT_CLEANUP("pread", len, 0, close(fd));
+
+	addr = (char *)mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+	TC_ASSERT_NEQ_CLEANUP("mmap", addr, MAP_FAILED, close(fd));
+
+	ret = memcmp(addr, read_buf, len);
+	munmap(addr, len);
+	TC_ASSERT_EQ_CLEANUP("mmap", ret, 0, close(fd));
+}
+
 static void tc_fs_mops_dup(int fd)
 {
 	int fd_dup = -1;
@@ -420,6 +448,7 @@ static void tc_fs_mops_test_main(const char *filesystemtype)
 	tc_fs_mops_lseek(filesystemtype, fd1);
 	tc_fs_mops_read(filesystemtype, fd1);
 	tc_fs_mops_ioctl(filesystemtype, fd1);
+	tc_fs_mops_mmap(filesystemtype, fd1);
 	tc_fs_mops_dup(fd1);
 	tc_fs_mops_fstat(filesystemtype, fd1);
 	close(fd1);
@@ -58,6 +58,7 @@
 **************************************************************************/
 #include <tinyara/config.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <errno.h>
 #include <sys/types.h>
@@ -938,6 +939,112 @@ errout:
 	mq_unlink("mqsetattr");	
 }
 
+#ifdef CONFIG_MQ_ZEROCOPY
+#define TEST_BUF_MSGSIZE 256
+
+/**
+* @fn                   :tc_mqueue_mq_send_receive_buf
+* @description          :Zero-copy messages keep their buffer and priority order, mix with copied messages
+* @return               :void
+*/
+static void tc_mqueue_mq_send_receive_buf(void)
+{
+	mqd_t mqdes;
+	struct mq_attr attr;
+	char msg_buffer[TEST_BUF_MSGSIZE];
+	char *bufa;
+	char *bufb;
+	void *rcvbuf = NULL;
+	int prio;
+	ssize_t nbytes;
+
+	attr.mq_maxmsg = 4;
+	attr.mq_msgsize = TEST_BUF_MSGSIZE;
+	attr.mq_flags = 0;
+
+	mqdes = mq_open("mqbuf", O_CREAT | O_RDWR, 0666, &attr);
+	TC_ASSERT_NEQ("mq_open", mqdes, (mqd_t)ERROR);
+
+	bufa = (char *)malloc(TEST_BUF_MSGSIZE);
+	bufb = (char *)malloc(TEST_BUF_MSGSIZE);
+	TC_ASSERT_NEQ_CLEANUP("malloc", bufa, NULL, goto errout);
+	TC_ASSERT_NEQ_CLEANUP("malloc", bufb, NULL, goto errout);
+	memset(bufa, 'a', TEST_BUF_MSGSIZE);
+	memset(bufb, 'b', TEST_BUF_MSGSIZE);
+
+	/* Invalid parameters leave the buffer with the caller */
+
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", mq_send_buf(mqdes, NULL, 1, 1), ERROR, goto errout);
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", errno, EINVAL, goto errout);
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", mq_send_buf(mqdes, (void *)TEST_MESSAGE, TEST_MSGLEN, 1), ERROR, goto errout);
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", errno, EINVAL, goto errout);
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", mq_send_buf(mqdes, bufa, TEST_BUF_MSGSIZE + 1, 1), ERROR, goto errout);
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", errno, EMSGSIZE, goto errout);
+
+	/* A low priority buffer, a copied message and a high priority buffer */
+
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", mq_send_buf(mqdes, bufa, TEST_BUF_MSGSIZE, 1), OK, goto errout);
+	TC_ASSERT_EQ_CLEANUP("mq_send", mq_send(mqdes, TEST_MESSAGE, TEST_MSGLEN, 1), OK, goto errout_b);
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", mq_send_buf(mqdes, bufb, 16, 5), OK, goto errout_b);
+
+	/* The receiver gets the very buffers of the sender, highest priority first */
+
+	nbytes = mq_receive_buf(mqdes, &rcvbuf, &prio);
+	TC_ASSERT_EQ_CLEANUP("mq_receive_buf", nbytes, 16, goto errout_q);
+	TC_ASSERT_EQ_CLEANUP("mq_receive_buf", rcvbuf, (void *)bufb, goto errout_q);
+	TC_ASSERT_EQ_CLEANUP("mq_receive_buf", prio, 5, goto errout_q);
+	free(rcvbuf);
+
+	nbytes = mq_receive_buf(mqdes, &rcvbuf, &prio);
+	TC_ASSERT_EQ_CLEANUP("mq_receive_buf", nbytes, TEST_BUF_MSGSIZE, goto errout_q);
+	TC_ASSERT_EQ_CLEANUP("mq_receive_buf", rcvbuf, (void *)bufa, goto errout_q);
+	TC_ASSERT_EQ_CLEANUP("mq_receive_buf", prio, 1, goto errout_q);
+	free(rcvbuf);
+
+	/* A copied message comes in a buffer of its own */
+
+	nbytes = mq_receive_buf(mqdes, &rcvbuf, &prio);
+	TC_ASSERT_EQ_CLEANUP("mq_receive_buf", nbytes, TEST_MSGLEN, goto errout_q);
+	TC_ASSERT_EQ_CLEANUP("mq_receive_buf", memcmp(rcvbuf, TEST_MESSAGE, TEST_MSGLEN), 0, goto errout_r);
+	free(rcvbuf);
+
+	/* mq_receive() copies a zero-copy message and releases its buffer */
+
+	bufa = (char *)malloc(TEST_BUF_MSGSIZE);
+	TC_ASSERT_NEQ_CLEANUP("malloc", bufa, NULL, goto errout_q);
+	memset(bufa, 'c', 32);
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", mq_send_buf(mqdes, bufa, 32, 3), OK, goto errout_a);
+	nbytes = mq_receive(mqdes, msg_buffer, TEST_BUF_MSGSIZE, &prio);
+	TC_ASSERT_EQ_CLEANUP("mq_receive", nbytes, 32, goto errout_q);
+	TC_ASSERT_EQ_CLEANUP("mq_receive", msg_buffer[0], 'c', goto errout_q);
+	TC_ASSERT_EQ_CLEANUP("mq_receive", msg_buffer[31], 'c', goto errout_q);
+
+	/* Buffers left in the queue are released with it */
+
+	bufa = (char *)malloc(TEST_BUF_MSGSIZE);
+	TC_ASSERT_NEQ_CLEANUP("malloc", bufa, NULL, goto errout_q);
+	TC_ASSERT_EQ_CLEANUP("mq_send_buf", mq_send_buf(mqdes, bufa, TEST_BUF_MSGSIZE, 1), OK, goto errout_a);
+
+	mq_close(mqdes);
+	mq_unlink("mqbuf");
+	TC_SUCCESS_RESULT();
+	return;
+
+errout_r:
+	free(rcvbuf);
+	goto errout_q;
+errout_a:
+	free(bufa);
+	goto errout_q;
+errout:
+	free(bufa);
+errout_b:
+	free(bufb);
+errout_q:
+	mq_close(mqdes);
+	mq_unlink("mqbuf");
+}
+#endif
 
 /****************************************************************************
  * Name: mqueue
@@ -952,6 +1059,9 @@ int mqueue_main(void)
 
 	tc_mqueue_mq_getattr();
 	tc_mqueue_mq_setattr();
+#ifdef CONFIG_MQ_ZEROCOPY
+	tc_mqueue_mq_send_receive_buf();
+#endif
 
 	return 0;
 }
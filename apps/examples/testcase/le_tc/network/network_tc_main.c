@@ -111,6 +111,9 @@ int tc_network_main(int argc, char *argv[])
 #ifdef CONFIG_TC_NET_RECVFROM
 	net_recvfrom_main();
 #endif
+#ifdef CONFIG_TC_NET_ZEROCOPY
+	net_zerocopy_main();
+#endif
 #ifdef CONFIG_TC_NET_SHUTDOWN
 	net_shutdown_main();
 #endif
@@ -83,6 +83,9 @@ int net_sendto_main(void);
 #ifdef CONFIG_TC_NET_RECVFROM
 int net_recvfrom_main(void);
 #endif
+#ifdef CONFIG_TC_NET_ZEROCOPY
+int net_zerocopy_main(void);
+#endif
 #ifdef CONFIG_TC_NET_SHUTDOWN
 int net_shutdown_main(void);
 #endif
@@ -0,0 +1,236 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+// @file tc_net_zerocopy.c
+// @brief Test Case Example for recv_zc(), release_zc() and send_zc() API
+
+#include <tinyara/config.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "tc_internal.h"
+
+#define UDPPORT 7892
+#define TCPPORT 7893
+#define ZC_WAIT_COUNT 100
+
+static volatile int g_zc_done;
+
+static void zc_done(void *arg)
+{
+	(*(volatile int *)arg)++;
+}
+
+static int zc_wait_done(int count)
+{
+	int i;
+
+	for (i = 0; i < ZC_WAIT_COUNT && g_zc_done < count; i++) {
+		usleep(10000);
+	}
+
+	return g_zc_done;
+}
+
+static int zc_compare(struct sock_zcbuf *zbuf, const char *msg, int len)
+{
+	int off = 0;
+	int i;
+
+	for (i = 0; i < zbuf->iovcnt; i++) {
+		if (off + zbuf->iov[i].iov_len > len || memcmp(zbuf->iov[i].iov_base, msg + off, zbuf->iov[i].iov_len) != 0) {
+			return -1;
+		}
+		off += zbuf->iov[i].iov_len;
+	}
+
+	return off;
+}
+
+static int zc_bind(int type, int port)
+{
+	struct sockaddr_in sa;
+	int fd;
+
+	fd = socket(PF_INET, type, 0);
+	if (fd < 0) {
+		return -1;
+	}
+
+	memset(&sa, 0, sizeof(sa));
+	sa.sin_family = PF_INET;
+	sa.sin_port = htons(port);
+	sa.sin_addr.s_addr = inet_addr("127.0.0.1");
+	if (bind(fd, (struct sockaddr *)&sa, sizeof(sa)) < 0) {
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+/**
+ * @testcase		   :tc_net_zerocopy_udp_p
+ * @brief		   :send a datagram from the buffer of the application and receive it without copying
+ * @scenario		   :send_zc() on loopback, recv_zc() and check the data, the sender address and the done callback
+ * @apicovered	   :send_zc(), recv_zc(), release_zc()
+ * @precondition	   :
+ * @postcondition	   :
+ */
+static void tc_net_zerocopy_udp_p(void)
+{
+	static char msg[] = "zero-copy datagram";
+	struct sockaddr_in dest;
+	struct sockaddr_in from;
+	socklen_t fromlen = sizeof(from);
+	struct sock_zcbuf zbuf;
+	int rfd;
+	int sfd;
+	int ret;
+
+	rfd = zc_bind(SOCK_DGRAM, UDPPORT);
+	TC_ASSERT_NEQ("socket", rfd, -1);
+	sfd = socket(PF_INET, SOCK_DGRAM, 0);
+	TC_ASSERT_NEQ_CLEANUP("socket", sfd, -1, close(rfd));
+
+	memset(&dest, 0, sizeof(dest));
+	dest.sin_family = PF_INET;
+	dest.sin_port = htons(UDPPORT);
+	dest.sin_addr.s_addr = inet_addr("127.0.0.1");
+
+	g_zc_done = 0;
+	ret = send_zc(sfd, msg, sizeof(msg), 0, (struct sockaddr *)&dest, sizeof(dest), zc_done, (void *)&g_zc_done);
+	TC_ASSERT_EQ_CLEANUP("send_zc", ret, sizeof(msg), close(sfd); close(rfd));
+
+	ret = recv_zc(rfd, &zbuf, 0, (struct sockaddr *)&from, &fromlen);
+	TC_ASSERT_EQ_CLEANUP("recv_zc", ret, sizeof(msg), close(sfd); close(rfd));
+	ret = zc_compare(&zbuf, msg, sizeof(msg));
+	release_zc(&zbuf);
+	TC_ASSERT_EQ_CLEANUP("recv_zc", ret, sizeof(msg), close(sfd); close(rfd));
+	TC_ASSERT_EQ_CLEANUP("recv_zc", from.sin_addr.s_addr, dest.sin_addr.s_addr, close(sfd); close(rfd));
+
+	ret = zc_wait_done(1);
+	close(sfd);
+	close(rfd);
+	TC_ASSERT_EQ("send_zc", ret, 1);
+	TC_SUCCESS_RESULT();
+}
+
+/**
+ * @testcase		   :tc_net_zerocopy_tcp_p
+ * @brief		   :send and receive a stream without copying on receive
+ * @scenario		   :send_zc() copies the data of a stream socket and calls done before it returns
+ * @apicovered	   :send_zc(), recv_zc(), release_zc()
+ * @precondition	   :
+ * @postcondition	   :
+ */
+static void tc_net_zerocopy_tcp_p(void)
+{
+	static char msg[] = "zero-copy stream";
+	struct sockaddr_in dest;
+	struct sock_zcbuf zbuf;
+	int lfd;
+	int cfd;
+	int afd;
+	int len = 0;
+	int ret;
+
+	lfd = zc_bind(SOCK_STREAM, TCPPORT);
+	TC_ASSERT_NEQ("socket", lfd, -1);
+	ret = listen(lfd, 1);
+	TC_ASSERT_EQ_CLEANUP("listen", ret, 0, close(lfd));
+
+	cfd = socket(PF_INET, SOCK_STREAM, 0);
+	TC_ASSERT_NEQ_CLEANUP("socket", cfd, -1, close(lfd));
+	memset(&dest, 0, sizeof(dest));
+	dest.sin_family = PF_INET;
+	dest.sin_port = htons(TCPPORT);
+	dest.sin_addr.s_addr = inet_addr("127.0.0.1");
+	ret = connect(cfd, (struct sockaddr *)&dest, sizeof(dest));
+	TC_ASSERT_EQ_CLEANUP("connect", ret, 0, close(cfd); close(lfd));
+	afd = accept(lfd, NULL, NULL);
+	TC_ASSERT_NEQ_CLEANUP("accept", afd, -1, close(cfd); close(lfd));
+
+	g_zc_done = 0;
+	ret = send_zc(cfd, msg, sizeof(msg), 0, NULL, 0, zc_done, (void *)&g_zc_done);
+	TC_ASSERT_EQ_CLEANUP("send_zc", ret, sizeof(msg), close(afd); close(cfd); close(lfd));
+	TC_ASSERT_EQ_CLEANUP("send_zc", g_zc_done, 1, close(afd); close(cfd); close(lfd));
+
+	while (len < sizeof(msg)) {
+		ret = recv_zc(afd, &zbuf, 0, NULL, NULL);
+		if (ret <= 0) {
+			break;
+		}
+		ret = zc_compare(&zbuf, msg + len, sizeof(msg) - len);
+		release_zc(&zbuf);
+		if (ret < 0) {
+			break;
+		}
+		len += ret;
+	}
+
+	close(afd);
+	close(cfd);
+	close(lfd);
+	TC_ASSERT_EQ("recv_zc", len, sizeof(msg));
+	TC_SUCCESS_RESULT();
+}
+
+/**
+ * @testcase		   :tc_net_zerocopy_n
+ * @brief		   :zero-copy calls on an invalid socket
+ * @scenario		   :both fail, zbuf is left empty, and done is still called once
+ * @apicovered	   :send_zc(), recv_zc(), release_zc()
+ * @precondition	   :
+ * @postcondition	   :
+ */
+static void tc_net_zerocopy_n(void)
+{
+	struct sock_zcbuf zbuf;
+	int ret;
+
+	memset(&zbuf, 0xff, sizeof(zbuf));
+	ret = recv_zc(-1, &zbuf, 0, NULL, NULL);
+	TC_ASSERT_EQ("recv_zc", ret, -1);
+	TC_ASSERT_EQ("recv_zc", zbuf.iovcnt, 0);
+	TC_ASSERT_EQ("recv_zc", zbuf.priv, NULL);
+	release_zc(&zbuf);
+
+	g_zc_done = 0;
+	ret = send_zc(-1, "x", 1, 0, NULL, 0, zc_done, (void *)&g_zc_done);
+	TC_ASSERT_EQ("send_zc", ret, -1);
+	TC_ASSERT_EQ("send_zc", g_zc_done, 1);
+	TC_SUCCESS_RESULT();
+}
+
+/****************************************************************************
+ * Name: recv_zc(), send_zc()
+ ****************************************************************************/
+int net_zerocopy_main(void)
+{
+	tc_net_zerocopy_udp_p();
+	tc_net_zerocopy_tcp_p();
+	tc_net_zerocopy_n();
+
+	return 0;
+}
@@ -184,6 +184,9 @@ struct http_server_t {
 	pthread_t tid;
 	pthread_t c_tid[HTTP_CONF_MAX_CLIENT_HANDLE];
 	mqd_t msg_q;
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+	pthread_t e_tid[CONFIG_NETUTILS_WEBSERVER_EVENT_WORKERS];
+#endif
 
 	int                       tls_init;
 #ifdef CONFIG_NET_SECURITY_TLS
@@ -331,6 +334,19 @@ int http_send_response_with_status_msg(struct http_client_t *client, int status,
 int http_send_response_chunk(struct http_client_t *client, int status, const char* status_message,
                         const char *body, struct http_keyvalue_list_t *headers, data_type_e data_type);
 
+/**
+ * @brief http_send_file() sends a file as the response.
+ *        The file is copied to the socket by sendfile(), so that it does not
+ *        have to fit in a buffer. 404 is sent if it is not a regular file.
+ *
+ * @param[in] client a pointer of HTTP client.
+ * @param[in] path path of the file.
+ * @return On success, HTTP_OK(0) is returned.
+ *         On failure, HTTP_ERROR(-1) is returned.
+ * @since TizenRT v4.0
+ */
+int http_send_file(struct http_client_t *client, const char *path);
+
 #ifdef CONFIG_NET_SECURITY_TLS
 /**
  * @brief http_tls_init() initializes the TLS configuere for webserver.
@@ -44,7 +44,10 @@ struct http_msg_t {
 	int data;
 };
 
+struct http_server_t;
+
 int http_server_mq_flush(mqd_t msg_q);
 mqd_t http_server_mq_open(int port);
 int http_server_mq_close(int port);
+int http_server_listen(struct http_server_t *server);
 #endif
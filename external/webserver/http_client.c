@@ -17,6 +17,9 @@
  ****************************************************************************/
 
 #include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <strings.h>
 #include <protocols/webserver/http_err.h>
 #include <protocols/webserver/http_keyvalue_list.h>
 #include <protocols/webclient.h>
@@ -31,7 +34,6 @@
 #include "http_arch.h"
 #include "http_log.h"
 
-#define MIN_WS_HEADER_FIELD 2
 #define MAX_CLIENT_REQUEST 999999 /* it Will be updated if max client request exceeds 999999 */
 #define MIN_CLIENT_REQUEST 100
 
@@ -150,6 +152,13 @@ struct http_client_t *http_client_init(struct http_server_t *server, int sock_fd
 		return NULL;
 	}
 
+	http_client_setup(p, server, sock_fd);
+
+	return p;
+}
+
+void http_client_setup(struct http_client_t *p, struct http_server_t *server, int sock_fd)
+{
 	memset(p, 0, sizeof(struct http_client_t));
 
 	p->client_fd = sock_fd;
@@ -159,8 +168,6 @@ struct http_client_t *http_client_init(struct http_server_t *server, int sock_fd
 	p->max_request = MAX_CLIENT_REQUEST;
 	p->remaining_request = MAX_CLIENT_REQUEST;
 	p->keep_alive_header_flag = 0;
-
-	return p;
 }
 
 int http_client_release(struct http_client_t *client)
@@ -595,6 +602,45 @@ int http_parse_message(char *buf, int buf_len, int *method, char *url,
 	return read_finish;
 }
 
+#ifdef CONFIG_NETUTILS_WEBSOCKET
+int http_client_open_websocket(struct http_client_t *client)
+{
+	websocket_t *ws = NULL;
+	ws = websocket_find_table();
+	if (ws == NULL) {
+		return HTTP_ERROR;
+	}
+	ws->fd = client->client_fd;
+	ws->cb = &client->server->ws_cb;
+#ifdef CONFIG_NET_SECURITY_TLS
+	if (client->server->tls_init) {
+		ws->tls_enabled = 1;
+		ws->tls_net.fd = client->tls_client_fd.fd;
+		ws->tls_ssl = (mbedtls_ssl_context *)malloc(sizeof(mbedtls_ssl_context));
+		memcpy(ws->tls_ssl, &client->tls_ssl, sizeof(mbedtls_ssl_context));
+		ws->tls_conf = &client->server->tls_conf;
+		mbedtls_ssl_set_bio(ws->tls_ssl, &ws->tls_net, mbedtls_net_send, mbedtls_net_recv, NULL);
+	}
+#endif
+	if (pthread_attr_init(&ws->thread_attr) != 0) {
+		HTTP_LOGE("Error: Cannot initialize thread attribute\n");
+		return HTTP_ERROR;
+	}
+	pthread_attr_setstacksize(&ws->thread_attr, WEBSOCKET_STACKSIZE);
+	pthread_attr_setschedpolicy(&ws->thread_attr, SCHED_RR);
+	if (pthread_create(&ws->thread_id, &ws->thread_attr,
+					   (pthread_startroutine_t)websocket_server_init,
+					   (pthread_addr_t)ws) != 0) {
+		HTTP_LOGE("Error: Cannot create websocket thread!!\n");
+		return HTTP_ERROR;
+	}
+	pthread_setname_np(ws->thread_id, "websocket handle server");
+	pthread_detach(ws->thread_id);
+
+	return HTTP_OK;
+}
+#endif
+
 int http_recv_and_handle_request(struct http_client_t *client, struct http_keyvalue_list_t *request_params)
 {
 	char *buf;
@@ -723,37 +769,9 @@ int http_recv_and_handle_request(struct http_client_t *client, struct http_keyva
 #ifdef CONFIG_NETUTILS_WEBSOCKET
 	/* open websocket */
 	if (client->ws_state >= MIN_WS_HEADER_FIELD) {
-		websocket_t *ws = NULL;
-		ws = websocket_find_table();
-		if (ws == NULL) {
-			goto errout;
-		}
-		ws->fd = client->client_fd;
-		ws->cb = &client->server->ws_cb;
-#ifdef CONFIG_NET_SECURITY_TLS
-		if (client->server->tls_init) {
-			ws->tls_enabled = 1;
-			ws->tls_net.fd = client->tls_client_fd.fd;
-			ws->tls_ssl = (mbedtls_ssl_context *)malloc(sizeof(mbedtls_ssl_context));
-			memcpy(ws->tls_ssl, &client->tls_ssl, sizeof(mbedtls_ssl_context));
-			ws->tls_conf = &client->server->tls_conf;
-			mbedtls_ssl_set_bio(ws->tls_ssl, &ws->tls_net, mbedtls_net_send, mbedtls_net_recv, NULL);
-		}
-#endif
-		if (pthread_attr_init(&ws->thread_attr) != 0) {
-			HTTP_LOGE("Error: Cannot initialize thread attribute\n");
+		if (http_client_open_websocket(client) != HTTP_OK) {
 			goto errout;
 		}
-		pthread_attr_setstacksize(&ws->thread_attr, WEBSOCKET_STACKSIZE);
-		pthread_attr_setschedpolicy(&ws->thread_attr, SCHED_RR);
-		if (pthread_create(&ws->thread_id, &ws->thread_attr,
-						   (pthread_startroutine_t)websocket_server_init,
-						   (pthread_addr_t)ws) != 0) {
-			HTTP_LOGE("Error: Cannot create websocket thread!!\n");
-			goto errout;
-		}
-		pthread_setname_np(ws->thread_id, "websocket handle server");
-		pthread_detach(ws->thread_id);
 	} else {
 		close(client->client_fd);
 	}
@@ -786,16 +804,8 @@ void http_handle_file(struct http_client_t *client, int method, const char *url,
 
 	switch (method) {
 	case HTTP_METHOD_GET:
-		if ((f = fopen(url, "r")) != NULL) {
-			fgets(entity, HTTP_CONF_MAX_ENTITY_LENGTH, f);
-			if (http_send_response(client, 200, entity, NULL) == HTTP_ERROR) {
-				HTTP_LOGE("Error: Fail to send response\n");
-			}
-			fclose(f);
-		} else {
-			if (http_send_response(client, 404, HTTP_ERROR_404, NULL) == HTTP_ERROR) {
-				HTTP_LOGE("Error: Fail to send response\n");
-			}
+		if (http_send_file(client, url) == HTTP_ERROR) {
+			HTTP_LOGE("Error: Fail to send response\n");
 		}
 		break;
 	case HTTP_METHOD_POST:
@@ -1093,6 +1103,110 @@ static int http_send_buffer(struct http_client_t *client, const char *buf, int l
 	return 0;
 }
 
+static const char *http_content_type(const char *path)
+{
+	static const struct {
+		const char *ext;
+		const char *type;
+	} types[] = {
+		{".html", "text/html"},
+		{".shtml", "text/html"},
+		{".htm", "text/html"},
+		{".css", "text/css"},
+		{".js", "application/javascript"},
+		{".json", "application/json"},
+		{".txt", "text/plain"},
+		{".png", "image/png"},
+		{".jpg", "image/jpeg"},
+		{".gif", "image/gif"},
+		{".ico", "image/x-icon"},
+	};
+	const char *ext = strrchr(path, '.');
+	int i;
+
+	if (ext != NULL) {
+		for (i = 0; i < sizeof(types) / sizeof(types[0]); i++) {
+			if (strcasecmp(ext, types[i].ext) == 0) {
+				return types[i].type;
+			}
+		}
+	}
+
+	return "application/octet-stream";
+}
+
+int http_send_file(struct http_client_t *client, const char *path)
+{
+	char *buf;
+	struct stat st;
+	off_t offset = 0;
+	ssize_t len;
+	int buflen;
+	int fd;
+	int ret = HTTP_ERROR;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0) {
+		return http_send_response(client, 404, HTTP_ERROR_404, NULL);
+	}
+
+	if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+		close(fd);
+		return http_send_response(client, 404, HTTP_ERROR_404, NULL);
+	}
+
+	buf = HTTP_MALLOC(HTTP_CONF_MAX_REQUEST_LENGTH);
+	if (buf == NULL) {
+		HTTP_LOGE("Error: Fail to malloc buffer\n");
+		close(fd);
+		return HTTP_ERROR;
+	}
+
+	buflen = snprintf(buf, HTTP_CONF_MAX_REQUEST_LENGTH,
+					  "HTTP/1.1 200 OK\r\n"
+					  "Content-Type: %s\r\n"
+					  "Content-Length: %d\r\n"
+					  "Connection: %s\r\n"
+					  "Keep-Alive: timeout=%d, max=%d\r\n\r\n",
+					  http_content_type(path), (int)st.st_size,
+					  client->keep_alive ? "Keep-Alive" : "close",
+					  client->keep_alive_timeout, client->max_request);
+	if (http_send_buffer(client, buf, buflen) < 0) {
+		HTTP_LOGE("Error: failed to send header of %s\n", path);
+		goto errout;
+	}
+
+	while (offset < st.st_size) {
+#ifdef CONFIG_NET_SECURITY_TLS
+		/* The records are encrypted in user space, so the file has to be
+		 * copied through the buffer.
+		 */
+		if (client->server->tls_init) {
+			len = read(fd, buf, HTTP_CONF_MAX_REQUEST_LENGTH);
+			if (len > 0 && http_send_buffer(client, buf, len) < 0) {
+				len = -1;
+			}
+			offset += len;
+		} else
+#endif
+		{
+			len = sendfile(client->client_fd, fd, &offset, st.st_size - offset);
+		}
+
+		if (len <= 0) {
+			HTTP_LOGE("Error: failed to send %s at %d errno[%d]\n", path, (int)offset, errno);
+			goto errout;
+		}
+	}
+
+	ret = HTTP_OK;
+
+errout:
+	HTTP_FREE(buf);
+	close(fd);
+	return ret;
+}
+
 int http_send_response_helper(struct http_client_t *client, int status, const char* status_message, const char* body, struct http_keyvalue_list_t *headers)
 {
 	char *buf;
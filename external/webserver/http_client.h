@@ -36,6 +36,8 @@
 #include "mbedtls/ssl_cache.h"
 #endif
 
+#define MIN_WS_HEADER_FIELD 2
+
 enum {
 	HTTP_REQUEST_HEADER, HTTP_REQUEST_PARAMETERS, HTTP_REQUEST_BODY
 };
@@ -71,6 +73,7 @@ void  http_close_client(struct http_client_t *client);
 void *http_handle_client(void *arg /* struct http_client_t *client */);
 
 struct http_client_t *http_client_init(struct http_server_t *server, int sock_fd);
+void  http_client_setup(struct http_client_t *client, struct http_server_t *server, int sock_fd);
 int   http_client_release(struct http_client_t *client);
 
 /**
@@ -102,6 +105,14 @@ int http_parse_message(char *buf, int buf_len, int *method, char *url,
 					   int *chunk_processed);
 int   http_recv_and_handle_request(struct http_client_t *client, struct http_keyvalue_list_t *request_params);
 
+#ifdef CONFIG_NETUTILS_WEBSOCKET
+int   http_client_open_websocket(struct http_client_t *client);
+#endif
+
+#ifdef CONFIG_NETUTILS_WEBSERVER_EVENT_LOOP
+int   http_event_start(struct http_server_t *server);
+#endif
+
 #ifdef CONFIG_NET_SECURITY_TLS
 int   http_client_tls_init(struct http_client_t *client);
 int   http_client_tls_release(struct http_client_t *client);
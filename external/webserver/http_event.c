@@ -0,0 +1,557 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+#include <protocols/webserver/http_err.h>
+#include <protocols/webserver/http_server.h>
+#include <protocols/webserver/http_keyvalue_list.h>
+
+#include "http.h"
+#include "http_client.h"
+#include "http_string_util.h"
+#include "http_query.h"
+#include "http_arch.h"
+#include "http_log.h"
+
+#define HTTP_EVENT_WORKERS       CONFIG_NETUTILS_WEBSERVER_EVENT_WORKERS
+#define HTTP_EVENT_CONNECTIONS   CONFIG_NETUTILS_WEBSERVER_EVENT_CONNECTIONS
+#define HTTP_EVENT_TIMEOUT_MS    100
+#define HTTP_EVENT_STACKSIZE     (1024 * 4)
+
+/* The parser terminates the message in place, one byte past its end */
+#define HTTP_EVENT_BUFSIZE       (HTTP_CONF_MAX_REQUEST_LENGTH + 1)
+
+#define HTTP_EVENT_TOO_LARGE     (-2)
+
+enum {
+	HTTP_EVENT_HEADER, HTTP_EVENT_CHUNK, HTTP_EVENT_TRAILER
+};
+
+enum {
+	HTTP_EVENT_KEEP, HTTP_EVENT_CLOSE, HTTP_EVENT_DETACH
+};
+
+struct http_event_conn_t {
+	struct http_client_t client;	/* client_fd is -1 while the slot is free */
+	uint32_t client_ip;
+	time_t last;
+	char *buf;
+	int buf_len;
+
+	/* Framing of the message at the head of buf */
+	int state;
+	int scanned;
+	int content_len;
+	int msg_len;
+	bool chunked;
+};
+
+struct http_event_t;
+
+struct http_event_worker_t {
+	struct http_event_t *event;
+	int id;
+	int nconns;
+	struct http_event_conn_t conns[HTTP_EVENT_CONNECTIONS];
+};
+
+struct http_event_t {
+	struct http_server_t *server;
+	int nworkers;
+	struct http_event_worker_t workers[HTTP_EVENT_WORKERS];
+};
+
+static time_t http_event_now(void)
+{
+	struct timespec ts;
+
+#ifdef CONFIG_CLOCK_MONOTONIC
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+#else
+	clock_gettime(CLOCK_REALTIME, &ts);
+#endif
+	return ts.tv_sec;
+}
+
+static void http_event_reset(struct http_event_conn_t *conn)
+{
+	conn->state = HTTP_EVENT_HEADER;
+	conn->scanned = 0;
+	conn->content_len = 0;
+	conn->msg_len = 0;
+	conn->chunked = false;
+}
+
+static const char *http_event_value(const char *line, int len, const char *key)
+{
+	int keylen = strlen(key);
+
+	if (len <= keylen || strncasecmp(line, key, keylen) != 0 || line[keylen] != ':') {
+		return NULL;
+	}
+
+	line += keylen + 1;
+	while (*line == ' ' || *line == '\t') {
+		line++;
+	}
+
+	return line;
+}
+
+/*
+ * Finds the end of the message at the head of the buffer without parsing it.
+ * Lines are scanned once, from where the previous call stopped, so a message
+ * which arrives in many segments is not scanned again for every segment.
+ * Returns the length of the message, 0 if it is not complete yet, or an error.
+ */
+static int http_event_frame(struct http_event_conn_t *conn)
+{
+	char *buf = conn->buf;
+	const char *value;
+	char *end;
+	long size;
+	int line;
+	int eol;
+
+	while (conn->msg_len == 0) {
+		eol = http_find_first_crlf(buf, conn->buf_len, conn->scanned);
+		if (eol < 0) {
+			return conn->buf_len < HTTP_CONF_MAX_REQUEST_LENGTH ? 0 : HTTP_EVENT_TOO_LARGE;
+		}
+
+		line = conn->scanned;
+		conn->scanned = eol + 2;
+
+		switch (conn->state) {
+		case HTTP_EVENT_HEADER:
+			if (eol == line) {
+				if (conn->chunked) {
+					conn->state = HTTP_EVENT_CHUNK;
+				} else {
+					conn->msg_len = conn->scanned + conn->content_len;
+				}
+			} else if ((value = http_event_value(buf + line, eol - line, "Content-Length")) != NULL) {
+				conn->content_len = HTTP_ATOI(value);
+				if (conn->content_len < 0) {
+					return HTTP_ERROR;
+				}
+			} else if ((value = http_event_value(buf + line, eol - line, "Transfer-Encoding")) != NULL) {
+				conn->chunked = (strncasecmp(value, "chunked", 7) == 0);
+			}
+			break;
+		case HTTP_EVENT_CHUNK:
+			size = strtol(buf + line, &end, 16);
+			if (end == buf + line || size < 0) {
+				return HTTP_ERROR;
+			}
+			if (size == 0) {
+				conn->state = HTTP_EVENT_TRAILER;
+			} else if (size > HTTP_CONF_MAX_REQUEST_LENGTH) {
+				return HTTP_EVENT_TOO_LARGE;
+			} else {
+				/* Skip the data and its CRLF, which may not be received yet */
+				conn->scanned += size + 2;
+				if (conn->scanned > HTTP_CONF_MAX_REQUEST_LENGTH) {
+					return HTTP_EVENT_TOO_LARGE;
+				}
+			}
+			break;
+		case HTTP_EVENT_TRAILER:
+			if (eol == line) {
+				conn->msg_len = conn->scanned;
+			}
+			break;
+		}
+	}
+
+	if (conn->msg_len > HTTP_CONF_MAX_REQUEST_LENGTH) {
+		return HTTP_EVENT_TOO_LARGE;
+	}
+
+	return conn->buf_len >= conn->msg_len ? conn->msg_len : 0;
+}
+
+static int http_event_handle(struct http_event_conn_t *conn, int msg_len)
+{
+	struct http_client_t *client = &conn->client;
+	struct http_keyvalue_list_t params;
+	struct http_req_message req = {0, };
+	struct http_message_len_t mlen = {0, };
+	char url[HTTP_CONF_MAX_REQUEST_HEADER_URL_LENGTH] = {0, };
+	int method = HTTP_METHOD_UNKNOWN;
+	int enc = HTTP_CONTENT_LENGTH;
+	int state = HTTP_REQUEST_HEADER;
+	int chunk_processed = 0;
+	char *body = NULL;
+	char *conn_type;
+	char next;
+	int ret = HTTP_EVENT_CLOSE;
+
+	if (http_keyvalue_list_init(&params) == HTTP_ERROR) {
+		HTTP_LOGE("Error: Fail to init request params\n");
+		http_keyvalue_list_release(&params);
+		return HTTP_EVENT_CLOSE;
+	}
+
+	client->ws_state = 0;
+	req.req_msg = conn->buf;
+	req.url = url;
+	req.headers = &params;
+	req.client_ip = conn->client_ip;
+	req.encoding = HTTP_CONTENT_LENGTH;
+
+	/* Keep the first byte of a pipelined request from being terminated */
+
+	next = conn->buf[msg_len];
+	if (http_parse_message(conn->buf, msg_len, &method, url, &body, &enc, &state, &mlen, &params, client, NULL, &req, &chunk_processed) != true) {
+		HTTP_LOGD("Client %d sent a malformed request\n", client->client_fd);
+		goto out;
+	}
+
+	conn_type = http_keyvalue_list_find(&params, "Connection");
+	client->keep_alive = !strncasecmp(conn_type, "Keep-Alive", strlen("Keep-Alive") + 1);
+	if (client->remaining_request > client->max_request) {
+		client->remaining_request = client->max_request;
+	}
+
+	if (method == HTTP_METHOD_UNKNOWN) {
+		goto out;
+	}
+
+	if (enc == HTTP_CONTENT_LENGTH) {
+		req.entity = body;
+		http_dispatch_url(client, &req);
+	}
+
+#ifdef CONFIG_NETUTILS_WEBSOCKET
+	if (client->ws_state >= MIN_WS_HEADER_FIELD) {
+		if (http_client_open_websocket(client) == HTTP_OK) {
+			ret = HTTP_EVENT_DETACH;
+		}
+		goto out;
+	}
+#endif
+
+	if (client->keep_alive && --client->remaining_request > 0) {
+		ret = HTTP_EVENT_KEEP;
+	}
+
+out:
+	conn->buf[msg_len] = next;
+	if (enc == HTTP_CHUNKED_ENCODING) {
+		HTTP_FREE(body);
+	}
+	http_keyvalue_list_release(&params);
+	return ret;
+}
+
+static void http_event_close(struct http_event_worker_t *worker, struct http_event_conn_t *conn, bool detach)
+{
+	HTTP_LOGD("Client %d closing.\n", conn->client.client_fd);
+
+	if (!detach) {
+		close(conn->client.client_fd);
+	}
+	conn->client.client_fd = -1;
+	worker->nconns--;
+}
+
+static void http_event_accept(struct http_event_worker_t *worker, time_t now)
+{
+	struct http_server_t *server = worker->event->server;
+	struct http_event_conn_t *conn = NULL;
+	struct sockaddr_in client_addr;
+	socklen_t addrlen = sizeof(struct sockaddr_in);
+	struct timeval tv;
+	int sock_fd;
+	int i;
+
+	/* Every worker waits for the listening socket, the others find it empty */
+
+	sock_fd = accept(server->listen_fd, (struct sockaddr *)&client_addr, &addrlen);
+	if (sock_fd < 0) {
+		if (errno != EWOULDBLOCK && errno != EAGAIN && errno != EINTR) {
+			HTTP_LOGE("Error: Accept client error!! errno[%d]\n", errno);
+		}
+		return;
+	}
+
+	for (i = 0; i < HTTP_EVENT_CONNECTIONS; i++) {
+		if (worker->conns[i].client.client_fd < 0) {
+			conn = &worker->conns[i];
+			break;
+		}
+	}
+
+	if (conn == NULL) {
+		HTTP_LOGE("Error: Too many request be piled\n");
+		close(sock_fd);
+		return;
+	}
+
+	/* Requests are read with MSG_DONTWAIT, while a response is written in
+	 * one go by the handler, which waits at most the send timeout for a
+	 * client which does not read it.
+	 */
+
+	tv.tv_sec = HTTP_CONF_SOCKET_TIMEOUT_MSEC / 1000;
+	tv.tv_usec = (HTTP_CONF_SOCKET_TIMEOUT_MSEC % 1000) * 1000;
+	if (setsockopt(sock_fd, SOL_SOCKET, SO_SNDTIMEO, (struct timeval *)&tv, sizeof(struct timeval)) < 0) {
+		HTTP_LOGD("Send timeout is not supported\n");
+	}
+
+	http_client_setup(&conn->client, server, sock_fd);
+	http_event_reset(conn);
+	conn->client_ip = client_addr.sin_addr.s_addr;
+	conn->buf_len = 0;
+	conn->last = now;
+	worker->nconns++;
+
+	HTTP_LOGD("Client %d is accepted by worker %d\n", sock_fd, worker->id);
+}
+
+static void http_event_read(struct http_event_worker_t *worker, struct http_event_conn_t *conn, time_t now)
+{
+	int msg_len;
+	int len;
+	int ret;
+
+	len = recv(conn->client.client_fd, conn->buf + conn->buf_len, HTTP_CONF_MAX_REQUEST_LENGTH - conn->buf_len, MSG_DONTWAIT);
+	if (len < 0) {
+		if (errno == EWOULDBLOCK || errno == EAGAIN || errno == EINTR) {
+			return;
+		}
+		HTTP_LOGE("Error: Receive Fail %d errno:[%d]\n", len, errno);
+		http_event_close(worker, conn, false);
+		return;
+	} else if (len == 0) {
+		http_event_close(worker, conn, false);
+		return;
+	}
+
+	conn->buf_len += len;
+	conn->last = now;
+
+	/* Serve every complete request, a client may pipeline several */
+
+	while ((msg_len = http_event_frame(conn)) > 0) {
+		ret = http_event_handle(conn, msg_len);
+		if (ret != HTTP_EVENT_KEEP) {
+			http_event_close(worker, conn, ret == HTTP_EVENT_DETACH);
+			return;
+		}
+
+		conn->buf_len -= msg_len;
+		memmove(conn->buf, conn->buf + msg_len, conn->buf_len);
+		http_event_reset(conn);
+	}
+
+	if (msg_len == HTTP_EVENT_TOO_LARGE) {
+		HTTP_LOGE("Error: Request size is too large!!\n");
+		http_send_response(&conn->client, 413, "Payload Too Large\r\n", NULL);
+	}
+
+	if (msg_len < 0) {
+		http_event_close(worker, conn, false);
+	}
+}
+
+static pthread_addr_t http_event_worker(pthread_addr_t arg)
+{
+	struct http_event_worker_t *worker = (struct http_event_worker_t *)arg;
+	struct http_event_t *event = worker->event;
+	struct http_server_t *server = event->server;
+	struct http_event_conn_t *conn;
+	struct timeval tv;
+	fd_set readfds;
+	time_t now;
+	int maxfd;
+	int ret;
+	int i;
+
+	while (server->state == HTTP_SERVER_RUN) {
+		FD_ZERO(&readfds);
+		maxfd = -1;
+
+		/* A full worker leaves new connections to the others */
+
+		if (worker->nconns < HTTP_EVENT_CONNECTIONS) {
+			FD_SET(server->listen_fd, &readfds);
+			maxfd = server->listen_fd;
+		}
+
+		for (i = 0; i < HTTP_EVENT_CONNECTIONS; i++) {
+			conn = &worker->conns[i];
+			if (conn->client.client_fd >= 0) {
+				FD_SET(conn->client.client_fd, &readfds);
+				if (conn->client.client_fd > maxfd) {
+					maxfd = conn->client.client_fd;
+				}
+			}
+		}
+
+		tv.tv_sec = 0;
+		tv.tv_usec = HTTP_EVENT_TIMEOUT_MS * 1000;
+		ret = select(maxfd + 1, &readfds, NULL, NULL, &tv);
+		if (ret < 0) {
+			if (errno != EINTR) {
+				HTTP_LOGE("Error: select fail errno[%d]\n", errno);
+				usleep(HTTP_EVENT_TIMEOUT_MS * 1000);
+			}
+			continue;
+		}
+
+		now = http_event_now();
+
+		for (i = 0; i < HTTP_EVENT_CONNECTIONS; i++) {
+			conn = &worker->conns[i];
+			if (conn->client.client_fd < 0) {
+				continue;
+			}
+
+			if (ret > 0 && FD_ISSET(conn->client.client_fd, &readfds)) {
+				http_event_read(worker, conn, now);
+			} else if (now - conn->last > conn->client.keep_alive_timeout) {
+				HTTP_LOGD("Client %d timed out\n", conn->client.client_fd);
+				http_event_close(worker, conn, false);
+			}
+		}
+
+		if (ret > 0 && FD_ISSET(server->listen_fd, &readfds)) {
+			http_event_accept(worker, now);
+		}
+	}
+
+	for (i = 0; i < HTTP_EVENT_CONNECTIONS; i++) {
+		if (worker->conns[i].client.client_fd >= 0) {
+			http_event_close(worker, &worker->conns[i], false);
+		}
+	}
+
+	/* The first worker reports the stop once the others are gone */
+
+	if (worker->id == 0) {
+		for (i = 1; i < event->nworkers; i++) {
+			pthread_join(server->e_tid[i], NULL);
+		}
+
+		HTTP_FREE(event);
+		HTTP_LOGD("http_event_worker stop :%d\n", server->port);
+		server->state = HTTP_SERVER_STOP;
+	}
+
+	return NULL;
+}
+
+int http_event_start(struct http_server_t *server)
+{
+	struct http_event_t *event;
+	struct http_event_worker_t *worker;
+	pthread_attr_t attr;
+	char *pool;
+	int flags;
+	int i;
+	int j;
+
+	/* The buffers of all connections are allocated with the workers, a
+	 * connection then costs no allocation until a handler makes one.
+	 */
+
+	event = (struct http_event_t *)HTTP_MALLOC(sizeof(struct http_event_t) + HTTP_EVENT_WORKERS * HTTP_EVENT_CONNECTIONS * HTTP_EVENT_BUFSIZE);
+	if (event == NULL) {
+		HTTP_LOGE("Error: Cannot allocate event loop\n");
+		return HTTP_ERROR;
+	}
+
+	HTTP_LOGD("Event loop: %d workers, %d bytes per connection\n", HTTP_EVENT_WORKERS,
+			  (int)(sizeof(struct http_event_conn_t) + HTTP_EVENT_BUFSIZE));
+
+	event->server = server;
+	event->nworkers = 0;
+	pool = (char *)(event + 1);
+	for (i = 0; i < HTTP_EVENT_WORKERS; i++) {
+		worker = &event->workers[i];
+		worker->event = event;
+		worker->id = i;
+		worker->nconns = 0;
+		for (j = 0; j < HTTP_EVENT_CONNECTIONS; j++) {
+			worker->conns[j].client.client_fd = -1;
+			worker->conns[j].buf = pool;
+			pool += HTTP_EVENT_BUFSIZE;
+		}
+	}
+
+	if (http_server_listen(server) != HTTP_OK) {
+		HTTP_FREE(event);
+		return HTTP_ERROR;
+	}
+
+	flags = fcntl(server->listen_fd, F_GETFL, 0);
+	if (flags < 0 || fcntl(server->listen_fd, F_SETFL, flags | O_NONBLOCK) < 0) {
+		HTTP_LOGE("Error: Cannot set listening socket non-blocking\n");
+		close(server->listen_fd);
+		HTTP_FREE(event);
+		return HTTP_ERROR;
+	}
+
+	server->state = HTTP_SERVER_RUN;
+
+	for (i = 0; i < HTTP_EVENT_WORKERS; i++) {
+		if (pthread_attr_init(&attr) != 0) {
+			HTTP_LOGE("Error: Cannot initialize thread attribute\n");
+			break;
+		}
+		pthread_attr_setschedpolicy(&attr, SCHED_RR);
+		pthread_attr_setstacksize(&attr, HTTP_EVENT_STACKSIZE);
+
+		/* Set before the thread starts, the first worker reads it when it stops */
+
+		event->nworkers = i + 1;
+		if (pthread_create(&server->e_tid[i], &attr, http_event_worker, (void *)&event->workers[i]) != 0) {
+			HTTP_LOGE("Error: Cannot create event loop thread!!\n");
+			event->nworkers = i;
+			break;
+		}
+		pthread_setname_np(server->e_tid[i], "webserver event loop");
+		if (i == 0) {
+			pthread_detach(server->e_tid[i]);
+		}
+	}
+
+	/* Fewer workers still serve every connection, but none cannot */
+
+	if (event->nworkers == 0) {
+		server->state = HTTP_SERVER_STOP;
+		close(server->listen_fd);
+		HTTP_FREE(event);
+		return HTTP_ERROR;
+	}
+
+	return HTTP_OK;
+}
@@ -197,7 +197,8 @@ int messaging_recv_nonblock(const char *port_name, msg_recv_buf_t *recv_buf, msg
  * @param[in] port_name The message port name.\n
  *		This API should be called from task/pthread who called\n
  *		messaging_recv_nonblock or messaging_unicast_send_async.\n
- *		If this API is not called, memory leak can happen.
+ *		If this API is not called, memory leak can happen.\n
+ *		It also releases the reply port which messaging_send_sync keeps for the next send.
  * @return On success, OK is returned. On failure, Error is returned.
  * @since TizenRT v3.0
  */
@@ -0,0 +1,291 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <assert.h>
+#include <debug.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <queue.h>
+#include <sys/types.h>
+#include <messaging/messaging.h>
+#include "messaging_internal.h"
+
+#ifdef CONFIG_MESSAGING_REPLY_CACHE
+/* The idle task never sends, so pid 0 marks a free slot. */
+#define MSG_CHANNEL_FREE 0
+
+/* A reply channel which is kept open between sync sends of its owner. */
+struct msg_reply_channel_s {
+	pid_t pid;
+	mqd_t mqdes;
+	int msgsize;
+	char name[MAX_PORT_NAME_SIZE];
+};
+typedef struct msg_reply_channel_s msg_reply_channel_t;
+
+static msg_reply_channel_t g_reply_channel[CONFIG_MESSAGING_REPLY_CACHE_SIZE];
+static sq_queue_t g_packet_pool;
+static int g_packet_pool_cnt;
+static sem_t g_msg_cache_sem = SEM_INITIALIZER(1);
+
+/****************************************************************************
+ * private functions
+ ****************************************************************************/
+static void messaging_cache_lock(void)
+{
+	while (sem_wait(&g_msg_cache_sem) != OK) {
+		/* Only interruption by a signal is expected here. */
+		DEBUGASSERT(errno == EINTR);
+	}
+}
+
+static void messaging_cache_unlock(void)
+{
+	sem_post(&g_msg_cache_sem);
+}
+
+static msg_reply_channel_t *messaging_find_channel(const char *name, pid_t pid)
+{
+	int idx;
+
+	for (idx = 0; idx < CONFIG_MESSAGING_REPLY_CACHE_SIZE; idx++) {
+		if (g_reply_channel[idx].pid == pid && strncmp(g_reply_channel[idx].name, name, MAX_PORT_NAME_SIZE) == 0) {
+			return &g_reply_channel[idx];
+		}
+	}
+	return NULL;
+}
+
+static msg_reply_channel_t *messaging_alloc_channel(void)
+{
+	int idx;
+	struct sched_param param;
+	msg_reply_channel_t *channel;
+
+	for (idx = 0; idx < CONFIG_MESSAGING_REPLY_CACHE_SIZE; idx++) {
+		if (g_reply_channel[idx].pid == MSG_CHANNEL_FREE) {
+			return &g_reply_channel[idx];
+		}
+	}
+
+	/* All slots are used. Reclaim the one of a task which exited without cleanup.
+	 * Its mq descriptor was closed when it exited, but the port is still linked.
+	 */
+	for (idx = 0; idx < CONFIG_MESSAGING_REPLY_CACHE_SIZE; idx++) {
+		channel = &g_reply_channel[idx];
+		if (sched_getparam(channel->pid, &param) != OK) {
+			mq_unlink(channel->name);
+			channel->pid = MSG_CHANNEL_FREE;
+			return channel;
+		}
+	}
+	return NULL;
+}
+#endif
+
+/****************************************************************************
+ * functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name : messaging_reply_channel_open
+ *
+ * Description:
+ *  Open the reply port of the calling task. The port which was used by the
+ *  previous sync send of the task is reused if it can hold msgsize bytes.
+ *
+ * Input Parameters:
+ *  name    : The reply port name
+ *  msgsize : The size of reply packet including header
+ *  mqdes   : The location to return mq descriptor
+ *
+ * Return Value:
+ *  On success, the message size of the reply port is returned. A receive
+ *  buffer should be that size. On failure, -1 (ERROR) is returned.
+ ****************************************************************************/
+int messaging_reply_channel_open(const char *name, int msgsize, mqd_t *mqdes)
+{
+	struct mq_attr internal_attr;
+#ifdef CONFIG_MESSAGING_REPLY_CACHE
+	msg_reply_channel_t *channel;
+	pid_t my_pid = getpid();
+
+	messaging_cache_lock();
+	channel = messaging_find_channel(name, my_pid);
+	if (channel != NULL) {
+		if (channel->msgsize >= msgsize) {
+			*mqdes = channel->mqdes;
+			msgsize = channel->msgsize;
+			messaging_cache_unlock();
+			return msgsize;
+		}
+
+		/* The cached port is too small for this reply. Create it again. */
+		mq_close(channel->mqdes);
+		mq_unlink(channel->name);
+	} else {
+		channel = messaging_alloc_channel();
+	}
+#endif
+
+	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
+	internal_attr.mq_msgsize = msgsize;
+	internal_attr.mq_flags = 0;
+
+	*mqdes = mq_open(name, O_RDONLY | O_CREAT, 0666, &internal_attr);
+	if (*mqdes == (mqd_t)ERROR) {
+		msgdbg("[Messaging] reply port open fail, errno %d.\n", errno);
+#ifdef CONFIG_MESSAGING_REPLY_CACHE
+		if (channel != NULL) {
+			channel->pid = MSG_CHANNEL_FREE;
+		}
+		messaging_cache_unlock();
+#endif
+		return ERROR;
+	}
+
+#ifdef CONFIG_MESSAGING_REPLY_CACHE
+	if (channel != NULL) {
+		/* If no slot is available, the port is used once as without cache. */
+		channel->pid = my_pid;
+		channel->mqdes = *mqdes;
+		channel->msgsize = msgsize;
+		strncpy(channel->name, name, MAX_PORT_NAME_SIZE);
+	}
+	messaging_cache_unlock();
+#endif
+	return msgsize;
+}
+
+/****************************************************************************
+ * Name : messaging_reply_channel_close
+ *
+ * Description:
+ *  Finish using the reply port which was opened by messaging_reply_channel_open.
+ *  A cached port stays open, unless keep is false because a stale reply
+ *  may arrive later. Otherwise the port is closed and unlinked.
+ ****************************************************************************/
+void messaging_reply_channel_close(const char *name, mqd_t mqdes, bool keep)
+{
+#ifdef CONFIG_MESSAGING_REPLY_CACHE
+	msg_reply_channel_t *channel;
+
+	messaging_cache_lock();
+	channel = messaging_find_channel(name, getpid());
+	if (channel != NULL && channel->mqdes == mqdes) {
+		if (keep) {
+			messaging_cache_unlock();
+			return;
+		}
+		channel->pid = MSG_CHANNEL_FREE;
+	}
+	messaging_cache_unlock();
+#endif
+
+	mq_close(mqdes);
+	mq_unlink(name);
+}
+
+/****************************************************************************
+ * Name : messaging_reply_channel_release
+ *
+ * Description:
+ *  Close and unlink the cached reply port of the calling task.
+ *
+ * Return Value:
+ *  OK if a cached port was released, ERROR if there was none.
+ ****************************************************************************/
+int messaging_reply_channel_release(const char *name)
+{
+#ifdef CONFIG_MESSAGING_REPLY_CACHE
+	msg_reply_channel_t *channel;
+
+	messaging_cache_lock();
+	channel = messaging_find_channel(name, getpid());
+	if (channel != NULL) {
+		channel->pid = MSG_CHANNEL_FREE;
+		mq_close(channel->mqdes);
+		mq_unlink(channel->name);
+		messaging_cache_unlock();
+		return OK;
+	}
+	messaging_cache_unlock();
+#endif
+	return ERROR;
+}
+
+/****************************************************************************
+ * Name : messaging_packet_alloc
+ *
+ * Description:
+ *  Allocate a packet buffer. Small packets are taken from the packet pool.
+ ****************************************************************************/
+char *messaging_packet_alloc(int size)
+{
+#ifdef CONFIG_MESSAGING_REPLY_CACHE
+	char *packet;
+
+	if (size <= CONFIG_MESSAGING_PACKET_BUFSIZE) {
+		messaging_cache_lock();
+		packet = (char *)sq_remfirst(&g_packet_pool);
+		if (packet != NULL) {
+			g_packet_pool_cnt--;
+		}
+		messaging_cache_unlock();
+		if (packet == NULL) {
+			packet = (char *)MSG_ALLOC(CONFIG_MESSAGING_PACKET_BUFSIZE);
+		}
+		return packet;
+	}
+#endif
+	return (char *)MSG_ALLOC(size);
+}
+
+/****************************************************************************
+ * Name : messaging_packet_free
+ *
+ * Description:
+ *  Free a packet buffer which was allocated with the same size by
+ *  messaging_packet_alloc.
+ ****************************************************************************/
+void messaging_packet_free(char *packet, int size)
+{
+	if (packet == NULL) {
+		return;
+	}
+#ifdef CONFIG_MESSAGING_REPLY_CACHE
+	if (size <= CONFIG_MESSAGING_PACKET_BUFSIZE) {
+		messaging_cache_lock();
+		if (g_packet_pool_cnt < CONFIG_MESSAGING_PACKET_POOL_SIZE) {
+			sq_addfirst((FAR sq_entry_t *)packet, &g_packet_pool);
+			g_packet_pool_cnt++;
+			packet = NULL;
+		}
+		messaging_cache_unlock();
+	}
+#endif
+	MSG_FREE(packet);
+}
@@ -21,7 +21,9 @@
 #include <debug.h>
 #include <errno.h>
 #include <mqueue.h>
+#include <stdio.h>
 #include <string.h>
+#include <unistd.h>
 #include <stdbool.h>
 #include <queue.h>
 #include <sys/types.h>
@@ -58,6 +60,7 @@ static int messaging_unlink_internalport(const char *port_name, int pid)
  *  Remove the information which related with the port.
  *  This API should be called if messaging_recv_nonblock or messaging_unicast_send_async was called.\n
  *  If this API is not called, memory leak can happen.
+ *  It also releases the reply port which is cached by messaging_send_sync.
  *
  * Input Parameters:
  *	port_name : The message port name to clean(remove)
@@ -72,6 +75,8 @@ int messaging_cleanup(const char *port_name)
 	msg_port_info_t *port_info;
 	pid_t my_pid;
 	sq_queue_t *port_info_list_ptr;
+	char reply_portname[MAX_PORT_NAME_SIZE];
+	int reply_released;
 
 	if (port_name == NULL) {
 		msgdbg("[Messaging] cleanup fail : invalid param.\n");
@@ -83,6 +88,10 @@ int messaging_cleanup(const char *port_name)
 		return ERROR;
 	}
 
+	/* Release the reply port of sync send, "port_name + sender_pid + _r". */
+	snprintf(reply_portname, MAX_PORT_NAME_SIZE, "%s%d%s", port_name, getpid(), "_r");
+	reply_released = messaging_reply_channel_release(reply_portname);
+
 	/* Remove the receiver information by port_name from the info list. */
 	port_info_list_ptr = messaging_get_port_info_list();
 	port_info = (msg_port_info_t *)sq_peek(port_info_list_ptr);
@@ -107,7 +116,7 @@ int messaging_cleanup(const char *port_name)
 	if (cleanup_pid != INVALID_PID) {
 		ret = messaging_unlink_internalport(port_name, cleanup_pid);
 	} else {
-		ret = ERROR;
+		ret = reply_released;
 	}
 
 	return ret;
@@ -17,6 +17,7 @@
  ****************************************************************************/
 #include <tinyara/compiler.h>
 #include <mqueue.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <queue.h>
@@ -142,6 +143,26 @@ int messaging_parse_packet(char *packet, char *buf, int buflen, pid_t *sender_pi
  * @brief Internal function for getting g_port_info_list
  */
 sq_queue_t *messaging_get_port_info_list(void);
+/**
+ * @brief Internal function for opening the reply port of sync send. The port is reused if it is cached.
+ */
+int messaging_reply_channel_open(const char *name, int msgsize, mqd_t *mqdes);
+/**
+ * @brief Internal function for finishing use of the reply port. The cached port is kept if keep is true.
+ */
+void messaging_reply_channel_close(const char *name, mqd_t mqdes, bool keep);
+/**
+ * @brief Internal function for removing the cached reply port of the calling task.
+ */
+int messaging_reply_channel_release(const char *name);
+/**
+ * @brief Internal function for allocating packet buffer from the packet pool.
+ */
+char *messaging_packet_alloc(int size);
+/**
+ * @brief Internal function for returning packet buffer to the packet pool.
+ */
+void messaging_packet_free(char *packet, int size);
 /*
  *@endcond
  */
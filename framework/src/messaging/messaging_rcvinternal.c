@@ -73,7 +73,7 @@ static int messaging_rcv_nonblock(mqd_t mqdes, const char *port_name, msg_recv_b
 	char *internal_portname;
 
 	recv_size = recv_buf->buflen + MSG_HEADER_SIZE;
-	recv_packet = (char *)MSG_ALLOC(recv_size);
+	recv_packet = messaging_packet_alloc(recv_size);
 	if (recv_packet == NULL) {
 		msgdbg("[Messaging] recv fail : out of memory for packet.\n");
 		goto errout_with_mq;
@@ -84,7 +84,7 @@ static int messaging_rcv_nonblock(mqd_t mqdes, const char *port_name, msg_recv_b
 		if (recv_size_chk > 0 && recv_size_chk <= recv_size) {
 			ret = messaging_parse_packet(recv_packet, recv_buf->buf, recv_buf->buflen, &recv_buf->sender_pid, &msg_type);
 			if (ret != OK) {
-				MSG_FREE(recv_packet);
+				messaging_packet_free(recv_packet, recv_size);
 				goto errout_with_mq;
 			}
 			recv_buf->buflen = recv_size_chk;
@@ -94,11 +94,11 @@ static int messaging_rcv_nonblock(mqd_t mqdes, const char *port_name, msg_recv_b
 			break;
 		} else {
 			msgdbg("[Messaging] recv fail : errno %d, size %d.\n", errno, recv_size_chk);
-			MSG_FREE(recv_packet);
+			messaging_packet_free(recv_packet, recv_size);
 			goto errout_with_mq;
 		}
 	}
-	MSG_FREE(recv_packet);
+	messaging_packet_free(recv_packet, recv_size);
 
 	/* There was no msg, then set notification. */
 	ret = messaging_set_notify_signal(SIGMSG_MESSAGING, (_sa_sigaction_t)messaging_run_callback);
@@ -174,7 +174,7 @@ static int messaging_rcv_block(mqd_t mqdes, const char *port_name, msg_recv_buf_
 	char *internal_portname;
 
 	recv_size = MSG_HEADER_SIZE + recv_buf->buflen;
-	recv_packet = (char *)MSG_ALLOC(recv_size);
+	recv_packet = messaging_packet_alloc(recv_size);
 	if (recv_packet == NULL) {
 		msgdbg("[Messaging] recv fail : out of memory for packet.\n");
 		ret = ERROR;
@@ -195,7 +195,7 @@ static int messaging_rcv_block(mqd_t mqdes, const char *port_name, msg_recv_buf_
 	}
 
 cleanup_return:
-	MSG_FREE(recv_packet);
+	messaging_packet_free(recv_packet, recv_size);
 	mq_close(mqdes);
 	MSG_ASPRINTF(&internal_portname, "%s%d", port_name, getpid());
 	mq_unlink(internal_portname);
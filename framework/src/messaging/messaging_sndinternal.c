@@ -63,6 +63,9 @@ static int messaging_set_async_callback(const char *port_name, msg_recv_buf_t *r
 		return ERROR;
 	}
 
+	/* The async reply port is unlinked after the reply, so it must not be cached for sync send. */
+	(void)messaging_reply_channel_release(reply_portname);
+
 	mqdes = mq_open(reply_portname, O_RDONLY | O_CREAT, 0666, &internal_attr);
 	if (mqdes == (mqd_t)ERROR) {
 		msgdbg("[Messaging] send fail : open fail, errno %d.\n", errno);
@@ -131,7 +134,7 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 		return ERROR;
 	}
 
-	send_packet = (char *)MSG_ALLOC(send_size);
+	send_packet = messaging_packet_alloc(send_size);
 	if (send_packet == NULL) {
 		msgdbg("[Messaging] send fail : out of memory for including header.\n");
 		mq_close(mqdes);
@@ -170,13 +173,13 @@ int messaging_send_packet(const char *port_name, msg_send_type_t msg_type, msg_s
 	ret = mq_send(mqdes, (char *)send_packet, send_size, send_data->priority);
 	if (ret != OK) {
 		msgdbg("[Messaging] send fail : errno %d.\n", errno);
-		MSG_FREE(send_packet);
+		messaging_packet_free(send_packet, send_size);
 		mq_close(mqdes);
 		mq_unlink(port_name);
 		return ERROR;
 	}
 
-	MSG_FREE(send_packet);
+	messaging_packet_free(send_packet, send_size);
 	mq_close(mqdes);
 	return ret;
 }
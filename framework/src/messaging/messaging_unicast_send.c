@@ -23,6 +23,7 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <mqueue.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <unistd.h>
 #include <sys/types.h>
@@ -47,58 +48,35 @@ static int messaging_send_param_validation(const char *port_name, msg_send_data_
 
 	return OK;
 }
-static int messaging_sync_recv(const char *port_name, msg_recv_buf_t *reply_buf)
+static int messaging_sync_recv(const char *sync_portname, mqd_t sync_mqdes, int reply_size, msg_recv_buf_t *reply_buf)
 {
 	int ret = OK;
-	mqd_t sync_mqdes;
-	char *sync_portname;
-	struct mq_attr internal_attr;
 	char *reply_data;
-	int reply_size;
 	int msg_type;
 
-	reply_size = reply_buf->buflen + MSG_HEADER_SIZE;
-
-	internal_attr.mq_maxmsg = CONFIG_MESSAGING_MAXMSG;
-	internal_attr.mq_msgsize = reply_size;
-	internal_attr.mq_flags = 0;
-
-	/* sender waits the reply with "port_name + sender_pid + _r". */
-	MSG_ASPRINTF(&sync_portname, "%s%d%s", port_name, getpid(), "_r");
-	if (sync_portname == NULL) {
-		msgdbg("message send fail : sync portname allocation fail.\n");
-		return ERROR;
-	}
-	sync_mqdes = mq_open(sync_portname, O_RDONLY | O_CREAT, 0666, &internal_attr);
-	if (sync_mqdes == (mqd_t)ERROR) {
-		msgdbg("message send fail : sync open fail %d.\n", errno);
-		MSG_FREE(sync_portname);
-		return ERROR;
-	}
-
-	reply_data = (char *)MSG_ALLOC(reply_size);
+	reply_data = messaging_packet_alloc(reply_size);
 	if (reply_data == NULL) {
 		msgdbg("message send fail : out of memory for including header\n");
-		mq_close(sync_mqdes);
-		mq_unlink(sync_portname);
+		messaging_reply_channel_close(sync_portname, sync_mqdes, false);
 		return ERROR;
 	}
 
 	ret = mq_receive(sync_mqdes, reply_data, reply_size, 0);
 	if (ret < 0) {
 		msgdbg("message send fail : sync recv fail %d.\n", errno);
+		/* The reply can still arrive later, so do not keep this port for the next send. */
+		messaging_reply_channel_close(sync_portname, sync_mqdes, false);
+		messaging_packet_free(reply_data, reply_size);
+		return ERROR;
+	}
+
+	ret = messaging_parse_packet(reply_data, reply_buf->buf, reply_buf->buflen, &reply_buf->sender_pid, &msg_type);
+	if (ret != OK) {
 		ret = ERROR;
-	} else {
-		ret = messaging_parse_packet(reply_data, reply_buf->buf, reply_buf->buflen, &reply_buf->sender_pid, &msg_type);
-		if (ret != OK) {
-			ret = ERROR;
-		}
 	}
 
-	mq_close(sync_mqdes);
-	mq_unlink(sync_portname);
-	MSG_FREE(reply_data);
-	MSG_FREE(sync_portname);
+	messaging_reply_channel_close(sync_portname, sync_mqdes, true);
+	messaging_packet_free(reply_data, reply_size);
 
 	return ret;
 }
@@ -112,6 +90,9 @@ static int messaging_sync_recv(const char *port_name, msg_recv_buf_t *reply_buf)
 int messaging_send_sync(const char *port_name, msg_send_data_t *send_data, msg_recv_buf_t *reply_buf)
 {
 	int ret;
+	mqd_t sync_mqdes;
+	int reply_size;
+	char sync_portname[MAX_PORT_NAME_SIZE];
 
 	ret = messaging_send_param_validation(port_name, send_data);
 	if (ret == ERROR) {
@@ -123,17 +104,32 @@ int messaging_send_sync(const char *port_name, msg_send_data_t *send_data, msg_r
 		return ERROR;
 	}
 
+	/* Sender waits the reply with "port_name + sender_pid + _r".
+	 * It is opened before sending, so that the reply cannot arrive before the port exists.
+	 */
+	ret = snprintf(sync_portname, MAX_PORT_NAME_SIZE, "%s%d%s", port_name, getpid(), "_r");
+	if (ret < 0 || ret >= MAX_PORT_NAME_SIZE) {
+		msgdbg("[Messaging] unicast send sync fail : too long port name.\n");
+		return ERROR;
+	}
+
+	reply_size = messaging_reply_channel_open(sync_portname, reply_buf->buflen + MSG_HEADER_SIZE, &sync_mqdes);
+	if (reply_size == ERROR) {
+		return ERROR;
+	}
+
 	ret = messaging_send_internal(port_name, MSG_SEND_SYNC, send_data, NULL, NULL);
 	if (ret == ERROR) {
+		messaging_reply_channel_close(sync_portname, sync_mqdes, true);
 		return ERROR;
 	}
 
-	ret = messaging_sync_recv(port_name, reply_buf);
+	ret = messaging_sync_recv(sync_portname, sync_mqdes, reply_size, reply_buf);
 	if (ret != OK) {
 		return ERROR;
 	}
 
-	return OK;	
+	return OK;
 }
 
 /****************************************************************************
@@ -196,7 +192,7 @@ int messaging_send(const char *port_name, msg_send_data_t *send_data)
 int messaging_reply(const char *port_name, pid_t sender_pid, msg_send_data_t *reply_data)
 {
 	int ret = OK;
-	char *reply_portname;
+	char reply_portname[MAX_PORT_NAME_SIZE];
 	msg_send_data_t reply;
 
 	if (port_name == NULL || sender_pid < 0 || reply_data == NULL || reply_data->msg == NULL || reply_data->msglen <= 0) {
@@ -205,16 +201,14 @@ int messaging_reply(const char *port_name, pid_t sender_pid, msg_send_data_t *re
 	}
 
 	/* Sender waits the reply with "port_name + sender_pid + _r". */
-	MSG_ASPRINTF(&reply_portname, "%s%d%s", port_name, sender_pid, "_r");
-	if (reply_portname == NULL) {
-		msgdbg("[Messaging] unicast reply fail : out of memory.\n");
+	ret = snprintf(reply_portname, MAX_PORT_NAME_SIZE, "%s%d%s", port_name, sender_pid, "_r");
+	if (ret < 0 || ret >= MAX_PORT_NAME_SIZE) {
+		msgdbg("[Messaging] unicast reply fail : too long port name.\n");
 		return ERROR;
 	}
 
 	reply.msg = reply_data->msg;
 	reply.msglen = reply_data->msglen;
 	reply.priority = MSG_REPLY_PRIO;
-	ret = messaging_send_packet(reply_portname, MSG_SEND_REPLY, &reply, NULL);
-	MSG_FREE(reply_portname);
-	return ret;
+	return messaging_send_packet(reply_portname, MSG_SEND_REPLY, &reply, NULL);
 }
@@ -155,6 +155,12 @@ extern "C" {
 #define EXTERN extern
 #endif
 
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__KERNEL__)
+/* Number of times the semaphore fast path had to make the system call */
+
+EXTERN unsigned int g_sem_fastpath_nslow;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -208,6 +214,13 @@ void lib_take_semaphore(FAR struct file_struct *stream);
 void lib_give_semaphore(FAR struct file_struct *stream);
 #endif
 
+/* Defined in sem_fastpath.c */
+
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__KERNEL__)
+bool sem_fasttake(FAR sem_t *sem);
+bool sem_fastgive(FAR sem_t *sem, int16_t max);
+#endif
+
 /* Defined in lib_libgetbase.c */
 
 int lib_getbase(const char *nptr, const char **endptr);
@@ -62,6 +62,11 @@
 #include <unistd.h>
 #include <errno.h>
 #include <limits.h>
+#ifdef CONFIG_PIPES
+#include <sys/ioctl.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#endif
 
 #include "lib_internal.h"
 
@@ -83,6 +88,50 @@
  * Private Functions
  ************************************************************************/
 
+/************************************************************************
+ * Name: sendfile_splice
+ *
+ * Description:
+ *   Move up to count bytes between the pipe pipefd and fd with the
+ *   PIPEIOC_SPLICETO or PIPEIOC_SPLICEFROM command cmd, so that the pipe
+ *   driver moves the data instead of the I/O buffer loop below.
+ *   Returns ERROR if the first command fails, for example because pipefd
+ *   is not a pipe, and the number of bytes moved otherwise.
+ *
+ ************************************************************************/
+
+#ifdef CONFIG_PIPES
+static ssize_t sendfile_splice(int pipefd, int cmd, int fd, size_t count)
+{
+	struct pipe_splice_s splice;
+	ssize_t ntransferred = 0;
+	int ret;
+
+	if ((unsigned int)pipefd >= CONFIG_NFILE_DESCRIPTORS) {
+		return ERROR;
+	}
+
+	splice.fd = fd;
+	while (ntransferred < count && ntransferred != SSIZE_MAX) {
+		splice.count = count - ntransferred;
+		if (splice.count > SSIZE_MAX - ntransferred) {
+			splice.count = SSIZE_MAX - ntransferred;
+		}
+
+		ret = ioctl(pipefd, cmd, (unsigned long)&splice);
+		if (ret < 0) {
+			return ntransferred > 0 ? ntransferred : ERROR;
+		} else if (ret == 0) {
+			break;
+		}
+
+		ntransferred += ret;
+	}
+
+	return ntransferred;
+}
+#endif
+
 /************************************************************************
  * Public Functions
  ************************************************************************/
@@ -98,6 +147,9 @@
  *   nothing in TinyAra but provide some Linux compatible (and adding
  *   another 'almost standard' interface).
  *
+ *   If infd or outfd is a pipe, the pipe driver moves the data between
+ *   the pipe and the other descriptor.
+ *
  *   NOTE: This interface is *not* specified in POSIX.1-2001, or other
  *   standards.  The implementation here is very similar to the Linux
  *   sendfile interface.  Other UNIX systems implement sendfile() with
@@ -159,6 +211,19 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
 		}
 	}
 
+#ifdef CONFIG_PIPES
+	/* If either descriptor is a pipe, let the pipe driver copy the data */
+
+	ntransferred = sendfile_splice(infd, PIPEIOC_SPLICETO, outfd, count);
+	if (ntransferred < 0) {
+		ntransferred = sendfile_splice(outfd, PIPEIOC_SPLICEFROM, infd, count);
+	}
+
+	if (ntransferred >= 0) {
+		goto return_offset;
+	}
+#endif
+
 	/* Allocate an I/O buffer */
 
 	iobuffer = (FAR void *)lib_malloc(CONFIG_LIB_SENDFILE_BUFSIZE);
@@ -283,6 +348,9 @@ ssize_t sendfile(int outfd, int infd, off_t *offset, size_t count)
 
 	lib_free(iobuffer);
 
+#ifdef CONFIG_PIPES
+return_offset:
+#endif
 	/* Return the current file position */
 
 	if (offset) {
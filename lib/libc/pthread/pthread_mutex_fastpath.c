@@ -0,0 +1,119 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include <errno.h>
+
+#include <tinyara/userspace.h>
+
+#include "lib_internal.h"
+
+#if defined(CONFIG_SEM_FASTPATH) && defined(CONFIG_PTHREAD_MUTEX_UNSAFE) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_fastable
+ *
+ * Description:
+ *   Return true if the mutex may be locked and unlocked in user space.  The
+ *   kernel does not need the owner of a NORMAL mutex which is not robust,
+ *   the other types count the locks and check the owner.
+ *
+ ****************************************************************************/
+
+static inline bool pthread_mutex_fastable(FAR pthread_mutex_t *mutex)
+{
+#ifdef CONFIG_PTHREAD_MUTEX_TYPES
+	return mutex != NULL && mutex->type == PTHREAD_MUTEX_NORMAL;
+#else
+	return mutex != NULL;
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: pthread_mutex_fastlock, pthread_mutex_fasttrylock
+ *
+ * Description:
+ *   pthread_mutex_lock() and pthread_mutex_trylock() of user space.  A free
+ *   mutex is taken without a system call, and its pid is then set to the
+ *   pid of the caller which the kernel keeps in g_sem_curpid.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fastlock(FAR pthread_mutex_t *mutex)
+{
+	if (pthread_mutex_fastable(mutex) && sem_fasttake(&mutex->sem)) {
+		mutex->pid = g_sem_curpid;
+		return OK;
+	}
+
+	return (pthread_mutex_lock)(mutex);
+}
+
+int pthread_mutex_fasttrylock(FAR pthread_mutex_t *mutex)
+{
+	if (pthread_mutex_fastable(mutex) && sem_fasttake(&mutex->sem)) {
+		mutex->pid = g_sem_curpid;
+		return OK;
+	}
+
+	return (pthread_mutex_trylock)(mutex);
+}
+
+/****************************************************************************
+ * Name: pthread_mutex_fastunlock
+ *
+ * Description:
+ *   pthread_mutex_unlock() of user space.  The mutex is released without a
+ *   system call if the caller owns it and no task waits for it.
+ *
+ ****************************************************************************/
+
+int pthread_mutex_fastunlock(FAR pthread_mutex_t *mutex)
+{
+	if (pthread_mutex_fastable(mutex) && mutex->pid == g_sem_curpid) {
+		/* The pid is cleared first, since the next owner sets it as soon as
+		 * the count is given.  The kernel clears it as well if the system
+		 * call has to be made.
+		 */
+
+		mutex->pid = -1;
+		if (sem_fastgive(&mutex->sem, 1)) {
+			return OK;
+		}
+	}
+
+	return (pthread_mutex_unlock)(mutex);
+}
+
+#endif							/* CONFIG_SEM_FASTPATH && CONFIG_PTHREAD_MUTEX_UNSAFE && !__KERNEL__ */
@@ -0,0 +1,235 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <semaphore.h>
+
+#include "lib_internal.h"
+
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__KERNEL__)
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+unsigned int g_sem_fastpath_nslow;
+
+/* Pid of the running task, set by the kernel through userspace_s */
+
+volatile pid_t g_sem_curpid;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_fastadd
+ *
+ * Description:
+ *   Add delta to the count of the semaphore if the count is between min and
+ *   max.  The kernel changes the count with interrupts disabled, and the
+ *   exception entry clears the exclusive monitor, so the store fails and
+ *   the count is read again if the kernel ran in between.
+ *
+ ****************************************************************************/
+
+static bool sem_fastadd(FAR sem_t *sem, int16_t min, int16_t max, int16_t delta)
+{
+	FAR volatile int16_t *count = &sem->semcount;
+	uint32_t value;
+	uint32_t fail;
+
+	do {
+		__asm__ __volatile__("ldrexh %0, [%1]" : "=r"(value) : "r"(count) : "memory");
+		if ((int16_t)value < min || (int16_t)value > max) {
+			__asm__ __volatile__("clrex" : : : "memory");
+			return false;
+		}
+		__asm__ __volatile__("strexh %0, %2, [%1]" : "=&r"(fail) : "r"(count), "r"(value + delta) : "memory");
+	} while (fail != 0);
+
+	return true;
+}
+
+#ifdef SAVE_SEM_HOLDER
+/****************************************************************************
+ * Name: sem_fastswap
+ *
+ * Description:
+ *   Like sem_fastadd(), and also replace the fast holder of the semaphore
+ *   by 'to' if it is 'from'.  semcount is the low and fastholder the high
+ *   half of one aligned word, so both are changed by a single STREX.
+ *
+ ****************************************************************************/
+
+static bool sem_fastswap(FAR sem_t *sem, pid_t from, pid_t to, int16_t min, int16_t max, int16_t delta)
+{
+	FAR volatile uint32_t *word = (FAR volatile uint32_t *)&sem->semcount;
+	uint32_t value;
+	uint32_t fail;
+	int16_t count;
+
+	do {
+		__asm__ __volatile__("ldrex %0, [%1]" : "=r"(value) : "r"(word) : "memory");
+		count = (int16_t)(value & 0xffff);
+		if ((pid_t)(value >> 16) != from || count < min || count > max) {
+			__asm__ __volatile__("clrex" : : : "memory");
+			return false;
+		}
+		value = ((uint32_t)(uint16_t)to << 16) | (uint16_t)(count + delta);
+		__asm__ __volatile__("strex %0, %2, [%1]" : "=&r"(fail) : "r"(word), "r"(value) : "memory");
+	} while (fail != 0);
+
+	return true;
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sem_fasttake
+ *
+ * Description:
+ *   Take a count of the semaphore if one is available.  If the kernel keeps
+ *   the holders of the semaphore, the caller is recorded as its fast holder
+ *   and the kernel makes it a holder once it is entered for the semaphore.
+ *   A second fast holder cannot be recorded, so the caller has to make the
+ *   system call if there is one already or no count is available.
+ *
+ ****************************************************************************/
+
+bool sem_fasttake(FAR sem_t *sem)
+{
+	if (sem != NULL && (sem->flags & FLAGS_INITIALIZED) != 0) {
+#ifdef SAVE_SEM_HOLDER
+		if ((sem->flags & FLAGS_SIGSEM) == 0) {
+			if (sem_fastswap(sem, 0, g_sem_curpid, 1, INT16_MAX, -1)) {
+				return true;
+			}
+		} else
+#endif
+		if (sem_fastadd(sem, 1, INT16_MAX, -1)) {
+			return true;
+		}
+	}
+
+	g_sem_fastpath_nslow++;
+	return false;
+}
+
+/****************************************************************************
+ * Name: sem_fastgive
+ *
+ * Description:
+ *   Give a count of the semaphore if no task waits for it and the count is
+ *   less than max.  If the kernel keeps the holders of the semaphore, the
+ *   count must also be the one the caller took in user space.  Otherwise
+ *   return false and the caller has to make the system call.
+ *
+ ****************************************************************************/
+
+bool sem_fastgive(FAR sem_t *sem, int16_t max)
+{
+	if (sem != NULL && (sem->flags & FLAGS_INITIALIZED) != 0) {
+#ifdef SAVE_SEM_HOLDER
+		if ((sem->flags & FLAGS_SIGSEM) == 0) {
+			if (sem_fastswap(sem, g_sem_curpid, 0, 0, max - 1, 1)) {
+				return true;
+			}
+		} else
+#endif
+		if (sem_fastadd(sem, 0, max - 1, 1)) {
+			return true;
+		}
+	}
+
+	g_sem_fastpath_nslow++;
+	return false;
+}
+
+/****************************************************************************
+ * Name: sem_fastwait, sem_fasttimedwait, sem_fasttrywait, sem_fastpost
+ *
+ * Description:
+ *   sem_wait(), sem_timedwait(), sem_trywait() and sem_post() of user space.
+ *   The system call is made only if the task has to wait, a waiting task
+ *   has to be woken up or another task holds a count taken in user space.
+ *
+ ****************************************************************************/
+
+int sem_fastwait(FAR sem_t *sem)
+{
+	if (sem_fasttake(sem)) {
+		return OK;
+	}
+
+	return (sem_wait)(sem);
+}
+
+int sem_fasttimedwait(FAR sem_t *sem, FAR const struct timespec *abstime)
+{
+	if (sem_fasttake(sem)) {
+		return OK;
+	}
+
+	return (sem_timedwait)(sem, abstime);
+}
+
+int sem_fasttrywait(FAR sem_t *sem)
+{
+	if (sem_fasttake(sem)) {
+		return OK;
+	}
+
+	return (sem_trywait)(sem);
+}
+
+int sem_fastpost(FAR sem_t *sem)
+{
+	if (sem_fastgive(sem, SEM_VALUE_MAX)) {
+		return OK;
+	}
+
+	return (sem_post)(sem);
+}
+
+/****************************************************************************
+ * Name: sem_fastpath_nslow
+ *
+ * Description:
+ *   Return the number of times the fast path had to make the system call.
+ *
+ ****************************************************************************/
+
+unsigned int sem_fastpath_nslow(void)
+{
+	return g_sem_fastpath_nslow;
+}
+
+#endif							/* CONFIG_SEM_FASTPATH && !__KERNEL__ */
@@ -123,6 +123,9 @@ int sem_init(FAR sem_t *sem, int pshared, unsigned int value)
 #endif
 
 #ifdef SAVE_SEM_HOLDER
+#ifdef CONFIG_SEM_FASTPATH
+		sem->fastholder = 0;
+#endif
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
 		sem->hhead = NULL;
 #else
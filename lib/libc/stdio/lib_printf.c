@@ -114,7 +114,7 @@ int printf(FAR const char *fmt, ...)
 	va_start(ap, fmt);
 
 #if defined(CONFIG_LOGM) && defined(CONFIG_PRINTF2LOGM)
-	ret = logm_internal(LOGM_NORMAL, LOGM_UNKNOWN, LOGM_DEF_PRIORITY, fmt, ap);
+	ret = logm_internal(LOGM_NORMAL, LOGM_PRINTF, LOGM_DEF_PRIORITY, fmt, ap);
 #elif CONFIG_NFILE_STREAMS > 0
 	ret = vfprintf(stdout, fmt, ap);
 #elif CONFIG_NFILE_DESCRIPTORS > 0
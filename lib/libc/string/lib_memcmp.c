@@ -60,6 +60,7 @@
 
 #include <tinyara/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
 /************************************************************
@@ -72,6 +73,31 @@ int memcmp(FAR const void *s1, FAR const void *s2, size_t n)
 	unsigned char *p1 = (unsigned char *)s1;
 	unsigned char *p2 = (unsigned char *)s2;
 
+#ifdef CONFIG_MEMCMP_OPTSPEED
+	/* This version is optimized for speed.  If both buffers have the same
+	 * alignment, equal words are skipped a word at a time.  The bytes from
+	 * the first differing word on are compared below.
+	 */
+
+	if ((((uintptr_t)p1 ^ (uintptr_t)p2) & 3) == 0) {
+		while (((uintptr_t)p1 & 3) != 0 && n > 0) {
+			if (*p1 != *p2) {
+				return *p1 < *p2 ? -1 : 1;
+			}
+
+			p1++;
+			p2++;
+			n--;
+		}
+
+		while (n >= sizeof(uint32_t) && *(uint32_t *)p1 == *(uint32_t *)p2) {
+			p1 += sizeof(uint32_t);
+			p2 += sizeof(uint32_t);
+			n -= sizeof(uint32_t);
+		}
+	}
+#endif
+
 	while (n-- > 0) {
 		if (*p1 < *p2) {
 			return -1;
@@ -56,8 +56,19 @@
 
 #include <tinyara/config.h>
 
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_STRCHR_OPTSPEED
+/* True if any byte of the 32-bit word w is zero */
+
+#define STRCHR_HASZERO(w) ((((w) - 0x01010101) & ~(w) & 0x80808080) != 0)
+#endif
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -79,9 +90,35 @@
 #ifndef CONFIG_ARCH_STRCHR
 FAR char *strchr(FAR const char *s, int c)
 {
+#ifdef CONFIG_STRCHR_OPTSPEED
+	FAR const uint32_t *ws;
+	uint32_t cw;
+#endif
+
 	if (s) {
+#ifdef CONFIG_STRCHR_OPTSPEED
+		/* This version is optimized for speed.  After the word boundary,
+		 * it skips a word at a time the words which hold neither the
+		 * terminating null nor the byte c.  The word where the search
+		 * stops is checked below.
+		 */
+
+		for (; ((uintptr_t)s & 3) != 0; s++) {
+			if (*s == (char)c) {
+				return (FAR char *)s;
+			}
+
+			if (!*s) {
+				return NULL;
+			}
+		}
+
+		cw = (uint32_t)(unsigned char)c * 0x01010101;
+		for (ws = (FAR const uint32_t *)s; !STRCHR_HASZERO(*ws) && !STRCHR_HASZERO(*ws ^ cw); ws++);
+		s = (FAR const char *)ws;
+#endif
 		for (;; s++) {
-			if (*s == c) {
+			if (*s == (char)c) {
 				return (FAR char *)s;
 			}
 
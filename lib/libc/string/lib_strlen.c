@@ -56,8 +56,19 @@
 
 #include <tinyara/config.h>
 #include <sys/types.h>
+#include <stdint.h>
 #include <string.h>
 
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_STRLEN_OPTSPEED
+/* True if any byte of the 32-bit word w is zero */
+
+#define STRLEN_HASZERO(w) ((((w) - 0x01010101) & ~(w) & 0x80808080) != 0)
+#endif
+
 /****************************************************************************
  * Global Functions
  ****************************************************************************/
@@ -66,10 +77,30 @@
 size_t strlen(const char *s)
 {
 	const char *sc;
+#ifdef CONFIG_STRLEN_OPTSPEED
+	const uint32_t *ws;
+#endif
 	if (s == NULL) {
 		return 0;
 	}
-	for (sc = s; *sc != '\0'; ++sc);
+#ifdef CONFIG_STRLEN_OPTSPEED
+	/* This version is optimized for speed.  After the word boundary, it
+	 * looks for the terminating null a word at a time.  Aligned words never
+	 * cross a page or a memory region, so reading past the null is safe.
+	 */
+
+	for (sc = s; ((uintptr_t)sc & 3) != 0; ++sc) {
+		if (*sc == '\0') {
+			return sc - s;
+		}
+	}
+
+	for (ws = (const uint32_t *)sc; !STRLEN_HASZERO(*ws); ws++);
+	sc = (const char *)ws;
+#else
+	sc = s;
+#endif
+	for (; *sc != '\0'; ++sc);
 	return sc - s;
 }
 #endif
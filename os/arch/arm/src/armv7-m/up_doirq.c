@@ -61,6 +61,9 @@
 
 #include <tinyara/irq.h>
 #include <tinyara/arch.h>
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+#include <tinyara/sched.h>
+#endif
 #include <arch/board/board.h>
 
 #include "up_arch.h"
@@ -94,6 +97,9 @@ uint32_t *up_doirq(int irq, uint32_t *regs)
 	irqstate_t flags;
 #endif
 	board_led_on(LED_INIRQ);
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	sched_cpuload_irqenter();
+#endif
 #ifdef CONFIG_SUPPRESS_INTERRUPTS
 	PANIC();
 #else
@@ -178,6 +184,9 @@ uint32_t *up_doirq(int irq, uint32_t *regs)
 
 	current_regs = savestate;
 #endif
+#endif
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	sched_cpuload_irqexit();
 #endif
 	board_led_off(LED_INIRQ);
 	return regs;
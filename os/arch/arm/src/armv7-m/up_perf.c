@@ -0,0 +1,126 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * arch/arm/src/armv7-m/up_perf.c
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+
+#include "up_arch.h"
+#include "nvic.h"
+#include "dwt.h"
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static bool g_perf_initialized;
+static bool g_perf_use_dwt;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_perf_initialize
+ *
+ * Description:
+ *   Enable the DWT cycle counter and check that it really counts.  The DWT
+ *   is optional (and not emulated by QEMU), SysTick is used without it.
+ *   Enabling twice is harmless, so no locking is needed if an interrupt
+ *   handler gets here first.
+ *
+ ****************************************************************************/
+
+static void up_perf_initialize(void)
+{
+	volatile int delay;
+	uint32_t start;
+
+	modifyreg32(NVIC_DEMCR, 0, NVIC_DEMCR_TRCENA);
+	modifyreg32(DWT_CTRL, 0, DWT_CTRL_CYCCNTENA_Msk);
+
+	start = getreg32(DWT_CYCCNT);
+	for (delay = 0; delay < 16; delay++) ;
+
+	g_perf_use_dwt = (getreg32(DWT_CYCCNT) != start);
+	g_perf_initialized = true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: up_perf_gettime
+ *
+ * Description:
+ *   Return a free running 32-bit cycle count.  This is the DWT cycle
+ *   counter if present, otherwise it is derived from the system tick count
+ *   and the SysTick current value.  May be called from interrupt handlers.
+ *
+ ****************************************************************************/
+
+uint32_t up_perf_gettime(void)
+{
+	clock_t ticks;
+	uint32_t reload;
+	uint32_t current;
+
+	if (!g_perf_initialized) {
+		up_perf_initialize();
+	}
+
+	if (g_perf_use_dwt) {
+		return getreg32(DWT_CYCCNT);
+	}
+
+	/* Retry if the tick count changed while SysTick was being read */
+
+	reload = getreg32(NVIC_SYSTICK_RELOAD);
+	do {
+		ticks = clock_systimer();
+		current = getreg32(NVIC_SYSTICK_CURRENT);
+	} while (ticks != clock_systimer());
+
+	return (uint32_t)ticks * (reload + 1) + (reload - current);
+}
+
+/****************************************************************************
+ * Name: up_perf_getfreq
+ *
+ * Description:
+ *   Return the frequency of the up_perf_gettime() counter in Hz.  SysTick
+ *   runs from the core clock, so this is the number of SysTick counts per
+ *   tick times the tick rate.
+ *
+ ****************************************************************************/
+
+uint32_t up_perf_getfreq(void)
+{
+	return (getreg32(NVIC_SYSTICK_RELOAD) + 1) * TICK_PER_SEC;
+}
@@ -37,6 +37,13 @@
 #include "mpu.h"
 #endif
 #include <tinyara/arch.h>
+#include <tinyara/ttrace.h>
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+#include <tinyara/sched.h>
+#endif
+#ifdef CONFIG_SEM_FASTPATH
+#include <tinyara/userspace.h>
+#endif
 
 #include "up_internal.h"
 #include "sched/sched.h"
@@ -65,6 +72,13 @@ extern uint32_t *g_umm_app_id;
 void up_restoretask(struct tcb_s *tcb)
 {
 	if (tcb) {
+		ttrace_event(TTRACE_EV_SWITCH, tcb->pid, tcb->sched_priority, 0);
+
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+		/* Charge the time elapsed to the thread which is switched out */
+		sched_cpuload_switch(tcb);
+#endif
+
 #ifdef CONFIG_TASK_SCHED_HISTORY
 		/* Save the task name which will be scheduled */
 		save_task_scheduling_status(tcb);
@@ -87,6 +101,13 @@ void up_restoretask(struct tcb_s *tcb)
 		}
 #endif
 #endif
+#ifdef CONFIG_SEM_FASTPATH
+		/* Tell the semaphore fast path of the binary which task runs */
+
+		if (tcb->uspace) {
+			*((FAR struct userspace_s *)tcb->uspace)->curpid = tcb->pid;
+		}
+#endif
 #ifdef CONFIG_MPU_STACK_OVERFLOW_PROTECTION
 		up_mpu_set_register(tcb->stack_mpu_regs);
 #endif
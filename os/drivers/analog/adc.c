@@ -422,7 +422,7 @@ static void adc_pollnotify(FAR struct adc_dev_s *dev, uint32_t type)
 		struct pollfd *fds = dev->fds[i];
 		if (fds) {
 			fds->revents |= type;
-			sem_post(fds->sem);
+			poll_post(fds);
 		}
 	}
 }
@@ -77,6 +77,10 @@ static int cpuload_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 	int ret;
 	int ticks;
 	pid_t *result_addr;
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	struct cpuload_times_s *times;
+	struct cpuload_s cpuload;
+#endif
 
 	ret = -EINVAL;
 
@@ -100,6 +104,20 @@ static int cpuload_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 			ret = OK;
 		}
 		break;
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	case CPULOADIOC_GETTIMES:
+		times = (struct cpuload_times_s *)arg;
+		if (times != NULL) {
+			/* The idle thread never exits, so its pid 0 is always valid */
+
+			(void)clock_cpuload(0, 0, &cpuload);
+			times->idle = cpuload.runtime;
+			(void)clock_cpuload_irq(0, &cpuload);
+			times->irq = cpuload.runtime;
+			ret = OK;
+		}
+		break;
+#endif
 	default:
 		break;
 	}
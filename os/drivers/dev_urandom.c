@@ -296,7 +296,7 @@ static int devurand_poll(FAR struct file *filep, FAR struct pollfd *fds, bool se
 	if (setup) {
 		fds->revents |= (fds->events & (POLLIN | POLLOUT));
 		if (fds->revents != 0) {
-			sem_post(fds->sem);
+			poll_post(fds);
 		}
 	}
 
@@ -122,7 +122,7 @@ static int devzero_poll(FAR struct file *filep, FAR struct pollfd *fds, bool set
 	if (setup) {
 		fds->revents |= (fds->events & (POLLIN | POLLOUT));
 		if (fds->revents != 0) {
-			sem_post(fds->sem);
+			poll_post(fds);
 		}
 	}
 	return OK;
@@ -29,6 +29,7 @@
 #include <debug.h>
 
 #include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
 #include <tinyara/gpio.h>
 
 /****************************************************************************
@@ -184,7 +185,7 @@ static void gpio_sample(FAR struct gpio_upperhalf_s *priv)
 				if (fds) {
 					fds->revents |= (fds->events & POLLIN);
 					if (fds->revents != 0) {
-						sem_post(fds->sem);
+						poll_post(fds);
 					}
 				}
 			}
@@ -249,7 +249,7 @@ static int lwnl_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 			int nready = lwnl_check_queue(filep);
 			if (nready > 0) {
 				fds->revents |= (fds->events & POLLIN);
-				sem_post(fds->sem);
+				poll_post(fds);
 				return 0;
 			}
 		}
@@ -286,7 +286,7 @@ static int lwnl_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 			int nready = lwnl_check_queue(filep);
 			if (nready > 0) {
 				fds->revents |= (fds->events & POLLIN);
-				sem_post(fds->sem);
+				poll_post(fds);
 				return 0;
 			}
 		}
@@ -382,10 +382,7 @@ int lwnl_postmsg(lwnl_dev_type dev, uint32_t evt, void *buffer, int32_t buf_len)
 		if (fds && (lwnl_get_dev_type(fds->filep) == dev)) {
 			fds->revents |= (fds->events & POLLIN);
 			if (fds->revents != 0) {
-				int tres = sem_post(fds->sem);
-				if (tres != 0) {
-					LWNL_LOGE(TAG, "sem post fail %d\n", errno);
-				}
+				poll_post(fds);
 			}
 		}
 	}
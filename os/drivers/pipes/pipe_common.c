@@ -66,6 +66,7 @@
 #include <sched.h>
 #include <semaphore.h>
 #include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <assert.h>
 #include <debug.h>
@@ -129,6 +130,80 @@ static void pipecommon_semtake(sem_t *sem)
 	}
 }
 
+/****************************************************************************
+ * Name: pipecommon_wakeall
+ *
+ * Description:
+ *   Wake up every thread waiting on sem.  Readers and writers are woken
+ *   once for each transfer, not for each byte.
+ *
+ ****************************************************************************/
+
+static void pipecommon_wakeall(sem_t *sem)
+{
+	int sval;
+
+	while (sem_getvalue(sem, &sval) == 0 && sval < 0) {
+		sem_post(sem);
+	}
+}
+
+/****************************************************************************
+ * Name: pipecommon_rdchunk and pipecommon_wrchunk
+ *
+ * Description:
+ *   Return the number of bytes which may be read from d_rdndx, or written
+ *   at d_wrndx, without wrapping around the end of the buffer.  One byte of
+ *   the buffer is always left free so that a full buffer is told from an
+ *   empty one.
+ *
+ ****************************************************************************/
+
+static size_t pipecommon_rdchunk(FAR struct pipe_dev_s *dev)
+{
+	if (dev->d_wrndx >= dev->d_rdndx) {
+		return dev->d_wrndx - dev->d_rdndx;
+	}
+
+	return CONFIG_DEV_PIPE_SIZE - dev->d_rdndx;
+}
+
+static size_t pipecommon_wrchunk(FAR struct pipe_dev_s *dev)
+{
+	if (dev->d_wrndx < dev->d_rdndx) {
+		return dev->d_rdndx - dev->d_wrndx - 1;
+	}
+
+	if (dev->d_rdndx == 0) {
+		return CONFIG_DEV_PIPE_SIZE - dev->d_wrndx - 1;
+	}
+
+	return CONFIG_DEV_PIPE_SIZE - dev->d_wrndx;
+}
+
+/****************************************************************************
+ * Name: pipecommon_rdadvance and pipecommon_wradvance
+ *
+ * Description:
+ *   Advance d_rdndx or d_wrndx by a number of bytes no greater than the
+ *   value of pipecommon_rdchunk() or pipecommon_wrchunk().
+ *
+ ****************************************************************************/
+
+static void pipecommon_rdadvance(FAR struct pipe_dev_s *dev, size_t nbytes)
+{
+	size_t ndx = dev->d_rdndx + nbytes;
+
+	dev->d_rdndx = ndx >= CONFIG_DEV_PIPE_SIZE ? 0 : ndx;
+}
+
+static void pipecommon_wradvance(FAR struct pipe_dev_s *dev, size_t nbytes)
+{
+	size_t ndx = dev->d_wrndx + nbytes;
+
+	dev->d_wrndx = ndx >= CONFIG_DEV_PIPE_SIZE ? 0 : ndx;
+}
+
 /****************************************************************************
  * Name: pipecommon_pollnotify
  ****************************************************************************/
@@ -144,7 +219,7 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev, pollevent_t events
 			fds->revents |= (fds->events & eventset);
 			if (fds->revents != 0) {
 				fvdbg("Report events: %02x\n", fds->revents);
-				sem_post(fds->sem);
+				poll_post(fds);
 			}
 		}
 	}
@@ -153,6 +228,282 @@ static void pipecommon_pollnotify(FAR struct pipe_dev_s *dev, pollevent_t events
 #define pipecommon_pollnotify(dev, event)
 #endif
 
+/****************************************************************************
+ * Name: pipecommon_splicecheck
+ *
+ * Description:
+ *   Refuse to splice a pipe with itself, which would wait for free space
+ *   or data only itself can provide.  Sockets are not in the file list and
+ *   are always allowed.
+ *
+ ****************************************************************************/
+
+static int pipecommon_splicecheck(FAR struct file *filep, int fd)
+{
+	FAR struct file *other;
+
+	if (fs_getfilep(fd, &other) == OK && other->f_inode == filep->f_inode) {
+		return -EINVAL;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: pipecommon_splicebuf
+ *
+ * Description:
+ *   Allocate the buffer through which a splice moves at most count bytes.
+ *   The data is copied out of or into the pipe under d_bfsem, but the I/O
+ *   on the other descriptor is done without it, since that may block or
+ *   be another pipe spliced with this one.
+ *
+ ****************************************************************************/
+
+static FAR uint8_t *pipecommon_splicebuf(FAR size_t *count)
+{
+	if (*count > CONFIG_DEV_PIPE_SIZE - 1) {
+		*count = CONFIG_DEV_PIPE_SIZE - 1;
+	}
+
+	return (FAR uint8_t *)kmm_malloc(*count);
+}
+
+/****************************************************************************
+ * Name: pipecommon_spliceto
+ *
+ * Description:
+ *   PIPEIOC_SPLICETO: write the data available in the pipe to splice->fd,
+ *   waiting for data as read() does.  The data is only removed from the
+ *   pipe once it was written.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_spliceto(FAR struct file *filep, FAR struct pipe_splice_s *splice)
+{
+	FAR struct pipe_dev_s *dev = filep->f_inode->i_private;
+	FAR uint8_t *buffer;
+	ssize_t nwritten;
+	size_t count = splice->count;
+	size_t ncopied = 0;
+	size_t nconsumed;
+	size_t chunk;
+	pipe_ndx_t start;
+	int ret;
+
+	if ((filep->f_oflags & O_RDOK) == 0) {
+		return -EBADF;
+	}
+
+	ret = pipecommon_splicecheck(filep, splice->fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	buffer = pipecommon_splicebuf(&count);
+	if (buffer == NULL) {
+		return -ENOMEM;
+	}
+
+	if (sem_wait(&dev->d_bfsem) < 0) {
+		ret = -get_errno();
+		goto errout;
+	}
+
+	/* If the pipe is empty, then wait for something to be written to it */
+
+	while (dev->d_wrndx == dev->d_rdndx) {
+		if (filep->f_oflags & O_NONBLOCK) {
+			sem_post(&dev->d_bfsem);
+			ret = -EAGAIN;
+			goto errout;
+		}
+
+		if (dev->d_nwriters <= 0) {
+			sem_post(&dev->d_bfsem);
+			ret = 0;
+			goto errout;
+		}
+
+		sched_lock();
+		sem_post(&dev->d_bfsem);
+		ret = sem_wait(&dev->d_rdsem);
+		sched_unlock();
+
+		if (ret < 0 || sem_wait(&dev->d_bfsem) < 0) {
+			ret = -get_errno();
+			goto errout;
+		}
+	}
+
+	/* Copy the buffered data in at most two chunks.  d_rdndx is restored,
+	 * so the data stays in the pipe until it is written.
+	 */
+
+	start = dev->d_rdndx;
+	while (ncopied < count && (chunk = pipecommon_rdchunk(dev)) > 0) {
+		if (chunk > count - ncopied) {
+			chunk = count - ncopied;
+		}
+
+		memcpy(&buffer[ncopied], &dev->d_buffer[dev->d_rdndx], chunk);
+		pipecommon_rdadvance(dev, chunk);
+		ncopied += chunk;
+	}
+
+	dev->d_rdndx = start;
+	sem_post(&dev->d_bfsem);
+
+	nwritten = write(splice->fd, buffer, ncopied);
+	if (nwritten <= 0) {
+		ret = nwritten < 0 ? -get_errno() : 0;
+		goto errout;
+	}
+
+	/* Remove what was written.  Another reader may have taken part of it
+	 * meanwhile, only the rest is removed then.
+	 */
+
+	pipecommon_semtake(&dev->d_bfsem);
+	nconsumed = (dev->d_rdndx + CONFIG_DEV_PIPE_SIZE - start) % CONFIG_DEV_PIPE_SIZE;
+	if (nconsumed < (size_t)nwritten) {
+		dev->d_rdndx = (start + nwritten) % CONFIG_DEV_PIPE_SIZE;
+		pipecommon_wakeall(&dev->d_wrsem);
+		pipecommon_pollnotify(dev, POLLOUT);
+	}
+
+	sem_post(&dev->d_bfsem);
+	ret = nwritten;
+
+errout:
+	kmm_free(buffer);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: pipecommon_splicefrom
+ *
+ * Description:
+ *   PIPEIOC_SPLICEFROM: read from splice->fd into the pipe, at most as much
+ *   as the pipe has free space, waiting for free space as write() does.
+ *   Returns zero at the end of splice->fd.
+ *
+ ****************************************************************************/
+
+static ssize_t pipecommon_splicefrom(FAR struct file *filep, FAR struct pipe_splice_s *splice)
+{
+	FAR struct pipe_dev_s *dev = filep->f_inode->i_private;
+	FAR uint8_t *buffer;
+	ssize_t nread;
+	size_t count = splice->count;
+	size_t nfree;
+	size_t ncopied;
+	size_t chunk;
+	int ret;
+
+	if ((filep->f_oflags & O_WROK) == 0) {
+		return -EBADF;
+	}
+
+	ret = pipecommon_splicecheck(filep, splice->fd);
+	if (ret < 0) {
+		return ret;
+	}
+
+	if (count == 0) {
+		return 0;
+	}
+
+	buffer = pipecommon_splicebuf(&count);
+	if (buffer == NULL) {
+		return -ENOMEM;
+	}
+
+	if (sem_wait(&dev->d_bfsem) < 0) {
+		ret = -get_errno();
+		goto errout;
+	}
+
+	/* If the pipe is full, then wait for something to be read from it */
+
+	while (pipecommon_wrchunk(dev) == 0) {
+		if (filep->f_oflags & O_NONBLOCK) {
+			sem_post(&dev->d_bfsem);
+			ret = -EAGAIN;
+			goto errout;
+		}
+
+		sched_lock();
+		sem_post(&dev->d_bfsem);
+		ret = sem_wait(&dev->d_wrsem);
+		sched_unlock();
+
+		if (ret < 0 || sem_wait(&dev->d_bfsem) < 0) {
+			ret = -get_errno();
+			goto errout;
+		}
+	}
+
+	nfree = (dev->d_rdndx + CONFIG_DEV_PIPE_SIZE - dev->d_wrndx - 1) % CONFIG_DEV_PIPE_SIZE;
+	if (count > nfree) {
+		count = nfree;
+	}
+
+	sem_post(&dev->d_bfsem);
+
+	/* A short read is returned as is, so that a socket is not waited on
+	 * with data in hand.
+	 */
+
+	nread = read(splice->fd, buffer, count);
+	if (nread <= 0) {
+		ret = nread < 0 ? -get_errno() : 0;
+		goto errout;
+	}
+
+	/* Another writer may have taken the free space meanwhile.  The data is
+	 * already read, so wait for space even with O_NONBLOCK.
+	 */
+
+	pipecommon_semtake(&dev->d_bfsem);
+	ncopied = 0;
+	for (;;) {
+		while (ncopied < (size_t)nread && (chunk = pipecommon_wrchunk(dev)) > 0) {
+			if (chunk > (size_t)nread - ncopied) {
+				chunk = (size_t)nread - ncopied;
+			}
+
+			memcpy(&dev->d_buffer[dev->d_wrndx], &buffer[ncopied], chunk);
+			pipecommon_wradvance(dev, chunk);
+			ncopied += chunk;
+		}
+
+		pipecommon_wakeall(&dev->d_rdsem);
+		pipecommon_pollnotify(dev, POLLIN);
+
+		if (ncopied >= (size_t)nread) {
+			break;
+		}
+
+		sched_lock();
+		sem_post(&dev->d_bfsem);
+		pipecommon_semtake(&dev->d_wrsem);
+		sched_unlock();
+		pipecommon_semtake(&dev->d_bfsem);
+	}
+
+	sem_post(&dev->d_bfsem);
+	ret = nread;
+
+errout:
+	kmm_free(buffer);
+	return ret;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -401,7 +752,7 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 	FAR uint8_t *start = (uint8_t *)buffer;
 #endif
 	ssize_t nread = 0;
-	int sval;
+	size_t chunk;
 	int ret;
 
 	DEBUGASSERT(dev);
@@ -445,22 +796,26 @@ ssize_t pipecommon_read(FAR struct file *filep, FAR char *buffer, size_t len)
 		}
 	}
 
-	/* Then return whatever is available in the pipe (which is at least one byte) */
+	/* Then return whatever is available in the pipe (which is at least one
+	 * byte).  It is copied in at most two chunks, up to the end of the buffer
+	 * and then from its beginning.
+	 */
 
 	nread = 0;
-	while (nread < len && dev->d_wrndx != dev->d_rdndx) {
-		*buffer++ = dev->d_buffer[dev->d_rdndx];
-		if (++dev->d_rdndx >= CONFIG_DEV_PIPE_SIZE) {
-			dev->d_rdndx = 0;
+	while (nread < len && (chunk = pipecommon_rdchunk(dev)) > 0) {
+		if (chunk > len - nread) {
+			chunk = len - nread;
 		}
-		nread++;
+
+		memcpy(buffer, &dev->d_buffer[dev->d_rdndx], chunk);
+		pipecommon_rdadvance(dev, chunk);
+		buffer += chunk;
+		nread += chunk;
 	}
 
 	/* Notify all waiting writers that bytes have been removed from the buffer */
 
-	while (sem_getvalue(&dev->d_wrsem, &sval) == 0 && sval < 0) {
-		sem_post(&dev->d_wrsem);
-	}
+	pipecommon_wakeall(&dev->d_wrsem);
 
 	/* Notify all poll/select waiters that they can write to the FIFO */
 
@@ -481,8 +836,7 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
 	struct pipe_dev_s *dev = inode->i_private;
 	ssize_t nwritten = 0;
 	ssize_t last;
-	int nxtwrndx;
-	int sval;
+	size_t chunk;
 
 	DEBUGASSERT(dev);
 	pipe_dumpbuffer("To PIPE:", (uint8_t *)buffer, len);
@@ -514,31 +868,29 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
 
 	last = 0;
 	for (;;) {
-		/* Calculate the write index AFTER the next byte is written */
-
-		nxtwrndx = dev->d_wrndx + 1;
-		if (nxtwrndx >= CONFIG_DEV_PIPE_SIZE) {
-			nxtwrndx = 0;
-		}
-
-		/* Would the next write overflow the circular buffer? */
+		/* Copy as much as fits before the end of the buffer or the read
+		 * index, whichever comes first.
+		 */
 
-		if (nxtwrndx != dev->d_rdndx) {
-			/* No... copy the byte */
+		chunk = pipecommon_wrchunk(dev);
+		if (chunk > 0) {
+			if (chunk > len - nwritten) {
+				chunk = len - nwritten;
+			}
 
-			dev->d_buffer[dev->d_wrndx] = *buffer++;
-			dev->d_wrndx = nxtwrndx;
+			memcpy(&dev->d_buffer[dev->d_wrndx], buffer, chunk);
+			pipecommon_wradvance(dev, chunk);
+			buffer += chunk;
+			nwritten += chunk;
 
 			/* Is the write complete? */
 
-			if (++nwritten >= len) {
+			if (nwritten >= len) {
 				/* Yes.. Notify all of the waiting readers that more data is available */
 
-				while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0) {
-					sem_post(&dev->d_rdsem);
-				}
+				pipecommon_wakeall(&dev->d_rdsem);
 
-				/* Notify all poll/select waiters that they can write to the FIFO */
+				/* Notify all poll/select waiters that they can read from the FIFO */
 
 				pipecommon_pollnotify(dev, POLLIN);
 
@@ -548,14 +900,13 @@ ssize_t pipecommon_write(FAR struct file *filep, FAR const char *buffer, size_t
 				return len;
 			}
 		} else {
-			/* There is not enough room for the next byte. Was anything written in this pass? */
+			/* The buffer is full. Was anything written in this pass? */
 
 			if (last < nwritten) {
 				/* Yes.. Notify all of the waiting readers that more data is available */
 
-				while (sem_getvalue(&dev->d_rdsem, &sval) == 0 && sval < 0) {
-					sem_post(&dev->d_rdsem);
-				}
+				pipecommon_wakeall(&dev->d_rdsem);
+				pipecommon_pollnotify(dev, POLLIN);
 			}
 			last = nwritten;
 
@@ -684,9 +1035,8 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 	FAR struct inode *inode = filep->f_inode;
 	FAR struct pipe_dev_s *dev = inode->i_private;
 
-	/* Only one command supported */
-
-	if (cmd == PIPEIOC_POLICY) {
+	switch (cmd) {
+	case PIPEIOC_POLICY:
 		if (arg != 0) {
 			PIPE_POLICY_1(dev->d_flags);
 		} else {
@@ -694,6 +1044,23 @@ int pipecommon_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 		}
 
 		return OK;
+
+	case PIPEIOC_SPLICETO:
+		if (arg == 0) {
+			return -EINVAL;
+		}
+
+		return pipecommon_spliceto(filep, (FAR struct pipe_splice_s *)arg);
+
+	case PIPEIOC_SPLICEFROM:
+		if (arg == 0) {
+			return -EINVAL;
+		}
+
+		return pipecommon_splicefrom(filep, (FAR struct pipe_splice_s *)arg);
+
+	default:
+		break;
 	}
 
 	return -ENOTTY;
@@ -41,6 +41,7 @@
 #include <tinyara/fs/fs.h>
 #include <tinyara/arch.h>
 #include <tinyara/ringbuf.h>
+#include <tinyara/ttrace.h>
 
 #include <arch/irq.h>
 
@@ -255,6 +256,15 @@ static int ttrace_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
 
 int ttrace_init(void)
 {
+#ifdef CONFIG_TTRACE_EVENTS
+	int ret;
+
+	ret = ttrace_event_register();
+	if (ret < 0) {
+		return ret;
+	}
+#endif
+
 	/* Register the syslog character driver */
 	return register_driver(CONFIG_TTRACE_DEVPATH, &g_ttracefops, 0666, &g_sysdev);
 }
@@ -0,0 +1,318 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/fs/fs.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/sched.h>
+#include <tinyara/ttrace.h>
+
+#include <arch/irq.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+#define ttrace_ev_timestamp() up_perf_gettime()
+#define ttrace_ev_timefreq() up_perf_getfreq()
+#else
+#define ttrace_ev_timestamp() ((uint32_t)clock_systimer())
+#define ttrace_ev_timefreq() TICK_PER_SEC
+#endif
+
+#ifdef CONFIG_TTRACE_EVENTS_AUTOSTART
+#define TTRACE_EV_INITIAL_STATE true
+#else
+#define TTRACE_EV_INITIAL_STATE false
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* A snapshot of the buffer taken when the device is opened */
+
+struct ttrace_evsnap_s {
+	size_t size;
+	FAR struct ttrace_evdump_s *hdr;
+	FAR struct ttrace_evtask_s *tasks;
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int ttrace_ev_open(FAR struct file *filep);
+static int ttrace_ev_close(FAR struct file *filep);
+static ssize_t ttrace_ev_read(FAR struct file *filep, FAR char *buffer, size_t len);
+static int ttrace_ev_ioctl(FAR struct file *filep, int cmd, unsigned long arg);
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+volatile bool g_ttrace_ev_enabled = TTRACE_EV_INITIAL_STATE;
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_ttrace_evfops = {
+	ttrace_ev_open,  /* open */
+	ttrace_ev_close, /* close */
+	ttrace_ev_read,  /* read */
+	0,               /* write */
+	0,               /* seek */
+	ttrace_ev_ioctl  /* ioctl */
+};
+
+static struct ttrace_event_s g_ttrace_ev[CONFIG_TTRACE_EVENTS_COUNT];
+static int g_ttrace_ev_next;		/* Where the next event is written */
+static int g_ttrace_ev_count;		/* Valid events in the buffer */
+static uint32_t g_ttrace_ev_lost;	/* Events overwritten */
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ttrace_ev_addtask
+ *
+ * Description:
+ *   sched_foreach() callback which adds a task to the name table of a
+ *   snapshot.  Runs with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static void ttrace_ev_addtask(FAR struct tcb_s *tcb, FAR void *arg)
+{
+	FAR struct ttrace_evsnap_s *snap = (FAR struct ttrace_evsnap_s *)arg;
+	FAR struct ttrace_evtask_s *task;
+
+	if (snap->hdr->ntasks >= CONFIG_MAX_TASKS) {
+		return;
+	}
+
+	task = &snap->tasks[snap->hdr->ntasks++];
+	task->pid = tcb->pid;
+	task->prio = tcb->sched_priority;
+	task->flags = tcb->flags & TCB_FLAG_TTYPE_MASK;
+#if CONFIG_TASK_NAME_SIZE > 0
+	strncpy(task->name, tcb->name, TTRACE_COMM_BYTES);
+	task->name[TTRACE_COMM_BYTES - 1] = '\0';
+#else
+	task->name[0] = '\0';
+#endif
+}
+
+/****************************************************************************
+ * Name: ttrace_ev_open
+ *
+ * Description:
+ *   Take a snapshot of the tasks and of the buffer, oldest event first.
+ *   Recording goes on meanwhile.
+ *
+ ****************************************************************************/
+
+static int ttrace_ev_open(FAR struct file *filep)
+{
+	FAR struct ttrace_evsnap_s *snap;
+	FAR struct ttrace_event_s *events;
+	irqstate_t flags;
+	int first;
+	int chunk;
+
+	if ((filep->f_oflags & O_WROK) != 0) {
+		return -EACCES;
+	}
+
+	snap = (FAR struct ttrace_evsnap_s *)kmm_malloc(sizeof(struct ttrace_evsnap_s) +
+			sizeof(struct ttrace_evdump_s) + CONFIG_MAX_TASKS * sizeof(struct ttrace_evtask_s) +
+			sizeof(g_ttrace_ev));
+	if (snap == NULL) {
+		return -ENOMEM;
+	}
+
+	snap->hdr = (FAR struct ttrace_evdump_s *)(snap + 1);
+	snap->tasks = (FAR struct ttrace_evtask_s *)(snap->hdr + 1);
+
+	memcpy(snap->hdr->magic, TTRACE_EV_MAGIC, sizeof(snap->hdr->magic));
+	snap->hdr->version = TTRACE_EV_VERSION;
+	snap->hdr->freq = ttrace_ev_timefreq();
+	snap->hdr->ntasks = 0;
+
+	sched_foreach(ttrace_ev_addtask, snap);
+
+	/* The events follow the used part of the task table */
+
+	events = (FAR struct ttrace_event_s *)&snap->tasks[snap->hdr->ntasks];
+
+	flags = irqsave();
+	first = g_ttrace_ev_next - g_ttrace_ev_count;
+	if (first < 0) {
+		first += CONFIG_TTRACE_EVENTS_COUNT;
+	}
+	chunk = CONFIG_TTRACE_EVENTS_COUNT - first;
+	if (chunk > g_ttrace_ev_count) {
+		chunk = g_ttrace_ev_count;
+	}
+	memcpy(events, &g_ttrace_ev[first], chunk * sizeof(struct ttrace_event_s));
+	memcpy(&events[chunk], g_ttrace_ev, (g_ttrace_ev_count - chunk) * sizeof(struct ttrace_event_s));
+	snap->hdr->nevents = g_ttrace_ev_count;
+	snap->hdr->lost = g_ttrace_ev_lost;
+	irqrestore(flags);
+
+	snap->size = (FAR char *)&events[snap->hdr->nevents] - (FAR char *)snap->hdr;
+	filep->f_priv = snap;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: ttrace_ev_close
+ ****************************************************************************/
+
+static int ttrace_ev_close(FAR struct file *filep)
+{
+	kmm_free(filep->f_priv);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: ttrace_ev_read
+ ****************************************************************************/
+
+static ssize_t ttrace_ev_read(FAR struct file *filep, FAR char *buffer, size_t len)
+{
+	FAR struct ttrace_evsnap_s *snap = (FAR struct ttrace_evsnap_s *)filep->f_priv;
+
+	if (filep->f_pos >= snap->size) {
+		return 0;
+	}
+
+	if (len > snap->size - filep->f_pos) {
+		len = snap->size - filep->f_pos;
+	}
+
+	memcpy(buffer, (FAR char *)snap->hdr + filep->f_pos, len);
+	filep->f_pos += len;
+	return (ssize_t)len;
+}
+
+/****************************************************************************
+ * Name: ttrace_ev_ioctl
+ *
+ * Description:
+ *   TTRACE_START clears the buffer and starts recording, TTRACE_FINISH
+ *   stops recording so that the buffer keeps the events before it.
+ *
+ ****************************************************************************/
+
+static int ttrace_ev_ioctl(FAR struct file *filep, int cmd, unsigned long arg)
+{
+	irqstate_t flags;
+
+	switch (cmd) {
+	case TTRACE_START:
+		flags = irqsave();
+		g_ttrace_ev_next = 0;
+		g_ttrace_ev_count = 0;
+		g_ttrace_ev_lost = 0;
+		g_ttrace_ev_enabled = true;
+		irqrestore(flags);
+		break;
+	case TTRACE_FINISH:
+		g_ttrace_ev_enabled = false;
+		break;
+	case TTRACE_USED_BUFSIZE:
+		return g_ttrace_ev_count * sizeof(struct ttrace_event_s);
+	default:
+		return -ENOTTY;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: ttrace_event_put
+ *
+ * Description:
+ *   Record a kernel event, overwriting the oldest one if the buffer is
+ *   full.  Called through the ttrace_event() tracepoint macro from any
+ *   context, including interrupt handlers and the scheduler.
+ *
+ ****************************************************************************/
+
+void ttrace_event_put(uint8_t type, pid_t pid, uint8_t arg8, uint32_t arg)
+{
+	FAR struct ttrace_event_s *ev;
+	irqstate_t flags;
+
+	flags = irqsave();
+
+	ev = &g_ttrace_ev[g_ttrace_ev_next];
+	if (++g_ttrace_ev_next == CONFIG_TTRACE_EVENTS_COUNT) {
+		g_ttrace_ev_next = 0;
+	}
+	if (g_ttrace_ev_count < CONFIG_TTRACE_EVENTS_COUNT) {
+		g_ttrace_ev_count++;
+	} else {
+		g_ttrace_ev_lost++;
+	}
+
+	ev->timestamp = ttrace_ev_timestamp();
+	ev->type = type;
+	ev->arg8 = arg8;
+	ev->pid = pid;
+	ev->arg = arg;
+
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: ttrace_event_register
+ *
+ * Description:
+ *   Register the event trace device at CONFIG_TTRACE_EVENTS_DEVPATH.
+ *
+ ****************************************************************************/
+
+int ttrace_event_register(void)
+{
+	return register_driver(CONFIG_TTRACE_EVENTS_DEVPATH, &g_ttrace_evfops, 0444, NULL);
+}
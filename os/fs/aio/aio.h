@@ -64,7 +64,6 @@
 #include <aio.h>
 #include <queue.h>
 
-#include <tinyara/wqueue.h>
 #include <tinyara/net/net.h>
 
 #ifdef CONFIG_FS_AIO
@@ -80,6 +79,24 @@
 #define CONFIG_FS_NAIOC 8
 #endif
 
+/* The pool of worker threads */
+
+#ifndef CONFIG_FS_AIO_NWORKERS
+#define CONFIG_FS_AIO_NWORKERS 1
+#endif
+
+#ifndef CONFIG_FS_AIO_PRIORITY
+#define CONFIG_FS_AIO_PRIORITY 100
+#endif
+
+#ifndef CONFIG_FS_AIO_STACKSIZE
+#define CONFIG_FS_AIO_STACKSIZE 2048
+#endif
+
+#ifndef CONFIG_FS_AIO_MERGE_SIZE
+#define CONFIG_FS_AIO_MERGE_SIZE 4096
+#endif
+
 #undef AIO_HAVE_FILEP
 
 #if CONFIG_NFILE_DESCRIPTORS > 0
@@ -93,6 +110,10 @@
 /****************************************************************************
  * Public Types
  ****************************************************************************/
+/* Performs the I/O of an AIO container on an AIO worker thread */
+
+typedef CODE void (*aio_worker_t)(FAR void *arg);
+
 /* This structure contains one AIO control block and appends information
  * needed by the logic running on the worker thread.  These structures are
  * pre-allocated, the number pre-allocated controlled by CONFIG_FS_NAIOC.
@@ -108,11 +129,10 @@ struct aio_container_s {
 #endif
 		FAR void *ptr;			/* Generic pointer to FAR data */
 	} u;
-	struct work_s aioc_work;	/* Used to defer I/O to the work thread */
+	aio_worker_t aioc_worker;		/* Performs the I/O on an AIO worker thread */
 	pid_t aioc_pid;				/* ID of the waiting task */
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	uint8_t aioc_prio;			/* Priority of the waiting task */
-#endif
+	uint8_t aioc_prio;			/* Priority of the waiting task less aio_reqprio */
+	uint8_t aioc_opcode;		/* LIO_READ, LIO_WRITE, or LIO_NOP for aio_fsync() */
 };
 
 /****************************************************************************
@@ -127,8 +147,9 @@ extern "C" {
 #define EXTERN extern
 #endif
 
-/* This is a list of pending asynchronous I/O.  The user must hold the
- * lock on this list in order to access the list.
+/* This is a list of asynchronous I/O which is queued and not started yet,
+ * by decreasing priority.  The user must hold the lock on this list in
+ * order to access the list.
  */
 
 EXTERN dq_queue_t g_aio_pending;
@@ -214,7 +235,8 @@ void aioc_free(FAR struct aio_container_s *aioc);
  * Name: aio_contain
  *
  * Description:
- *   Create and initialize a container for the provided AIO control block
+ *   Create and initialize a container for the provided AIO control block.
+ *   The container is added to g_aio_pending by aio_queue().
  *
  * Input Parameters:
  *   aiocbp - The AIO control block pointer
@@ -234,7 +256,7 @@ FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp);
  *
  * Description:
  *   Remove the AIO control block from the container and free all resources
- *   used by the container.
+ *   used by the container.  The container must not be in g_aio_pending.
  *
  * Input Parameters:
  *   aioc - Pointer to the AIO control block container
@@ -250,11 +272,11 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  * Name: aio_queue
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Schedule the asynchronous I/O on the AIO worker threads
  *
  * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ *   aioc   - The AIO control block container
+ *   worker - The function which performs the I/O of the container
  *
  * Returned Value:
  *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
@@ -262,7 +284,7 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc);
  *
  ****************************************************************************/
 
-int aio_queue(FAR struct aio_container_s *aioc, worker_t worker);
+int aio_queue(FAR struct aio_container_s *aioc, aio_worker_t worker);
 
 /****************************************************************************
  * Name: aio_signal
@@ -57,12 +57,9 @@
 #include <tinyara/config.h>
 
 #include <aio.h>
-#include <sched.h>
 #include <assert.h>
 #include <errno.h>
 
-#include <tinyara/wqueue.h>
-
 #include "aio/aio.h"
 
 #ifdef CONFIG_FS_AIO
@@ -114,7 +111,7 @@
  *   will not be modified by aio_cancel().
  *
  * Input Parameters:
- *   fildes - Not used in this implementation
+ *   fildes - The file descriptor of the requests to cancel if aiocbp is NULL
  *   aiocbp - Points to the asynchronous I/O control block for a particular
  *            request to be cancelled.
  *
@@ -136,17 +133,14 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 {
 	FAR struct aio_container_s *aioc;
 	FAR struct aio_container_s *next;
-	int status;
 	int ret;
 
-	/* Check if a non-NULL aiocbp was provided */
-
-	/* Lock the scheduler so that no I/O events can complete on the worker
-	 * thread until we set complete this operation.
+	/* Only the requests which are still in g_aio_pending can be cancelled.
+	 * A worker thread removes a request from the list, under the lock,
+	 * before it starts the I/O.
 	 */
 
 	ret = AIO_ALLDONE;
-	sched_lock();
 	aio_lock();
 
 	if (aiocbp) {
@@ -157,76 +151,38 @@ int aio_cancel(int fildes, FAR struct aiocb *aiocbp)
 
 			for (aioc = (FAR struct aio_container_s *)g_aio_pending.head; aioc && aioc->aioc_aiocbp != aiocbp; aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink) ;
 
-			/* Did we find a container for this fildes?  We should; the aio_result says
-			 * that the transfer is pending.  If not we return AIO_ALLDONE.
-			 */
-
 			if (aioc) {
-				/* Yes... attempt to cancel the I/O.  There are two
-				 * possibilities:* (1) the work has already been started and
-				 * is no longer queued, or (2) the work has not been started
-				 * and is still in the work queue.  Only the second case can
-				 * be cancelled.  work_cancel() will return -ENOENT in the
-				 * first case.
+				/* The I/O is not started yet.  Remove the container from
+				 * the list of pending transfers.
 				 */
 
-				status = work_cancel(LPWORK, &aioc->aioc_work);
-				if (status >= 0) {
-					aiocbp->aio_result = -ECANCELED;
-					ret = AIO_CANCELED;
-				} else {
-					ret = AIO_NOTCANCELED;
-				}
-
-				/* Remove the container from the list of pending transfers */
-
+				dq_rem(&aioc->aioc_link, &g_aio_pending);
 				(void)aioc_decant(aioc);
+				aiocbp->aio_result = -ECANCELED;
+				ret = AIO_CANCELED;
+			} else {
+				/* A worker thread is performing the I/O */
+
+				ret = AIO_NOTCANCELED;
 			}
 		}
 	} else {
 		/* No aiocbp.. cancel all outstanding I/O for the fildes */
 
-		next = (FAR struct aio_container_s *)g_aio_pending.head;
-		do {
-			/* Find the next container with this AIO control block */
-
-			for (aioc = next; aioc && aioc->aioc_aiocbp->aio_fildes != fildes; aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink) ;
-
-			/* Did we find the container?  We should; the aio_result says
-			 * that the transfer is pending.  If not we return AIO_ALLDONE.
-			 */
-
-			if (aioc) {
-				/* Yes... attempt to cancel the I/O.  There are two
-				 * possibilities:* (1) the work has already been started and
-				 * is no longer queued, or (2) the work has not been started
-				 * and is still in the work queue.  Only the second case can
-				 * be cancelled.  work_cancel() will return -ENOENT in the
-				 * first case.
-				 */
-
-				status = work_cancel(LPWORK, &aioc->aioc_work);
-
-				/* Remove the container from the list of pending transfers */
-
-				next = (FAR struct aio_container_s *)aioc->aioc_link.flink;
+		for (aioc = (FAR struct aio_container_s *)g_aio_pending.head; aioc; aioc = next) {
+			next = (FAR struct aio_container_s *)aioc->aioc_link.flink;
+			if (aioc->aioc_aiocbp->aio_fildes == fildes) {
+				dq_rem(&aioc->aioc_link, &g_aio_pending);
 				aiocbp = aioc_decant(aioc);
 				DEBUGASSERT(aiocbp);
 
-				if (status >= 0) {
-					aiocbp->aio_result = -ECANCELED;
-					if (ret != AIO_NOTCANCELED) {
-						ret = AIO_CANCELED;
-					}
-				} else {
-					ret = AIO_NOTCANCELED;
-				}
+				aiocbp->aio_result = -ECANCELED;
+				ret = AIO_CANCELED;
 			}
-		} while (aioc);
+		}
 	}
 
 	aio_unlock();
-	sched_unlock();
 	return ret;
 }
 
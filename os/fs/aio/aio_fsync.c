@@ -109,10 +109,8 @@ static void aio_fsync_worker(FAR void *arg)
 {
 	FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
 	FAR struct aiocb *aiocbp;
+	FAR struct file *filep;
 	pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	uint8_t prio;
-#endif
 	int ret;
 
 	/* Get the information from the container, decant the AIO control block,
@@ -122,14 +120,12 @@ static void aio_fsync_worker(FAR void *arg)
 
 	DEBUGASSERT(aioc && aioc->aioc_aiocbp);
 	pid = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	prio = aioc->aioc_prio;
-#endif
+	filep = aioc->u.aioc_filep;
 	aiocbp = aioc_decant(aioc);
 
 	/* Perform the fsync using u.aioc_filep */
 
-	ret = file_fsync(aioc->u.aioc_filep);
+	ret = file_fsync(filep);
 	if (ret < 0) {
 		int errcode = get_errno();
 		fdbg("ERROR: fsync failed: %d\n", errcode);
@@ -142,12 +138,6 @@ static void aio_fsync_worker(FAR void *arg)
 	/* Signal the client */
 
 	(void)aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	/* Restore the low priority worker thread default priority */
-
-	lpwork_restorepriority(prio);
-#endif
 }
 
 /****************************************************************************
@@ -259,6 +249,7 @@ int aio_fsync(int op, FAR struct aiocb *aiocbp)
 
 	/* Defer the work to the worker thread */
 
+	aioc->aioc_opcode = LIO_NOP;
 	ret = aio_queue(aioc, aio_fsync_worker);
 	if (ret < 0) {
 		/* The result and the errno have already been set */
@@ -56,12 +56,21 @@
 
 #include <tinyara/config.h>
 
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
 #include <sched.h>
 #include <aio.h>
+#include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <debug.h>
 
-#include <tinyara/wqueue.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/kthread.h>
+#include <tinyara/fs/fs.h>
 
 #include "aio/aio.h"
 
@@ -71,14 +80,35 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* The largest number of requests performed as one */
+
+#define AIO_MAXBATCH CONFIG_FS_NAIOC
+
 /****************************************************************************
  * Private Types
  ****************************************************************************/
 
+/* The state of an AIO worker thread, protected by the lock */
+
+struct aio_worker_s {
+	pid_t pid;					/* Task ID of the worker */
+	uint8_t prio;				/* Priority it runs at */
+	bool busy;					/* True while it performs requests */
+};
+
 /****************************************************************************
  * Private Data
  ****************************************************************************/
 
+/* Counts the requests added to g_aio_pending for the worker threads */
+
+static sem_t g_aio_worksem;
+
+/* The worker threads started */
+
+static struct aio_worker_s g_aio_workers[CONFIG_FS_AIO_NWORKERS];
+static uint8_t g_aio_nworkers;
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -88,54 +118,389 @@
  ****************************************************************************/
 
 /****************************************************************************
- * Name: aio_queue
+ * Name: aio_mergeable
  *
  * Description:
- *   Schedule the asynchronous I/O on the low priority work queue
+ *   Return true if the container reads or writes the file at aio_offset,
+ *   so that it may be ordered by offset and performed as part of a larger
+ *   request.  Writes to a file opened with O_APPEND are not at aio_offset,
+ *   and a file without a seek method has no offsets.
  *
- * Input Parameters:
- *   arg - Worker argument.  In this case, a pointer to an instance of
- *     struct aiocb cast to void *.
+ ****************************************************************************/
+
+static bool aio_mergeable(FAR struct aio_container_s *aioc)
+{
+	FAR struct inode *inode = aioc->u.aioc_filep->f_inode;
+
+	if (aioc->aioc_opcode == LIO_WRITE) {
+		if ((aioc->u.aioc_filep->f_oflags & O_APPEND) != 0) {
+			return false;
+		}
+	} else if (aioc->aioc_opcode != LIO_READ) {
+		return false;
+	}
+
+	return inode != NULL && inode->u.i_ops != NULL && inode->u.i_ops->seek != NULL;
+}
+
+/****************************************************************************
+ * Name: aio_insert
  *
- * Returned Value:
- *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
- *   appropriately.
+ * Description:
+ *   Add the container to g_aio_pending after the requests of the same or a
+ *   higher priority.  A container which may be merged goes before the
+ *   mergeable requests of the same priority on the same file which follow
+ *   it, so that they are performed in the order of their offsets.  Other
+ *   requests, and overlapping ones, keep their order.  Called with the
+ *   lock held.
  *
  ****************************************************************************/
 
-int aio_queue(FAR struct aio_container_s *aioc, worker_t worker)
+static void aio_insert(FAR struct aio_container_s *aioc)
 {
-	int ret;
+	FAR struct aio_container_s *next;
+	bool mergeable = aio_mergeable(aioc);
+
+	for (next = (FAR struct aio_container_s *)g_aio_pending.head; next; next = (FAR struct aio_container_s *)next->aioc_link.flink) {
+		if (next->aioc_prio < aioc->aioc_prio) {
+			break;
+		}
+
+		if (mergeable && next->aioc_prio == aioc->aioc_prio && next->u.ptr == aioc->u.ptr && aio_mergeable(next) && next->aioc_aiocbp->aio_offset >= aioc->aioc_aiocbp->aio_offset + (off_t)aioc->aioc_aiocbp->aio_nbytes) {
+			break;
+		}
+	}
+
+	if (next) {
+		dq_addbefore(&next->aioc_link, &aioc->aioc_link, &g_aio_pending);
+	} else {
+		dq_addlast(&aioc->aioc_link, &g_aio_pending);
+	}
+}
+
+/****************************************************************************
+ * Name: aio_boost
+ *
+ * Description:
+ *   If every worker is busy, raise the worker of the lowest priority to the
+ *   priority of a request just queued, as the low priority work queue was
+ *   raised for AIO before.  The worker drops back to the priority of the
+ *   next request it takes.  Called with the lock held.
+ *
+ ****************************************************************************/
+
+static void aio_boost(uint8_t prio)
+{
+	FAR struct aio_worker_s *lowest = NULL;
+	struct sched_param param;
+	int i;
+
+	for (i = 0; i < g_aio_nworkers; i++) {
+		if (!g_aio_workers[i].busy) {
+			/* The idle worker takes the request */
+
+			return;
+		}
+
+		if (lowest == NULL || g_aio_workers[i].prio < lowest->prio) {
+			lowest = &g_aio_workers[i];
+		}
+	}
+
+	if (lowest != NULL && lowest->prio < prio) {
+		lowest->prio = prio;
+		param.sched_priority = prio;
+		(void)sched_setparam(lowest->pid, &param);
+	}
+}
+
+/****************************************************************************
+ * Name: aio_collect
+ *
+ * Description:
+ *   Remove from g_aio_pending the requests which continue the request in
+ *   batch[0]: same file, same operation, and at the offset where the
+ *   previous one ends.  Returns the number of requests in batch.  Called
+ *   with the lock held.
+ *
+ ****************************************************************************/
+
+static int aio_collect(FAR struct aio_container_s **batch)
+{
+	FAR struct aio_container_s *aioc;
+	FAR struct aiocb *first = batch[0]->aioc_aiocbp;
+	off_t end = first->aio_offset + first->aio_nbytes;
+	size_t total = first->aio_nbytes;
+	int nbatch = 1;
+
+	if (!aio_mergeable(batch[0])) {
+		return 1;
+	}
+
+	while (nbatch < AIO_MAXBATCH) {
+		for (aioc = (FAR struct aio_container_s *)g_aio_pending.head; aioc; aioc = (FAR struct aio_container_s *)aioc->aioc_link.flink) {
+			if (aioc->u.ptr == batch[0]->u.ptr && aioc->aioc_opcode == batch[0]->aioc_opcode && aioc->aioc_aiocbp->aio_offset == end && total + aioc->aioc_aiocbp->aio_nbytes <= CONFIG_FS_AIO_MERGE_SIZE) {
+				break;
+			}
+		}
+
+		if (aioc == NULL) {
+			break;
+		}
+
+		dq_rem(&aioc->aioc_link, &g_aio_pending);
+		batch[nbatch++] = aioc;
+		end += aioc->aioc_aiocbp->aio_nbytes;
+		total += aioc->aioc_aiocbp->aio_nbytes;
+	}
+
+	return nbatch;
+}
+
+/****************************************************************************
+ * Name: aio_merged
+ *
+ * Description:
+ *   Perform the contiguous requests of batch as one read or write of the
+ *   file, and complete each of them.  The data goes through a temporary
+ *   buffer unless the buffers of the requests are contiguous as well.
+ *
+ ****************************************************************************/
+
+static void aio_merged(FAR struct aio_container_s **batch, int nbatch)
+{
+	FAR struct file *filep = batch[0]->u.aioc_filep;
+	FAR struct aiocb *aiocbp;
+	FAR uint8_t *buffer;
+	FAR uint8_t *next;
+	bool bounce = false;
+	uint8_t opcode = batch[0]->aioc_opcode;
+	off_t offset = batch[0]->aioc_aiocbp->aio_offset;
+	size_t total = 0;
+	size_t nbytes;
+	ssize_t ret;
+	pid_t pid;
+	int i;
+
+	buffer = (FAR uint8_t *)batch[0]->aioc_aiocbp->aio_buf;
+	next = buffer;
+	for (i = 0; i < nbatch; i++) {
+		aiocbp = batch[i]->aioc_aiocbp;
+		if ((FAR uint8_t *)aiocbp->aio_buf != next) {
+			bounce = true;
+		}
+
+		next = (FAR uint8_t *)aiocbp->aio_buf + aiocbp->aio_nbytes;
+		total += aiocbp->aio_nbytes;
+	}
+
+	if (bounce) {
+		buffer = (FAR uint8_t *)kmm_malloc(total);
+		if (buffer == NULL) {
+			/* Perform the requests one by one */
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	/* Prohibit context switches until we complete the queuing */
+			for (i = 0; i < nbatch; i++) {
+				batch[i]->aioc_worker(batch[i]);
+			}
 
-	sched_lock();
+			return;
+		}
 
-	/* Make sure that the low-priority worker thread is running at at least
-	 * the priority specified for this action.
+		if (opcode == LIO_WRITE) {
+			for (i = 0, next = buffer; i < nbatch; i++) {
+				aiocbp = batch[i]->aioc_aiocbp;
+				memcpy(next, (FAR const void *)aiocbp->aio_buf, aiocbp->aio_nbytes);
+				next += aiocbp->aio_nbytes;
+			}
+		}
+	}
+
+	if (opcode == LIO_READ) {
+		ret = file_pread(filep, buffer, total, offset);
+	} else {
+		ret = file_pwrite(filep, buffer, total, offset);
+	}
+
+	if (ret < 0) {
+		ret = -get_errno();
+		fdbg("ERROR: merged I/O of %d bytes failed: %d\n", total, (int)ret);
+	}
+
+	/* Share the bytes transferred among the requests in the order of their
+	 * offsets, and complete them.
 	 */
 
-	lpwork_boostpriority(aioc->aioc_prio);
+	for (i = 0, next = buffer; i < nbatch; i++) {
+		pid = batch[i]->aioc_pid;
+		aiocbp = aioc_decant(batch[i]);
+
+		if (ret < 0) {
+			aiocbp->aio_result = ret;
+		} else {
+			nbytes = aiocbp->aio_nbytes < (size_t)ret ? aiocbp->aio_nbytes : (size_t)ret;
+			if (bounce && opcode == LIO_READ) {
+				memcpy((FAR void *)aiocbp->aio_buf, next, nbytes);
+			}
+
+			next += aiocbp->aio_nbytes;
+			aiocbp->aio_result = nbytes;
+			ret -= nbytes;
+		}
+
+		(void)aio_signal(pid, aiocbp);
+	}
+
+	if (bounce) {
+		kmm_free(buffer);
+	}
+}
+
+/****************************************************************************
+ * Name: aio_worker
+ *
+ * Description:
+ *   The AIO worker threads.  Each one takes the request of the highest
+ *   priority, collects the requests which continue it and performs them at
+ *   their priority.
+ *
+ ****************************************************************************/
+
+static int aio_worker(int argc, FAR char *argv[])
+{
+	FAR struct aio_container_s *batch[AIO_MAXBATCH];
+	FAR struct aio_worker_s *self;
+	struct sched_param param;
+	pid_t pid = getpid();
+	int nbatch;
+
+	/* aio_start() fills in the slot of the worker with the lock held */
+
+	aio_lock();
+	for (self = g_aio_workers; self->pid != pid; self++) ;
+	aio_unlock();
+
+	for (;;) {
+		while (sem_wait(&g_aio_worksem) < 0) {
+			DEBUGASSERT(get_errno() == EINTR);
+		}
+
+		/* A request may have been merged or cancelled since it was counted */
+
+		aio_lock();
+		batch[0] = (FAR struct aio_container_s *)dq_remfirst(&g_aio_pending);
+		if (batch[0] == NULL) {
+			aio_unlock();
+			continue;
+		}
+
+		nbatch = 1;
+#if CONFIG_FS_AIO_MERGE_SIZE > 0
+		nbatch = aio_collect(batch);
 #endif
 
-	/* Schedule the work on the low priority worker thread */
+		/* Run at the priority of the request */
 
-	ret = work_queue(LPWORK, &aioc->aioc_work, worker, aioc, 0);
-	if (ret < 0) {
-		FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
-		DEBUGASSERT(aiocbp);
+		self->busy = true;
+		if (batch[0]->aioc_prio != self->prio) {
+			self->prio = batch[0]->aioc_prio;
+			param.sched_priority = self->prio;
+			(void)sched_setparam(0, &param);
+		}
+
+		aio_unlock();
+
+		if (nbatch > 1) {
+			aio_merged(batch, nbatch);
+		} else {
+			batch[0]->aioc_worker(batch[0]);
+		}
+
+		aio_lock();
+		self->busy = false;
+		aio_unlock();
+	}
 
+	return OK;
+}
+
+/****************************************************************************
+ * Name: aio_start
+ *
+ * Description:
+ *   Start the AIO worker threads if they are not running yet.  Called with
+ *   the lock held.
+ *
+ ****************************************************************************/
+
+static int aio_start(void)
+{
+	int pid;
+
+	if (g_aio_nworkers == 0) {
+		(void)sem_init(&g_aio_worksem, 0, 0);
+		sem_setprotocol(&g_aio_worksem, SEM_PRIO_NONE);
+	}
+
+	while (g_aio_nworkers < CONFIG_FS_AIO_NWORKERS) {
+		pid = kernel_thread("aio", CONFIG_FS_AIO_PRIORITY, CONFIG_FS_AIO_STACKSIZE, aio_worker, (FAR char *const *)NULL);
+		if (pid < 0) {
+			fdbg("ERROR: Failed to start an AIO worker: %d\n", pid);
+			return g_aio_nworkers > 0 ? OK : pid;
+		}
+
+		g_aio_workers[g_aio_nworkers].pid = pid;
+		g_aio_workers[g_aio_nworkers].prio = CONFIG_FS_AIO_PRIORITY;
+		g_aio_workers[g_aio_nworkers].busy = false;
+		g_aio_nworkers++;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: aio_queue
+ *
+ * Description:
+ *   Schedule the asynchronous I/O on the AIO worker threads
+ *
+ * Input Parameters:
+ *   aioc   - The AIO control block container
+ *   worker - The function which performs the I/O of the container
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  Otherwise, -1 is returned and the errno is set
+ *   appropriately.
+ *
+ ****************************************************************************/
+
+int aio_queue(FAR struct aio_container_s *aioc, aio_worker_t worker)
+{
+	FAR struct aiocb *aiocbp = aioc->aioc_aiocbp;
+	int ret;
+
+	DEBUGASSERT(aiocbp);
+
+	aio_lock();
+	ret = aio_start();
+	if (ret < 0) {
+		aio_unlock();
+		(void)aioc_decant(aioc);
 		aiocbp->aio_result = ret;
 		set_errno(-ret);
-		ret = ERROR;
+		return ERROR;
 	}
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	/* Now the low-priority work queue might run at its new priority */
 
-	sched_unlock();
-#endif
-	return ret;
+	aioc->aioc_worker = worker;
+	aio_insert(aioc);
+	aio_boost(aioc->aioc_prio);
+	aio_unlock();
+
+	sem_post(&g_aio_worksem);
+	return OK;
 }
 
 #endif							/* CONFIG_FS_AIO */
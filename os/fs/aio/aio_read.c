@@ -109,10 +109,10 @@ static void aio_read_worker(FAR void *arg)
 {
 	FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
 	FAR struct aiocb *aiocbp;
-	pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	uint8_t prio;
+#ifdef AIO_HAVE_FILEP
+	FAR struct file *filep;
 #endif
+	pid_t pid;
 	ssize_t nread = 0;
 
 	/* Get the information from the container, decant the AIO control block,
@@ -122,8 +122,8 @@ static void aio_read_worker(FAR void *arg)
 
 	DEBUGASSERT(aioc && aioc->aioc_aiocbp);
 	pid = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	prio = aioc->aioc_prio;
+#ifdef AIO_HAVE_FILEP
+	filep = aioc->u.aioc_filep;
 #endif
 	aiocbp = aioc_decant(aioc);
 
@@ -137,7 +137,7 @@ static void aio_read_worker(FAR void *arg)
 		 *   aio_offset   - File offset
 		 */
 
-		nread = file_pread(aioc->u.aioc_filep, (FAR void *)aiocbp->aio_buf, aiocbp->aio_nbytes, aiocbp->aio_offset);
+		nread = file_pread(filep, (FAR void *)aiocbp->aio_buf, aiocbp->aio_nbytes, aiocbp->aio_offset);
 	}
 #endif
 
@@ -155,12 +155,6 @@ static void aio_read_worker(FAR void *arg)
 	/* Signal the client */
 
 	(void)aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	/* Restore the low priority worker thread default priority */
-
-	lpwork_restorepriority(prio);
-#endif
 }
 
 /****************************************************************************
@@ -289,6 +283,7 @@ int aio_read(FAR struct aiocb *aiocbp)
 
 	/* Defer the work to the worker thread */
 
+	aioc->aioc_opcode = LIO_READ;
 	ret = aio_queue(aioc, aio_read_worker);
 	if (ret < 0) {
 		/* The result and the errno have already been set */
@@ -127,11 +127,9 @@ static void aio_write_worker(FAR void *arg)
 	FAR struct aio_container_s *aioc = (FAR struct aio_container_s *)arg;
 	FAR struct aiocb *aiocbp;
 	pid_t pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	uint8_t prio;
-#endif
 	ssize_t nwritten = 0;
 #ifdef AIO_HAVE_FILEP
+	FAR struct file *filep;
 	int oflags;
 #endif
 
@@ -142,8 +140,8 @@ static void aio_write_worker(FAR void *arg)
 
 	DEBUGASSERT(aioc && aioc->aioc_aiocbp);
 	pid = aioc->aioc_pid;
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	prio = aioc->aioc_prio;
+#ifdef AIO_HAVE_FILEP
+	filep = aioc->u.aioc_filep;
 #endif
 	aiocbp = aioc_decant(aioc);
 
@@ -151,7 +149,7 @@ static void aio_write_worker(FAR void *arg)
 	{
 		/* Call fcntl(F_GETFL) to get the file open mode. */
 
-		oflags = file_fcntl(aioc->u.aioc_filep, F_GETFL);
+		oflags = file_fcntl(filep, F_GETFL);
 		if (oflags < 0) {
 			int errcode = get_errno();
 			fdbg("ERROR: fcntl failed: %d\n", errcode);
@@ -172,9 +170,9 @@ static void aio_write_worker(FAR void *arg)
 		if ((oflags & O_APPEND) != 0) {
 			/* Append to the current file position */
 
-			nwritten = file_write(aioc->u.aioc_filep, (FAR const void *)aiocbp->aio_buf, aiocbp->aio_nbytes);
+			nwritten = file_write(filep, (FAR const void *)aiocbp->aio_buf, aiocbp->aio_nbytes);
 		} else {
-			nwritten = file_pwrite(aioc->u.aioc_filep, (FAR const void *)aiocbp->aio_buf, aiocbp->aio_nbytes, aiocbp->aio_offset);
+			nwritten = file_pwrite(filep, (FAR const void *)aiocbp->aio_buf, aiocbp->aio_nbytes, aiocbp->aio_offset);
 		}
 	}
 #endif
@@ -197,12 +195,6 @@ errout:
 	/* Signal the client */
 
 	(void)aio_signal(pid, aiocbp);
-
-#ifdef CONFIG_PRIORITY_INHERITANCE
-	/* Restore the low priority worker thread default priority */
-
-	lpwork_restorepriority(prio);
-#endif
 }
 
 /****************************************************************************
@@ -333,6 +325,7 @@ int aio_write(FAR struct aiocb *aiocbp)
 
 	/* Defer the work to the worker thread */
 
+	aioc->aioc_opcode = LIO_WRITE;
 	ret = aio_queue(aioc, aio_write_worker);
 	if (ret < 0) {
 		/* The result and the errno have already been set */
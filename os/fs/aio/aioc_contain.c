@@ -57,6 +57,7 @@
 #include <tinyara/config.h>
 
 #include <sched.h>
+#include <assert.h>
 #include <errno.h>
 
 #include <tinyara/fs/fs.h>
@@ -118,11 +119,17 @@ FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp)
 #endif
 		FAR void *ptr;
 	} u;
-#ifdef CONFIG_PRIORITY_INHERITANCE
 	struct sched_param param;
-#endif
+	int prio;
 	int ret;
 
+	/* aio_reqprio may only lower the priority of the request */
+
+	if (aiocbp->aio_reqprio < 0) {
+		ret = -EINVAL;
+		goto errout;
+	}
+
 #ifdef AIO_HAVE_FILEP
 	{
 		/* Get the file structure corresponding to the file descriptor. */
@@ -148,16 +155,10 @@ FAR struct aio_container_s *aio_contain(FAR struct aiocb *aiocbp)
 	aioc->u.ptr = u.ptr;
 	aioc->aioc_pid = getpid();
 
-#ifdef CONFIG_PRIORITY_INHERITANCE
 	DEBUGVERIFY(sched_getparam(aioc->aioc_pid, &param));
-	aioc->aioc_prio = param.sched_priority;
-#endif
-
-	/* Add the container to the pending transfer list. */
+	prio = param.sched_priority - aiocbp->aio_reqprio;
+	aioc->aioc_prio = prio < SCHED_PRIORITY_MIN ? SCHED_PRIORITY_MIN : prio;
 
-	aio_lock();
-	dq_addlast(&aioc->aioc_link, &g_aio_pending);
-	aio_unlock();
 	return aioc;
 errout:
 	set_errno(-ret);
@@ -185,17 +186,11 @@ FAR struct aiocb *aioc_decant(FAR struct aio_container_s *aioc)
 
 	DEBUGASSERT(aioc);
 
-	/* Remove the container to the pending transfer list. */
-
-	aio_lock();
-	dq_rem(&aioc->aioc_link, &g_aio_pending);
-
 	/* De-cant the AIO control block and return the container to the free list */
 
 	aiocbp = aioc->aioc_aiocbp;
 	aioc_free(aioc);
 
-	aio_unlock();
 	return aiocbp;
 }
 
@@ -189,6 +189,40 @@
 
 #endif
 
+/* Sector map cache.  Entries are chained per hash bucket by index, and
+ * SMART_CACHE_NONE ends a chain.  Sectors below SMART_FIRST_ALLOC_SECTOR
+ * are never evicted, so the cache must be larger than that.
+ */
+
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+#if CONFIG_MTD_SMART_SECTOR_CACHE_SIZE <= SMART_FIRST_ALLOC_SECTOR
+#error "CONFIG_MTD_SMART_SECTOR_CACHE_SIZE must be larger than SMART_FIRST_ALLOC_SECTOR"
+#endif
+
+#define SMART_CACHE_NONE            0xFFFF
+#define SMART_CACHE_HASH(d, l)      ((l) & (d)->cache_hashmask)
+
+/* A one byte signature of the logical sector of each physical sector.
+ * Zero means the physical sector is not known to hold a logical sector.
+ */
+
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+#define SMART_SIG_NONE              0
+#define SMART_SIGNATURE(l)          ((uint8_t)((l) ^ ((l) >> 8)) == SMART_SIG_NONE ? 1 : (uint8_t)((l) ^ ((l) >> 8)))
+#define SMART_SET_SIG(d, p, l)      ((d)->sSig[p] = SMART_SIGNATURE(l))
+#define SMART_CLEAR_SIG(d, p)       ((d)->sSig[p] = SMART_SIG_NONE)
+#else
+#define SMART_SET_SIG(d, p, l)
+#define SMART_CLEAR_SIG(d, p)
+#endif
+
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+#define SMART_CACHE_STAT(d, f, n)   ((d)->f += (n))
+#else
+#define SMART_CACHE_STAT(d, f, n)
+#endif
+#endif
+
 #define SET_TO_TRUE(v, n) v[n/8] |= (1<<(7-(n%8)))
 #define GET_VAL(v, n) (v[n/8] & 1<<(7-(n%8)))
 /* Bit mapping for wear level bits */
@@ -234,7 +268,8 @@ static const uint8_t gWearBitToLevelMap4[] = {
 struct smart_cache_s {
 	uint16_t logical;			/* Logical sector number */
 	uint16_t physical;			/* Associated physical sector */
-	uint16_t birth;				/* The "birthday" of this entry */
+	uint16_t next;				/* Next entry in the same hash bucket */
+	uint8_t referenced;			/* Used since the clock hand passed */
 };
 #endif
 
@@ -299,11 +334,21 @@ struct smart_struct_s {
 	FAR uint16_t *sMap;		/* Virtual to physical sector map */
 #else
 	FAR uint8_t *sBitMap;			/* Virtual sector used bit-map */
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+	FAR uint8_t *sSig;			/* Logical sector signature per physical sector */
+#endif
 	FAR struct smart_cache_s *sCache;	/* Sector cache */
+	FAR uint16_t *cache_hash;		/* First cache entry of each hash bucket */
+	uint16_t cache_hashmask;		/* Number of hash buckets - 1 */
 	uint16_t cache_entries;			/* Number of valid entries in the cache */
+	uint16_t cache_hand;			/* Next replacement candidate */
 	uint16_t cache_lastlog;			/* Keep track of the last sector accessed */
 	uint16_t cache_lastphys;		/* Keep the physical sector number also */
-	uint16_t cache_nextbirth;		/* Sector cache aging value */
+#if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
+	uint32_t cache_hits;			/* Lookups served from the cache */
+	uint32_t cache_misses;			/* Lookups which had to read the device */
+	uint32_t cache_reads;			/* Sector headers read on misses */
+#endif
 #endif
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
 	FAR uint8_t *erasecounts;	/* Number of erases for each erase block */
@@ -468,6 +513,10 @@ static int smart_relocate_static_data(FAR struct smart_struct_s *dev, uint16_t b
 #endif
 static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t block, uint8_t forceerase);
 static int smart_relocate_sector(FAR struct smart_struct_s *dev, uint16_t oldsector, uint16_t newsector);
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev, uint16_t logical);
+static int smart_cache_readheader(FAR struct smart_struct_s *dev, uint16_t physical, FAR uint16_t *logical);
+#endif
 #ifdef CONFIG_MTD_SMART_ENABLE_CRC
 static int smart_validate_crc(FAR struct smart_struct_s *dev);
 static crc_t smart_calc_sector_crc(FAR struct smart_struct_s *dev);
@@ -531,16 +580,26 @@ static int smart_dumpsector(FAR struct smart_struct_s *dev, uint16_t sector, uin
 
 	if (command == SMART_DEBUG_CMD_DUMP_LSECTOR) {
 		lsector = sector;
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 		psector = dev->sMap[sector];
+#else
+		psector = smart_cache_lookup(dev, sector);
+#endif
 	} else {
 		psector = sector;
 		lsector = (uint16_t)-1;
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 		for (int i = 0; i < dev->totalsectors; i++) {
 			if (dev->sMap[i] == psector) {
 				lsector = i;
 				break;
 			}
 		}
+#else
+		if (psector < dev->totalsectors) {
+			(void)smart_cache_readheader(dev, psector, &lsector);
+		}
+#endif
 	}
 
 	if (psector >= dev->totalsectors) {
@@ -1066,6 +1125,9 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 	uint32_t erasesize;
 	uint32_t totalsectors;
 	uint32_t allocsize;
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+	uint32_t x;
+#endif
 
 	/* Validate the size isn't zero so we don't divide by zero below. */
 
@@ -1161,8 +1223,8 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 	}
 
 	dev->cache_entries = 0;
+	dev->cache_hand = 0;
 	dev->cache_lastlog = 0xFFFF;
-	dev->cache_nextbirth = 0;
 #endif
 
 	if (dev->rwbuffer != NULL) {
@@ -1218,13 +1280,22 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 
 	dev->releasecount = (FAR uint8_t *)dev->sMap + (totalsectors * sizeof(uint16_t));
 	dev->freecount = dev->releasecount + dev->neraseblocks;
+#else
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+	dev->sBitMap = (FAR uint8_t *)smart_malloc(dev, ((totalsectors + 7) >> 3) + totalsectors, "Sector Bitmap");
 #else
 	dev->sBitMap = (FAR uint8_t *)smart_malloc(dev, (totalsectors + 7) >> 3, "Sector Bitmap");
+#endif
 	if (dev->sBitMap == NULL) {
 		fdbg("Error allocating SMART sector cache\n");
 		goto errexit;
 	}
 
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+	dev->sSig = dev->sBitMap + ((totalsectors + 7) >> 3);
+	memset(dev->sSig, SMART_SIG_NONE, totalsectors);
+#endif
+
 	/* Calculate the alloc size of the freesector and release sector arrays. */
 
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
@@ -1240,10 +1311,15 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 	allocsize = dev->neraseblocks << 1;
 #endif
 
-	/* Allocate the sector cache. */
+	/* Allocate the sector cache with one hash bucket per entry, rounded up
+	 * to a power of two.
+	 */
+
+	for (x = 1; x < CONFIG_MTD_SMART_SECTOR_CACHE_SIZE; x <<= 1) ;
+	dev->cache_hashmask = x - 1;
 
 	if (dev->sCache == NULL) {
-		dev->sCache = (FAR struct smart_cache_s *)smart_malloc(dev, CONFIG_MTD_SMART_SECTOR_CACHE_SIZE * sizeof(struct smart_cache_s) + allocsize, "Sector Cache");
+		dev->sCache = (FAR struct smart_cache_s *)smart_malloc(dev, CONFIG_MTD_SMART_SECTOR_CACHE_SIZE * sizeof(struct smart_cache_s) + x * sizeof(uint16_t) + allocsize, "Sector Cache");
 	}
 
 	if (!dev->sCache) {
@@ -1251,7 +1327,10 @@ static int smart_setsectorsize(FAR struct smart_struct_s *dev, uint16_t size)
 		goto errexit;
 	}
 
-	dev->releasecount = (FAR uint8_t *)dev->sCache + (CONFIG_MTD_SMART_SECTOR_CACHE_SIZE * sizeof(struct smart_cache_s));
+	dev->cache_hash = (FAR uint16_t *)&dev->sCache[CONFIG_MTD_SMART_SECTOR_CACHE_SIZE];
+	memset(dev->cache_hash, 0xFF, x * sizeof(uint16_t));
+
+	dev->releasecount = (FAR uint8_t *)&dev->cache_hash[x];
 
 #ifdef CONFIG_MTD_SMART_PACK_COUNTS
 	if (dev->sectorsPerBlk > 16) {
@@ -1418,6 +1497,82 @@ static ssize_t smart_bytewrite(FAR struct smart_struct_s *dev, size_t offset, in
 	return ret;
 }
 
+/****************************************************************************
+ * Name: smart_cache_find
+ *
+ * Description: Return the index of the cache entry of a logical sector or
+ *              SMART_CACHE_NONE.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+static uint16_t smart_cache_find(FAR struct smart_struct_s *dev, uint16_t logical)
+{
+	uint16_t x;
+
+	for (x = dev->cache_hash[SMART_CACHE_HASH(dev, logical)]; x != SMART_CACHE_NONE; x = dev->sCache[x].next) {
+		if (dev->sCache[x].logical == logical) {
+			break;
+		}
+	}
+
+	return x;
+}
+
+/****************************************************************************
+ * Name: smart_cache_unlink
+ *
+ * Description: Remove a cache entry from its hash bucket.
+ *
+ ****************************************************************************/
+
+static void smart_cache_unlink(FAR struct smart_struct_s *dev, uint16_t index)
+{
+	FAR uint16_t *link;
+
+	link = &dev->cache_hash[SMART_CACHE_HASH(dev, dev->sCache[index].logical)];
+	while (*link != index) {
+		link = &dev->sCache[*link].next;
+	}
+
+	*link = dev->sCache[index].next;
+}
+
+/****************************************************************************
+ * Name: smart_cache_link
+ *
+ * Description: Add a cache entry to the head of its hash bucket.
+ *
+ ****************************************************************************/
+
+static void smart_cache_link(FAR struct smart_struct_s *dev, uint16_t index)
+{
+	FAR uint16_t *head = &dev->cache_hash[SMART_CACHE_HASH(dev, dev->sCache[index].logical)];
+
+	dev->sCache[index].next = *head;
+	*head = index;
+}
+
+/****************************************************************************
+ * Name: smart_cache_reset
+ *
+ * Description: Forget all cached mappings and sector signatures, when the
+ *              map is rebuilt by a scan or a format.
+ *
+ ****************************************************************************/
+
+static void smart_cache_reset(FAR struct smart_struct_s *dev)
+{
+	dev->cache_entries = 0;
+	dev->cache_hand = 0;
+	dev->cache_lastlog = 0xFFFF;
+	memset(dev->cache_hash, 0xFF, (dev->cache_hashmask + 1) * sizeof(uint16_t));
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+	memset(dev->sSig, SMART_SIG_NONE, dev->totalsectors);
+#endif
+}
+#endif
+
 /****************************************************************************
  * Name: smart_add_sector_to_cache
  *
@@ -1425,65 +1580,119 @@ static ssize_t smart_bytewrite(FAR struct smart_struct_s *dev, size_t offset, in
  *              map cache.  The cache is used to minimize RAM by eliminating
  *              a one-to-one mapping of all logical sectors and only keeping
  *              a fixed number of mappings per the
- *              CONFIG_MTD_SMART_SECTOR_CACHE_SIZE parameter.  Sectors are
- *              automatically managed and removed based on the time since
- *              they were accessed last.
+ *              CONFIG_MTD_SMART_SECTOR_CACHE_SIZE parameter.  When the cache
+ *              is full an entry is replaced with the CLOCK algorithm: the
+ *              hand skips and clears entries used since it last passed them
+ *              and replaces the first one which was not.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
 static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev, uint16_t logical, uint16_t physical, int line)
 {
-	uint16_t index, x;
-	uint16_t oldest;
+	uint16_t index;
+
+	SMART_SET_SIG(dev, physical, logical);
 
-	/* If we aren't full yet, just add the sector to the end of the list. */
+	index = smart_cache_find(dev, logical);
+	if (index != SMART_CACHE_NONE) {
+		/* Already cached, e.g. a duplicate found by the scan. */
 
-	index = 1;
-	if (dev->cache_entries < CONFIG_MTD_SMART_SECTOR_CACHE_SIZE) {
-		index = dev->cache_entries++;
+		dev->sCache[index].physical = physical;
 	} else {
-		/* Cache is full.  We must find the least accessed entry and replace it. */
+		/* If we aren't full yet, just add the sector to the end of the list. */
 
-		oldest = 0xFFFF;
-		for (x = 0; x < CONFIG_MTD_SMART_SECTOR_CACHE_SIZE; x++) {
-			/* Never replace cache entries for system sectors. */
+		if (dev->cache_entries < CONFIG_MTD_SMART_SECTOR_CACHE_SIZE) {
+			index = dev->cache_entries++;
+		} else {
+			/* Cache is full.  Never replace cache entries for system
+			 * sectors, so this ends within two turns of the hand.
+			 */
 
-			if (dev->sCache[x].logical < SMART_FIRST_ALLOC_SECTOR) {
-				continue;
-			}
+			for (;;) {
+				index = dev->cache_hand;
+				if (++dev->cache_hand >= dev->cache_entries) {
+					dev->cache_hand = 0;
+				}
+
+				if (dev->sCache[index].logical < SMART_FIRST_ALLOC_SECTOR) {
+					continue;
+				}
 
-			/* If the hit count is zero, then choose this entry. */
+				if (!dev->sCache[index].referenced) {
+					break;
+				}
 
-			if (dev->sCache[x].birth < oldest) {
-				oldest = dev->sCache[x].birth;
-				index = x;
+				dev->sCache[index].referenced = 0;
 			}
+
+			smart_cache_unlink(dev, index);
 		}
-	}
 
-	/* Now add the sector at index. */
+		/* Now add the sector at index. */
 
-	dev->sCache[index].logical = logical;
-	dev->sCache[index].physical = physical;
-	dev->sCache[index].birth = dev->cache_nextbirth++;
+		dev->sCache[index].logical = logical;
+		dev->sCache[index].physical = physical;
+		smart_cache_link(dev, index);
+	}
+
+	dev->sCache[index].referenced = 1;
 	dev->cache_lastlog = logical;
 	dev->cache_lastphys = physical;
 	if (dev->debuglevel > 1) {
 		dbg("Add Cache sector:  Log=%d, Phys=%d at index %d from line %d\n", logical, physical, index, line);
 	}
 
-	/* Test if the birthdays need to be adjusted. */
+	return index;
+}
+#endif
 
-	if (oldest >= CONFIG_MTD_SMART_SECTOR_CACHE_SIZE + 1024) {
-		for (x = 0; x < dev->cache_entries; x++) {
-			dev->sCache[x].birth -= 1024;
-		}
+/****************************************************************************
+ * Name: smart_cache_readheader
+ *
+ * Description: Read the header of a physical sector and return the logical
+ *              sector it holds, or 0xFFFF if it holds none.  Used to find
+ *              sectors which are not in the cache.
+ *
+ ****************************************************************************/
 
-		dev->cache_nextbirth -= 1024;
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+static int smart_cache_readheader(FAR struct smart_struct_s *dev, uint16_t physical, FAR uint16_t *logical)
+{
+	struct smart_sect_header_s header;
+	size_t readaddress;
+	int ret;
+
+	SMART_CACHE_STAT(dev, cache_reads, 1);
+
+	readaddress = (physical / dev->sectorsPerBlk) * dev->erasesize + (physical % dev->sectorsPerBlk) * CONFIG_MTD_SMART_SECTOR_SIZE;
+	ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
+	if (ret != sizeof(struct smart_sect_header_s)) {
+		return -EIO;
 	}
 
-	return index;
+	*logical = 0xFFFF;
+
+	/* Get the logical sector number for this physical sector. */
+
+#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
+	if (*((FAR uint16_t *)header.logicalsector) == 0) {
+		return OK;
+	}
+#endif
+
+	/* Skip sectors which are not committed or were released. */
+
+	if (!(SECTOR_IS_COMMITTED(header)) || SECTOR_IS_RELEASED(header)) {
+		return OK;
+	}
+
+	if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION) {
+		return OK;
+	}
+
+	*logical = *((FAR uint16_t *)header.logicalsector);
+	return OK;
 }
 #endif
 
@@ -1491,110 +1700,119 @@ static int smart_add_sector_to_cache(FAR struct smart_struct_s *dev, uint16_t lo
  * Name: smart_cache_lookup
  *
  * Description: Perform a cache lookup for the requested logical sector.
- *              If the sector is in the cache, then update the hitcount and
+ *              If the sector is in the cache, then mark it referenced and
  *              return the physical mapping.  If a cache miss occurs, then
  *              the routine will scan the volume to find the logical sector
  *              and add / replace a cache entry with the newly located sector.
+ *              With CONFIG_MTD_SMART_SECTOR_SIGNATURES only the physical
+ *              sectors with a matching signature are read first.
  *
  ****************************************************************************/
 
 #ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
 static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev, uint16_t logical)
 {
-	int ret;
 	uint16_t block, sector;
 	uint16_t x, physical, logicalsector;
-	struct smart_sect_header_s header;
-	size_t readaddress;
-
-	physical = 0xFFFF;
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+	FAR uint8_t *sig;
+	FAR uint8_t *end;
+#endif
 
 	/* Test if searching for the last sector used. */
 
 	if (logical == dev->cache_lastlog) {
+		SMART_CACHE_STAT(dev, cache_hits, 1);
 		return dev->cache_lastphys;
 	}
 
 	/* First search for the entry in the cache. */
 
-	for (x = 0; x < dev->cache_entries; x++) {
-		if (dev->sCache[x].logical == logical) {
-			/* Entry found in the cache.  Grab the physical mapping. */
+	x = smart_cache_find(dev, logical);
+	if (x != SMART_CACHE_NONE) {
+		/* Entry found in the cache.  Grab the physical mapping. */
 
-			physical = dev->sCache[x].physical;
-			break;
-		}
+		SMART_CACHE_STAT(dev, cache_hits, 1);
+		dev->sCache[x].referenced = 1;
+		dev->cache_lastlog = logical;
+		dev->cache_lastphys = dev->sCache[x].physical;
+		return dev->cache_lastphys;
 	}
 
 	/* If the entry wasn't found in the cache, then we must search the volume
 	 * for it and add it to the cache.
 	 */
 
-	if (physical == 0xFFFF) {
-		/* Now scan the MTD device.  Instead of scanning start to end, we
-		 * span the erase blocks and read one sector from each at a time.
-		 * this helps speed up the search on volumes that aren't full
-		 * because sector allocation scheme will use the lower sector
-		 * numbers in each erase block first.
-		 */
-
-		for (sector = 0; sector < dev->sectorsPerBlk && physical == 0xFFFF; sector++) {
-			/* Now scan across each erase block. */
+	SMART_CACHE_STAT(dev, cache_misses, 1);
+	physical = 0xFFFF;
 
-			for (block = 0; block < dev->neraseblocks; block++) {
-				/* Calculate the read address for this sector. */
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+	/* Only read the sectors whose signature matches.  Signatures of sectors
+	 * which turn out to hold something else are corrected on the way.
+	 */
 
-				readaddress = block * dev->erasesize + sector * CONFIG_MTD_SMART_SECTOR_SIZE;
+	sig = dev->sSig;
+	end = dev->sSig + dev->totalsectors;
+	while (sig < end && (sig = memchr(sig, SMART_SIGNATURE(logical), end - sig)) != NULL) {
+		sector = sig - dev->sSig;
+		sig++;
 
-				/* Read the header for this sector. */
+		if (smart_cache_readheader(dev, sector, &logicalsector) != OK) {
+			return physical;
+		}
 
-				ret = MTD_READ(dev->mtd, readaddress, sizeof(struct smart_sect_header_s), (FAR uint8_t *)&header);
-				if (ret != sizeof(struct smart_sect_header_s)) {
-					return physical;
-				}
+		if (logicalsector == logical) {
+			physical = sector;
+			break;
+		}
 
-				/* Get the logical sector number for this physical sector. */
+		if (logicalsector == 0xFFFF) {
+			SMART_CLEAR_SIG(dev, sector);
+		} else {
+			SMART_SET_SIG(dev, sector, logicalsector);
+		}
+	}
 
-				logicalsector = *((FAR uint16_t *)header.logicalsector);
-#if CONFIG_SMARTFS_ERASEDSTATE == 0x00
-				if (logicalsector == 0) {
-					continue;
-				}
+	/* The signatures should be complete; the full scan below only runs if
+	 * some path updated the device without updating them.
+	 */
 #endif
 
-				/* Test if this sector has been committed. */
-
-				if (!(SECTOR_IS_COMMITTED(header))) {
-					continue;
-				}
-
-				/* Test if this sector has been release and skip it if it has. */
-
-				if (SECOR_IS_RELEASED(header)) {
-					continue;
-				}
+	/* Now scan the MTD device.  Instead of scanning start to end, we
+	 * span the erase blocks and read one sector from each at a time.
+	 * this helps speed up the search on volumes that aren't full
+	 * because sector allocation scheme will use the lower sector
+	 * numbers in each erase block first.
+	 */
 
-				if ((header.status & SMART_STATUS_VERBITS) != SMART_STATUS_VERSION) {
-					continue;
-				}
+	for (sector = 0; sector < dev->sectorsPerBlk && physical == 0xFFFF; sector++) {
+		/* Now scan across each erase block. */
 
-				/* Test if this is the sector we are looking for. */
+		for (block = 0; block < dev->neraseblocks; block++) {
+			x = block * dev->sectorsPerBlk + sector;
+			if (smart_cache_readheader(dev, x, &logicalsector) != OK) {
+				return physical;
+			}
 
-				if (logicalsector == logical) {
-					/* This is the sector we are looking for!  Add it to the cache. */
+			/* Test if this is the sector we are looking for. */
 
-					physical = block * dev->sectorsPerBlk + sector;
-					smart_add_sector_to_cache(dev, logical, physical, __LINE__);
-					break;
-				}
+			if (logicalsector == logical) {
+				physical = x;
+				break;
 			}
 		}
 	}
 
-	/* Update the last logical sector found variable. */
+	if (physical != 0xFFFF) {
+		/* This is the sector we are looking for!  Add it to the cache. */
 
-	dev->cache_lastlog = logical;
-	dev->cache_lastphys = physical;
+		smart_add_sector_to_cache(dev, logical, physical, __LINE__);
+	} else {
+		/* Update the last logical sector found variable. */
+
+		dev->cache_lastlog = logical;
+		dev->cache_lastphys = physical;
+	}
 
 	return physical;
 }
@@ -1605,7 +1823,7 @@ static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev, uint16_t logi
  *
  * Description: Update a cache entry (if present) replacing the logical
  *              sector's physical sector mapping with the new one provided.
- *              This does not affect the hit count.
+ *              This does not mark the entry referenced.
  *
  ****************************************************************************/
 
@@ -1613,30 +1831,41 @@ static uint16_t smart_cache_lookup(FAR struct smart_struct_s *dev, uint16_t logi
 static void smart_update_cache(FAR struct smart_struct_s *dev, uint16_t logical, uint16_t physical)
 {
 	uint16_t x;
+	uint16_t last;
 
-	/* Scan through all cache entries and find the logical sector entry */
+	if (physical != 0xFFFF) {
+		SMART_SET_SIG(dev, physical, logical);
+	}
 
-	for (x = 0; x < dev->cache_entries; x++) {
-		if (dev->sCache[x].logical == logical) {
-			/* Entry found.  Update it's physical mapping. */
+	/* Find the logical sector entry */
 
-			dev->sCache[x].physical = physical;
+	x = smart_cache_find(dev, logical);
+	if (x != SMART_CACHE_NONE) {
+		/* Entry found.  Update it's physical mapping. */
 
-			/* If we are freeing a sector, then remove the logical entry from
-			   the cache.
+		if (physical == 0xFFFF) {
+			/* We are freeing a sector: remove the logical entry from the
+			 * cache and move the last entry into its place.
 			 */
 
-			if (physical == 0xFFFF) {
-				dev->sCache[x].logical = dev->sCache[dev->cache_entries - 1].logical;
-				dev->sCache[x].physical = dev->sCache[dev->cache_entries - 1].physical;
-				dev->cache_entries--;
+			SMART_CLEAR_SIG(dev, dev->sCache[x].physical);
+			smart_cache_unlink(dev, x);
+			last = --dev->cache_entries;
+			if (x != last) {
+				smart_cache_unlink(dev, last);
+				dev->sCache[x] = dev->sCache[last];
+				smart_cache_link(dev, x);
 			}
 
-			if (dev->debuglevel > 1) {
-				dbg("Update Cache:  Log=%d, Phys=%d at index %d\n", logical, physical, x);
+			if (dev->cache_hand >= dev->cache_entries) {
+				dev->cache_hand = 0;
 			}
+		} else {
+			dev->sCache[x].physical = physical;
+		}
 
-			break;
+		if (dev->debuglevel > 1) {
+			dbg("Update Cache:  Log=%d, Phys=%d at index %d\n", logical, physical, x);
 		}
 	}
 
@@ -1899,6 +2128,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 	/* Clear all logical sector used bits. */
 
 	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
+	smart_cache_reset(dev);
 #endif
 
 	/* Now scan the MTD device. */
@@ -2087,6 +2317,14 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 			 */
 
 			for (dupsector = 0; dupsector < sector; dupsector++) {
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+				/* Sectors scanned so far have their signatures set */
+
+				if (dev->sSig[dupsector] != SMART_SIGNATURE(logicalsector)) {
+					continue;
+				}
+#endif
+
 				/* Calculate the read address for this sector. */
 
 				readaddress = dupsector * dev->mtdBlksPerSector * dev->geo.blocksize;
@@ -2225,6 +2463,9 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 				fdbg("Error %d releasing duplicate sector\n", -ret);
 				goto err_out;
 			}
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+			SMART_CLEAR_SIG(dev, loser);
+#endif
 		}
 #ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 		/* Update the logical to physical sector map. */
@@ -2233,6 +2474,7 @@ static int smart_scan(FAR struct smart_struct_s *dev)
 #else
 		/* Mark the logical sector as used in the bitmap */
 		dev->sBitMap[logicalsector >> 3] |= 1 << (logicalsector & 0x07);
+		SMART_SET_SIG(dev, winner, logicalsector);
 
 		if (logicalsector < SMART_FIRST_ALLOC_SECTOR) {
 			smart_add_sector_to_cache(dev, logicalsector, winner, __LINE__);
@@ -2439,6 +2681,9 @@ static void smart_erase_block_if_empty(FAR struct smart_struct_s *dev, uint16_t
 			dev->freecount[block] = 0;
 			return;
 		}
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+		memset(&dev->sSig[block * dev->sectorsPerBlk], SMART_SIG_NONE, dev->sectorsPerBlk);
+#endif
 
 
 #ifdef CONFIG_MTD_SMART_SECTOR_ERASE_DEBUG
@@ -2968,6 +3213,11 @@ static inline int smart_llformat(FAR struct smart_struct_s *dev, unsigned long a
 
 		dev->sMap[x] = -1;
 	}
+#else
+	memset(dev->sBitMap, 0, (dev->totalsectors + 7) >> 3);
+	smart_cache_reset(dev);
+	dev->sBitMap[0] = 1;
+	smart_add_sector_to_cache(dev, 0, 0, __LINE__);
 #endif
 
 #ifdef CONFIG_SMARTFS_MULTI_ROOT_DIRS
@@ -3284,6 +3534,9 @@ static int smart_relocate_block(FAR struct smart_struct_s *dev, uint16_t block)
 		dev->freecount[block] = 0;
 		return ret;
 	}
+#ifdef CONFIG_MTD_SMART_SECTOR_SIGNATURES
+	memset(&dev->sSig[block * dev->sectorsPerBlk], SMART_SIG_NONE, dev->sectorsPerBlk);
+#endif
 #if defined(CONFIG_FS_PROCFS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_SMARTFS)
 	dev->unusedsectors += freecount;
 	dev->blockerases++;
@@ -4899,7 +5152,11 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 		sleep(1);
 		goto ok_out;
 	case BIOC_CORRUPTION :
+#ifndef CONFIG_MTD_SMART_MINIMIZE_RAM
 		sector = dev->sMap[SMART_FIRST_DIR_SECTOR];
+#else
+		sector = smart_cache_lookup(dev, SMART_FIRST_DIR_SECTOR);
+#endif
 		header = (FAR struct smart_sect_header_s *)dev->rwbuffer;
 		ret = MTD_BREAD(dev->mtd, sector * dev->mtdBlksPerSector, dev->mtdBlksPerSector, (FAR uint8_t *)dev->rwbuffer);
 		if (ret != dev->mtdBlksPerSector) {
@@ -4968,6 +5225,11 @@ static int smart_ioctl(FAR struct inode *inode, int cmd, unsigned long arg)
 #endif
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 		procfs_data->uneven_wearcount = dev->uneven_wearcount;
+#endif
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+		procfs_data->cachehits = dev->cache_hits;
+		procfs_data->cachemisses = dev->cache_misses;
+		procfs_data->cachereads = dev->cache_reads;
 #endif
 		ret = OK;
 		goto ok_out;
@@ -65,6 +65,10 @@
 #include "aio/aio.h"
 #endif
 
+#ifdef CONFIG_FS_RAMMAP
+#include "mmap/fs_rammap.h"
+#endif
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -141,6 +145,12 @@ void fs_initialize(void)
 
 #endif
 
+#ifdef CONFIG_FS_RAMMAP
+	/* Initialize the list of files mapped by reading */
+
+	rammap_initialize();
+#endif
+
 #if !defined(CONFIG_DISABLE_PSEUDOFS_OPERATIONS) && \
 	!defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_BCH)
 	/* Initialize for unique character device used in  */
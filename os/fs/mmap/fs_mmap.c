@@ -0,0 +1,180 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/sched.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+
+#include "fs_rammap.h"
+
+#if CONFIG_NFILE_DESCRIPTORS > 0
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmap_accessible
+ *
+ * Description:
+ *   Return true if the caller may read the file data at addr returned by
+ *   FIOC_MMAP.  In the protected build, a user task cannot read the kernel
+ *   heap, where tmpfs keeps its files, nor the kernel sections.
+ *
+ ****************************************************************************/
+
+static bool mmap_accessible(FAR void *addr)
+{
+#ifdef CONFIG_BUILD_PROTECTED
+	FAR struct tcb_s *rtcb = sched_self();
+
+	if ((rtcb->flags & TCB_FLAG_TTYPE_MASK) == TCB_FLAG_TTYPE_KERNEL) {
+		return true;
+	}
+
+#ifdef CONFIG_MM_KERNEL_HEAP
+	if (kmm_heapmember(addr)) {
+		return false;
+	}
+#endif
+
+	return !is_kernel_space(addr);
+#else
+	return true;
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mmap
+ *
+ * Description:
+ *   Maps length bytes of the file fd, starting at offset, into memory.
+ *   Only read-only mappings are supported, and the address of the mapping
+ *   is chosen by the file system:
+ *
+ *   - A file system which keeps the file contiguous in addressable memory
+ *     returns its address with the FIOC_MMAP ioctl.  romfs does so on an
+ *     XIP device, where the mapping points into the flash, and tmpfs does
+ *     so with the file data in RAM.  If the caller can read that memory,
+ *     nothing is copied, and the mapping stays valid until the file is
+ *     written, truncated or removed.  In the protected build, a user task
+ *     cannot read the kernel heap of tmpfs.
+ *   - Otherwise, if CONFIG_FS_RAMMAP is enabled, the region is read into a
+ *     buffer which has to be released with munmap().
+ *
+ * Input Parameters:
+ *   start  - A hint of the address of the mapping.  It is ignored.
+ *   length - The length of the mapping.
+ *   prot   - PROT_READ, optionally with PROT_EXEC.  PROT_WRITE is not
+ *            supported.
+ *   flags  - MAP_SHARED or MAP_PRIVATE.  MAP_FIXED and MAP_ANONYMOUS are
+ *            not supported.
+ *   fd     - The file descriptor of an open file.
+ *   offset - The offset of the mapping in the file.
+ *
+ * Returned Value:
+ *   The address of the mapping on success.  Otherwise MAP_FAILED is
+ *   returned and the errno is set:
+ *
+ *   EBADF  - fd is not a valid file descriptor.
+ *   EINVAL - length is zero or offset is negative.
+ *   ENXIO  - The region is beyond the end of a regular file.
+ *   ENOSYS - prot or flags ask for an unsupported mapping.
+ *   ENODEV - The file system cannot map the file and CONFIG_FS_RAMMAP is
+ *            not enabled.
+ *   ENOMEM - No memory for the buffer of the mapping.
+ *
+ ****************************************************************************/
+
+FAR void *mmap(FAR void *start, size_t length, int prot, int flags, int fd, off_t offset)
+{
+	FAR struct file *filep;
+	FAR uint8_t *addr;
+	struct stat buf;
+	int errcode;
+	int ret;
+
+	if (length == 0 || offset < 0) {
+		errcode = EINVAL;
+		goto errout;
+	}
+
+	if ((prot & PROT_WRITE) != 0 || (prot & (PROT_READ | PROT_EXEC)) == 0 || (flags & (MAP_FIXED | MAP_ANONYMOUS)) != 0) {
+		fdbg("Unsupported mapping: prot=%x flags=%04x\n", prot, flags);
+		errcode = ENOSYS;
+		goto errout;
+	}
+
+	ret = fs_getfilep(fd, &filep);
+	if (ret < 0) {
+		errcode = -ret;
+		goto errout;
+	}
+
+	/* The region must lie within a regular file.  Files of other types may
+	 * have no size, their reads decide how much is mapped.
+	 */
+
+	if (fstat(fd, &buf) == OK && S_ISREG(buf.st_mode) && (offset > buf.st_size || length > buf.st_size - offset)) {
+		fdbg("Region %u bytes at %d is beyond the size %d\n", length, offset, buf.st_size);
+		errcode = ENXIO;
+		goto errout;
+	}
+
+	/* Ask the file system for the address of the file data */
+
+	ret = file_ioctl(filep, FIOC_MMAP, (unsigned long)((uintptr_t)&addr));
+	if (ret >= 0 && mmap_accessible(addr)) {
+		return addr + offset;
+	}
+
+#ifdef CONFIG_FS_RAMMAP
+	/* Read the region into memory instead */
+
+	return rammap(filep, length, offset);
+#else
+	fdbg("The file system cannot map fd %d: %d\n", fd, ret);
+	errcode = ENODEV;
+#endif
+
+errout:
+	set_errno(errcode);
+	return MAP_FAILED;
+}
+
+#endif							/* CONFIG_NFILE_DESCRIPTORS > 0 */
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <stdint.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+
+#include "fs_rammap.h"
+
+#ifdef CONFIG_FS_RAMMAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: munmap
+ *
+ * Description:
+ *   Releases a mapping made by mmap().  A region read into memory is freed
+ *   when it is unmapped from its start, and shortened when only its end is
+ *   unmapped.  A mapping returned directly by the file system holds no
+ *   resource, so unmapping it does nothing.
+ *
+ * Input Parameters:
+ *   start  - The address of the region to unmap.
+ *   length - The length of the region to unmap.
+ *
+ * Returned Value:
+ *   Zero (OK) on success.  Otherwise ERROR is returned and the errno is
+ *   set:
+ *
+ *   EINVAL - length is zero, or the region is within a mapping read into
+ *            memory but does not end at its end.
+ *
+ ****************************************************************************/
+
+int munmap(FAR void *start, size_t length)
+{
+	FAR struct fs_rammap_s *prev;
+	FAR struct fs_rammap_s *curr;
+	FAR uint8_t *addr = (FAR uint8_t *)start;
+	FAR uint8_t *end;
+	int errcode;
+
+	if (length == 0) {
+		errcode = EINVAL;
+		goto errout;
+	}
+
+	while (sem_wait(&g_rammaps.exclsem) != 0) {
+		ASSERT(get_errno() == EINTR);
+	}
+
+	for (prev = NULL, curr = g_rammaps.head; curr != NULL; prev = curr, curr = curr->flink) {
+		end = (FAR uint8_t *)curr->addr + curr->length;
+		if (addr >= (FAR uint8_t *)curr->addr && addr < end) {
+			break;
+		}
+	}
+
+	if (curr == NULL) {
+		/* Not read into memory, the file system mapped it directly */
+
+		sem_post(&g_rammaps.exclsem);
+		return OK;
+	}
+
+	if (addr + length < end) {
+		fdbg("Cannot unmap the middle of a mapping\n");
+		sem_post(&g_rammaps.exclsem);
+		errcode = EINVAL;
+		goto errout;
+	}
+
+	if (addr == (FAR uint8_t *)curr->addr) {
+		if (prev == NULL) {
+			g_rammaps.head = curr->flink;
+		} else {
+			prev->flink = curr->flink;
+		}
+
+		kumm_free(curr);
+	} else {
+		/* Only the end is unmapped.  The buffer is freed when the rest of
+		 * the mapping is unmapped.
+		 */
+
+		curr->length = addr - (FAR uint8_t *)curr->addr;
+	}
+
+	sem_post(&g_rammaps.exclsem);
+	return OK;
+
+errout:
+	set_errno(errcode);
+	return ERROR;
+}
+
+#endif							/* CONFIG_FS_RAMMAP */
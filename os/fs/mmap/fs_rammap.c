@@ -0,0 +1,148 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+
+#include "fs_rammap.h"
+
+#ifdef CONFIG_FS_RAMMAP
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+/* The list of every region mapped by reading */
+
+struct fs_allmaps_s g_rammaps;
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rammap_initialize
+ *
+ * Description:
+ *   Initializes the list of mapped regions.  Called once by fs_initialize().
+ *
+ ****************************************************************************/
+
+void rammap_initialize(void)
+{
+	g_rammaps.head = NULL;
+	(void)sem_init(&g_rammaps.exclsem, 0, 1);
+}
+
+/****************************************************************************
+ * Name: rammap
+ *
+ * Description:
+ *   Maps length bytes of the file at offset by reading them into a buffer
+ *   of the user heap.  The file position is not changed.  Bytes past the
+ *   end of the file read as zero.
+ *
+ ****************************************************************************/
+
+FAR void *rammap(FAR struct file *filep, size_t length, off_t offset)
+{
+	FAR struct fs_rammap_s *map;
+	FAR uint8_t *rdbuffer;
+	size_t remaining;
+	ssize_t nread;
+	off_t fpos;
+	int errcode;
+
+	/* The buffer has to be accessible to the caller, so it is allocated from
+	 * the user heap.
+	 */
+
+	map = (FAR struct fs_rammap_s *)kumm_malloc(sizeof(struct fs_rammap_s) + length);
+	if (map == NULL) {
+		fdbg("Failed to allocate %d bytes\n", (int)length);
+		errcode = ENOMEM;
+		goto errout;
+	}
+
+	map->addr = (FAR uint8_t *)map + sizeof(struct fs_rammap_s);
+	map->length = length;
+	map->offset = offset;
+
+	fpos = file_seek(filep, 0, SEEK_CUR);
+	if (fpos < 0 || file_seek(filep, offset, SEEK_SET) < 0) {
+		/* file_seek() has set the errno */
+
+		kumm_free(map);
+		return MAP_FAILED;
+	}
+
+	rdbuffer = (FAR uint8_t *)map->addr;
+	remaining = length;
+	while (remaining > 0) {
+		nread = file_read(filep, rdbuffer, remaining);
+		if (nread < 0) {
+			fdbg("Read failed: offset=%d errno=%d\n", (int)offset, (int)-nread);
+			(void)file_seek(filep, fpos, SEEK_SET);
+			kumm_free(map);
+			errcode = -nread;
+			goto errout;
+		}
+
+		if (nread == 0) {
+			memset(rdbuffer, 0, remaining);
+			break;
+		}
+
+		rdbuffer += nread;
+		remaining -= nread;
+	}
+
+	(void)file_seek(filep, fpos, SEEK_SET);
+
+	while (sem_wait(&g_rammaps.exclsem) != 0) {
+		ASSERT(get_errno() == EINTR);
+	}
+
+	map->flink = g_rammaps.head;
+	g_rammaps.head = map;
+
+	sem_post(&g_rammaps.exclsem);
+	return map->addr;
+
+errout:
+	set_errno(errcode);
+	return MAP_FAILED;
+}
+
+#endif							/* CONFIG_FS_RAMMAP */
@@ -0,0 +1,90 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#ifndef __FS_MMAP_FS_RAMMAP_H
+#define __FS_MMAP_FS_RAMMAP_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <semaphore.h>
+
+#include <tinyara/fs/fs.h>
+
+#ifdef CONFIG_FS_RAMMAP
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+/* This structure describes one file region which was read into memory by
+ * mmap().  The data follows the structure in the same allocation.
+ */
+
+struct fs_rammap_s {
+	FAR struct fs_rammap_s *flink;	/* Implements a singly linked list */
+	FAR void *addr;					/* Start of the mapped data */
+	size_t length;					/* Length of the mapped data */
+	off_t offset;					/* Offset of the data in the file */
+};
+
+/* This structure holds every region mapped by reading. */
+
+struct fs_allmaps_s {
+	sem_t exclsem;					/* Provides exclusive access to the list */
+	FAR struct fs_rammap_s *head;	/* The list of mapped regions */
+};
+
+/****************************************************************************
+ * Public Data
+ ****************************************************************************/
+
+extern struct fs_allmaps_s g_rammaps;
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: rammap_initialize
+ *
+ * Description:
+ *   Initializes the list of mapped regions.  Called once by fs_initialize().
+ *
+ ****************************************************************************/
+
+void rammap_initialize(void);
+
+/****************************************************************************
+ * Name: rammap
+ *
+ * Description:
+ *   Maps length bytes of the file at offset by reading them into a buffer
+ *   of the user heap.  Returns the address of the buffer, or MAP_FAILED
+ *   with the errno set.
+ *
+ ****************************************************************************/
+
+FAR void *rammap(FAR struct file *filep, size_t length, off_t offset);
+
+#endif							/* CONFIG_FS_RAMMAP */
+#endif							/* __FS_MMAP_FS_RAMMAP_H */
@@ -473,6 +473,9 @@ static ssize_t proc_entry_stat(FAR struct proc_file_s *procfile, FAR struct tcb_
 static ssize_t proc_entry_status(FAR struct proc_file_s *procfile, FAR struct tcb_s *tcb, FAR char *buffer, size_t buflen, off_t offset)
 {
 	FAR const char *name;
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	struct cpuload_s cpuload;
+#endif
 	size_t remaining;
 	size_t linesize;
 	size_t copysize;
@@ -563,6 +566,23 @@ static ssize_t proc_entry_status(FAR struct proc_file_s *procfile, FAR struct tc
 	copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
 
 	totalsize += copysize;
+	buffer += copysize;
+	remaining -= copysize;
+
+	if (totalsize >= buflen) {
+		return totalsize;
+	}
+#endif
+
+	/* Show the time spent on the thread in seconds */
+
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	if (clock_cpuload(procfile->pid, 0, &cpuload) == OK) {
+		linesize = snprintf(procfile->line, STATUS_LINELEN, "\n%-12s%u.%06u", "RunTime:", (unsigned int)(cpuload.runtime / 1000000), (unsigned int)(cpuload.runtime % 1000000));
+		copysize = procfs_memcpy(procfile->line, linesize, buffer, remaining, &offset);
+
+		totalsize += copysize;
+	}
 #endif
 	return totalsize;
 }
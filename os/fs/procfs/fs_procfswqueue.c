@@ -0,0 +1,309 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/statfs.h>
+#include <sys/stat.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/wqueue.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/procfs.h>
+
+#if !defined(CONFIG_DISABLE_MOUNTPOINT) && defined(CONFIG_FS_PROCFS)
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && !defined(CONFIG_FS_PROCFS_EXCLUDE_WQUEUE)
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+/* Determines the size of an intermediate buffer that must be large enough
+ * to hold the header line and one line per kernel work queue.
+ */
+
+#define WQUEUE_BUFSIZE 256
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure describes one open "file" */
+
+struct wqueue_file_s {
+	struct procfs_file_s base;	/* Base open file structure */
+	unsigned int linesize;		/* Number of valid characters in line[] */
+	char line[WQUEUE_BUFSIZE];	/* Pre-allocated buffer for formatted lines */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+/* File system methods */
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode);
+static int wqueue_close(FAR struct file *filep);
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer, size_t buflen);
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp);
+
+static int wqueue_stat(FAR const char *relpath, FAR struct stat *buf);
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* See fs_mount.c -- this structure is explicitly externed there.
+ * We use the old-fashioned kind of initializers so that this will compile
+ * with any compiler.
+ */
+
+const struct procfs_operations wqueue_operations = {
+	wqueue_open,				/* open */
+	wqueue_close,				/* close */
+	wqueue_read,				/* read */
+	NULL,						/* write */
+
+	wqueue_dup,					/* dup */
+
+	NULL,						/* opendir */
+	NULL,						/* closedir */
+	NULL,						/* readdir */
+	NULL,						/* rewinddir */
+
+	wqueue_stat					/* stat */
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wqueue_line
+ *
+ * Description:
+ *   Format the statistics of one work queue.  Times are in microseconds.
+ *
+ ****************************************************************************/
+
+static size_t wqueue_line(FAR char *line, size_t size, FAR const char *name, int qid)
+{
+	struct work_stats_s stats;
+	uint32_t latency_avg = 0;
+	uint32_t runtime_avg = 0;
+
+	if (work_getstats(qid, &stats) < 0) {
+		return 0;
+	}
+
+	if (stats.nrun > 0) {
+		latency_avg = (uint32_t)(stats.latency_total / stats.nrun);
+		runtime_avg = (uint32_t)(stats.runtime_total / stats.nrun);
+	}
+
+	return snprintf(line, size, "%-7s %10u %8u %8u %8u %8u  %p\n", name, stats.nrun,
+					latency_avg, stats.latency_max, runtime_avg, stats.runtime_max,
+					stats.runtime_maxworker);
+}
+
+/****************************************************************************
+ * Name: wqueue_open
+ ****************************************************************************/
+
+static int wqueue_open(FAR struct file *filep, FAR const char *relpath, int oflags, mode_t mode)
+{
+	FAR struct wqueue_file_s *attr;
+
+	fvdbg("Open '%s'\n", relpath);
+
+	/* PROCFS is read-only.  Any attempt to open with any kind of write
+	 * access is not permitted.
+	 */
+
+	if ((oflags & O_WRONLY) != 0 || (oflags & O_RDONLY) == 0) {
+		fdbg("ERROR: Only O_RDONLY supported\n");
+		return -EACCES;
+	}
+
+	/* "wqueue" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "wqueue") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* Allocate a container to hold the file attributes */
+
+	attr = (FAR struct wqueue_file_s *)kmm_zalloc(sizeof(struct wqueue_file_s));
+	if (!attr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* Save the attributes as the open-specific state in filep->f_priv */
+
+	filep->f_priv = (FAR void *)attr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_close
+ ****************************************************************************/
+
+static int wqueue_close(FAR struct file *filep)
+{
+	FAR struct wqueue_file_s *attr;
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct wqueue_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Release the file attributes structure */
+
+	kmm_free(attr);
+	filep->f_priv = NULL;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_read
+ ****************************************************************************/
+
+static ssize_t wqueue_read(FAR struct file *filep, FAR char *buffer, size_t buflen)
+{
+	FAR struct wqueue_file_s *attr;
+	size_t linesize;
+	off_t offset;
+	ssize_t ret;
+
+	fvdbg("buffer=%p buflen=%d\n", buffer, (int)buflen);
+
+	/* Recover our private data from the struct file instance */
+
+	attr = (FAR struct wqueue_file_s *)filep->f_priv;
+	DEBUGASSERT(attr);
+
+	/* Take a snapshot of the statistics when f_pos is zero, so that they
+	 * remain stable when read in several parts.
+	 */
+
+	if (filep->f_pos == 0) {
+		linesize = snprintf(attr->line, WQUEUE_BUFSIZE, "%-7s %10s %8s %8s %8s %8s  %s\n",
+							"QUEUE", "RUN", "LAT_AVG", "LAT_MAX", "RUN_AVG", "RUN_MAX", "MAXWORKER");
+#ifdef CONFIG_SCHED_HPWORK
+		linesize += wqueue_line(&attr->line[linesize], WQUEUE_BUFSIZE - linesize, "hpwork", HPWORK);
+#endif
+#ifdef CONFIG_SCHED_LPWORK
+		linesize += wqueue_line(&attr->line[linesize], WQUEUE_BUFSIZE - linesize, "lpwork", LPWORK);
+#endif
+
+		/* Save the linesize in case we are re-entered with f_pos > 0 */
+
+		attr->linesize = linesize;
+	}
+
+	/* Transfer the statistics to user receive buffer */
+
+	offset = filep->f_pos;
+	ret = procfs_memcpy(attr->line, attr->linesize, buffer, buflen, &offset);
+
+	/* Update the file offset */
+
+	if (ret > 0) {
+		filep->f_pos += ret;
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Name: wqueue_dup
+ ****************************************************************************/
+
+static int wqueue_dup(FAR const struct file *oldp, FAR struct file *newp)
+{
+	FAR struct wqueue_file_s *oldattr;
+	FAR struct wqueue_file_s *newattr;
+
+	fvdbg("Dup %p->%p\n", oldp, newp);
+
+	/* Recover our private data from the old struct file instance */
+
+	oldattr = (FAR struct wqueue_file_s *)oldp->f_priv;
+	DEBUGASSERT(oldattr);
+
+	/* Allocate a new container to hold the attribute selection */
+
+	newattr = (FAR struct wqueue_file_s *)kmm_malloc(sizeof(struct wqueue_file_s));
+	if (!newattr) {
+		fdbg("ERROR: Failed to allocate file attributes\n");
+		return -ENOMEM;
+	}
+
+	/* The copy the file attributes from the old attributes to the new */
+
+	memcpy(newattr, oldattr, sizeof(struct wqueue_file_s));
+
+	/* Save the new attributes in the new file structure */
+
+	newp->f_priv = (FAR void *)newattr;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: wqueue_stat
+ *
+ * Description: Return information about a file or directory
+ *
+ ****************************************************************************/
+
+static int wqueue_stat(const char *relpath, struct stat *buf)
+{
+	/* "wqueue" is the only acceptable value for the relpath */
+
+	if (strcmp(relpath, "wqueue") != 0) {
+		fdbg("ERROR: relpath is '%s'\n", relpath);
+		return -ENOENT;
+	}
+
+	/* "wqueue" is the name for a read-only file */
+
+	buf->st_mode = S_IFREG | S_IROTH | S_IRGRP | S_IRUSR;
+	buf->st_size = 0;
+	buf->st_blksize = 0;
+	buf->st_blocks = 0;
+	return OK;
+}
+
+#endif							/* CONFIG_SCHED_WORKQUEUE_STATS && !CONFIG_FS_PROCFS_EXCLUDE_WQUEUE */
+#endif							/* !CONFIG_DISABLE_MOUNTPOINT && CONFIG_FS_PROCFS */
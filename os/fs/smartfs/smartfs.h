@@ -329,6 +329,31 @@ struct smartfs_ofile_s {
 								 * causes the sector to change. */
 };
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+/* This structure caches the result of the search for a name in a directory,
+ * positive or negative.  It is keyed by the first sector of the directory
+ * and the hash of the name.
+ */
+
+struct smartfs_dcache_entry_s {
+	uint16_t parent;			/* First sector of the directory, 0 if unused */
+	uint16_t hash;				/* Hash of the name */
+	bool negative;				/* true: The name is not in the directory */
+	uint16_t firstsector;		/* Sector number of the name */
+	uint16_t flags;				/* Flags, including mode */
+	uint16_t dsector;			/* Sector number of the directory entry */
+	uint16_t doffset;			/* Offset of the directory entry */
+	uint32_t utc;				/* Time stamp */
+	char name[CONFIG_SMARTFS_MAXNAMLEN + 1];	/* Name searched for */
+};
+
+struct smartfs_dcache_s {
+	struct smartfs_dcache_entry_s entries[CONFIG_SMARTFS_DENTRY_CACHE_SIZE];
+	uint32_t hits;				/* Lookups answered by the cache */
+	uint32_t misses;			/* Lookups which read the directory */
+};
+#endif
+
 /* This structure represents the overall mountpoint state.  An instance of this
  * structure is retained as inode private data on each mountpoint that is
  * mounted with a smartfs filesystem.
@@ -353,6 +378,13 @@ struct smartfs_mountpt_s {
 #ifdef CONFIG_SMARTFS_ENTRY_TIMESTAMP
 	uint32_t entry_seq;
 #endif
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+	struct smartfs_dcache_s fs_dcache;	/* Cache of directory entry lookups */
+#endif
+#ifdef CONFIG_SMARTFS_WRITEBACK_CACHE
+	uint32_t fs_wbwrites;		/* Writes taken by the write-back cache */
+	uint32_t fs_wbflushes;		/* Sectors written out by the write-back cache */
+#endif
 };
 
 
@@ -423,6 +455,24 @@ void smartfs_wrle32(uint8_t *dest, uint32_t val);
 struct smartfs_mountpt_s *smartfs_get_first_mount(void);
 #endif
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+FAR struct smartfs_dcache_entry_s *smartfs_dcache_lookup(FAR struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name);
+void smartfs_dcache_add(FAR struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name, FAR const struct smartfs_entry_header_s *entry, uint16_t dsector, uint16_t doffset);
+void smartfs_dcache_invalidate(FAR struct smartfs_mountpt_s *fs);
+#else
+#define smartfs_dcache_invalidate(fs)
+#endif
+
+#ifdef CONFIG_SMARTFS_WRITEBACK_CACHE
+ssize_t smartfs_wbcache_write(FAR struct smartfs_mountpt_s *fs, FAR struct smartfs_ofile_s *sf, FAR const char *buffer, size_t buflen);
+int smartfs_wbcache_chain(FAR struct smartfs_mountpt_s *fs, FAR struct smartfs_ofile_s *sf, uint16_t nextsector);
+int smartfs_wbcache_flush(FAR struct smartfs_mountpt_s *fs, uint16_t file);
+int smartfs_wbcache_flushall(FAR struct smartfs_mountpt_s *fs);
+#else
+#define smartfs_wbcache_flush(fs, file) (OK)
+#define smartfs_wbcache_flushall(fs) (OK)
+#endif
+
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 uint16_t get_leftover_used_byte_count(uint8_t *buffer, uint16_t base_index);
 uint16_t get_used_byte_count_from_end(uint8_t *buffer);
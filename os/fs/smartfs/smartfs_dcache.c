@@ -0,0 +1,176 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "smartfs.h"
+
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_dcache_hash
+ *
+ * Description: Returns the FNV-1a hash of the name, folded to 16 bits.
+ *
+ ****************************************************************************/
+
+static uint16_t smartfs_dcache_hash(FAR const char *name)
+{
+	uint32_t hash = 2166136261u;
+
+	while (*name != '\0') {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619u;
+	}
+
+	return (uint16_t)(hash ^ (hash >> 16));
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_slot
+ *
+ * Description: Returns the slot of the cache for the name in the directory
+ *   which begins at sector parent.  The cache is direct mapped.
+ *
+ ****************************************************************************/
+
+static FAR struct smartfs_dcache_entry_s *smartfs_dcache_slot(FAR struct smartfs_mountpt_s *fs, uint16_t parent, uint16_t hash)
+{
+	return &fs->fs_dcache.entries[(hash ^ (parent * 31)) % CONFIG_SMARTFS_DENTRY_CACHE_SIZE];
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_cacheable
+ *
+ * Description: Only names which fit in an entry of the directory are
+ *   cached, so that a longer name is always searched on the device.
+ *
+ ****************************************************************************/
+
+static bool smartfs_dcache_cacheable(FAR struct smartfs_mountpt_s *fs, FAR const char *name)
+{
+	size_t len = strlen(name);
+
+	return len <= fs->fs_llformat.namesize && len <= CONFIG_SMARTFS_MAXNAMLEN;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_dcache_lookup
+ *
+ * Description: Looks up the name in the directory which begins at sector
+ *   parent.  Returns the cached entry, which may be a negative one, or
+ *   NULL if the directory has to be read.
+ *
+ ****************************************************************************/
+
+FAR struct smartfs_dcache_entry_s *smartfs_dcache_lookup(FAR struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name)
+{
+	FAR struct smartfs_dcache_entry_s *dentry;
+	uint16_t hash;
+
+	if (smartfs_dcache_cacheable(fs, name)) {
+		hash = smartfs_dcache_hash(name);
+		dentry = smartfs_dcache_slot(fs, parent, hash);
+		if (dentry->parent == parent && dentry->hash == hash && strcmp(dentry->name, name) == 0) {
+			fs->fs_dcache.hits++;
+			return dentry;
+		}
+	}
+
+	fs->fs_dcache.misses++;
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_add
+ *
+ * Description: Records the result of a search for the name in the directory
+ *   which begins at sector parent.  entry is the entry found at offset
+ *   doffset of sector dsector, or NULL if the name is not in the directory.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_add(FAR struct smartfs_mountpt_s *fs, uint16_t parent, FAR const char *name, FAR const struct smartfs_entry_header_s *entry, uint16_t dsector, uint16_t doffset)
+{
+	FAR struct smartfs_dcache_entry_s *dentry;
+	uint16_t hash;
+
+	if (!smartfs_dcache_cacheable(fs, name)) {
+		return;
+	}
+
+	hash = smartfs_dcache_hash(name);
+	dentry = smartfs_dcache_slot(fs, parent, hash);
+
+	dentry->parent = parent;
+	dentry->hash = hash;
+	strcpy(dentry->name, name);
+	if (entry == NULL) {
+		dentry->negative = true;
+		return;
+	}
+
+	dentry->negative = false;
+#ifdef CONFIG_SMARTFS_ALIGNED_ACCESS
+	dentry->firstsector = smartfs_rdle16(&entry->firstsector);
+	dentry->flags = smartfs_rdle16(&entry->flags);
+	dentry->utc = smartfs_rdle32(&entry->utc);
+#else
+	dentry->firstsector = entry->firstsector;
+	dentry->flags = entry->flags;
+	dentry->utc = entry->utc;
+#endif
+	dentry->dsector = dsector;
+	dentry->doffset = doffset;
+}
+
+/****************************************************************************
+ * Name: smartfs_dcache_invalidate
+ *
+ * Description: Drops every cached entry.  Called before a directory of the
+ *   mount is changed.  The counters are kept.
+ *
+ ****************************************************************************/
+
+void smartfs_dcache_invalidate(FAR struct smartfs_mountpt_s *fs)
+{
+	int i;
+
+	for (i = 0; i < CONFIG_SMARTFS_DENTRY_CACHE_SIZE; i++) {
+		fs->fs_dcache.entries[i].parent = 0;
+	}
+}
+
+#endif							/* CONFIG_SMARTFS_DENTRY_CACHE */
@@ -62,6 +62,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -730,6 +731,35 @@ static ssize_t smartfs_debug_write(FAR struct file *filep, FAR const char *buffe
 	return buflen;
 }
 
+/****************************************************************************
+ * Name: smartfs_status_append
+ *
+ * Description: Append a formatted line to the buffer at len and return the
+ *              new length, which never exceeds the data that fit into it.
+ *
+ ****************************************************************************/
+
+static size_t smartfs_status_append(FAR char *buffer, size_t buflen, size_t len, FAR const char *fmt, ...)
+{
+	va_list ap;
+	int ret;
+
+	if (len + 1 >= buflen) {
+		return len;
+	}
+
+	va_start(ap, fmt);
+	ret = vsnprintf(&buffer[len], buflen - len, fmt, ap);
+	va_end(ap);
+
+	if (ret < 0) {
+		return len;
+	}
+
+	len += ret;
+	return len < buflen ? len : buflen - 1;
+}
+
 /****************************************************************************
  * Name: smartfs_status_read
  *
@@ -760,7 +790,17 @@ static size_t smartfs_status_read(FAR struct file *filep, FAR char *buffer, size
 
 		if (ret == OK) {
 			/* Format and return data in the buffer */
-			len = snprintf(buffer, buflen, "Total Sectors    %d\nFree Sectors     %d\n" "Released Sectors %d\n", procfs_data.totalsectors, procfs_data.freesectors, procfs_data.releasesectors);
+			len = smartfs_status_append(buffer, buflen, 0, "Total Sectors    %d\nFree Sectors     %d\n" "Released Sectors %d\n", procfs_data.totalsectors, procfs_data.freesectors, procfs_data.releasesectors);
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+			len = smartfs_status_append(buffer, buflen, len, "Map Cache Hits   %u\nMap Cache Miss   %u\n" "Map Flash Reads  %u\n", procfs_data.cachehits, procfs_data.cachemisses, procfs_data.cachereads);
+#endif
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+			len = smartfs_status_append(buffer, buflen, len, "Dentry Cache Hits %u\nDentry Cache Miss %u\n", (unsigned int)priv->level1.mount->fs_dcache.hits, (unsigned int)priv->level1.mount->fs_dcache.misses);
+#endif
+#ifdef CONFIG_SMARTFS_WRITEBACK_CACHE
+			len = smartfs_status_append(buffer, buflen, len, "Write Cache Writes %u\nWrite Cache Flushes %u\n", (unsigned int)priv->level1.mount->fs_wbwrites, (unsigned int)priv->level1.mount->fs_wbflushes);
+#endif
+			len = smartfs_status_append(buffer, buflen, len, "Block Erases     %u\n", (unsigned int)procfs_data.blockerases);
 #ifdef CONFIG_DEBUG_FS
 			/* Calculate the sector utilization percentage */
 			if (procfs_data.blockerases == 0) {
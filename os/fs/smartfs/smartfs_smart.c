@@ -522,6 +522,15 @@ static ssize_t smartfs_read(FAR struct file *filep, char *buffer, size_t buflen)
 
 	smartfs_semtake(fs);
 
+#ifdef CONFIG_SMARTFS_WRITEBACK_CACHE
+	/* The data is read from the device, write out the cached sectors of the file */
+
+	ret = smartfs_wbcache_flush(fs, sf->entry.firstsector);
+	if (ret < 0) {
+		goto errout_with_semaphore;
+	}
+#endif
+
 	/* Loop until all byte read or error */
 
 	bytesread = 0;
@@ -1316,6 +1325,9 @@ static int smartfs_unbind(void *handle, FAR struct inode **blkdriver)
 		smartfs_semgive(fs);
 		return -EBUSY;
 	}
+
+	(void)smartfs_wbcache_flushall(fs);
+
 	/* Unmount ... close the block driver */
 	ret = smartfs_unmount(fs);
 	smartfs_semgive(fs);
@@ -1637,6 +1649,7 @@ int smartfs_rename(struct inode *mountpt, const char *oldrelpath, const char *ne
 #ifdef CONFIG_SMARTFS_USE_SECTOR_BUFFER
 		if (oldentry.dfirst == newentry.dsector) {
 			/* We will not use any new entry found, we will overwrite the existing entry but with a new name */
+			smartfs_dcache_invalidate(fs);
 			smartfs_setbuffer(&readwrite, oldentry.dsector, oldentry.doffset + offsetof(struct smartfs_entry_header_s, name), fs->fs_llformat.namesize, (uint8_t *)newentry.name);
 			ret = FS_IOCTL(fs, BIOC_WRITESECT, (unsigned long)&readwrite);
 			if (ret != OK) {
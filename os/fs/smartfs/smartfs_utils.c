@@ -565,6 +565,13 @@ off_t smartfs_seek_internal(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s
 		smartfs_sync_internal(fs, sf);
 	}
 
+	/* The sectors are read from the device below, write out the cached ones */
+
+	ret = smartfs_wbcache_flush(fs, sf->entry.firstsector);
+	if (ret < 0) {
+		goto errout;
+	}
+
 	/* Calculate the file position to seek to based on current position */
 
 	switch (whence) {
@@ -725,6 +732,13 @@ int smartfs_sync_internal(struct smartfs_mountpt_s *fs, struct smartfs_ofile_s *
 	}
 #else							/* CONFIG_SMARTFS_USE_SECTOR_BUFFER */
 
+	/* Write out the sectors of the file kept in the write-back cache */
+
+	ret = smartfs_wbcache_flush(fs, sf->entry.firstsector);
+	if (ret < 0) {
+		goto errout;
+	}
+
 	/* Test if we have written bytes to the current sector that
 	 * need to be recorded in the chain header's used bytes field. */
 
@@ -1063,6 +1077,13 @@ int smartfs_get_datalen(struct smartfs_mountpt_s *fs, uint16_t firstsector, uint
 
 	(*datalen) = 0;
 
+	/* The chain of the file is followed on the device */
+
+	ret = smartfs_wbcache_flush(fs, firstsector);
+	if (ret < 0) {
+		return ret;
+	}
+
 	header = (struct smartfs_chain_header_s *)fs->fs_rwbuffer;
 	dirsector = firstsector;
 
@@ -1134,6 +1155,9 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 	struct smartfs_chain_header_s *header;
 	struct smart_read_write_s readwrite;
 	struct smartfs_entry_header_s *entry;
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+	struct smartfs_dcache_entry_s *dentry;
+#endif
 #ifdef CONFIG_SMARTFS_DYNAMIC_HEADER
 	int used_value;
 #endif
@@ -1216,6 +1240,51 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 			segment = ptr;
 			continue;
 		} else {
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+			/* Check if the last search for the name in this directory is known */
+
+			dentry = smartfs_dcache_lookup(fs, dirstack[depth], fs->fs_workbuffer);
+			if (dentry != NULL) {
+				if (dentry->negative) {
+					goto errout_notfound;
+				}
+
+				if (*ptr == '\0') {
+					/* We are at the last segment.  Report the entry */
+
+					direntry->firstsector = dentry->firstsector;
+					direntry->flags = dentry->flags;
+					direntry->utc = dentry->utc;
+					direntry->dsector = dentry->dsector;
+					direntry->doffset = dentry->doffset;
+					direntry->dfirst = dirstack[depth];
+					strncpy(direntry->name, dentry->name, fs->fs_llformat.namesize);
+					direntry->datalen = 0;
+					if ((dentry->flags & SMARTFS_DIRENT_TYPE) == SMARTFS_DIRENT_TYPE_FILE) {
+						direntry->datalen = SMARTFS_DIRENT_LEN_UNKWN;
+					}
+
+					direntry->prev_parent = dirstack[depth];
+					ret = OK;
+					goto errout;
+				}
+
+				if ((dentry->flags & SMARTFS_DIRENT_TYPE) != SMARTFS_DIRENT_TYPE_DIR) {
+					ret = -ENOTDIR;
+					goto errout;
+				}
+
+				if (depth >= CONFIG_SMARTFS_DIRDEPTH - 1) {
+					ret = -ENAMETOOLONG;
+					goto errout;
+				}
+
+				dirstack[++depth] = dentry->firstsector;
+				segment = ptr + 1;
+				continue;
+			}
+#endif
+
 			/* Search for the entry in the current directory */
 
 			dirsector = dirstack[depth];
@@ -1269,6 +1338,9 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 						 * open it and continue searching.
 						 */
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+						smartfs_dcache_add(fs, dirstack[depth], fs->fs_workbuffer, entry, readwrite.logsector, offset);
+#endif
 						if (*ptr == '\0') {
 							/* We are at the last segment.  Report the entry */
 
@@ -1367,6 +1439,10 @@ int smartfs_finddirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *d
 				continue;
 			}
 
+#ifdef CONFIG_SMARTFS_DENTRY_CACHE
+			smartfs_dcache_add(fs, dirstack[depth], fs->fs_workbuffer, NULL, 0, 0);
+errout_notfound:
+#endif
 			/* Entry not found!  Report the error.  Also, if this is the last
 			 * segment, then report the parent directory sector.
 			 */
@@ -1415,6 +1491,8 @@ int smartfs_createdirentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s
 {
 	int ret;
 
+	smartfs_dcache_invalidate(fs);
+
 	/* If we are in the context of smartfs_createdirentry, then smartfs_find_availableentry did not find an available entry. */
 
 	/* Allocate a new sector and chain it to the last one */
@@ -1542,6 +1620,8 @@ int smartfs_writeentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s new_
 	char *tmp_buf = NULL;
 	uint16_t nextsector;
 
+	smartfs_dcache_invalidate(fs);
+
 	entrysize = sizeof(struct smartfs_entry_header_s) + fs->fs_llformat.namesize;
 	offset = new_entry.doffset;
 
@@ -1719,6 +1799,8 @@ int smartfs_invalidateentry(struct smartfs_mountpt_s *fs, uint16_t parentdirsect
 	struct smart_read_write_s readwrite;
 	uint8_t *entry_flags;
 
+	smartfs_dcache_invalidate(fs);
+
 	smartfs_setbuffer(&readwrite, parentdirsector, offset, sizeof(uint16_t), (uint8_t *)fs->fs_rwbuffer);
 	ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
 	if (ret < 0) {
@@ -1775,6 +1857,19 @@ int smartfs_deleteentry(struct smartfs_mountpt_s *fs, struct smartfs_entry_s *en
 	struct smartfs_chain_header_s *header;
 	struct smart_read_write_s readwrite;
 	bool inactive_entry = TRUE;
+
+	smartfs_dcache_invalidate(fs);
+
+	/* Write out the cached sectors of the file first.  Sectors which were
+	 * allocated for it but not written yet are then freed by the chain walk
+	 * below, like the others.
+	 */
+
+	ret = smartfs_wbcache_flush(fs, entry->firstsector);
+	if (ret < 0) {
+		return ret;
+	}
+
 	/* Our policy is that integrity entry & chaining.
 	 * If Isolated sector created but entry or chain is safe, we can handle it through the fs_recover.
 	 * So We will always process regarding entry & chain first when delete entry.
@@ -2130,7 +2225,11 @@ ssize_t smartfs_append_data(FAR struct smartfs_mountpt_s *fs, FAR struct smartfs
 {
 	int ret;
 	struct smart_read_write_s readwrite;
+#ifdef CONFIG_SMARTFS_WRITEBACK_CACHE
+	uint16_t nextsector;
+#else
 	struct smartfs_chain_header_s *chainheader;
+#endif
 
 	while (buflen > 0) {
 		/* We will fill up the current sector. Write data to
@@ -2147,6 +2246,18 @@ ssize_t smartfs_append_data(FAR struct smartfs_mountpt_s *fs, FAR struct smartfs
 		memcpy(&sf->buffer[sf->curroffset], &buffer[byteswritten], readwrite.count);
 		sf->bflags |= SMARTFS_BFLAG_DIRTY;
 
+#elif defined(CONFIG_SMARTFS_WRITEBACK_CACHE)
+		/* Copy the data to the cached image of the sector, which also
+		 * keeps the used bytes of the sector.
+		 */
+
+		ret = smartfs_wbcache_write(fs, sf, &buffer[byteswritten], buflen);
+		if (ret < 0) {
+			return ret;
+		}
+
+		readwrite.count = ret;
+
 #else                                                   /* CONFIG_SMARTFS_USE_SECTOR_BUFFER */
 		smartfs_setbuffer(&readwrite, sf->currsector, sf->curroffset, fs->fs_llformat.availbytes - sf->curroffset, (uint8_t *)&buffer[byteswritten]);
 		if (readwrite.count > buflen) {
@@ -2166,7 +2277,9 @@ ssize_t smartfs_append_data(FAR struct smartfs_mountpt_s *fs, FAR struct smartfs
 
 		/* Update our control variables */
 		sf->entry.datalen += readwrite.count;
+#ifndef CONFIG_SMARTFS_WRITEBACK_CACHE
 		sf->byteswritten += readwrite.count;
+#endif
 		sf->filepos += readwrite.count;
 		sf->curroffset += readwrite.count;
 		buflen -= readwrite.count;
@@ -2207,6 +2320,27 @@ ssize_t smartfs_append_data(FAR struct smartfs_mountpt_s *fs, FAR struct smartfs
 			memset(sf->buffer, CONFIG_SMARTFS_ERASEDSTATE, fs->fs_llformat.availbytes);
 			chainheader->type = SMARTFS_SECTOR_TYPE_FILE;
 		}
+#elif defined(CONFIG_SMARTFS_WRITEBACK_CACHE)
+		if (sf->curroffset == fs->fs_llformat.availbytes && buflen > 0) {
+			/* Get a new sector and chain it in the cache.  Nothing is
+			 * written to the device until the cache is flushed.
+			 */
+
+			ret = FS_IOCTL(fs, BIOC_ALLOCSECT, 0xFFFF);
+			if (ret < 0) {
+				fdbg("Error allocating new sector, ret : %d\n", ret);
+				return ret;
+			}
+
+			nextsector = (uint16_t)ret;
+			ret = smartfs_wbcache_chain(fs, sf, nextsector);
+			if (ret < 0) {
+				return ret;
+			}
+
+			sf->currsector = nextsector;
+			sf->curroffset = sizeof(struct smartfs_chain_header_s);
+		}
 #else                                                   /* CONFIG_SMARTFS_USE_SECTOR_BUFFER */
 		if (sf->curroffset == fs->fs_llformat.availbytes) {
 
@@ -2551,6 +2685,7 @@ int smartfs_sector_recovery(struct smartfs_mountpt_s *fs)
 		return -ENOMEM;
 	}
 	fvdbg("sector recover start\n");
+	smartfs_dcache_invalidate(fs);
 	memset(map, 0, size);
 
 	/* If any of logical sector is mapped to physical block it means active block, Mark it */
@@ -0,0 +1,385 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/fs/ioctl.h>
+#include <tinyara/clock.h>
+#include <tinyara/wqueue.h>
+
+#include "smartfs.h"
+
+#ifdef CONFIG_SMARTFS_WRITEBACK_CACHE
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#if defined(CONFIG_SCHED_WORKQUEUE) && CONFIG_SMARTFS_WRITEBACK_CACHE_DELAY > 0
+#define SMARTFS_WBCACHE_TIMER 1
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* This structure holds the image of one sector, chain header included,
+ * which has not been written to the device yet.
+ */
+
+struct smartfs_wbsector_s {
+	FAR struct smartfs_mountpt_s *fs;	/* Mount of the sector, NULL if the slot is free */
+	uint16_t file;				/* First sector of the file which owns the sector */
+	uint16_t sector;			/* Logical sector */
+	uint16_t size;				/* Size of buffer */
+	uint32_t seq;				/* Order in which the sectors were cached */
+	FAR uint8_t *buffer;		/* Image of the sector */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The pool is shared by all mounts.  It is protected by the semaphore of
+ * smartfs, which is the same for all mounts.
+ */
+
+static struct smartfs_wbsector_s g_wbsectors[CONFIG_SMARTFS_WRITEBACK_CACHE_SECTORS];
+static uint32_t g_wbseq;
+
+#ifdef SMARTFS_WBCACHE_TIMER
+static struct work_s g_wbwork;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_wbcache_writeout
+ *
+ * Description: Writes the image of a cached sector to the device and frees
+ *   the slot.
+ *
+ ****************************************************************************/
+
+static int smartfs_wbcache_writeout(FAR struct smartfs_wbsector_s *slot)
+{
+	FAR struct smartfs_mountpt_s *fs = slot->fs;
+	struct smart_read_write_s readwrite;
+	int ret;
+
+	smartfs_setbuffer(&readwrite, slot->sector, 0, fs->fs_llformat.availbytes, slot->buffer);
+	ret = FS_IOCTL(fs, BIOC_WRITESECT, (unsigned long)&readwrite);
+	if (ret < 0) {
+		fdbg("Error %d writing cached sector %d\n", ret, slot->sector);
+		return ret;
+	}
+
+	fs->fs_wbflushes++;
+	slot->fs = NULL;
+	return OK;
+}
+
+#ifdef SMARTFS_WBCACHE_TIMER
+/****************************************************************************
+ * Name: smartfs_wbcache_worker
+ *
+ * Description: Writes out every cached sector when the flush delay expires.
+ *   arg is the semaphore of smartfs, which outlives the mounts.
+ *
+ ****************************************************************************/
+
+static void smartfs_wbcache_worker(FAR void *arg)
+{
+	FAR sem_t *sem = (FAR sem_t *)arg;
+	int i;
+
+	while (sem_wait(sem) != 0) {
+		ASSERT(*get_errno_ptr() == EINTR);
+	}
+
+	for (i = 0; i < CONFIG_SMARTFS_WRITEBACK_CACHE_SECTORS; i++) {
+		if (g_wbsectors[i].fs != NULL) {
+			(void)smartfs_wbcache_flush(g_wbsectors[i].fs, g_wbsectors[i].file);
+		}
+	}
+
+	sem_post(sem);
+}
+#endif
+
+/****************************************************************************
+ * Name: smartfs_wbcache_get
+ *
+ * Description: Returns the slot which caches the sector of the file.  If
+ *   the sector is not cached, it is read from the device, or set to an
+ *   empty file sector if newsector is true.  If no slot is free, the file
+ *   of the oldest cached sector is written out first.
+ *
+ ****************************************************************************/
+
+static int smartfs_wbcache_get(FAR struct smartfs_mountpt_s *fs, uint16_t file, uint16_t sector, bool newsector, FAR struct smartfs_wbsector_s **slotp)
+{
+	FAR struct smartfs_wbsector_s *slot = NULL;
+	FAR struct smartfs_wbsector_s *oldest = NULL;
+	struct smartfs_chain_header_s *header;
+	struct smart_read_write_s readwrite;
+	int ret;
+	int i;
+
+	for (i = 0; i < CONFIG_SMARTFS_WRITEBACK_CACHE_SECTORS; i++) {
+		if (g_wbsectors[i].fs == NULL) {
+			if (slot == NULL) {
+				slot = &g_wbsectors[i];
+			}
+		} else if (g_wbsectors[i].fs == fs && g_wbsectors[i].sector == sector) {
+			*slotp = &g_wbsectors[i];
+			return OK;
+		} else if (oldest == NULL || (int32_t)(g_wbsectors[i].seq - oldest->seq) < 0) {
+			oldest = &g_wbsectors[i];
+		}
+	}
+
+	if (slot == NULL) {
+		/* The pool is full.  Write out the file of the oldest sector */
+
+		ret = smartfs_wbcache_flush(oldest->fs, oldest->file);
+		if (ret < 0) {
+			return ret;
+		}
+
+		slot = oldest;
+	}
+
+	if (slot->size < fs->fs_llformat.availbytes) {
+		if (slot->buffer != NULL) {
+			kmm_free(slot->buffer);
+		}
+
+		slot->size = 0;
+		slot->buffer = (FAR uint8_t *)kmm_malloc(fs->fs_llformat.availbytes);
+		if (slot->buffer == NULL) {
+			return -ENOMEM;
+		}
+
+		slot->size = fs->fs_llformat.availbytes;
+	}
+
+	header = (struct smartfs_chain_header_s *)slot->buffer;
+	if (newsector) {
+		memset(slot->buffer, CONFIG_SMARTFS_ERASEDSTATE, fs->fs_llformat.availbytes);
+	} else {
+		smartfs_setbuffer(&readwrite, sector, 0, fs->fs_llformat.availbytes, slot->buffer);
+		ret = FS_IOCTL(fs, BIOC_READSECT, (unsigned long)&readwrite);
+		if (ret < 0) {
+			fdbg("Error %d reading sector %d\n", ret, sector);
+			return ret;
+		}
+	}
+
+	if (header->type == CONFIG_SMARTFS_ERASEDSTATE) {
+		header->type = SMARTFS_SECTOR_TYPE_FILE;
+	}
+
+	slot->fs = fs;
+	slot->file = file;
+	slot->sector = sector;
+	slot->seq = ++g_wbseq;
+
+#ifdef SMARTFS_WBCACHE_TIMER
+	if (work_available(&g_wbwork)) {
+		(void)work_queue(LPWORK, &g_wbwork, smartfs_wbcache_worker, fs->fs_sem, MSEC2TICK(CONFIG_SMARTFS_WRITEBACK_CACHE_DELAY));
+	}
+#endif
+
+	*slotp = slot;
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: smartfs_wbcache_write
+ *
+ * Description: Copies data to the current sector and offset of the file,
+ *   up to the end of the sector, and adds it to the used bytes of the
+ *   sector.  Returns the number of bytes copied.
+ *
+ ****************************************************************************/
+
+ssize_t smartfs_wbcache_write(FAR struct smartfs_mountpt_s *fs, FAR struct smartfs_ofile_s *sf, FAR const char *buffer, size_t buflen)
+{
+	FAR struct smartfs_wbsector_s *slot;
+	struct smartfs_chain_header_s *header;
+	uint16_t count;
+	uint16_t used;
+	int ret;
+
+	ret = smartfs_wbcache_get(fs, sf->entry.firstsector, sf->currsector, false, &slot);
+	if (ret < 0) {
+		return ret;
+	}
+
+	count = fs->fs_llformat.availbytes - sf->curroffset;
+	if (count > buflen) {
+		count = buflen;
+	}
+
+	memcpy(&slot->buffer[sf->curroffset], buffer, count);
+
+	header = (struct smartfs_chain_header_s *)slot->buffer;
+	used = SMARTFS_USED(header);
+	if (used == SMARTFS_ERASEDSTATE_16BIT) {
+		used = 0;
+	}
+
+	used += count;
+	header->used[0] = (uint8_t)(used & 0x00FF);
+	header->used[1] = (uint8_t)(used >> 8);
+
+	fs->fs_wbwrites++;
+	return count;
+}
+
+/****************************************************************************
+ * Name: smartfs_wbcache_chain
+ *
+ * Description: Caches the newly allocated sector nextsector as an empty
+ *   file sector and chains it to the current sector of the file.
+ *
+ *   The new sector is cached first: making room for it may write out the
+ *   file, and the current sector must not reach the device pointing to a
+ *   sector which is not written yet.  Reading the current sector back may
+ *   in turn write out the new one, which is harmless since it is not
+ *   linked yet.
+ *
+ ****************************************************************************/
+
+int smartfs_wbcache_chain(FAR struct smartfs_mountpt_s *fs, FAR struct smartfs_ofile_s *sf, uint16_t nextsector)
+{
+	FAR struct smartfs_wbsector_s *next;
+	FAR struct smartfs_wbsector_s *slot;
+	struct smartfs_chain_header_s *header;
+	int ret;
+
+	ret = smartfs_wbcache_get(fs, sf->entry.firstsector, nextsector, true, &next);
+	if (ret < 0) {
+		return ret;
+	}
+
+	ret = smartfs_wbcache_get(fs, sf->entry.firstsector, sf->currsector, false, &slot);
+	if (ret < 0) {
+		return ret;
+	}
+
+	header = (struct smartfs_chain_header_s *)slot->buffer;
+	*((uint16_t *)header->nextsector) = nextsector;
+
+	/* The current sector may have been cached again after the new one.
+	 * The file is written out from the newest sector on, so make the new
+	 * sector the newest if it is still cached.
+	 */
+
+	if (next->fs == fs && next->sector == nextsector) {
+		next->seq = ++g_wbseq;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: smartfs_wbcache_flush
+ *
+ * Description: Writes out the cached sectors of the file which begins at
+ *   sector file.  The newest sector is written first.  A sector which is
+ *   not on the device yet is always newer than the sector which points to
+ *   it, see smartfs_wbcache_chain(), so the chain never points to a sector
+ *   which is not written yet.
+ *
+ ****************************************************************************/
+
+int smartfs_wbcache_flush(FAR struct smartfs_mountpt_s *fs, uint16_t file)
+{
+	FAR struct smartfs_wbsector_s *last;
+	int ret;
+	int i;
+
+	for (;;) {
+		last = NULL;
+		for (i = 0; i < CONFIG_SMARTFS_WRITEBACK_CACHE_SECTORS; i++) {
+			if (g_wbsectors[i].fs == fs && g_wbsectors[i].file == file) {
+				if (last == NULL || (int32_t)(g_wbsectors[i].seq - last->seq) > 0) {
+					last = &g_wbsectors[i];
+				}
+			}
+		}
+
+		if (last == NULL) {
+			return OK;
+		}
+
+		ret = smartfs_wbcache_writeout(last);
+		if (ret < 0) {
+			return ret;
+		}
+	}
+}
+
+/****************************************************************************
+ * Name: smartfs_wbcache_flushall
+ *
+ * Description: Writes out every cached sector of the mount.
+ *
+ ****************************************************************************/
+
+int smartfs_wbcache_flushall(FAR struct smartfs_mountpt_s *fs)
+{
+	int ret;
+	int i;
+
+	for (i = 0; i < CONFIG_SMARTFS_WRITEBACK_CACHE_SECTORS; i++) {
+		if (g_wbsectors[i].fs == fs) {
+			ret = smartfs_wbcache_flush(fs, g_wbsectors[i].file);
+			if (ret < 0) {
+				return ret;
+			}
+		}
+	}
+
+	return OK;
+}
+
+#endif							/* CONFIG_SMARTFS_WRITEBACK_CACHE */
@@ -104,6 +104,12 @@ int close(int fd)
 	/* close() is a cancellation point */
 	(void)enter_cancellation_point();
 
+#ifdef CONFIG_EPOLL
+	/* Drop the descriptor from the epoll instances which watch it */
+
+	epoll_fdclose(fd);
+#endif
+
 #if CONFIG_NFILE_DESCRIPTORS > 0
 	/* Did we get a valid file descriptor? */
 
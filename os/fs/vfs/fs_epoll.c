@@ -0,0 +1,851 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <sys/epoll.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <queue.h>
+#include <sched.h>
+#include <time.h>
+#include <errno.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <tinyara/kmalloc.h>
+#include <tinyara/clock.h>
+#include <tinyara/cancelpt.h>
+#include <tinyara/semaphore.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/net/net.h>
+#include <arch/irq.h>
+
+#include "inode/inode.h"
+
+#ifdef CONFIG_EPOLL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The events which are reported even if they are not of interest */
+
+#define EPOLL_ALWAYS (POLLERR | POLLHUP)
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+struct epoll_head_s;
+
+/* One descriptor of the interest list.  Its pollfd stays set up with the
+ * driver or the socket until the descriptor is removed or changed.  The item
+ * holds its own reference to the file, so that the file it was set up with
+ * stays open until it is torn down, whatever happens to the descriptor.
+ */
+
+struct epoll_item_s {
+	dq_entry_t link;			/* Link in the ready list */
+	FAR struct epoll_item_s *flink;	/* Next in the interest list */
+	FAR struct epoll_head_s *eph;	/* The instance of the item */
+	struct file file;			/* The file, no inode for a socket */
+	struct pollfd pfd;			/* Set up with the driver or the socket */
+	epoll_data_t data;			/* Returned with the events */
+	uint32_t events;			/* The events of interest and the flags */
+	bool ready;					/* True if in a ready list */
+	bool armed;					/* False once reported with EPOLLONESHOT */
+};
+
+/* An epoll instance.  It is the private data of an unlinked inode, so that
+ * it has a file descriptor which is inherited and closed like any other.
+ */
+
+struct epoll_head_s {
+	sem_t exclsem;				/* Serializes epoll_ctl() and epoll_wait() */
+	sem_t waitsem;				/* Posted when the ready list is filled */
+	int crefs;					/* Number of descriptors of the instance */
+	FAR struct epoll_item_s *items;	/* The interest list */
+	dq_queue_t ready;			/* The items which became ready */
+};
+
+/****************************************************************************
+ * Private Function Prototypes
+ ****************************************************************************/
+
+static int epoll_open(FAR struct file *filep);
+static int epoll_close(FAR struct file *filep);
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+static const struct file_operations g_epoll_ops = {
+	epoll_open,					/* open */
+	epoll_close,				/* close */
+	0,							/* read */
+	0,							/* write */
+	0,							/* seek */
+	0							/* ioctl */
+#ifndef CONFIG_DISABLE_POLL
+	, 0							/* poll */
+#endif
+};
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_semtake
+ ****************************************************************************/
+
+static void epoll_semtake(FAR struct epoll_head_s *eph)
+{
+	while (sem_wait(&eph->exclsem) < 0) {
+		DEBUGASSERT(get_errno() == EINTR);
+	}
+}
+
+#define epoll_semgive(eph) sem_post(&(eph)->exclsem)
+
+/****************************************************************************
+ * Name: epoll_head
+ *
+ * Description:
+ *   Return the instance of the descriptor epfd, or NULL if epfd is not the
+ *   descriptor of an epoll instance.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_head_s *epoll_head(int epfd)
+{
+	FAR struct file *filep;
+
+	if (fs_getfilep(epfd, &filep) < 0 || filep->f_inode == NULL) {
+		return NULL;
+	}
+
+	if (filep->f_inode->u.i_ops != &g_epoll_ops) {
+		return NULL;
+	}
+
+	return (FAR struct epoll_head_s *)filep->f_inode->i_private;
+}
+
+/****************************************************************************
+ * Name: epoll_callback
+ *
+ * Description:
+ *   Called by poll_post() when the events of an item are set.  The item is
+ *   added to the ready list, and the waiter is woken up if the list was
+ *   empty.  May be called from an interrupt handler.
+ *
+ ****************************************************************************/
+
+static void epoll_callback(FAR struct pollfd *fds)
+{
+	FAR struct epoll_item_s *item;
+	FAR struct epoll_head_s *eph;
+	irqstate_t flags;
+
+	item = (FAR struct epoll_item_s *)((FAR char *)fds - offsetof(struct epoll_item_s, pfd));
+	eph = item->eph;
+
+	flags = irqsave();
+	if (!item->ready) {
+		item->ready = true;
+		dq_addlast(&item->link, &eph->ready);
+		if (eph->ready.head == &item->link) {
+			sem_post(&eph->waitsem);
+		}
+	}
+
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_setup
+ *
+ * Description:
+ *   Set up or tear down the poll of the item with its driver or socket.
+ *
+ ****************************************************************************/
+
+static int epoll_setup(FAR struct epoll_item_s *item, bool setup)
+{
+	int ret;
+
+	if (item->file.f_inode != NULL) {
+		ret = file_poll(&item->file, &item->pfd, setup);
+	} else {
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+		ret = net_poll(item->pfd.fd, &item->pfd, setup);
+#else
+		ret = -EBADF;
+#endif
+	}
+
+	/* A driver without a poll method cannot be waited for */
+
+	return ret == -ENOSYS ? -EPERM : ret;
+}
+
+/****************************************************************************
+ * Name: epoll_unready
+ *
+ * Description:
+ *   Remove the item from the ready list and clear its events.
+ *
+ ****************************************************************************/
+
+static void epoll_unready(FAR struct epoll_item_s *item)
+{
+	irqstate_t flags;
+
+	flags = irqsave();
+	if (item->ready) {
+		dq_rem(&item->link, &item->eph->ready);
+		item->ready = false;
+	}
+
+	item->pfd.revents = 0;
+	irqrestore(flags);
+}
+
+/****************************************************************************
+ * Name: epoll_find
+ *
+ * Description:
+ *   Return the item of fd in the interest list, and the item before it in
+ *   *prev.
+ *
+ ****************************************************************************/
+
+static FAR struct epoll_item_s *epoll_find(FAR struct epoll_head_s *eph, int fd, FAR struct epoll_item_s **prev)
+{
+	FAR struct epoll_item_s *item;
+
+	*prev = NULL;
+	for (item = eph->items; item != NULL; item = item->flink) {
+		if (item->pfd.fd == fd) {
+			break;
+		}
+
+		*prev = item;
+	}
+
+	return item;
+}
+
+/****************************************************************************
+ * Name: epoll_alloc
+ *
+ * Description:
+ *   Allocate the item of fd.  The file of fd is duplicated into the item.
+ *   Must not be called with the semaphore of the instance held, since the
+ *   file list of the task group is locked.
+ *
+ ****************************************************************************/
+
+static int epoll_alloc(FAR struct epoll_head_s *eph, int fd, FAR struct epoll_event *ev, FAR struct epoll_item_s **itemp)
+{
+	FAR struct epoll_item_s *item;
+	FAR struct file *filep;
+	int ret;
+
+	if ((unsigned int)fd < CONFIG_NFILE_DESCRIPTORS) {
+		ret = fs_getfilep(fd, &filep);
+		if (ret < 0) {
+			return ret;
+		}
+
+		if (filep->f_inode == NULL || filep->f_inode->u.i_ops == &g_epoll_ops) {
+			return -EINVAL;
+		}
+	}
+#if defined(CONFIG_NET) && CONFIG_NSOCKET_DESCRIPTORS > 0
+	else if ((unsigned int)fd < (CONFIG_NFILE_DESCRIPTORS + CONFIG_NSOCKET_DESCRIPTORS)) {
+		filep = NULL;
+	}
+#endif
+	else {
+		return -EBADF;
+	}
+
+	item = (FAR struct epoll_item_s *)kmm_zalloc(sizeof(struct epoll_item_s));
+	if (item == NULL) {
+		return -ENOMEM;
+	}
+
+	if (filep != NULL && file_dup2(filep, &item->file) < 0) {
+		ret = -get_errno();
+		kmm_free(item);
+		return ret;
+	}
+
+	item->eph = eph;
+	item->data = ev->data;
+	item->events = ev->events;
+	item->pfd.fd = fd;
+	item->pfd.sem = &eph->waitsem;
+	item->pfd.events = (pollevent_t)(ev->events | EPOLL_ALWAYS);
+	item->pfd.cb = epoll_callback;
+
+	*itemp = item;
+	return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_release
+ *
+ * Description:
+ *   Tear down an item which is no more in the interest list, close its file
+ *   and free it.
+ *
+ ****************************************************************************/
+
+static void epoll_release(FAR struct epoll_item_s *item)
+{
+	if (item->armed) {
+		(void)epoll_setup(item, false);
+	}
+
+	epoll_unready(item);
+	if (item->file.f_inode != NULL) {
+		(void)file_close(&item->file);
+	}
+
+	kmm_free(item);
+}
+
+/****************************************************************************
+ * Name: epoll_rescan
+ *
+ * Description:
+ *   Add to the ready list the items whose events are set although they are
+ *   not in it.  A driver which posts the semaphore of the pollfd instead of
+ *   calling poll_post() is only seen this way.
+ *
+ ****************************************************************************/
+
+static void epoll_rescan(FAR struct epoll_head_s *eph)
+{
+	FAR struct epoll_item_s *item;
+	irqstate_t flags;
+
+	for (item = eph->items; item != NULL; item = item->flink) {
+		flags = irqsave();
+		if (item->armed && !item->ready && item->pfd.revents != 0) {
+			item->ready = true;
+			dq_addlast(&item->link, &eph->ready);
+		}
+
+		irqrestore(flags);
+	}
+}
+
+/****************************************************************************
+ * Name: epoll_collect
+ *
+ * Description:
+ *   Report the events of the items in the ready list to evs.  A level
+ *   triggered item is set up again so that it goes back to the ready list
+ *   while it is ready.  Returns the number of events.
+ *
+ ****************************************************************************/
+
+static int epoll_collect(FAR struct epoll_head_s *eph, FAR struct epoll_event *evs, int maxevents)
+{
+	FAR struct epoll_item_s *item;
+	dq_queue_t ready;
+	irqstate_t flags;
+	pollevent_t eventset;
+	int nevents = 0;
+
+	/* Take the ready list.  The items keep their ready flag, so that they
+	 * are not added to the list again until they are visited.
+	 */
+
+	flags = irqsave();
+	ready = eph->ready;
+	dq_init(&eph->ready);
+	irqrestore(flags);
+
+	while (nevents < maxevents && (item = (FAR struct epoll_item_s *)dq_remfirst(&ready)) != NULL) {
+		flags = irqsave();
+		item->ready = false;
+		eventset = item->pfd.revents;
+		item->pfd.revents = 0;
+		irqrestore(flags);
+
+		if (!item->armed) {
+			continue;
+		}
+
+		if ((item->events & EPOLLET) == 0 && (item->events & EPOLLONESHOT) == 0) {
+			/* Level triggered: learn whether the item is still ready.  If it
+			 * is, the setup adds it to the ready list for the next wait.
+			 */
+
+			(void)epoll_setup(item, false);
+			item->pfd.revents = 0;
+			if (epoll_setup(item, true) < 0) {
+				item->armed = false;
+				eventset = POLLERR;
+			} else {
+				eventset = item->pfd.revents;
+			}
+		}
+
+		eventset &= (pollevent_t)(item->events | EPOLL_ALWAYS);
+		if (eventset == 0) {
+			continue;
+		}
+
+		if ((item->events & EPOLLONESHOT) != 0) {
+			(void)epoll_setup(item, false);
+			epoll_unready(item);
+			item->armed = false;
+		}
+
+		evs[nevents].events = eventset;
+		evs[nevents].data = item->data;
+		nevents++;
+	}
+
+	/* Give back the items which did not fit in evs, before the items which
+	 * became ready since.
+	 */
+
+	flags = irqsave();
+	while ((item = (FAR struct epoll_item_s *)dq_remlast(&ready)) != NULL) {
+		dq_addfirst(&item->link, &eph->ready);
+	}
+
+	irqrestore(flags);
+	return nevents;
+}
+
+/****************************************************************************
+ * Name: epoll_open
+ *
+ * Description:
+ *   Called when the descriptor of the instance is duplicated.
+ *
+ ****************************************************************************/
+
+static int epoll_open(FAR struct file *filep)
+{
+	FAR struct epoll_head_s *eph = (FAR struct epoll_head_s *)filep->f_inode->i_private;
+
+	epoll_semtake(eph);
+	eph->crefs++;
+	epoll_semgive(eph);
+	return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_close
+ *
+ * Description:
+ *   Called when a descriptor of the instance is closed.  The last close
+ *   tears down the interest list and frees the instance.  The inode is
+ *   unlinked, so it is freed when it is released.
+ *
+ ****************************************************************************/
+
+static int epoll_close(FAR struct file *filep)
+{
+	FAR struct epoll_head_s *eph = (FAR struct epoll_head_s *)filep->f_inode->i_private;
+	FAR struct epoll_item_s *item;
+
+	epoll_semtake(eph);
+	if (--eph->crefs > 0) {
+		epoll_semgive(eph);
+		return OK;
+	}
+
+	while ((item = eph->items) != NULL) {
+		eph->items = item->flink;
+		epoll_release(item);
+	}
+
+	sem_destroy(&eph->waitsem);
+	sem_destroy(&eph->exclsem);
+	kmm_free(eph);
+	return OK;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: epoll_fdclose
+ *
+ * Description:
+ *   Remove fd from the interest lists of the epoll instances of the task
+ *   group.  Called by close() before fd is closed, so that a socket is not
+ *   torn down once it is freed, and so that the descriptor can be reused
+ *   and added again.
+ *
+ * Input Parameters:
+ *   fd - The descriptor which is being closed
+ *
+ ****************************************************************************/
+
+void epoll_fdclose(int fd)
+{
+	FAR struct filelist *list;
+	FAR struct inode *inode;
+	FAR struct epoll_head_s *eph;
+	FAR struct epoll_item_s *item;
+	FAR struct epoll_item_s *prev;
+	int i;
+
+	list = sched_getfiles();
+	if (list == NULL) {
+		return;
+	}
+
+	/* Hold the file list so that no instance is freed while it is visited */
+
+	while (sem_wait(&list->fl_sem) < 0) {
+		DEBUGASSERT(get_errno() == EINTR);
+	}
+
+	for (i = 0; i < CONFIG_NFILE_DESCRIPTORS; i++) {
+		inode = list->fl_files[i].f_inode;
+		if (inode == NULL || inode->u.i_ops != &g_epoll_ops) {
+			continue;
+		}
+
+		eph = (FAR struct epoll_head_s *)inode->i_private;
+		epoll_semtake(eph);
+		item = epoll_find(eph, fd, &prev);
+		if (item != NULL) {
+			if (prev != NULL) {
+				prev->flink = item->flink;
+			} else {
+				eph->items = item->flink;
+			}
+
+			epoll_release(item);
+		}
+
+		epoll_semgive(eph);
+	}
+
+	sem_post(&list->fl_sem);
+}
+
+/****************************************************************************
+ * Name: epoll_create
+ *
+ * Description:
+ *   Create an epoll instance and return its descriptor.
+ *
+ * Input Parameters:
+ *   size - Ignored, but must be greater than zero
+ *
+ * Returned Value:
+ *   The descriptor of the instance on success.  On failure, -1 is returned
+ *   and errno is set to EINVAL, ENOMEM or EMFILE.
+ *
+ ****************************************************************************/
+
+int epoll_create(int size)
+{
+	FAR struct epoll_head_s *eph;
+	FAR struct inode *inode;
+	int err;
+	int fd;
+
+	if (size <= 0) {
+		err = EINVAL;
+		goto errout;
+	}
+
+	eph = (FAR struct epoll_head_s *)kmm_zalloc(sizeof(struct epoll_head_s));
+	if (eph == NULL) {
+		err = ENOMEM;
+		goto errout;
+	}
+
+	inode = (FAR struct inode *)kmm_zalloc(FSNODE_SIZE(0));
+	if (inode == NULL) {
+		err = ENOMEM;
+		goto errout_with_eph;
+	}
+
+	inode->i_crefs = 1;
+	inode->i_flags = FSNODEFLAG_TYPE_DRIVER | FSNODEFLAG_DELETED;
+	inode->u.i_ops = &g_epoll_ops;
+	inode->i_private = eph;
+
+	(void)sem_init(&eph->exclsem, 0, 1);
+	(void)sem_init(&eph->waitsem, 0, 0);
+	sem_setprotocol(&eph->waitsem, SEM_PRIO_NONE);
+	dq_init(&eph->ready);
+	eph->crefs = 1;
+
+	fd = files_allocate(inode, O_RDWR, 0, 0);
+	if (fd < 0) {
+		err = EMFILE;
+		goto errout_with_inode;
+	}
+
+	return fd;
+
+errout_with_inode:
+	sem_destroy(&eph->waitsem);
+	sem_destroy(&eph->exclsem);
+	kmm_free(inode);
+
+errout_with_eph:
+	kmm_free(eph);
+
+errout:
+	set_errno(err);
+	return ERROR;
+}
+
+/****************************************************************************
+ * Name: epoll_ctl
+ *
+ * Description:
+ *   Add, change or remove a descriptor of the interest list of an epoll
+ *   instance.  The descriptor is set up with its driver or socket once,
+ *   and stays set up until it is changed or removed.
+ *
+ * Input Parameters:
+ *   epfd - The descriptor of the epoll instance
+ *   op   - EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ *   fd   - The descriptor of interest
+ *   ev   - The events of interest and the data to return
+ *
+ * Returned Value:
+ *   OK on success.  On failure, -1 is returned and errno is set.
+ *
+ ****************************************************************************/
+
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev)
+{
+	FAR struct epoll_head_s *eph;
+	FAR struct epoll_item_s *item;
+	FAR struct epoll_item_s *prev;
+	FAR struct epoll_item_s *newitem = NULL;
+	int ret;
+
+	eph = epoll_head(epfd);
+	if (eph == NULL) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+
+	if (op != EPOLL_CTL_DEL && ev == NULL) {
+		set_errno(EFAULT);
+		return ERROR;
+	}
+
+	if (op == EPOLL_CTL_ADD) {
+		ret = epoll_alloc(eph, fd, ev, &newitem);
+		if (ret < 0) {
+			set_errno(-ret);
+			return ERROR;
+		}
+	}
+
+	epoll_semtake(eph);
+	item = epoll_find(eph, fd, &prev);
+
+	switch (op) {
+	case EPOLL_CTL_ADD:
+		if (item != NULL) {
+			epoll_release(newitem);
+			ret = -EEXIST;
+			break;
+		}
+
+		ret = epoll_setup(newitem, true);
+		if (ret < 0) {
+			epoll_release(newitem);
+			break;
+		}
+
+		newitem->armed = true;
+		newitem->flink = eph->items;
+		eph->items = newitem;
+		break;
+
+	case EPOLL_CTL_MOD:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		if (item->armed) {
+			(void)epoll_setup(item, false);
+			item->armed = false;
+		}
+
+		epoll_unready(item);
+		item->data = ev->data;
+		item->events = ev->events;
+		item->pfd.events = (pollevent_t)(ev->events | EPOLL_ALWAYS);
+
+		ret = epoll_setup(item, true);
+		if (ret < 0) {
+			epoll_unready(item);
+			break;
+		}
+
+		item->armed = true;
+		break;
+
+	case EPOLL_CTL_DEL:
+		if (item == NULL) {
+			ret = -ENOENT;
+			break;
+		}
+
+		if (prev != NULL) {
+			prev->flink = item->flink;
+		} else {
+			eph->items = item->flink;
+		}
+
+		epoll_release(item);
+		ret = OK;
+		break;
+
+	default:
+		ret = -EINVAL;
+		break;
+	}
+
+	epoll_semgive(eph);
+
+	if (ret < 0) {
+		set_errno(-ret);
+		return ERROR;
+	}
+
+	return OK;
+}
+
+/****************************************************************************
+ * Name: epoll_wait
+ *
+ * Description:
+ *   Wait for events on the descriptors of the interest list of an epoll
+ *   instance.  Only the descriptors which became ready are visited.
+ *
+ * Input Parameters:
+ *   epfd      - The descriptor of the epoll instance
+ *   evs       - The events of the ready descriptors
+ *   maxevents - The size of evs
+ *   timeout   - The time to wait in milliseconds, -1 to wait forever
+ *
+ * Returned Value:
+ *   The number of events in evs, zero on timeout.  On failure, -1 is
+ *   returned and errno is set.
+ *
+ ****************************************************************************/
+
+int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents, int timeout)
+{
+	FAR struct epoll_head_s *eph;
+	struct timespec abstime;
+	bool woken = false;
+	int ret;
+
+	eph = epoll_head(epfd);
+	if (eph == NULL) {
+		set_errno(EBADF);
+		return ERROR;
+	}
+
+	if (evs == NULL || maxevents <= 0) {
+		set_errno(EINVAL);
+		return ERROR;
+	}
+
+	/* epoll_wait() is a cancellation point */
+
+	(void)enter_cancellation_point();
+
+	if (timeout > 0) {
+		(void)clock_gettime(CLOCK_REALTIME, &abstime);
+		abstime.tv_sec += timeout / MSEC_PER_SEC;
+		abstime.tv_nsec += (timeout % MSEC_PER_SEC) * NSEC_PER_MSEC;
+		if (abstime.tv_nsec >= NSEC_PER_SEC) {
+			abstime.tv_sec++;
+			abstime.tv_nsec -= NSEC_PER_SEC;
+		}
+	}
+
+	for (;;) {
+		epoll_semtake(eph);
+		if (woken && dq_empty(&eph->ready)) {
+			/* Woken up without a ready item: a driver posted the semaphore */
+
+			epoll_rescan(eph);
+		}
+
+		ret = epoll_collect(eph, evs, maxevents);
+		epoll_semgive(eph);
+
+		if (ret > 0 || timeout == 0) {
+			break;
+		}
+
+		if (timeout > 0) {
+			ret = sem_timedwait(&eph->waitsem, &abstime);
+		} else {
+			ret = sem_wait(&eph->waitsem);
+		}
+
+		if (ret < 0) {
+			ret = get_errno() == ETIMEDOUT ? OK : -get_errno();
+			break;
+		}
+
+		woken = true;
+	}
+
+	leave_cancellation_point();
+
+	if (ret < 0) {
+		set_errno(-ret);
+		return ERROR;
+	}
+
+	return ret;
+}
+
+#endif							/* CONFIG_EPOLL */
@@ -163,6 +163,9 @@ static inline int poll_setup(FAR struct pollfd *fds, nfds_t nfds, sem_t *sem)
 		fds[i].revents = 0;
 		fds[i].priv = NULL;
 		fds[i].filep = NULL;
+#ifdef CONFIG_EPOLL
+		fds[i].cb = NULL;
+#endif
 
 		/* Check for invalid descriptors. "If the value of fd is less than 0,
 		 * events shall be ignored, and revents shall be set to 0 in that entry
@@ -249,6 +252,31 @@ static inline int poll_teardown(FAR struct pollfd *fds, nfds_t nfds, int *count,
  * Public Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: poll_post
+ *
+ * Description:
+ *   Wake up the waiter of fds once the events it waits for are set in
+ *   fds->revents.  The semaphore of poll() and select() is posted, and the
+ *   callback of epoll() is called.  May be called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   fds   - The structure describing the events which occurred
+ *
+ ****************************************************************************/
+
+void poll_post(FAR struct pollfd *fds)
+{
+#ifdef CONFIG_EPOLL
+	if (fds->cb != NULL) {
+		fds->cb(fds);
+		return;
+	}
+#endif
+
+	poll_semgive(fds->sem);
+}
+
 /****************************************************************************
  * Name: file_poll
  *
@@ -297,7 +325,7 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup)
 			if (setup) {
 				fds->revents |= (fds->events & (POLLIN | POLLOUT));
 				if (fds->revents != 0) {
-					sem_post(fds->sem);
+					poll_post(fds);
 				}
 			}
 
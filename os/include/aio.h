@@ -63,8 +63,6 @@
 #include <signal.h>
 #include <time.h>
 
-#include <tinyara/wqueue.h>
-
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
@@ -75,22 +73,12 @@
 #undef CONFIG_FS_AIO
 #endif
 
-/* Work queue support is required.  The low-priority work queue is required
- * so that the asynchronous I/O does not interfere with high priority driver
- * operations.  If this pre-requisite is met, then asynchronous I/O support
- * can be enabled with CONFIG_FS_AIO
+/* Asynchronous I/O is performed by dedicated kernel threads.  Asynchronous
+ * I/O support can be enabled with CONFIG_FS_AIO
  */
 
 #ifdef CONFIG_FS_AIO
 
-#ifndef CONFIG_SCHED_WORKQUEUE
-#error Asynchronous I/O requires CONFIG_SCHED_WORKQUEUE
-#endif
-
-#ifndef CONFIG_SCHED_LPWORK
-#error Asynchronous I/O requires CONFIG_SCHED_LPWORK
-#endif
-
 /* Standard Definitions *****************************************************/
 /* aio_cancel return values
  *
@@ -146,7 +134,7 @@ struct aiocb {
 #else
 	int8_t aio_fildes;			/* File descriptor (should be int) */
 #endif
-	int8_t aio_reqprio;			/* Request priority offset (not used, should be int) */
+	int8_t aio_reqprio;			/* Request priority offset (should be int) */
 	uint8_t aio_lio_opcode;		/* Operation to be performed (should be int) */
 
 	/* Non-standard, implementation-dependent data.  For portability reasons,
@@ -174,6 +174,36 @@ ssize_t mq_timedreceive(mqd_t mqdes, FAR char *msg, size_t msglen, FAR int *prio
  */
 int mq_notify(mqd_t mqdes, const struct sigevent *notification);
 
+#ifdef CONFIG_MQ_ZEROCOPY
+/**
+ * @brief send a buffer to a message queue without copying it
+ * @details @b #include <mqueue.h> \n
+ * SYSTEM CALL API \n
+ * Like mq_send(), but the message queue takes ownership of buf, which must
+ * have been allocated with malloc(), instead of copying msglen bytes from
+ * it.  msglen is only limited by the mq_msgsize attribute of the queue.
+ * The buffer stays owned by the caller if ERROR is returned.
+ * @return On success, OK is returned. On failure, ERROR is returned and
+ * errno is set as by mq_send(), or to EINVAL if buf is not a heap buffer
+ * of the caller.
+ * @since TizenRT v3.1 PRE
+ */
+int mq_send_buf(mqd_t mqdes, FAR void *buf, size_t msglen, int prio);
+/**
+ * @brief receive a message from a message queue without copying it
+ * @details @b #include <mqueue.h> \n
+ * SYSTEM CALL API \n
+ * Like mq_receive(), but returns the buffer of the message in *buf.  The
+ * caller owns the buffer and must release it with free().  Messages sent
+ * with mq_send() are returned in a newly allocated buffer.
+ * @return On success, the length of the message. On failure, ERROR is
+ * returned and errno is set as by mq_receive(), or to ENOMEM if a buffer
+ * could not be allocated for a copied message, which is left queued.
+ * @since TizenRT v3.1 PRE
+ */
+ssize_t mq_receive_buf(mqd_t mqdes, FAR void **buf, FAR int *prio);
+#endif
+
 /**
  * @brief set message queue attributes
  * @details @b #include <mqueue.h> \n
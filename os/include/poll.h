@@ -130,6 +130,15 @@ typedef unsigned int nfds_t;
 
 typedef uint8_t pollevent_t;
 
+#ifdef CONFIG_EPOLL
+/* The callback of a persistent waiter, called by poll_post() in place of
+ * posting the semaphore.  It may be called from an interrupt handler.
+ */
+
+struct pollfd;
+typedef CODE void (*pollcb_t)(FAR struct pollfd *fds);
+#endif
+
 /* This is the TinyAra variant of the standard pollfd structure. */
 
 struct pollfd {
@@ -142,6 +151,9 @@ struct pollfd {
 #ifdef CONFIG_NET_LWIP
 	FAR void *scb;
 #endif
+#ifdef CONFIG_EPOLL
+	pollcb_t cb;				/* Set by epoll(), NULL for poll() and select() */
+#endif
 };
 
 /****************************************************************************
@@ -562,6 +562,26 @@ int pthread_mutex_trylock(FAR pthread_mutex_t *mutex);
  */
 int pthread_mutex_unlock(FAR pthread_mutex_t *mutex);
 
+#if defined(CONFIG_SEM_FASTPATH) && defined(CONFIG_PTHREAD_MUTEX_UNSAFE) && !defined(__KERNEL__)
+/**
+ * @cond
+ * @internal
+ * In user space, these lock and unlock a free NORMAL mutex without a system
+ * call.  The system calls are still reached with (pthread_mutex_lock)(mutex)
+ * etc.
+ */
+int pthread_mutex_fastlock(FAR pthread_mutex_t *mutex);
+int pthread_mutex_fasttrylock(FAR pthread_mutex_t *mutex);
+int pthread_mutex_fastunlock(FAR pthread_mutex_t *mutex);
+
+#define pthread_mutex_lock(m)     pthread_mutex_fastlock(m)
+#define pthread_mutex_trylock(m)  pthread_mutex_fasttrylock(m)
+#define pthread_mutex_unlock(m)   pthread_mutex_fastunlock(m)
+/**
+ * @endcond
+ */
+#endif
+
 /**
  * @cond
  * @internal
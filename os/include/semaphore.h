@@ -124,6 +124,14 @@ struct sem_s {
 #endif
 	int16_t semcount;			/* >0 -> Num counts available */
 	/* <0 -> Num tasks waiting for semaphore */
+#if defined(CONFIG_SEM_FASTPATH) && defined(SAVE_SEM_HOLDER)
+	/* Task which took a count in user space, 0 if none.  It forms one 32-bit
+	 * word with semcount, so both are changed by a single STREX.  The kernel
+	 * moves it to the holders below when it is entered for the semaphore.
+	 */
+
+	int16_t fastholder;
+#endif
 	/* If priority inheritance is enabled, then we have to keep track of which
 	 * tasks hold references to the semaphore.
 	 */
@@ -151,17 +159,22 @@ typedef struct sem_s sem_t;
  * @brief Sem initializer
  */
 #ifdef SAVE_SEM_HOLDER
+#ifdef CONFIG_SEM_FASTPATH
+#define _SEM_COUNT_INITIALIZER(c) (c), 0 /* semcount, fastholder */
+#else
+#define _SEM_COUNT_INITIALIZER(c) (c)    /* semcount */
+#endif
 #ifdef CONFIG_BINARY_MANAGER
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#define SEM_INITIALIZER(c) {NULL, (c), FLAGS_INITIALIZED, NULL} /* flink, semcount, flags, hhead */
+#define SEM_INITIALIZER(c) {NULL, _SEM_COUNT_INITIALIZER(c), FLAGS_INITIALIZED, NULL} /* flink, semcount, flags, hhead */
 #else
-#define SEM_INITIALIZER(c) {NULL, (c), FLAGS_INITIALIZED, SEMHOLDER_INITIALIZER} /* flink, semcount, flags, holder */
+#define SEM_INITIALIZER(c) {NULL, _SEM_COUNT_INITIALIZER(c), FLAGS_INITIALIZED, SEMHOLDER_INITIALIZER} /* flink, semcount, flags, holder */
 #endif
 #else // CONFIG_BINARY_MANAGER
 #if CONFIG_SEM_PREALLOCHOLDERS > 0
-#define SEM_INITIALIZER(c) {(c), FLAGS_INITIALIZED, NULL} /* semcount, flags, hhead */
+#define SEM_INITIALIZER(c) {_SEM_COUNT_INITIALIZER(c), FLAGS_INITIALIZED, NULL} /* semcount, flags, hhead */
 #else
-#define SEM_INITIALIZER(c) {(c), FLAGS_INITIALIZED, SEMHOLDER_INITIALIZER} /* semcount, flags, holder */
+#define SEM_INITIALIZER(c) {_SEM_COUNT_INITIALIZER(c), FLAGS_INITIALIZED, SEMHOLDER_INITIALIZER} /* semcount, flags, holder */
 #endif
 #endif
 #else
@@ -272,6 +285,29 @@ int sem_unlink(FAR const char *name);
  */
 #endif
 
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__KERNEL__)
+/**
+ * @cond
+ * @internal
+ * In user space, these take and give a count without a system call when
+ * no task has to wait or to be woken up.  The system calls are still
+ * reached with (sem_wait)(sem) etc.
+ */
+int sem_fastwait(FAR sem_t *sem);
+int sem_fasttimedwait(FAR sem_t *sem, FAR const struct timespec *abstime);
+int sem_fasttrywait(FAR sem_t *sem);
+int sem_fastpost(FAR sem_t *sem);
+unsigned int sem_fastpath_nslow(void);
+
+#define sem_wait(s)          sem_fastwait(s)
+#define sem_timedwait(s, t)  sem_fasttimedwait(s, t)
+#define sem_trywait(s)       sem_fasttrywait(s)
+#define sem_post(s)          sem_fastpost(s)
+/**
+ * @endcond
+ */
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
@@ -0,0 +1,147 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/**
+ * @ingroup POLL_KERNEL
+ * @{
+ */
+
+/// @file sys/epoll.h
+/// @brief epoll APIs
+
+#ifndef __INCLUDE_SYS_EPOLL_H
+#define __INCLUDE_SYS_EPOLL_H
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <poll.h>
+
+#ifdef CONFIG_EPOLL
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Operations of epoll_ctl() */
+
+#define EPOLL_CTL_ADD  1		/* Add a descriptor to the interest list */
+#define EPOLL_CTL_DEL  2		/* Remove a descriptor from the interest list */
+#define EPOLL_CTL_MOD  3		/* Change the events of a descriptor */
+
+/* Events.  They are the events of poll(), which does not make priority
+ * distinctions, and the flags which select how they are reported.
+ */
+
+#define EPOLLIN        POLLIN
+#define EPOLLRDNORM    POLLRDNORM
+#define EPOLLRDBAND    POLLRDBAND
+#define EPOLLPRI       POLLPRI
+#define EPOLLOUT       POLLOUT
+#define EPOLLWRNORM    POLLWRNORM
+#define EPOLLWRBAND    POLLWRBAND
+#define EPOLLERR       POLLERR
+#define EPOLLHUP       POLLHUP
+
+#define EPOLLONESHOT   (1u << 30)	/* Disable the descriptor once it is reported */
+#define EPOLLET        (1u << 31)	/* Report a descriptor when it becomes ready only */
+
+/****************************************************************************
+ * Public Type Definitions
+ ****************************************************************************/
+
+typedef union epoll_data {
+	FAR void *ptr;
+	int fd;
+	uint32_t u32;
+	uint64_t u64;
+} epoll_data_t;
+
+struct epoll_event {
+	uint32_t events;			/* The events and flags */
+	epoll_data_t data;			/* Returned as given to epoll_ctl() */
+};
+
+/****************************************************************************
+ * Public Function Prototypes
+ ****************************************************************************/
+
+#undef EXTERN
+#if defined(__cplusplus)
+#define EXTERN extern "C"
+extern "C" {
+#else
+#define EXTERN extern
+#endif
+
+/**
+ * @brief Create an epoll instance
+ * @details @b #include <sys/epoll.h> \n
+ * The interest list of the instance is kept until it is closed, so the
+ * descriptors are not set up again on every wait.
+ * @param[in] size Ignored, but must be greater than zero
+ * @return On success, the descriptor of the instance is returned.  On
+ *   failure, -1 is returned and errno is set.
+ * @since TizenRT v4.0
+ */
+int epoll_create(int size);
+
+/**
+ * @brief Change the interest list of an epoll instance
+ * @details @b #include <sys/epoll.h> \n
+ * A file, pipe, device or socket descriptor is added, changed or removed.
+ * A descriptor must be removed before it is closed.
+ * @param[in] epfd The descriptor of the epoll instance
+ * @param[in] op EPOLL_CTL_ADD, EPOLL_CTL_MOD or EPOLL_CTL_DEL
+ * @param[in] fd The descriptor of interest
+ * @param[in] ev The events of interest and the data to return, ignored by
+ *   EPOLL_CTL_DEL
+ * @return On success, OK is returned.  On failure, -1 is returned and errno
+ *   is set.
+ * @since TizenRT v4.0
+ */
+int epoll_ctl(int epfd, int op, int fd, FAR struct epoll_event *ev);
+
+/**
+ * @brief Wait for events on an epoll instance
+ * @details @b #include <sys/epoll.h> \n
+ * Only the descriptors which became ready are visited.  A descriptor is
+ * reported while it is ready, or once per event with EPOLLET.
+ * @param[in] epfd The descriptor of the epoll instance
+ * @param[out] evs The events of the ready descriptors
+ * @param[in] maxevents The size of evs
+ * @param[in] timeout The time to wait in milliseconds, -1 to wait forever
+ * @return On success, the number of events in evs, zero on timeout.  On
+ *   failure, -1 is returned and errno is set.
+ * @since TizenRT v4.0
+ */
+int epoll_wait(int epfd, FAR struct epoll_event *evs, int maxevents, int timeout);
+
+#undef EXTERN
+#if defined(__cplusplus)
+}
+#endif
+
+#endif							/* CONFIG_EPOLL */
+#endif							/* __INCLUDE_SYS_EPOLL_H */
+/**
+ * @}
+ */
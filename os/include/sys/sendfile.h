@@ -97,6 +97,9 @@ extern "C" {
  *   nothing in TinyAra but provide some Linux compatible (and adding
  *   another 'almost standard' interface).
  *
+ *   If infd or outfd is a pipe, the pipe driver copies the data between
+ *   its buffer and the other descriptor, without an I/O buffer.
+ *
  *   NOTE: This interface is *not* specified in POSIX.1-2001, or other
  *   standards.  The implementation here is very similar to the Linux
  *   sendfile interface.  Other UNIX systems implement sendfile() with
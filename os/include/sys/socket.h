@@ -143,6 +143,18 @@ struct msghdr {
 	int msg_flags;                 /* flags on received message */
 };
 
+#ifdef CONFIG_NET_SOCKET_ZEROCOPY
+#define SOCK_ZC_MAXIOV 4               /* Max segments of a zero-copy receive */
+
+struct sock_zcbuf {
+	int iovcnt;                        /* # elements of iov in use */
+	struct iovec iov[SOCK_ZC_MAXIOV];  /* data, owned by the stack */
+	FAR void *priv;                    /* buffers of the stack, for release_zc() */
+};
+
+typedef CODE void (*sock_zcdone_t)(FAR void *arg);
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -364,6 +376,64 @@ int getpeername(int s, struct sockaddr *name, socklen_t *namelen);
 ssize_t recvmsg(int sockfd, struct msghdr *msg, int flags);
 ssize_t sendmsg(int sockfd, struct msghdr *msg, int flags);
 
+#ifdef CONFIG_NET_SOCKET_ZEROCOPY
+/**
+* @brief   receive a message from a socket without copying it
+*
+* @details @b #include <sys/socket.h>\n
+* SYSTEM CALL API\n
+* zbuf refers to the buffers of the network stack which hold the message.
+* They are given back by release_zc(), which has to be called after every
+* call which does not fail, including one which returns 0 for an empty
+* datagram.  zbuf is emptied on entry, so release_zc() may also be called
+* after a failure or the shutdown of the peer.  A datagram is returned whole,
+* while the data of a stream socket which does not fit in SOCK_ZC_MAXIOV
+* segments is left for the next call.  MSG_PEEK is not supported.
+* @param[in] sockfd the file descriptor associated with the socket.
+* @param[out] zbuf  the segments of the message
+* @param[in] flags the type of message reception
+* @param[inout] from  A null pointer, or pointer to  sockaddr structure in which the sending address is to be stored
+* @param[inout] fromlen  null or the length of the sockaddr structure
+* @return On success, returns the length of the message in bytes, which is 0 for an empty datagram, or 0 with no segment if the peer has shut down. On failure, -1 is returned and zbuf holds no segment.
+* @since TizenRT v4.0
+*/
+ssize_t recv_zc(int sockfd, FAR struct sock_zcbuf *zbuf, int flags, FAR struct sockaddr *from, FAR socklen_t *fromlen);
+
+/**
+* @brief   give back the buffers of recv_zc()
+*
+* @details @b #include <sys/socket.h>\n
+* SYSTEM CALL API\n
+* @param[in] zbuf  the segments filled by recv_zc()
+* @return none
+* @since TizenRT v4.0
+*/
+void release_zc(FAR struct sock_zcbuf *zbuf);
+
+/**
+* @brief   send a message on a socket without copying it
+*
+* @details @b #include <sys/socket.h>\n
+* SYSTEM CALL API\n
+* The buffer of a datagram is given to the network driver as it is, and must
+* not be changed until done is called with arg.  done is called exactly once,
+* on failure as well, possibly after send_zc() returns and from the context
+* of the network stack, so it must not block.  The data of a stream socket is
+* copied, as by sendto(), and done is called before send_zc() returns.
+* @param[in] sockfd the file descriptor associated with the socket.
+* @param[in] buf  Pointer to the buffer containing the message to send.
+* @param[in] len the length of the message in bytes.
+* @param[in] flags the type of message transmission
+* @param[in] to pointer to a sockaddr structure containing the destination address
+* @param[in] tolen  the length of the sockaddr structure
+* @param[in] done  null or the function called when buf is not used any more
+* @param[in] arg  the argument of done
+* @return On success, returns the number of bytes sent, On failure, -1 is returned.
+* @since TizenRT v4.0
+*/
+ssize_t send_zc(int sockfd, FAR const void *buf, size_t len, int flags, FAR const struct sockaddr *to, socklen_t tolen, sock_zcdone_t done, FAR void *arg);
+#endif
+
 #undef EXTERN
 #if defined(__cplusplus)
 }
@@ -289,7 +289,14 @@
 #ifndef CONFIG_DISABLE_POLL
 #define SYS_poll                       __SYS_poll
 #define SYS_select                     (__SYS_poll + 1)
+#ifdef CONFIG_EPOLL
+#define SYS_epoll_create               (__SYS_poll + 2)
+#define SYS_epoll_ctl                  (__SYS_poll + 3)
+#define SYS_epoll_wait                 (__SYS_poll + 4)
+#define __SYS_boardctl                 (__SYS_poll + 5)
+#else
 #define __SYS_boardctl                 (__SYS_poll + 2)
+#endif
 #else
 #define __SYS_boardctl                 __SYS_poll
 #endif
@@ -322,13 +329,19 @@
 #define __SYS_mmap                     (__SYS_filedesc + 7)
 #endif
 #define SYS_mmap                       (__SYS_mmap + 0)
-#define SYS_open                       (__SYS_mmap + 1)
-#define SYS_opendir                    (__SYS_mmap + 2)
+#if defined(CONFIG_FS_RAMMAP)
+#define SYS_munmap                     (__SYS_mmap + 1)
+#define __SYS_open                     (__SYS_mmap + 2)
+#else
+#define __SYS_open                     (__SYS_mmap + 1)
+#endif
+#define SYS_open                       (__SYS_open + 0)
+#define SYS_opendir                    (__SYS_open + 1)
 #if defined(CONFIG_PIPES)
-#define SYS_pipe                       (__SYS_mmap + 3)
-#define __SYS_readdir                  (__SYS_mmap + 4)
+#define SYS_pipe                       (__SYS_open + 2)
+#define __SYS_readdir                  (__SYS_open + 3)
 #else
-#define __SYS_readdir                  (__SYS_mmap + 3)
+#define __SYS_readdir                  (__SYS_open + 2)
 #endif
 #define SYS_readdir                    (__SYS_readdir + 0)
 #define SYS_rewinddir                  (__SYS_readdir + 1)
@@ -433,7 +446,13 @@
 #define SYS_mq_timedreceive            (__SYS_mqueue + 7)
 #define SYS_mq_timedsend               (__SYS_mqueue + 8)
 #define SYS_mq_unlink                  (__SYS_mqueue + 9)
+#ifdef CONFIG_MQ_ZEROCOPY
+#define SYS_mq_send_buf                (__SYS_mqueue + 10)
+#define SYS_mq_receive_buf             (__SYS_mqueue + 11)
+#define __SYS_environ                  (__SYS_mqueue + 12)
+#else
 #define __SYS_environ                  (__SYS_mqueue + 10)
+#endif
 #else
 #define __SYS_environ                  __SYS_mqueue
 #endif
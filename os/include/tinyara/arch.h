@@ -1723,6 +1723,22 @@ char up_romgetc(FAR const char *ptr);
 void up_mdelay(unsigned int milliseconds);
 void up_udelay(useconds_t microseconds);
 
+/****************************************************************************
+ * Name: up_perf_gettime and up_perf_getfreq
+ *
+ * Description:
+ *   up_perf_gettime() returns a free running 32-bit cycle counter which may
+ *   be read from any context, including interrupt handlers.  It wraps, so
+ *   only differences of nearby values are meaningful.  up_perf_getfreq()
+ *   returns the rate of that counter in Hz.
+ *
+ ***************************************************************************/
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+uint32_t up_perf_gettime(void);
+uint32_t up_perf_getfreq(void);
+#endif
+
 /****************************************************************************
  * Name: up_cxxinitialize
  *
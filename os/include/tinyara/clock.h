@@ -202,6 +202,9 @@
 struct cpuload_s {
 	volatile uint32_t total;	/* Total number of clock ticks */
 	volatile uint32_t active;	/* Number of ticks while this thread was active */
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	uint64_t runtime;			/* Microseconds on this thread since it was created */
+#endif
 };
 
 #ifdef CONFIG_SCHED_MULTI_CPULOAD
@@ -370,6 +373,26 @@ int clock_cpuload(int pid, int index, FAR struct cpuload_s *cpuload);
  */
 #endif
 
+/****************************************************************************
+ * Function:  clock_cpuload_irq
+ *
+ * Description:
+ *   Return load measurement data for the interrupt handlers, as
+ *   clock_cpuload() does for a thread.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+/**
+ * @cond
+ * @internal
+ */
+int clock_cpuload_irq(int index, FAR struct cpuload_s *cpuload);
+/**
+ * @endcond
+ */
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
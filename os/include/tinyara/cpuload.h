@@ -24,11 +24,26 @@
  ****************************************************************************/
 #include <tinyara/config.h>
 
+#include <stdint.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 #define CPULOAD_DRVPATH     "/dev/cpuload"
 
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+/* Result of CPULOADIOC_GETTIMES, in microseconds since boot */
+
+struct cpuload_times_s {
+	uint64_t idle;				/* Time in the idle thread */
+	uint64_t irq;				/* Time in interrupt handlers */
+};
+#endif
+
 void cpuload_initialize(void);
 
 #ifdef __cplusplus
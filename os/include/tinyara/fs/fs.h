@@ -296,6 +296,19 @@ struct file {
 	void *f_priv;				/* Per file driver private data */
 };
 
+/* This is the argument of the PIPEIOC_SPLICETO and PIPEIOC_SPLICEFROM
+ * commands.  The pipe driver moves the data between the pipe and fd, and
+ * the ioctl returns the number of bytes moved, or zero at the end of the
+ * data.
+ */
+
+#ifdef CONFIG_PIPES
+struct pipe_splice_s {
+	int fd;						/* File or socket descriptor to write or read */
+	size_t count;				/* Maximum number of bytes to move */
+};
+#endif
+
 /* This defines a list of files indexed by the file descriptor */
 
 #if CONFIG_NFILE_DESCRIPTORS > 0
@@ -1020,6 +1033,38 @@ int file_poll(FAR struct file *filep, FAR struct pollfd *fds, bool setup);
 
 int fdesc_poll(int fd, FAR struct pollfd *fds, bool setup);
 
+/****************************************************************************
+ * Name: poll_post
+ *
+ * Description:
+ *   Wake up the waiter of fds once the events it waits for are set in
+ *   fds->revents.  The semaphore of poll() and select() is posted, and the
+ *   callback of epoll() is called.  May be called from an interrupt handler.
+ *
+ * Input Parameters:
+ *   fds   - The structure describing the events which occurred
+ *
+ ****************************************************************************/
+
+void poll_post(FAR struct pollfd *fds);
+
+/* fs/vfs/fs_epoll.c ********************************************************/
+/****************************************************************************
+ * Name: epoll_fdclose
+ *
+ * Description:
+ *   Remove fd from the interest lists of the epoll instances of the task
+ *   group.  Called by close() before fd is closed.
+ *
+ * Input Parameters:
+ *   fd - The descriptor which is being closed
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_EPOLL
+void epoll_fdclose(int fd);
+#endif
+
 /* fs/driver/block/fs_blockproxy.c ******************************************/
 /****************************************************************************
  * Name: unique_chardev_initialize
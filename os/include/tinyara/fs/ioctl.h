@@ -364,6 +364,16 @@
 											 *       (default)
 											 *     1=fre when empty
 											 * OUT: None */
+#define PIPEIOC_SPLICETO   _PIPEIOC(0x0002)	/* Move data from the pipe to
+											 * another descriptor
+											 * IN: Pointer to struct
+											 *     pipe_splice_s
+											 * OUT: None */
+#define PIPEIOC_SPLICEFROM _PIPEIOC(0x0003)	/* Move data from another
+											 * descriptor to the pipe
+											 * IN: Pointer to struct
+											 *     pipe_splice_s
+											 * OUT: None */
 /* RTC driver ioctl definitions *********************************************/
 /* (see include/tinyara/rtc.h */
 
@@ -441,6 +451,7 @@
 #define CPULOADIOC_START              _CPULOADIOC(0x0001)
 #define CPULOADIOC_STOP               _CPULOADIOC(0x0002)
 #define CPULOADIOC_GETVALUE           _CPULOADIOC(0x0003)
+#define CPULOADIOC_GETTIMES           _CPULOADIOC(0x0004)
 
 /* Audio driver ioctl definitions *************************************/
 /* (see tinyara/audio/audio.h) */
@@ -113,6 +113,11 @@ struct mtd_smart_procfs_data_s {
 #ifdef CONFIG_MTD_SMART_WEAR_LEVEL
 	uint32_t uneven_wearcount;	/* Number of uneven block erases */
 #endif
+#ifdef CONFIG_MTD_SMART_MINIMIZE_RAM
+	uint32_t cachehits;			/* Map lookups found in the cache */
+	uint32_t cachemisses;		/* Map lookups which read the FLASH */
+	uint32_t cachereads;		/* Sector headers read by the misses */
+#endif
 };
 
 /* The following defines debug command data passed from the procfs layer to
@@ -58,7 +58,8 @@ enum logm_logflag_e {
 
 /* Log index means where messages are from */
 enum logm_logindex_e {
-	LOGM_UNKNOWN
+	LOGM_UNKNOWN,
+	LOGM_PRINTF		/* printf() routed through logm */
 	/* Not supported yet. This would be updated later */
 };
 
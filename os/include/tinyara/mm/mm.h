@@ -170,6 +170,32 @@
 #define MM_MAX_CHUNK     (1 << MM_MAX_SHIFT)
 #define MM_NNODES        (MM_MAX_SHIFT - MM_MIN_SHIFT + 1)
 
+/* Free list organization.
+ *
+ * By default there is one size-sorted free list per power-of-two class.
+ * With CONFIG_MM_TLSF each class is split into MM_TLSF_SL_COUNT unsorted
+ * second level lists and the heap keeps a bitmap of non-empty lists, so a
+ * fitting list can be found without walking any of them.
+ *
+ * MM_NFREELISTS is the number of free list heads in mm_nodelist[] and
+ * MM_FREELIST_CLASS() maps a free list index back to its power-of-two
+ * class (the index used by the default allocator).
+ */
+
+#ifdef CONFIG_MM_TLSF
+#define MM_TLSF_SL_SHIFT  CONFIG_MM_TLSF_SL_SHIFT
+#define MM_TLSF_SL_COUNT  (1 << MM_TLSF_SL_SHIFT)
+#define MM_NFREELISTS     (MM_NNODES << MM_TLSF_SL_SHIFT)
+#define MM_FREELIST_CLASS(ndx) ((ndx) >> MM_TLSF_SL_SHIFT)
+
+#if MM_TLSF_SL_SHIFT > MM_MIN_SHIFT
+#error CONFIG_MM_TLSF_SL_SHIFT must not be larger than MM_MIN_SHIFT
+#endif
+#else
+#define MM_NFREELISTS     MM_NNODES
+#define MM_FREELIST_CLASS(ndx) (ndx)
+#endif
+
 #define MM_GRAN_MASK     (MM_MIN_CHUNK-1)
 #define MM_ALIGN_UP(a)   (((a) + MM_GRAN_MASK) & ~MM_GRAN_MASK)
 #define MM_ALIGN_DOWN(a) ((a) & ~MM_GRAN_MASK)
@@ -389,7 +415,17 @@ struct mm_heap_s {
 	 * speed searches for free nodes.
 	 */
 
-	struct mm_freenode_s mm_nodelist[MM_NNODES + 1];
+	struct mm_freenode_s mm_nodelist[MM_NFREELISTS + 1];
+
+#ifdef CONFIG_MM_TLSF
+	/* Bit n of mm_fl_bitmap is set if any second level list of the
+	 * power-of-two class n is non-empty.  Bit m of mm_sl_bitmap[n] is set
+	 * if mm_nodelist[(n << MM_TLSF_SL_SHIFT) + m] is non-empty.
+	 */
+
+	uint32_t mm_fl_bitmap;
+	uint32_t mm_sl_bitmap[MM_NNODES];
+#endif
 };
 
 /****************************************************************************
@@ -668,6 +704,13 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 int mm_size2ndx(size_t size);
 
+#ifdef CONFIG_MM_TLSF
+/* Functions contained in mm_tlsf.c *****************************************/
+
+int mm_tlsf_findlist(FAR struct mm_heap_s *heap, size_t size);
+void mm_tlsf_removechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node);
+#endif
+
 #ifdef CONFIG_DEBUG_MM_HEAPINFO
 /* Functions contained in kmm_mallinfo.c . Used to display memory allocation details */
 void heapinfo_parse_heap(FAR struct mm_heap_s *heap, int mode, pid_t pid);
@@ -718,6 +761,20 @@ size_t kmm_get_heap_free_size(void);
 size_t umm_get_heap_free_size(void);
 #endif
 
+#ifdef CONFIG_MM_SMALL_CACHE
+/* Functions contained in umm_cache.c ***************************************/
+
+struct task_group_s;			/* Forward reference */
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *umm_cache_alloc(size_t size, mmaddress_t caller_retaddr);
+#else
+FAR void *umm_cache_alloc(size_t size);
+#endif
+bool umm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem);
+void umm_cache_release(FAR struct task_group_s *group);
+size_t umm_cache_get_size(void);
+#endif
+
 /* Function to check heap corruption */
 int mm_check_heap_corruption(struct mm_heap_s *heap);
 
@@ -491,6 +491,12 @@ struct task_group_s {
 	struct group_shm_s tg_shm;	/* Task shared memory logic                 */
 #endif
 
+#ifdef CONFIG_MM_SMALL_CACHE
+	/* Small Object Cache ******************************************************** */
+
+	FAR struct umm_cache_s *tg_mmcache;	/* Magazines of free small chunks       */
+#endif
+
 #if defined(CONFIG_PREFERENCE) && CONFIG_TASK_NAME_SIZE > 0
 	/* Preference **************************************************************** */
 	/* The values of private preference are managed by task group.
@@ -860,6 +866,16 @@ void sched_clear_cpuload_snapshot(void);
 void sched_get_cpuload_snapshot(pid_t *result_addr);
 #endif
 
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+/* Called by the architecture before tcb is restored, with interrupts
+ * disabled, and at the entry and exit of interrupt handling.
+ */
+
+void sched_cpuload_switch(FAR struct tcb_s *tcb);
+void sched_cpuload_irqenter(void);
+void sched_cpuload_irqexit(void);
+#endif
+
 /********************************************************************************
  * Name: task_starthook
  *
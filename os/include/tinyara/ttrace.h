@@ -162,18 +162,92 @@ int trace_end_uid(int tag);
  * @since TizenRT v1.1
  */
 int trace_sched(struct tcb_s *prev, struct tcb_s *next);
+
+#if defined(__cplusplus)
+}
+#endif
+
 #else
 #define trace_begin(a, b, ...)
 #define trace_begin_uid(a, b)
 #define trace_end(a)
 #define trace_end_uid(a)
 #define trace_sched(a, b)
+#endif /* CONFIG_TTRACE */
+
+/****************************************************************************
+ * Kernel Events
+ ****************************************************************************/
+
+#ifdef CONFIG_TTRACE_EVENTS
+/* Kernel event types, see ttrace_event() for the meaning of the fields */
+
+#define TTRACE_EV_SWITCH           1	/* pid: next task, arg8: its priority */
+#define TTRACE_EV_IRQ_ENTER        2	/* arg: IRQ number */
+#define TTRACE_EV_IRQ_LEAVE        3	/* arg: IRQ number */
+#define TTRACE_EV_SEM_BLOCK        4	/* pid: waiting task, arg: semaphore */
+#define TTRACE_EV_SEM_WAKE         5	/* pid: woken task, arg: semaphore */
+#define TTRACE_EV_MQ_SEND          6	/* pid: sender, arg8: prio, arg: queue */
+#define TTRACE_EV_MQ_RECV          7	/* pid: receiver, arg8: prio, arg: queue */
+
+#define TTRACE_EV_MAGIC            "TTEV"
+#define TTRACE_EV_VERSION          1
+
+/* One event in the trace buffer, 12 bytes */
+
+struct ttrace_event_s {
+	uint32_t timestamp;        /* up_perf_gettime() or system ticks */
+	uint8_t type;              /* TTRACE_EV_* */
+	uint8_t arg8;
+	int16_t pid;               /* -1 if not related to a task */
+	uint32_t arg;
+};
+
+/* The buffer read from CONFIG_TTRACE_EVENTS_DEVPATH is this header,
+ * 'ntasks' struct ttrace_evtask_s for the tasks alive when the device was
+ * opened and then 'nevents' events, oldest first.
+ */
+
+struct ttrace_evdump_s {
+	char magic[4];             /* TTRACE_EV_MAGIC */
+	uint32_t version;          /* TTRACE_EV_VERSION */
+	uint32_t freq;             /* Timestamp frequency in Hz */
+	uint32_t nevents;
+	uint32_t ntasks;
+	uint32_t lost;             /* Events overwritten since the last start */
+};
+
+struct ttrace_evtask_s {
+	int16_t pid;
+	uint8_t prio;
+	uint8_t flags;             /* TCB_FLAG_TTYPE_* of the task */
+	char name[TTRACE_COMM_BYTES];
+};
+
+extern volatile bool g_ttrace_ev_enabled;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+void ttrace_event_put(uint8_t type, pid_t pid, uint8_t arg8, uint32_t arg);
+int ttrace_event_register(void);
 
 #if defined(__cplusplus)
 }
 #endif
 
-#endif /* CONFIG_TTRACE */
+/* Tracepoints cost a load and a branch while recording is stopped */
+
+#define ttrace_event(type, pid, arg8, arg) \
+	do { \
+		if (g_ttrace_ev_enabled) { \
+			ttrace_event_put(type, pid, arg8, (uint32_t)(arg)); \
+		} \
+	} while (0)
+#else
+#define ttrace_event(type, pid, arg8, arg)
+#endif /* CONFIG_TTRACE_EVENTS */
 #endif /* __INCLUDE_TINYARA_TTRACE_INTERNAL_H */
 /**
  * @}
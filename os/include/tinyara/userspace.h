@@ -90,6 +90,14 @@ struct userspace_s {
 #ifndef CONFIG_DISABLE_SIGNALS
 	void (*signal_handler)(_sa_sigaction_t sighand, int signo, FAR siginfo_t *info, FAR void *ucontext);
 #endif
+
+	/* Pid of the running task, set by the kernel on every context switch.
+	 * The semaphore fast path records it as the holder of a count.
+	 */
+
+#ifdef CONFIG_SEM_FASTPATH
+	FAR volatile pid_t *curpid;
+#endif
 };
 
 /****************************************************************************
@@ -103,6 +111,12 @@ extern "C" {
 #define EXTERN extern
 #endif
 
+#if defined(CONFIG_SEM_FASTPATH) && !defined(__KERNEL__)
+/* Defined in sem_fastpath.c */
+
+EXTERN volatile pid_t g_sem_curpid;
+#endif
+
 /****************************************************************************
  * Public Function Prototypes
  ****************************************************************************/
@@ -287,8 +287,26 @@ struct work_s {
 	FAR void *arg;				/* Callback argument */
 	clock_t qtime;			/* Time work queued */
 	clock_t delay;			/* Delay until work performed */
+	FAR struct work_s *child;	/* First child in the heap of delayed work */
+	FAR void *wqueue;			/* The work queue the work is pending on */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	uint32_t qstamp;			/* Cycle counter when the work was queued */
+#endif
 };
 
+/* Statistics of one work queue, times are in microseconds */
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+struct work_stats_s {
+	uint32_t nrun;				/* Number of work items run */
+	uint32_t latency_max;		/* Longest delay from due to run */
+	uint64_t latency_total;		/* Sum of the delays from due to run */
+	uint32_t runtime_max;		/* Longest run time of a worker */
+	uint64_t runtime_total;		/* Sum of the run times */
+	worker_t runtime_maxworker;	/* The worker with the longest run time */
+};
+#endif
+
 /****************************************************************************
  * Public Data
  ****************************************************************************/
@@ -432,6 +450,29 @@ int work_cancel(int qid, FAR struct work_s *work);
 
 int work_signal(int qid);
 
+/****************************************************************************
+ * Name: work_getstats
+ *
+ * Description:
+ *   Get the statistics of a kernel work queue.  Delays are measured from
+ *   the time the work was due, i.e. the time it was queued plus its delay,
+ *   to the time the worker was called.
+ *
+ * Input parameters:
+ *   qid    - The work queue ID (must be HPWORK or LPWORK)
+ *   stats  - Location to return the statistics
+ *
+ * Returned Value:
+ *   Zero on success, a negated errno on failure
+ *
+ *   -EINVAL - An invalid work queue was specified
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+int work_getstats(int qid, FAR struct work_stats_s *stats);
+#endif
+
 /****************************************************************************
  * Name: work_available
  *
@@ -48,7 +48,7 @@
 /* Move tcb from current state list to inactive list */
 #define BM_DEACTIVATE_TASK(tcb) \
 	do { \
-		dq_rem((FAR dq_entry_t *)tcb, (dq_queue_t *)g_tasklisttable[tcb->task_state].list); \
+		sched_removeprioritized(tcb, (dq_queue_t *)g_tasklisttable[tcb->task_state].list); \
 		dq_addlast((FAR dq_entry_t *)tcb, (FAR dq_queue_t *)g_tasklisttable[TSTATE_TASK_INACTIVE].list); \
 		tcb->task_state = TSTATE_TASK_INACTIVE; \
 	} while (0)
@@ -223,6 +223,12 @@ static inline void group_release(FAR struct task_group_s *group)
 	mq_release(group);
 #endif
 
+#ifdef CONFIG_MM_SMALL_CACHE
+	/* Give the cached small objects back to the user heap */
+
+	umm_cache_release(group);
+#endif
+
 #if defined(CONFIG_BUILD_KERNEL) && defined(CONFIG_MM_SHM)
 	/* Release any resource held by shared memory virtual page allocator */
 
@@ -101,6 +101,9 @@
 #ifdef CONFIG_LOG_DUMP
 #include <tinyara/log_dump/log_dump_internal.h>
 #endif
+#ifdef CONFIG_PREFERENCE_LOG
+#include  "preference/preference.h"
+#endif
 
 extern const uint32_t g_idle_topstack;
 
@@ -140,6 +143,13 @@ volatile dq_queue_t g_readytorun;
 
 volatile dq_queue_t g_pendingtasks;
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+/* These index the g_readytorun and the g_pendingtasks lists */
+
+struct sched_prioindex_s g_readytorun_index;
+struct sched_prioindex_s g_pendingtasks_index;
+#endif
+
 /* This is the list of all tasks that are blocked waiting for a semaphore */
 
 volatile dq_queue_t g_waitingforsemaphore;
@@ -556,6 +566,12 @@ void os_start(void)
 	shm_initialize();
 #endif
 
+#ifdef CONFIG_PREFERENCE_LOG
+	/* Initialize the log of preferences */
+
+	preference_log_initialize();
+#endif
+
 	/* Initialize the C libraries.  This is done last because the libraries
 	 * may depend on the above.
 	 */
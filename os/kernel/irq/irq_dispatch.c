@@ -59,6 +59,7 @@
 #include <debug.h>
 #include <tinyara/arch.h>
 #include <tinyara/irq.h>
+#include <tinyara/ttrace.h>
 
 #include "irq/irq.h"
 
@@ -128,5 +129,13 @@ void irq_dispatch(int irq, FAR void *context)
 
 	/* Then dispatch to the interrupt handler */
 
+#ifdef CONFIG_TTRACE_EVENTS_IRQ
+	ttrace_event(TTRACE_EV_IRQ_ENTER, -1, 0, irq);
+#endif
+
 	vector(irq, context, arg);
+
+#ifdef CONFIG_TTRACE_EVENTS_IRQ
+	ttrace_event(TTRACE_EV_IRQ_LEAVE, -1, 0, irq);
+#endif
 }
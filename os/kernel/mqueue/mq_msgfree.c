@@ -107,6 +107,17 @@ void mq_msgfree(FAR struct mqueue_msg_s *mqmsg)
 {
 	irqstate_t saved_state;
 
+#ifdef CONFIG_MQ_ZEROCOPY
+	/* The buffer of a zero-copy message is not needed after it was copied
+	 * by mq_receive() or when the queue is destroyed.
+	 */
+
+	if (mqmsg->buf) {
+		kumm_free(mqmsg->buf);
+		mqmsg->buf = NULL;
+	}
+#endif
+
 	/* If this is a generally available pre-allocated message,
 	 * then just put it back in the free list.
 	 */
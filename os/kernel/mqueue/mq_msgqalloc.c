@@ -117,10 +117,12 @@ FAR struct mqueue_inode_s *mq_msgqalloc(mode_t mode, FAR struct mq_attr *attr)
 	 * larger than the configured maximum message size.
 	 */
 
+#ifndef CONFIG_MQ_ZEROCOPY
 	DEBUGASSERT(!attr || attr->mq_msgsize <= MQ_MAX_BYTES);
 	if (attr && attr->mq_msgsize > MQ_MAX_BYTES) {
 		return NULL;
 	}
+#endif
 
 	/* Allocate memory for the new message queue. */
 
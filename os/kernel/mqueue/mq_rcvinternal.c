@@ -254,7 +254,8 @@ FAR struct mqueue_msg_s *mq_waitreceive(mqd_t mqdes)
  * Parameters:
  *   mqdes - Message queue descriptor
  *   mqmsg   - The message obtained by mq_waitmsg()
- *   ubuffer - The address of the user provided buffer to receive the message
+ *   ubuffer - The address of the user provided buffer to receive the message,
+ *             NULL if the caller has already taken the message data
  *   prio    - The user-provided location to return the message priority.
  *
  * Return Value:
@@ -284,7 +285,16 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuf
 
 	/* Copy the message into the caller's buffer */
 
-	memcpy(ubuffer, (const void *)mqmsg->mail, rcvmsglen);
+	if (ubuffer) {
+#ifdef CONFIG_MQ_ZEROCOPY
+		if (mqmsg->buf) {
+			memcpy(ubuffer, mqmsg->buf, rcvmsglen);
+		} else
+#endif
+		{
+			memcpy(ubuffer, (const void *)mqmsg->mail, rcvmsglen);
+		}
+	}
 
 	/* Copy the message priority as well (if a buffer is provided) */
 
@@ -292,6 +302,8 @@ ssize_t mq_doreceive(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR char *ubuf
 		*prio = mqmsg->priority;
 	}
 
+	ttrace_event(TTRACE_EV_MQ_RECV, this_task()->pid, mqmsg->priority, mqdes->msgq);
+
 	/* We are done with the message.  Deallocate it now. */
 
 	mq_msgfree(mqmsg);
@@ -0,0 +1,160 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <sys/types.h>
+#include <fcntl.h>
+#include <string.h>
+#include <assert.h>
+#include <errno.h>
+#include <mqueue.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/cancelpt.h>
+
+#include "mqueue/mqueue.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_requeue
+ *
+ * Description:
+ *   Put back a message taken by mq_waitreceive() ahead of the messages of
+ *   the same priority, where it was taken from.
+ *
+ ****************************************************************************/
+
+static void mq_requeue(FAR struct mqueue_inode_s *msgq, FAR struct mqueue_msg_s *mqmsg)
+{
+	FAR struct mqueue_msg_s *next;
+	FAR struct mqueue_msg_s *prev;
+	irqstate_t saved_state;
+
+	saved_state = irqsave();
+
+	for (prev = NULL, next = (FAR struct mqueue_msg_s *)msgq->msglist.head; next && mqmsg->priority < next->priority; prev = next, next = next->next) ;
+
+	if (prev) {
+		sq_addafter((FAR sq_entry_t *)prev, (FAR sq_entry_t *)mqmsg, &msgq->msglist);
+	} else {
+		sq_addfirst((FAR sq_entry_t *)mqmsg, &msgq->msglist);
+	}
+
+	msgq->nmsgs++;
+	irqrestore(saved_state);
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_receive_buf
+ *
+ * Description:
+ *   This function receives the oldest of the highest priority messages
+ *   from the message queue specified by "mqdes" like mq_receive(), but
+ *   returns the buffer holding the message instead of copying it.  The
+ *   caller owns the buffer and must release it with free().  Messages sent
+ *   with mq_send() are returned in a newly allocated buffer.
+ *
+ * Parameters:
+ *   mqdes - Message Queue Descriptor
+ *   buf - Location to return the buffer holding the message
+ *   prio - If not NULL, the location to store message priority.
+ *
+ * Return Value:
+ *   One success, the length of the selected message in bytes is returned.
+ *   On failure, -1 (ERROR) is returned and the errno is set as by
+ *   mq_receive(), or to ENOMEM if no buffer could be allocated for a copied
+ *   message, which is then left in the queue.
+ *
+ ****************************************************************************/
+
+ssize_t mq_receive_buf(mqd_t mqdes, FAR void **buf, FAR int *prio)
+{
+	FAR struct mqueue_msg_s *mqmsg;
+	irqstate_t saved_state;
+	ssize_t ret = ERROR;
+
+	DEBUGASSERT(up_interrupt_context() == false);
+
+	/* mq_receive_buf() is a cancellation point */
+	(void)enter_cancellation_point();
+
+	if (!buf || !mqdes) {
+		set_errno(EINVAL);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	if ((mqdes->oflags & O_RDOK) == 0) {
+		set_errno(EPERM);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	/* Get the next message with pre-emption disabled, as mq_receive()
+	 * does, so that a message can be put back in place if needed.
+	 */
+
+	sched_lock();
+
+	saved_state = irqsave();
+	mqmsg = mq_waitreceive(mqdes);
+	irqrestore(saved_state);
+
+	if (mqmsg) {
+		if (mqmsg->buf) {
+			/* Take over the buffer of the sender */
+
+			*buf = mqmsg->buf;
+			mqmsg->buf = NULL;
+		} else {
+			/* A copied message, give it a buffer of its own */
+
+			*buf = kumm_malloc(mqmsg->msglen > 0 ? mqmsg->msglen : 1);
+			if (*buf == NULL) {
+				mq_requeue(mqdes->msgq, mqmsg);
+				mqmsg = NULL;
+				set_errno(ENOMEM);
+			} else {
+				memcpy(*buf, mqmsg->mail, mqmsg->msglen);
+			}
+		}
+	}
+
+	sched_unlock();
+
+	if (mqmsg) {
+		ret = mq_doreceive(mqdes, mqmsg, NULL, prio);
+	}
+
+	leave_cancellation_point();
+	return ret;
+}
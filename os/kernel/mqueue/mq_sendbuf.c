@@ -0,0 +1,170 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include  <tinyara/config.h>
+
+#include  <sys/types.h>
+#include  <stdbool.h>
+#include  <unistd.h>
+#include  <fcntl.h>
+#include  <mqueue.h>
+#include  <errno.h>
+#include  <debug.h>
+
+#include  <tinyara/arch.h>
+#include  <tinyara/cancelpt.h>
+#include  <tinyara/mm/mm.h>
+
+#include  "mqueue/mqueue.h"
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_bufowned
+ *
+ * Description:
+ *   Check that the buffer is an allocated chunk of the user heap, large
+ *   enough for the message and, when the heap records owners, allocated by
+ *   the caller.  mq_msgfree() gives the buffer back with kumm_free().
+ *
+ ****************************************************************************/
+
+static bool mq_bufowned(FAR void *buf, size_t msglen)
+{
+	FAR struct mm_allocnode_s *node;
+
+	if (umm_get_heap(buf) == NULL) {
+		return false;
+	}
+
+	node = (FAR struct mm_allocnode_s *)((FAR char *)buf - SIZEOF_MM_ALLOCNODE);
+	if ((node->preceding & MM_ALLOC_BIT) == 0 || node->size - SIZEOF_MM_ALLOCNODE < msglen) {
+		return false;
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	if (!up_interrupt_context() && node->pid != getpid()) {
+		return false;
+	}
+#endif
+
+	return true;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mq_send_buf
+ *
+ * Description:
+ *   This function adds a message to the message queue (mqdes) like
+ *   mq_send(), but the message structure only carries the buffer of the
+ *   caller instead of a copy of its content.  The ownership of the buffer,
+ *   which must have been allocated with malloc(), passes to the message
+ *   queue on success.  The receiver gets it from mq_receive_buf() or it is
+ *   copied and freed by mq_receive().
+ *
+ * Parameters:
+ *   mqdes - Message queue descriptor
+ *   buf - Buffer holding the message
+ *   msglen - The length of the message in bytes
+ *   prio - The priority of the message
+ *
+ * Return Value:
+ *   On success, mq_send_buf() returns 0 (OK); on error, -1 (ERROR)
+ *   is returned, with errno set as by mq_send() or to EINVAL if the buffer
+ *   is not a heap buffer of the caller, and the buffer remains owned by the
+ *   caller.
+ *
+ ****************************************************************************/
+
+int mq_send_buf(mqd_t mqdes, FAR void *buf, size_t msglen, int prio)
+{
+	FAR struct mqueue_inode_s *msgq;
+	FAR struct mqueue_msg_s *mqmsg = NULL;
+	irqstate_t saved_state;
+	int ret = ERROR;
+
+	/* mq_send_buf() is a cancellation point */
+	(void)enter_cancellation_point();
+
+	/* Verify the input parameters.  Unlike mq_send(), the message is only
+	 * limited by the maxmsgsize attribute of the message queue.
+	 */
+
+	if (!buf || !mqdes || prio < 0 || prio > MQ_PRIO_MAX) {
+		set_errno(EINVAL);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	if ((mqdes->oflags & O_WROK) == 0) {
+		set_errno(EPERM);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	if (msglen > mqdes->msgq->maxmsgsize) {
+		set_errno(EMSGSIZE);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	if (!mq_bufowned(buf, msglen)) {
+		set_errno(EINVAL);
+		leave_cancellation_point();
+		return ERROR;
+	}
+
+	/* Get a pointer to the message queue */
+
+	msgq = mqdes->msgq;
+
+	/* Allocate a message structure as mq_send() does */
+
+	saved_state = irqsave();
+	if (up_interrupt_context() ||	/* In an interrupt handler */
+		msgq->nmsgs < msgq->maxmsgs ||	/* OR Message queue not full */
+		mq_waitsend(mqdes) == OK) {	/* OR Successfully waited for mq not full */
+		irqrestore(saved_state);
+		mqmsg = mq_msgalloc();
+	} else {
+		irqrestore(saved_state);
+	}
+
+	sched_lock();
+
+	if (mqmsg) {
+		/* Attach the buffer and perform the message send */
+
+		mqmsg->buf = buf;
+		ret = mq_dosend(mqdes, mqmsg, (FAR const char *)buf, msglen, prio);
+	}
+
+	sched_unlock();
+	leave_cancellation_point();
+	return ret;
+}
@@ -146,6 +146,17 @@ int mq_verifysend(mqd_t mqdes, FAR const char *msg, size_t msglen, int prio)
 		return ERROR;
 	}
 
+#ifdef CONFIG_MQ_ZEROCOPY
+	/* The queue may accept zero-copy messages larger than a message
+	 * structure can hold.
+	 */
+
+	if (msglen > MQ_MAX_BYTES) {
+		set_errno(EMSGSIZE);
+		return ERROR;
+	}
+#endif
+
 	return OK;
 }
 
@@ -227,6 +238,12 @@ FAR struct mqueue_msg_s *mq_msgalloc(void)
 		}
 	}
 
+#ifdef CONFIG_MQ_ZEROCOPY
+	if (mqmsg) {
+		mqmsg->buf = NULL;
+	}
+#endif
+
 	return mqmsg;
 }
 
@@ -373,9 +390,16 @@ int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg,
 	mqmsg->priority = prio;
 	mqmsg->msglen = msglen;
 
-	/* Copy the message data into the message */
+	/* Copy the message data into the message, unless it is a zero-copy
+	 * message which only carries the buffer of the sender.
+	 */
 
-	memcpy((void *)mqmsg->mail, (FAR const void *)msg, msglen);
+#ifdef CONFIG_MQ_ZEROCOPY
+	if (mqmsg->buf == NULL)
+#endif
+	{
+		memcpy((void *)mqmsg->mail, (FAR const void *)msg, msglen);
+	}
 
 	/* Insert the new message in the message queue */
 
@@ -400,6 +424,8 @@ int mq_dosend(mqd_t mqdes, FAR struct mqueue_msg_s *mqmsg, FAR const char *msg,
 	msgq->nmsgs++;
 	irqrestore(saved_state);
 
+	ttrace_event(TTRACE_EV_MQ_SEND, this_task()->pid, prio, msgq);
+
 	/* Check if we need to notify any tasks that are attached to the
 	 * message queue
 	 */
@@ -109,6 +109,9 @@ struct mqueue_msg_s {
 	uint8_t type;					/* (Used to manage allocations) */
 	uint8_t priority;				/* priority of message */
 	size_t msglen;					/* Message data length */
+#ifdef CONFIG_MQ_ZEROCOPY
+	FAR void *buf;					/* Message data if zero-copy, else NULL */
+#endif
 	char mail[MQ_MAX_BYTES];		/* Message data */
 };
 
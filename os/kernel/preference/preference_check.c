@@ -25,9 +25,12 @@
 #include <sys/stat.h>
 #include <tinyara/preference.h>
 
+#include "preference.h"
+
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+#ifndef CONFIG_PREFERENCE_LOG
 static int preference_check_fs_key(char *path, bool *existing)
 {
 	int ret;
@@ -51,6 +54,7 @@ static int preference_check_fs_key(char *path, bool *existing)
 
 	return OK;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -79,5 +83,9 @@ int preference_check_key(int type, const char *key, bool *result)
 		}
 	}
 
+#ifdef CONFIG_PREFERENCE_LOG
+	return preference_log_check(path, result);
+#else
 	return preference_check_fs_key(path, result);
+#endif
 }
@@ -0,0 +1,789 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+#include <tinyara/config.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <semaphore.h>
+#include <assert.h>
+#include <errno.h>
+#include <debug.h>
+#include <crc32.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/fs/fs.h>
+#include <tinyara/preference.h>
+#ifdef CONFIG_SCHED_LPWORK
+#include <tinyara/wqueue.h>
+#endif
+
+#include "preference.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+#define PREF_LOG_PATH            PREF_PATH"/preference.log"
+#define PREF_LOG_TMPPATH         PREF_PATH"/preference.tmp"
+
+#define PREF_LOG_MAGIC           0x474f4c50	/* "PLOG" */
+#define PREF_LOG_VERSION         1
+#define PREF_LOG_REC_MAGIC       0x5052
+
+/* Operations of a record */
+
+#define PREF_LOG_OP_SET          1	/* The record holds the value of the key */
+#define PREF_LOG_OP_DELETE       2	/* The key is removed */
+
+/* Flags of a record */
+
+#define PREF_LOG_FLAG_COMMIT     0x01	/* The record ends a batch */
+
+#define PREF_LOG_RECSIZE(k, l)   (sizeof(struct pref_log_rec_s) + (k) + (l))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+/* The log begins with this header, followed by the records.  The records of
+ * a batch take effect when the record which ends the batch is read, so a
+ * batch torn by a power loss is discarded as a whole.
+ */
+
+struct pref_log_hdr_s {
+	uint32_t magic;				/* PREF_LOG_MAGIC */
+	uint32_t version;			/* PREF_LOG_VERSION */
+};
+
+/* Each record is followed by the key path, without the terminating null,
+ * and by the value.
+ */
+
+struct pref_log_rec_s {
+	uint32_t crc;				/* CRC32 of the rest of the record, key and value */
+	uint16_t magic;				/* PREF_LOG_REC_MAGIC */
+	uint8_t op;					/* PREF_LOG_OP_SET or PREF_LOG_OP_DELETE */
+	uint8_t flags;				/* PREF_LOG_FLAG_* */
+	uint16_t keylen;			/* Length of the key path */
+	uint16_t reserved;
+	int32_t type;				/* Type of the value */
+	int32_t len;				/* Length of the value */
+};
+
+/* An entry of the index, one per key */
+
+struct pref_log_entry_s {
+	FAR struct pref_log_entry_s *flink;
+	uint32_t hash;				/* Hash of the key path */
+	off_t offset;				/* Offset of the record in the log */
+	int type;					/* Type of the value */
+	int len;					/* Length of the value */
+	uint16_t keylen;			/* Length of the key path */
+	char key[1];				/* Key path, allocated with the entry */
+};
+
+struct pref_log_s {
+	sem_t sem;					/* Protects the log and the index */
+	bool loaded;				/* True once the index is built */
+	struct file file;			/* The log, opened by the kernel */
+	off_t size;					/* Size of the committed log */
+	off_t live;					/* Bytes of the records of the index */
+	FAR struct pref_log_entry_s *buckets[CONFIG_PREFERENCE_LOG_HASH_SIZE];
+#ifdef CONFIG_SCHED_LPWORK
+	struct work_s work;			/* Runs the compaction */
+#endif
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+static struct pref_log_s g_pref_log;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+static void preference_log_lock(void)
+{
+	while (sem_wait(&g_pref_log.sem) != 0) {
+		ASSERT(get_errno() == EINTR);
+	}
+}
+
+static void preference_log_unlock(void)
+{
+	sem_post(&g_pref_log.sem);
+}
+
+static uint32_t preference_log_hash(FAR const char *key, size_t keylen)
+{
+	uint32_t hash = 2166136261u;
+
+	while (keylen-- > 0) {
+		hash ^= (uint8_t)*key++;
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+static FAR struct pref_log_entry_s **preference_log_find(FAR const char *key, size_t keylen, uint32_t hash)
+{
+	FAR struct pref_log_entry_s **entryp;
+
+	entryp = &g_pref_log.buckets[hash % CONFIG_PREFERENCE_LOG_HASH_SIZE];
+	while (*entryp != NULL) {
+		if ((*entryp)->hash == hash && (*entryp)->keylen == keylen && memcmp((*entryp)->key, key, keylen) == 0) {
+			break;
+		}
+		entryp = &(*entryp)->flink;
+	}
+
+	return entryp;
+}
+
+/* Applies a record to the index */
+
+static int preference_log_apply(FAR const struct pref_log_rec_s *rec, FAR const char *key, off_t offset)
+{
+	FAR struct pref_log_entry_s **entryp;
+	FAR struct pref_log_entry_s *entry;
+	uint32_t hash;
+
+	hash = preference_log_hash(key, rec->keylen);
+	entryp = preference_log_find(key, rec->keylen, hash);
+	entry = *entryp;
+	if (entry != NULL) {
+		*entryp = entry->flink;
+		g_pref_log.live -= PREF_LOG_RECSIZE(entry->keylen, entry->len);
+	}
+
+	if (rec->op != PREF_LOG_OP_SET) {
+		kmm_free(entry);
+		return OK;
+	}
+
+	if (entry == NULL) {
+		entry = (FAR struct pref_log_entry_s *)kmm_malloc(sizeof(struct pref_log_entry_s) + rec->keylen);
+		if (entry == NULL) {
+			return PREFERENCE_OUT_OF_MEMORY;
+		}
+
+		entry->hash = hash;
+		entry->keylen = rec->keylen;
+		memcpy(entry->key, key, rec->keylen);
+		entry->key[rec->keylen] = '\0';
+	}
+
+	entry->offset = offset;
+	entry->type = rec->type;
+	entry->len = rec->len;
+	entry->flink = *entryp;
+	*entryp = entry;
+	g_pref_log.live += PREF_LOG_RECSIZE(entry->keylen, entry->len);
+
+	return OK;
+}
+
+/* Returns true if the entry is the key at path, or a key in the directory
+ * at path if all is true.  The keys of a directory are its direct children.
+ */
+
+static bool preference_log_match(FAR const struct pref_log_entry_s *entry, FAR const char *path, size_t pathlen, bool all)
+{
+	if (entry->keylen < pathlen || memcmp(entry->key, path, pathlen) != 0) {
+		return false;
+	}
+
+	if (!all) {
+		return entry->keylen == pathlen;
+	}
+
+	return entry->keylen > pathlen + 1 && entry->key[pathlen] == '/' && strchr(&entry->key[pathlen + 1], '/') == NULL;
+}
+
+static void preference_log_clear(void)
+{
+	FAR struct pref_log_entry_s *entry;
+	int i;
+
+	for (i = 0; i < CONFIG_PREFERENCE_LOG_HASH_SIZE; i++) {
+		while ((entry = g_pref_log.buckets[i]) != NULL) {
+			g_pref_log.buckets[i] = entry->flink;
+			kmm_free(entry);
+		}
+	}
+
+	g_pref_log.live = 0;
+}
+
+/* Builds a record in buffer and returns its size */
+
+static size_t preference_log_build(FAR uint8_t *buffer, uint8_t op, uint8_t flags, FAR const char *key, int type, FAR const void *value, int len)
+{
+	FAR struct pref_log_rec_s *rec = (FAR struct pref_log_rec_s *)buffer;
+	size_t keylen = strlen(key);
+
+	rec->magic = PREF_LOG_REC_MAGIC;
+	rec->op = op;
+	rec->flags = flags;
+	rec->keylen = keylen;
+	rec->reserved = 0;
+	rec->type = type;
+	rec->len = len;
+	memcpy(buffer + sizeof(struct pref_log_rec_s), key, keylen);
+	if (len > 0) {
+		memcpy(buffer + sizeof(struct pref_log_rec_s) + keylen, value, len);
+	}
+
+	rec->crc = crc32(buffer + sizeof(uint32_t), PREF_LOG_RECSIZE(keylen, len) - sizeof(uint32_t));
+
+	return PREF_LOG_RECSIZE(keylen, len);
+}
+
+/* Reads the record at offset of filep into a buffer allocated with
+ * PREFERENCE_ALLOC() and verifies it.  The record has to end before end.
+ */
+
+static int preference_log_readrec(FAR struct file *filep, off_t offset, off_t end, FAR uint8_t **bufferp)
+{
+	struct pref_log_rec_s rec;
+	FAR uint8_t *buffer;
+	size_t size;
+	ssize_t nread;
+
+	nread = file_pread(filep, &rec, sizeof(struct pref_log_rec_s), offset);
+	if (nread != sizeof(struct pref_log_rec_s)) {
+		return PREFERENCE_INVALID_DATA;
+	}
+
+	if (rec.magic != PREF_LOG_REC_MAGIC || rec.keylen == 0 || rec.len < 0 || offset + PREF_LOG_RECSIZE(rec.keylen, rec.len) > end) {
+		return PREFERENCE_INVALID_DATA;
+	}
+
+	size = PREF_LOG_RECSIZE(rec.keylen, rec.len);
+	buffer = (FAR uint8_t *)PREFERENCE_ALLOC(size);
+	if (buffer == NULL) {
+		return PREFERENCE_OUT_OF_MEMORY;
+	}
+
+	nread = file_pread(filep, buffer, size, offset);
+	if (nread != size) {
+		PREFERENCE_FREE(buffer);
+		return PREFERENCE_IO_ERROR;
+	}
+
+	if (crc32(buffer + sizeof(uint32_t), size - sizeof(uint32_t)) != ((FAR struct pref_log_rec_s *)buffer)->crc) {
+		PREFERENCE_FREE(buffer);
+		return PREFERENCE_INVALID_DATA;
+	}
+
+	*bufferp = buffer;
+	return OK;
+}
+
+/* Writes the header of an empty log */
+
+static int preference_log_format(FAR struct file *filep)
+{
+	struct pref_log_hdr_s hdr;
+
+	hdr.magic = PREF_LOG_MAGIC;
+	hdr.version = PREF_LOG_VERSION;
+	if (file_write(filep, &hdr, sizeof(struct pref_log_hdr_s)) != sizeof(struct pref_log_hdr_s)) {
+		return PREFERENCE_IO_ERROR;
+	}
+
+	return OK;
+}
+
+/* Writes the records of the index to a new log, which then replaces the
+ * log.  The log is replaced only once the new one is complete, and a new
+ * log left without the log by a power loss is picked up by the next load.
+ */
+
+static int preference_log_compact(void)
+{
+	FAR struct pref_log_entry_s *entry;
+	struct file newfile;
+	FAR uint8_t *buffer;
+	off_t offset;
+	size_t size;
+	int ret;
+	int i;
+
+	prefvdbg("Compacting, size %d live %d\n", (int)g_pref_log.size, (int)g_pref_log.live);
+
+	ret = file_open(&newfile, PREF_LOG_TMPPATH, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (ret < 0) {
+		prefdbg("Failed to create %s, %d\n", PREF_LOG_TMPPATH, ret);
+		return PREFERENCE_IO_ERROR;
+	}
+
+	ret = preference_log_format(&newfile);
+	for (i = 0; ret == OK && i < CONFIG_PREFERENCE_LOG_HASH_SIZE; i++) {
+		for (entry = g_pref_log.buckets[i]; ret == OK && entry != NULL; entry = entry->flink) {
+			ret = preference_log_readrec(&g_pref_log.file, entry->offset, g_pref_log.size, &buffer);
+			if (ret != OK) {
+				break;
+			}
+
+			size = PREF_LOG_RECSIZE(entry->keylen, entry->len);
+			if (file_write(&newfile, buffer, size) != size) {
+				ret = PREFERENCE_IO_ERROR;
+			}
+			PREFERENCE_FREE(buffer);
+		}
+	}
+
+	if (ret == OK && file_fsync(&newfile) < 0) {
+		ret = PREFERENCE_IO_ERROR;
+	}
+
+	file_close(&newfile);
+	if (ret != OK) {
+		prefdbg("Failed to write %s, %d\n", PREF_LOG_TMPPATH, ret);
+		unlink(PREF_LOG_TMPPATH);
+		return ret;
+	}
+
+	file_close(&g_pref_log.file);
+	g_pref_log.loaded = false;
+	if (unlink(PREF_LOG_PATH) < 0 || rename(PREF_LOG_TMPPATH, PREF_LOG_PATH) < 0) {
+		prefdbg("Failed to replace %s, %d\n", PREF_LOG_PATH, errno);
+		preference_log_clear();
+		return PREFERENCE_IO_ERROR;
+	}
+
+	ret = file_open(&g_pref_log.file, PREF_LOG_PATH, O_RDWR | O_APPEND);
+	if (ret < 0) {
+		prefdbg("Failed to open %s, %d\n", PREF_LOG_PATH, ret);
+		preference_log_clear();
+		return PREFERENCE_IO_ERROR;
+	}
+
+	/* The records were written in the order of the index */
+
+	offset = sizeof(struct pref_log_hdr_s);
+	for (i = 0; i < CONFIG_PREFERENCE_LOG_HASH_SIZE; i++) {
+		for (entry = g_pref_log.buckets[i]; entry != NULL; entry = entry->flink) {
+			entry->offset = offset;
+			offset += PREF_LOG_RECSIZE(entry->keylen, entry->len);
+		}
+	}
+
+	g_pref_log.size = offset;
+	g_pref_log.loaded = true;
+	return OK;
+}
+
+static bool preference_log_needcompact(void)
+{
+	off_t dead = g_pref_log.size - sizeof(struct pref_log_hdr_s) - g_pref_log.live;
+
+	return g_pref_log.size >= CONFIG_PREFERENCE_LOG_COMPACT_SIZE && dead > g_pref_log.live;
+}
+
+#ifdef CONFIG_SCHED_LPWORK
+static void preference_log_worker(FAR void *arg)
+{
+	preference_log_lock();
+	if (g_pref_log.loaded && preference_log_needcompact()) {
+		(void)preference_log_compact();
+	}
+	preference_log_unlock();
+}
+#endif
+
+/* Opens the log and builds the index from it */
+
+static int preference_log_load(void)
+{
+	struct pref_log_hdr_s hdr;
+	struct stat st;
+	FAR struct pref_log_rec_s *rec;
+	FAR uint8_t *buffer;
+	off_t batch;
+	off_t offset;
+	off_t end;
+	int ret;
+
+	if (g_pref_log.loaded) {
+		return OK;
+	}
+
+	ret = mkdir(PREF_PATH, 0777);
+	if (ret < 0 && errno != EEXIST) {
+		prefdbg("mkdir fail, %d\n", errno);
+		return PREFERENCE_IO_ERROR;
+	}
+
+	/* A new log is complete if the log was removed to be replaced by it */
+
+	if (stat(PREF_LOG_TMPPATH, &st) == OK) {
+		if (stat(PREF_LOG_PATH, &st) == OK) {
+			unlink(PREF_LOG_TMPPATH);
+		} else {
+			rename(PREF_LOG_TMPPATH, PREF_LOG_PATH);
+		}
+	}
+
+	ret = file_open(&g_pref_log.file, PREF_LOG_PATH, O_RDWR | O_CREAT | O_APPEND, 0666);
+	if (ret < 0) {
+		prefdbg("Failed to open %s, %d\n", PREF_LOG_PATH, ret);
+		return PREFERENCE_IO_ERROR;
+	}
+
+	end = file_seek(&g_pref_log.file, 0, SEEK_END);
+	if (end < (off_t)sizeof(struct pref_log_hdr_s) || file_pread(&g_pref_log.file, &hdr, sizeof(hdr), 0) != sizeof(hdr) || hdr.magic != PREF_LOG_MAGIC || hdr.version != PREF_LOG_VERSION) {
+		if (end > 0) {
+			prefdbg("Invalid log, discarded\n");
+		}
+
+		file_close(&g_pref_log.file);
+		ret = file_open(&g_pref_log.file, PREF_LOG_PATH, O_RDWR | O_CREAT | O_TRUNC, 0666);
+		if (ret < 0 || preference_log_format(&g_pref_log.file) != OK) {
+			prefdbg("Failed to create %s\n", PREF_LOG_PATH);
+			if (ret >= 0) {
+				file_close(&g_pref_log.file);
+			}
+			return PREFERENCE_IO_ERROR;
+		}
+
+		g_pref_log.size = sizeof(struct pref_log_hdr_s);
+		g_pref_log.loaded = true;
+		return OK;
+	}
+
+	/* Replay the log.  The records of a batch are applied once the record
+	 * which ends the batch is read, by replaying the batch again.
+	 */
+
+	batch = sizeof(struct pref_log_hdr_s);
+	offset = batch;
+	while (offset < end) {
+		ret = preference_log_readrec(&g_pref_log.file, offset, end, &buffer);
+		if (ret == PREFERENCE_OUT_OF_MEMORY) {
+			goto errout;
+		} else if (ret != OK) {
+			break;
+		}
+
+		rec = (FAR struct pref_log_rec_s *)buffer;
+		offset += PREF_LOG_RECSIZE(rec->keylen, rec->len);
+		if ((rec->flags & PREF_LOG_FLAG_COMMIT) == 0) {
+			PREFERENCE_FREE(buffer);
+			continue;
+		}
+		PREFERENCE_FREE(buffer);
+
+		while (batch < offset) {
+			ret = preference_log_readrec(&g_pref_log.file, batch, end, &buffer);
+			if (ret != OK) {
+				goto errout;
+			}
+
+			rec = (FAR struct pref_log_rec_s *)buffer;
+			ret = preference_log_apply(rec, (FAR const char *)(rec + 1), batch);
+			batch += PREF_LOG_RECSIZE(rec->keylen, rec->len);
+			PREFERENCE_FREE(buffer);
+			if (ret != OK) {
+				goto errout;
+			}
+		}
+	}
+
+	g_pref_log.size = batch;
+	g_pref_log.loaded = true;
+
+	if (batch < end) {
+		/* Drop the torn batch, so that the next records are not appended
+		 * after it.
+		 */
+
+		prefdbg("Discarding %d bytes at the end of the log\n", (int)(end - batch));
+		return preference_log_compact();
+	}
+
+	prefvdbg("Loaded %s, size %d live %d\n", PREF_LOG_PATH, (int)g_pref_log.size, (int)g_pref_log.live);
+	return OK;
+
+errout:
+	preference_log_clear();
+	file_close(&g_pref_log.file);
+	return ret;
+}
+
+/* Appends the records in buffer to the log.  The caller updates the index
+ * once the records are written.
+ */
+
+static int preference_log_append(FAR const uint8_t *buffer, size_t size)
+{
+	ssize_t nwritten;
+
+	nwritten = file_write(&g_pref_log.file, buffer, size);
+	if (nwritten == size && file_fsync(&g_pref_log.file) == OK) {
+		g_pref_log.size += size;
+		return OK;
+	}
+
+	prefdbg("Failed to append to %s, %d\n", PREF_LOG_PATH, (int)nwritten);
+	if (nwritten > 0) {
+		/* Records appended after a partial one would be lost at the next
+		 * load, so the log is rewritten without it.
+		 */
+
+		(void)preference_log_compact();
+	}
+
+	return PREFERENCE_IO_ERROR;
+}
+
+static void preference_log_schedule(void)
+{
+	if (!preference_log_needcompact()) {
+		return;
+	}
+
+#ifdef CONFIG_SCHED_LPWORK
+	if (work_available(&g_pref_log.work)) {
+		(void)work_queue(LPWORK, &g_pref_log.work, preference_log_worker, NULL, 0);
+	}
+#else
+	(void)preference_log_compact();
+#endif
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+/****************************************************************************
+ * Name: preference_log_initialize
+ *
+ * Description:
+ *   Initializes the log of preferences.  The log is loaded by the first
+ *   access, once the file system which holds it is mounted.
+ *
+ ****************************************************************************/
+void preference_log_initialize(void)
+{
+	sem_init(&g_pref_log.sem, 0, 1);
+	g_pref_log.loaded = false;
+}
+
+/****************************************************************************
+ * Name: preference_log_write
+ *
+ * Description:
+ *   Appends the value of the key at path to the log, with a single write.
+ *   path is freed.
+ *
+ ****************************************************************************/
+int preference_log_write(char *path, preference_data_t *data)
+{
+	FAR uint8_t *buffer;
+	struct pref_log_rec_s rec;
+	size_t size;
+	off_t offset;
+	int ret;
+
+	buffer = (FAR uint8_t *)PREFERENCE_ALLOC(PREF_LOG_RECSIZE(strlen(path), data->attr.len));
+	if (buffer == NULL) {
+		PREFERENCE_FREE(path);
+		return PREFERENCE_OUT_OF_MEMORY;
+	}
+
+	size = preference_log_build(buffer, PREF_LOG_OP_SET, PREF_LOG_FLAG_COMMIT, path, data->attr.type, data->value, data->attr.len);
+	memcpy(&rec, buffer, sizeof(struct pref_log_rec_s));
+
+	preference_log_lock();
+	ret = preference_log_load();
+	if (ret == OK) {
+		offset = g_pref_log.size;
+		ret = preference_log_append(buffer, size);
+		if (ret == OK) {
+			ret = preference_log_apply(&rec, path, offset);
+			preference_log_schedule();
+		}
+	}
+	preference_log_unlock();
+
+	if (ret == OK) {
+		prefvdbg("Write Key Success : %s, len = %d\n", path, data->attr.len);
+	}
+
+	PREFERENCE_FREE(buffer);
+	PREFERENCE_FREE(path);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: preference_log_read
+ *
+ * Description:
+ *   Reads the value of the key at path with a single read of the log.  On
+ *   success, data->value is allocated and has to be freed by the caller.
+ *   path is freed.
+ *
+ ****************************************************************************/
+int preference_log_read(char *path, preference_data_t *data)
+{
+	FAR struct pref_log_entry_s *entry;
+	FAR uint8_t *buffer;
+	size_t keylen = strlen(path);
+	int ret;
+
+	preference_log_lock();
+	ret = preference_log_load();
+	if (ret != OK) {
+		goto errout;
+	}
+
+	entry = *preference_log_find(path, keylen, preference_log_hash(path, keylen));
+	if (entry == NULL) {
+		ret = PREFERENCE_KEY_NOT_EXIST;
+		goto errout;
+	} else if (entry->type != data->attr.type) {
+		prefdbg("Invalid type. request type:%d, read type:%d\n", data->attr.type, entry->type);
+		ret = PREFERENCE_INVALID_PARAMETER;
+		goto errout;
+	}
+
+	ret = preference_log_readrec(&g_pref_log.file, entry->offset, g_pref_log.size, &buffer);
+	if (ret != OK) {
+		prefdbg("Failed to read %s, %d\n", path, ret);
+		goto errout;
+	}
+
+	/* The value is returned in the buffer of the record */
+
+	memmove(buffer, buffer + sizeof(struct pref_log_rec_s) + keylen, entry->len);
+	data->attr.len = entry->len;
+	data->value = buffer;
+	prefvdbg("Read key Success!\n");
+
+errout:
+	preference_log_unlock();
+	PREFERENCE_FREE(path);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: preference_log_check
+ *
+ * Description:
+ *   Looks the key at path up in the index.  path is freed.
+ *
+ ****************************************************************************/
+int preference_log_check(char *path, bool *existing)
+{
+	size_t keylen = strlen(path);
+	int ret;
+
+	preference_log_lock();
+	ret = preference_log_load();
+	if (ret == OK) {
+		*existing = *preference_log_find(path, keylen, preference_log_hash(path, keylen)) != NULL;
+	}
+	preference_log_unlock();
+
+	PREFERENCE_FREE(path);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: preference_log_remove
+ *
+ * Description:
+ *   Removes the key at path, or every key in the directory at path if all
+ *   is true.  The keys of a directory are removed by a single batch, so
+ *   either all or none of them are removed.  path is freed.
+ *
+ ****************************************************************************/
+int preference_log_remove(char *path, bool all)
+{
+	FAR struct pref_log_entry_s *entry;
+	FAR struct pref_log_rec_s *rec;
+	FAR uint8_t *buffer = NULL;
+	size_t pathlen = strlen(path);
+	size_t size = 0;
+	size_t pos;
+	uint8_t flags;
+	int ret;
+	int i;
+
+	preference_log_lock();
+	ret = preference_log_load();
+	if (ret != OK) {
+		goto errout;
+	}
+
+	for (i = 0; i < CONFIG_PREFERENCE_LOG_HASH_SIZE; i++) {
+		for (entry = g_pref_log.buckets[i]; entry != NULL; entry = entry->flink) {
+			if (preference_log_match(entry, path, pathlen, all)) {
+				size += PREF_LOG_RECSIZE(entry->keylen, 0);
+			}
+		}
+	}
+
+	if (size == 0) {
+		ret = all ? PREFERENCE_PATH_NOT_FOUND : PREFERENCE_KEY_NOT_EXIST;
+		goto errout;
+	}
+
+	buffer = (FAR uint8_t *)PREFERENCE_ALLOC(size);
+	if (buffer == NULL) {
+		ret = PREFERENCE_OUT_OF_MEMORY;
+		goto errout;
+	}
+
+	pos = 0;
+	for (i = 0; i < CONFIG_PREFERENCE_LOG_HASH_SIZE; i++) {
+		for (entry = g_pref_log.buckets[i]; entry != NULL; entry = entry->flink) {
+			if (preference_log_match(entry, path, pathlen, all)) {
+				/* The last record commits the batch */
+
+				flags = pos + PREF_LOG_RECSIZE(entry->keylen, 0) == size ? PREF_LOG_FLAG_COMMIT : 0;
+				pos += preference_log_build(buffer + pos, PREF_LOG_OP_DELETE, flags, entry->key, entry->type, NULL, 0);
+			}
+		}
+	}
+
+	ret = preference_log_append(buffer, size);
+	if (ret == OK) {
+		for (pos = 0; pos < size; pos += PREF_LOG_RECSIZE(rec->keylen, 0)) {
+			rec = (FAR struct pref_log_rec_s *)(buffer + pos);
+			(void)preference_log_apply(rec, (FAR const char *)(rec + 1), 0);
+		}
+		preference_log_schedule();
+		prefvdbg("Removed %s\n", path);
+	}
+
+errout:
+	preference_log_unlock();
+	if (buffer != NULL) {
+		PREFERENCE_FREE(buffer);
+	}
+	PREFERENCE_FREE(path);
+	return ret;
+}
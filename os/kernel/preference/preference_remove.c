@@ -25,6 +25,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <tinyara/preference.h>
+
+#include "preference.h"
 #if CONFIG_TASK_NAME_SIZE > 0
 #include <sys/types.h>
 #include <tinyara/sched.h>
@@ -35,6 +37,7 @@
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+#ifndef CONFIG_PREFERENCE_LOG
 static int preference_remove_fs_key(char *path)
 {
 	int ret;
@@ -63,6 +66,57 @@ static int preference_remove_fs_key(char *path)
 	return ret;
 }
 
+static int preference_remove_fs_dir(char *dir_path)
+{
+	int ret = OK;
+	DIR *dir;
+	char *key_path;
+	struct dirent *entry;
+
+	dir = (DIR *)opendir(dir_path);
+	if (!dir) {
+		prefdbg("Failed to open dir %s, %d\n", dir_path, errno);
+		if (errno == ENOENT) {
+			ret = PREFERENCE_PATH_NOT_FOUND;
+		} else {
+			ret = PREFERENCE_IO_ERROR;
+		}
+		goto errout_with_free;
+	}
+
+	while (1) {
+		entry = (struct dirent *)readdir(dir);
+		if (!entry) {
+			break;
+		}
+		ret = PREFERENCE_ASPRINTF(&key_path, "%s/%s", dir_path, entry->d_name);
+		if (ret < 0) {
+			ret = PREFERENCE_OUT_OF_MEMORY;
+			break;
+		}
+		/* Remove key file */
+		prefvdbg("Remove key file : %s\n", key_path);
+		ret = preference_remove_fs_key(key_path);
+		if (ret < 0) {
+			prefdbg("Failed to remove key file %d\n", ret);
+			break;
+		}
+	}
+	closedir(dir);
+
+	if (ret < 0) {
+		goto errout_with_free;
+	}
+
+	ret = OK;
+
+errout_with_free:
+	PREFERENCE_FREE(dir_path);
+
+	return ret;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -90,16 +144,17 @@ int preference_remove_key(int type, const char *key)
 		}
 	}
 
+#ifdef CONFIG_PREFERENCE_LOG
+	return preference_log_remove(path, false);
+#else
 	return preference_remove_fs_key(path);
+#endif
 }
 
 int preference_remove_all_key(int type, const char *path)
 {
 	int ret;
-	DIR *dir;
 	char *dir_path;
-	char *key_path;
-	struct dirent *entry;
 #if CONFIG_TASK_NAME_SIZE > 0
 	struct tcb_s *tcb;
 #endif
@@ -134,45 +189,9 @@ int preference_remove_all_key(int type, const char *path)
 
 	prefvdbg("preference dir path = %s\n", dir_path);
 
-	dir = (DIR *)opendir(dir_path);
-	if (!dir) {
-		prefdbg("Failed to open dir %s, %d\n", dir_path, errno);
-		if (errno == ENOENT) {
-			ret = PREFERENCE_PATH_NOT_FOUND;
-		} else {
-			ret = PREFERENCE_IO_ERROR;
-		}
-		goto errout_with_free;
-	}
-
-	while (1) {
-		entry = (struct dirent *)readdir(dir);
-		if (!entry) {
-			break;
-		}
-		ret = PREFERENCE_ASPRINTF(&key_path, "%s/%s", dir_path, entry->d_name);
-		if (ret < 0) {
-			ret = PREFERENCE_OUT_OF_MEMORY;
-			break;
-		}
-		/* Remove key file */
-		prefvdbg("Remove key file : %s\n", key_path);
-		ret = preference_remove_fs_key(key_path);
-		if (ret < 0) {
-			prefdbg("Failed to remove key file %d\n", ret);
-			break;
-		}
-	}
-	closedir(dir);
-
-	if (ret < 0) {
-		goto errout_with_free;
-	}
-
-	ret = OK;
-
-errout_with_free:
-	PREFERENCE_FREE(dir_path);
-
-	return ret;
+#ifdef CONFIG_PREFERENCE_LOG
+	return preference_log_remove(dir_path, true);
+#else
+	return preference_remove_fs_dir(dir_path);
+#endif
 }
@@ -28,6 +28,8 @@
 #include <crc32.h>
 #include <sys/stat.h>
 #include <tinyara/preference.h>
+
+#include "preference.h"
 #if CONFIG_TASK_NAME_SIZE > 0
 #include <tinyara/sched.h>
 
@@ -37,7 +39,7 @@
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
-#if CONFIG_TASK_NAME_SIZE > 0
+#if CONFIG_TASK_NAME_SIZE > 0 && !defined(CONFIG_PREFERENCE_LOG)
 static int preference_private_setup(void)
 {
 	int ret;
@@ -64,6 +66,7 @@ static int preference_private_setup(void)
 	return OK;
 }
 #endif
+#ifndef CONFIG_PREFERENCE_LOG
 static int preference_shared_setup(char *key_path)
 {
 	int ret;
@@ -149,6 +152,7 @@ errout_with_close:
 
 	return PREFERENCE_IO_ERROR;
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -165,11 +169,13 @@ int preference_write_key(preference_data_t *data)
 
 	if (data->type == PRIVATE_PREFERENCE) {
 #if CONFIG_TASK_NAME_SIZE > 0
+#ifndef CONFIG_PREFERENCE_LOG
 		ret = preference_private_setup();
 		if (ret < 0) {
 			prefdbg("Failed to set up preference\n");
 			return ret;
 		}
+#endif
 		ret = preference_get_private_keypath(data->key, &path);
 		if (ret < 0) {
 			prefdbg("Failed to get preference path\n");
@@ -180,11 +186,13 @@ int preference_write_key(preference_data_t *data)
 		return PREFERENCE_NOT_SUPPORTED;
 #endif
 	} else {
+#ifndef CONFIG_PREFERENCE_LOG
 		ret = preference_shared_setup(data->key);
 		if (ret < 0) {
 			prefdbg("Failed to set up preference\n");
 			return ret;
 		}
+#endif
 		ret = PREFERENCE_ASPRINTF(&path, "%s/%s", PREF_SHARED_PATH, data->key);
 		if (ret < 0) {
 			prefdbg("Failed to allocate path\n");
@@ -193,7 +201,11 @@ int preference_write_key(preference_data_t *data)
 	}
 	prefvdbg("Preference key path = %s\n", path);
 
+#ifdef CONFIG_PREFERENCE_LOG
+	ret = preference_log_write(path, data);
+#else
 	ret = preference_write_fs_key(path, data);
+#endif
 #if !defined(CONFIG_DISABLE_MQUEUE) && !defined(CONFIG_DISABLE_SIGNAL)
 	if (ret == OK) {
 		/* Execute callback if registered cb is existing */
@@ -71,6 +71,10 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Return true if the task with the pid is the owner of the mutex */
+
+#define pthread_mutex_isowner(m, p) ((m)->pid == (p))
+
 /****************************************************************************
  * Public Type Declarations
  ****************************************************************************/
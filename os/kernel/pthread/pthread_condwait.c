@@ -104,7 +104,7 @@ int pthread_cond_wait(FAR pthread_cond_t *cond, FAR pthread_mutex_t *mutex)
 
 	/* Make sure that the caller holds the mutex */
 
-	else if (mutex->pid != (int)getpid()) {
+	else if (!pthread_mutex_isowner(mutex, (int)getpid())) {
 		ret = EPERM;
 	} else {
 		uint16_t oldstate;
@@ -112,6 +112,9 @@ struct pidhash_s {
 	pid_t pid;					/* The full PID value */
 #ifdef CONFIG_SCHED_CPULOAD
 	uint32_t ticks[SCHED_NCPULOAD];				/* Number of ticks on this thread */
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	uint64_t runtime;			/* Time on this thread since it was created */
+#endif
 #endif
 };
 
@@ -125,6 +128,23 @@ struct tasklist_s {
 	bool prioritized;			/* true if the list is prioritized */
 };
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+/* This structure indexes a prioritized task list.  Tasks of the same
+ * priority are adjacent in the list, in FIFO order, so the list is a
+ * sequence of per-priority FIFOs.  The bitmap tells which of them are not
+ * empty and last[] gives the tail of each one.  last[] is only valid for
+ * the priorities set in the bitmap.  The IDLE task, always at the end of
+ * g_readytorun, is not indexed.
+ */
+
+#define SCHED_PRIOINDEX_NWORDS ((SCHED_PRIORITY_MAX >> 5) + 1)
+
+struct sched_prioindex_s {
+	uint32_t bitmap[SCHED_PRIOINDEX_NWORDS];	/* Bit n set if priority n is in the list */
+	FAR struct tcb_s *last[SCHED_PRIORITY_MAX + 1];	/* Last task of each priority */
+};
+#endif
+
 /****************************************************************************
  * Global Variables
  ****************************************************************************/
@@ -154,6 +174,17 @@ extern volatile dq_queue_t g_readytorun;
 
 extern volatile dq_queue_t g_pendingtasks;
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+/* These index the g_readytorun and the g_pendingtasks lists */
+
+extern struct sched_prioindex_s g_readytorun_index;
+extern struct sched_prioindex_s g_pendingtasks_index;
+
+#define sched_prioindex(list) \
+	((list) == (FAR dq_queue_t *)&g_readytorun ? &g_readytorun_index : \
+	 (list) == (FAR dq_queue_t *)&g_pendingtasks ? &g_pendingtasks_index : NULL)
+#endif
+
 /* This is the list of all tasks that are blocked waiting for a semaphore */
 
 extern volatile dq_queue_t g_waitingforsemaphore;
@@ -239,6 +270,12 @@ extern const struct tasklist_s g_tasklisttable[NUM_TASK_STATES];
 bool sched_addreadytorun(FAR struct tcb_s *rtrtcb);
 bool sched_removereadytorun(FAR struct tcb_s *rtrtcb);
 bool sched_addprioritized(FAR struct tcb_s *newTcb, DSEG dq_queue_t *list);
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+void sched_removeprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list);
+#else
+#define sched_removeprioritized(tcb, list) \
+		dq_rem((FAR dq_entry_t *)(tcb), (list))
+#endif
 bool sched_mergepending(void);
 void sched_addblocked(FAR struct tcb_s *btcb, tstate_t task_state);
 void sched_removeblocked(FAR struct tcb_s *btcb);
@@ -83,6 +83,40 @@
  * Private Function Prototypes
  ************************************************************************/
 
+/************************************************************************
+ * Private Functions
+ ************************************************************************/
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+/************************************************************************
+ * Name: sched_prioindex_prev
+ *
+ * Description:
+ *  Find the task after which a task of the given priority is inserted:
+ *  the last task of that priority or, if there is none, the last task
+ *  of the nearest higher priority.  NULL means the head of the list.
+ *
+ ************************************************************************/
+
+static FAR struct tcb_s *sched_prioindex_prev(FAR struct sched_prioindex_s *idx, uint8_t sched_priority)
+{
+	int word = sched_priority >> 5;
+	uint32_t map;
+
+	/* Look at the priorities from sched_priority up, a word at a time */
+
+	map = idx->bitmap[word] & ~((1u << (sched_priority & 31)) - 1);
+	while (map == 0) {
+		if (++word >= SCHED_PRIOINDEX_NWORDS) {
+			return NULL;
+		}
+		map = idx->bitmap[word];
+	}
+
+	return idx->last[(word << 5) + __builtin_ctz(map)];
+}
+#endif
+
 /************************************************************************
  * Public Functions
  ************************************************************************/
@@ -116,6 +150,9 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 {
 	FAR struct tcb_s *next;
 	FAR struct tcb_s *prev;
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+	FAR struct sched_prioindex_s *idx;
+#endif
 	uint8_t sched_priority = tcb->sched_priority;
 	bool ret = false;
 
@@ -123,11 +160,27 @@ bool sched_addprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
 
 	ASSERT(sched_priority >= SCHED_PRIORITY_MIN);
 
-	/* Search the list to find the location to insert the new Tcb.
-	 * Each is list is maintained in ascending sched_priority order.
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+	/* If the list is indexed, the location is known without searching.
+	 * The new tcb becomes the last one of its priority.
 	 */
 
-	for (next = (FAR struct tcb_s *)list->head; (next && sched_priority <= next->sched_priority); next = next->flink) ;
+	idx = sched_prioindex(list);
+	if (idx) {
+		prev = sched_prioindex_prev(idx, sched_priority);
+		next = prev ? prev->flink : (FAR struct tcb_s *)list->head;
+
+		idx->last[sched_priority] = tcb;
+		idx->bitmap[sched_priority >> 5] |= 1u << (sched_priority & 31);
+	} else
+#endif
+	{
+		/* Search the list to find the location to insert the new Tcb.
+		 * Each is list is maintained in ascending sched_priority order.
+		 */
+
+		for (next = (FAR struct tcb_s *)list->head; (next && sched_priority <= next->sched_priority); next = next->flink) ;
+	}
 
 	/* Add the tcb to the spot found in the list.  Check if the tcb
 	 * goes at the end of the list. NOTE:  This could only happen if list
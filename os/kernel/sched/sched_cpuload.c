@@ -65,6 +65,9 @@
 #include <tinyara/sched.h>
 #include <tinyara/kmalloc.h>
 #include <arch/irq.h>
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+#include <tinyara/arch.h>
+#endif
 
 #include "sched/sched.h"
 
@@ -86,6 +89,13 @@
 #define CPULOAD_TICKSPERSEC CLOCKS_PER_SEC
 #endif
 
+/* With CONFIG_SCHED_CPULOAD_CYCLES, time is counted in units of a power of
+ * two of cycles, no shorter than 10 microseconds, so that the counts of a
+ * time constant fit in 32 bits.
+ */
+
+#define CPULOAD_MAXRATE 100000
+
 /************************************************************************
  * Private Type Declarations
  ************************************************************************/
@@ -113,6 +123,16 @@ static volatile uint32_t g_cpuload_timeconstant[SCHED_NCPULOAD] = {
 #endif
 };
 
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+static uint32_t g_cpuload_rate;	/* Units per second, 0 until the first switch */
+static uint8_t g_cpuload_shift;	/* log2 of the number of cycles in a unit */
+static uint32_t g_cpuload_last;	/* Cycle count up to which time is charged */
+static pid_t g_cpuload_pid;		/* The thread which is running */
+static uint8_t g_cpuload_nesting;	/* Nesting level of interrupt handling */
+static uint32_t g_cpuload_irq[SCHED_NCPULOAD];	/* Units in interrupt handlers */
+static uint64_t g_cpuload_irqtime;	/* Units in interrupt handlers since boot */
+#endif
+
 static int16_t g_cpusnap_head;
 static int16_t g_cpusnap_arr_size;
 static pid_t *g_cpusnap_arr;
@@ -121,6 +141,124 @@ static pid_t *g_cpusnap_arr;
  * Private Functions
  ************************************************************************/
 
+/************************************************************************
+ * Name: sched_cpuload_add
+ *
+ * Description:
+ *   Add count to the load of the thread at hash_index, or of the
+ *   interrupt handlers if hash_index is negative.  Every load is divided
+ *   by two when the total exceeds the time constant.  rate is the number
+ *   of counts in a second.  Called with interrupts disabled.
+ *
+ ************************************************************************/
+
+static void sched_cpuload_add(int hash_index, uint32_t count, uint32_t rate)
+{
+	int cpuload_idx;
+	int i;
+
+	for (cpuload_idx = 0; cpuload_idx < SCHED_NCPULOAD; cpuload_idx++) {
+		if (hash_index >= 0) {
+			g_pidhash[hash_index].ticks[cpuload_idx] += count;
+		}
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+		else {
+			g_cpuload_irq[cpuload_idx] += count;
+		}
+#endif
+
+		/* Increment tick count.  If the accumulated tick value exceed a time
+		 * constant, then shift the accumulators.
+		 */
+
+		g_cpuload_total[cpuload_idx] += count;
+		if (g_cpuload_total[cpuload_idx] > (g_cpuload_timeconstant[cpuload_idx] * rate)) {
+			uint32_t total = 0;
+
+			/* Divide the tick count for every task by two and recalculate the
+			 * total.
+			 */
+			for (i = 0; i < CONFIG_MAX_TASKS; i++) {
+				g_pidhash[i].ticks[cpuload_idx] >>= 1;
+				total += g_pidhash[i].ticks[cpuload_idx];
+			}
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+			g_cpuload_irq[cpuload_idx] >>= 1;
+			total += g_cpuload_irq[cpuload_idx];
+#endif
+
+			/* Save the new total. */
+
+			g_cpuload_total[cpuload_idx] = total;
+		}
+	}
+}
+
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+/************************************************************************
+ * Name: sched_cpuload_charge
+ *
+ * Description:
+ *   Charge the cycles elapsed since the last call to the running thread,
+ *   or to the interrupt handlers if one is running.  The cycles which do
+ *   not make a whole unit are left for the next call.  Called with
+ *   interrupts disabled.
+ *
+ ************************************************************************/
+
+static void sched_cpuload_charge(void)
+{
+	uint32_t now = up_perf_gettime();
+	uint32_t units;
+	uint32_t freq;
+	int hash_index;
+
+	if (g_cpuload_rate == 0) {
+		freq = up_perf_getfreq();
+		while ((freq >> g_cpuload_shift) > CPULOAD_MAXRATE) {
+			g_cpuload_shift++;
+		}
+
+		g_cpuload_rate = freq >> g_cpuload_shift;
+		g_cpuload_last = now;
+		return;
+	}
+
+	units = (now - g_cpuload_last) >> g_cpuload_shift;
+	if (units == 0) {
+		return;
+	}
+
+	g_cpuload_last += units << g_cpuload_shift;
+
+	if (g_cpuload_nesting > 0) {
+		g_cpuload_irqtime += units;
+		sched_cpuload_add(-1, units, g_cpuload_rate);
+	} else {
+		hash_index = PIDHASH(g_cpuload_pid);
+		g_pidhash[hash_index].runtime += units;
+		sched_cpuload_add(hash_index, units, g_cpuload_rate);
+	}
+}
+
+/************************************************************************
+ * Name: sched_cpuload_usec
+ *
+ * Description:
+ *   Convert a number of units to microseconds.
+ *
+ ************************************************************************/
+
+static uint64_t sched_cpuload_usec(uint64_t units)
+{
+	if (g_cpuload_rate == 0) {
+		return 0;
+	}
+
+	return units * 1000000 / g_cpuload_rate;
+}
+#endif
+
 /************************************************************************
  * Public Functions
  ************************************************************************/
@@ -195,6 +333,9 @@ void sched_clear_cpuload(pid_t pid)
 		g_cpuload_total[cpuload_idx] -= g_pidhash[hash_ndx].ticks[cpuload_idx];
 		g_pidhash[hash_ndx].ticks[cpuload_idx] = 0;
 	}
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	g_pidhash[hash_ndx].runtime = 0;
+#endif
 	irqrestore(flags);
 }
 
@@ -220,10 +361,15 @@ void sched_clear_cpuload(pid_t pid)
 void weak_function sched_process_cpuload(void)
 {
 	FAR struct tcb_s *rtcb = this_task();
-	int hash_index;
-	int i;
-	int cpuload_idx;
 
+	if (g_cpusnap_arr) {
+		g_cpusnap_arr[g_cpusnap_head] = rtcb->pid;
+		if (++g_cpusnap_head >= g_cpusnap_arr_size) {
+			g_cpusnap_head = 0;
+		}
+	}
+
+#ifndef CONFIG_SCHED_CPULOAD_CYCLES
 	/* Increment the count on the currently executing thread
 	 *
 	 * NOTE also that CPU load measurement data is retained in the g_pidhash
@@ -233,37 +379,74 @@ void weak_function sched_process_cpuload(void)
 	 * do this too, but this would require a little more overhead.
 	 */
 
-	if (g_cpusnap_arr) {
-		g_cpusnap_arr[g_cpusnap_head] = rtcb->pid;
-		if (++g_cpusnap_head >= g_cpusnap_arr_size) {
-			g_cpusnap_head = 0;
-		}
+	sched_cpuload_add(PIDHASH(rtcb->pid), 1, CPULOAD_TICKSPERSEC);
+#endif
+}
+#endif
+
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+/************************************************************************
+ * Name: sched_cpuload_switch
+ *
+ * Description:
+ *   Charge the time elapsed to the thread which ran, unless an interrupt
+ *   handler ran, and make tcb the running thread.
+ *
+ * Assumptions:
+ *   Called by the architecture before tcb is restored, with interrupts
+ *   disabled.
+ *
+ ************************************************************************/
+
+void sched_cpuload_switch(FAR struct tcb_s *tcb)
+{
+	if (g_cpuload_nesting == 0) {
+		sched_cpuload_charge();
 	}
-	hash_index = PIDHASH(rtcb->pid);
 
-	for (cpuload_idx = 0; cpuload_idx < SCHED_NCPULOAD; cpuload_idx++) {
-		g_pidhash[hash_index].ticks[cpuload_idx]++;
+	g_cpuload_pid = tcb->pid;
+}
 
-		/* Increment tick count.  If the accumulated tick value exceed a time
-		 * constant, then shift the accumulators.
-		 */
+/************************************************************************
+ * Name: sched_cpuload_irqenter and sched_cpuload_irqexit
+ *
+ * Description:
+ *   Charge the time elapsed before the outermost interrupt to the running
+ *   thread, and the time of the interrupt handling, nested interrupts
+ *   included, to the interrupt handlers.
+ *
+ * Assumptions:
+ *   Called by the architecture at the entry and exit of interrupt
+ *   handling.  Interrupts are disabled here since a nested interrupt
+ *   may preempt the caller.
+ *
+ ************************************************************************/
 
-		if (++g_cpuload_total[cpuload_idx] > (g_cpuload_timeconstant[cpuload_idx] * CPULOAD_TICKSPERSEC)) {
-			uint32_t total = 0;
+void sched_cpuload_irqenter(void)
+{
+	irqstate_t flags = irqsave();
 
-			/* Divide the tick count for every task by two and recalculate the
-			 * total.
-			 */
-			for (i = 0; i < CONFIG_MAX_TASKS; i++) {
-				g_pidhash[i].ticks[cpuload_idx] >>= 1;
-				total += g_pidhash[i].ticks[cpuload_idx];
-			}
+	if (g_cpuload_nesting == 0) {
+		sched_cpuload_charge();
+	}
 
-			/* Save the new total. */
+	g_cpuload_nesting++;
+	irqrestore(flags);
+}
 
-			g_cpuload_total[cpuload_idx] = total;
+void sched_cpuload_irqexit(void)
+{
+	irqstate_t flags = irqsave();
+
+	if (g_cpuload_nesting > 0) {
+		if (g_cpuload_nesting == 1) {
+			sched_cpuload_charge();
 		}
+
+		g_cpuload_nesting--;
 	}
+
+	irqrestore(flags);
 }
 #endif
 
@@ -301,6 +484,12 @@ int clock_cpuload(int pid, int index, FAR struct cpuload_s *cpuload)
 
 	flags = irqsave();
 
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+	/* Charge the time of the running thread so far */
+
+	sched_cpuload_charge();
+#endif
+
 	/* Make sure that the entry is valid (TCB field is not NULL) and matches
 	 * the requested PID.  The first check is needed if the thread has exited.
 	 * The second check is needed for the case where the task associated with
@@ -317,10 +506,40 @@ int clock_cpuload(int pid, int index, FAR struct cpuload_s *cpuload)
 	if (g_pidhash[hash_index].tcb && g_pidhash[hash_index].pid == pid) {
 		cpuload->total = g_cpuload_total[index];
 		cpuload->active = g_pidhash[hash_index].ticks[index];
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+		cpuload->runtime = sched_cpuload_usec(g_pidhash[hash_index].runtime);
+#endif
 		ret = OK;
 	}
 
 	irqrestore(flags);
 	return ret;
 }
+
+#ifdef CONFIG_SCHED_CPULOAD_CYCLES
+/****************************************************************************
+ * Function:  clock_cpuload_irq
+ *
+ * Description:
+ *   Return load measurement data for the interrupt handlers.  runtime is
+ *   the time spent in interrupt handlers since boot.
+ *
+ ****************************************************************************/
+
+int clock_cpuload_irq(int index, FAR struct cpuload_s *cpuload)
+{
+	irqstate_t flags;
+
+	DEBUGASSERT(cpuload && index >= 0 && index < SCHED_NCPULOAD);
+
+	flags = irqsave();
+	sched_cpuload_charge();
+	cpuload->total = g_cpuload_total[index];
+	cpuload->active = g_cpuload_irq[index];
+	cpuload->runtime = sched_cpuload_usec(g_cpuload_irqtime);
+	irqrestore(flags);
+
+	return OK;
+}
+#endif
 #endif							/* CONFIG_SCHED_CPULOAD */
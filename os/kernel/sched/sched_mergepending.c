@@ -109,6 +109,35 @@
  *
  ************************************************************************/
 
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+bool sched_mergepending(void)
+{
+	FAR struct tcb_s *pndtcb;
+	FAR struct tcb_s *rtrtcb;
+	bool ret = false;
+
+	/* Move every TCB in the g_pendingtasks list, highest priority first, to
+	 * the location given by the index of the g_readytorun list.
+	 */
+
+	while ((pndtcb = (FAR struct tcb_s *)g_pendingtasks.head) != NULL) {
+		rtrtcb = this_task();
+		sched_removeprioritized(pndtcb, (FAR dq_queue_t *)&g_pendingtasks);
+
+		if (sched_addprioritized(pndtcb, (FAR dq_queue_t *)&g_readytorun)) {
+			/* pndtcb was inserted at the head of the list */
+
+			rtrtcb->task_state = TSTATE_TASK_READYTORUN;
+			pndtcb->task_state = TSTATE_TASK_RUNNING;
+			ret = true;
+		} else {
+			pndtcb->task_state = TSTATE_TASK_READYTORUN;
+		}
+	}
+
+	return ret;
+}
+#else
 bool sched_mergepending(void)
 {
 	FAR struct tcb_s *pndtcb;
@@ -177,3 +206,4 @@ bool sched_mergepending(void)
 
 	return ret;
 }
+#endif
@@ -0,0 +1,80 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <queue.h>
+
+#include "sched/sched.h"
+
+#ifdef CONFIG_SCHED_PRIORITY_BITMAP
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: sched_removeprioritized
+ *
+ * Description:
+ *  This function removes a TCB from a task list, keeping the index of the
+ *  list up to date if it has one.  Every removal from g_readytorun and
+ *  g_pendingtasks must be done with it, and the priority of a task must
+ *  not be changed while it is in one of them.
+ *
+ * Inputs:
+ *   tcb - Points to the TCB to remove
+ *   list - Points to the list which holds tcb
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ * - The caller has established a critical section before calling this
+ *   function.
+ *
+ ****************************************************************************/
+
+void sched_removeprioritized(FAR struct tcb_s *tcb, DSEG dq_queue_t *list)
+{
+	FAR struct sched_prioindex_s *idx = sched_prioindex(list);
+	FAR struct tcb_s *prev;
+	uint8_t sched_priority = tcb->sched_priority;
+
+	if (idx && idx->last[sched_priority] == tcb) {
+		/* The task before becomes the last one of the priority, if it has
+		 * the same priority.  Otherwise no task of the priority is left.
+		 */
+
+		prev = tcb->blink;
+		if (prev && prev->sched_priority == sched_priority) {
+			idx->last[sched_priority] = prev;
+		} else {
+			idx->bitmap[sched_priority >> 5] &= ~(1u << (sched_priority & 31));
+		}
+	}
+
+	dq_rem((FAR dq_entry_t *)tcb, list);
+}
+
+#endif							/* CONFIG_SCHED_PRIORITY_BITMAP */
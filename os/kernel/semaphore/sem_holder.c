@@ -766,6 +766,9 @@ void sem_destroyholder(FAR sem_t *sem)
 
 	sem->holder.htcb = NULL;
 #endif
+#ifdef CONFIG_SEM_FASTPATH
+	sem->fastholder = 0;
+#endif
 }
 
 /****************************************************************************
@@ -871,6 +874,44 @@ void sem_addholder(FAR sem_t *sem)
 	sem_addholder_tcb(rtcb, sem);
 }
 
+#ifdef CONFIG_SEM_FASTPATH
+/****************************************************************************
+ * Name: sem_addfastholder
+ *
+ * Description:
+ *   Called when the kernel is entered for the semaphore.  The task which
+ *   took a count in user space is then recorded as a holder like any other,
+ *   so that it can be boosted and its count released by the kernel.
+ *
+ * Parameters:
+ *   sem - A reference to the semaphore
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *   Interrupts are disabled.  The exception entry cleared the exclusive
+ *   monitor, so user space cannot store a stale lock word after this.
+ *
+ ****************************************************************************/
+
+void sem_addfastholder(FAR sem_t *sem)
+{
+	FAR struct tcb_s *htcb;
+
+	if (sem->fastholder != 0) {
+		htcb = sched_gettcb(sem->fastholder);
+		sem->fastholder = 0;
+
+		/* The holder may have exited without giving the count back */
+
+		if (htcb != NULL) {
+			sem_addholder_tcb(htcb, sem);
+		}
+	}
+}
+#endif
+
 /****************************************************************************
  * Name: sem_releaseholder
  *
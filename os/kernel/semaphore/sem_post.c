@@ -62,6 +62,7 @@
 #include <sched.h>
 #include <tinyara/arch.h>
 #include <tinyara/sched.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -139,6 +140,7 @@ void sem_unblock_task(sem_t *sem, struct tcb_s *htcb)
 #endif
 			/* Restart the waiting task. */
 
+			ttrace_event(TTRACE_EV_SEM_WAKE, stcb->pid, 0, sem);
 			up_unblock_task(stcb);
 		}
 	}
@@ -210,6 +212,12 @@ int sem_post(FAR sem_t *sem)
 
 		saved_state = irqsave();
 
+		/* Record the holder of a count taken in user space, the count may
+		 * be the one given back now.
+		 */
+
+		sem_addfastholder(sem);
+
 		/* Perform the semaphore unlock operation. */
 		ASSERT(sem->semcount < SEM_VALUE_MAX);
 		sem_releaseholder(sem, this_task());
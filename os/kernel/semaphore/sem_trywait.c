@@ -132,6 +132,10 @@ int sem_trywait(FAR sem_t *sem)
 
 		saved_state = irqsave();
 
+		/* Record the holder of a count taken in user space */
+
+		sem_addfastholder(sem);
+
 		/* If the semaphore is available, give it to the requesting task */
 
 		if (sem->semcount > 0) {
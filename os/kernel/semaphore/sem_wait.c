@@ -62,6 +62,7 @@
 #include <assert.h>
 #include <tinyara/arch.h>
 #include <tinyara/cancelpt.h>
+#include <tinyara/ttrace.h>
 
 #include "sched/sched.h"
 #include "semaphore/semaphore.h"
@@ -155,6 +156,10 @@ int sem_wait(FAR sem_t *sem)
 	/* Make sure we were supplied with a valid semaphore */
 	if ((sem != NULL) && ((sem->flags & FLAGS_INITIALIZED) != 0)) {
 
+		/* Record the holder of a count taken in user space */
+
+		sem_addfastholder(sem);
+
 		/* Check if the lock is available */
 
 		if (sem->semcount > 0) {
@@ -213,6 +218,7 @@ int sem_wait(FAR sem_t *sem)
 			/* Add the TCB to the prioritized semaphore wait queue */
 
 			set_errno(0);
+			ttrace_event(TTRACE_EV_SEM_BLOCK, rtcb->pid, 0, sem);
 			up_block_task(rtcb, TSTATE_WAIT_SEM);
 
 			/* When we resume at this point, either (1) the semaphore has been
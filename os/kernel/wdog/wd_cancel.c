@@ -108,8 +108,10 @@
 
 int wd_cancel(WDOG_ID wdog)
 {
+#ifndef CONFIG_WDOG_TIMING_WHEEL
 	FAR struct wdog_s *curr;
 	FAR struct wdog_s *prev;
+#endif
 	irqstate_t state;
 	int ret = ERROR;
 
@@ -124,6 +126,15 @@ int wd_cancel(WDOG_ID wdog)
 	 */
 
 	if (wdog && WDOG_ISACTIVE(wdog)) {
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+		/* Remove the watchdog from its timing wheel slot.  The next timer
+		 * event only depends on which slots are in use.
+		 */
+
+		if (wd_wheel_remove(wdog)) {
+			sched_timer_reassess();
+		}
+#else
 		/* Search the g_wdactivelist for the target FCB.  We can't use sq_rem
 		 * to do this because there are additional operations that need to be
 		 * done.
@@ -168,6 +179,7 @@ int wd_cancel(WDOG_ID wdog)
 
 			sched_timer_reassess();
 		}
+#endif
 
 		/* Mark the watchdog inactive */
 
@@ -111,12 +111,67 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
 /****************************************************************************
  * Private Functions
  ****************************************************************************/
+/****************************************************************************
+ * Name: wd_dispatch
+ *
+ * Description:
+ *   Execute the function of an expired watchdog.
+ *
+ * Parameters:
+ *   wdog - The watchdog which expired
+ *
+ * Return Value:
+ *   None
+ *
+ * Assumptions:
+ *
+ ****************************************************************************/
+
+static inline void wd_dispatch(FAR struct wdog_s *wdog)
+{
+	/* Execute the watchdog function */
+
+	up_setpicbase(wdog->picbase);
+	switch (wdog->argc) {
+	default:
+		DEBUGPANIC();
+		break;
+
+	case 0:
+		(*((wdentry0_t)(wdog->func)))(0);
+		break;
+
+#if CONFIG_MAX_WDOGPARMS > 0
+	case 1:
+		(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 1
+	case 2:
+		(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 2
+	case 3:
+		(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
+		break;
+#endif
+#if CONFIG_MAX_WDOGPARMS > 3
+	case 4:
+		(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
+		break;
+#endif
+	}
+}
+
 /****************************************************************************
  * Name: wd_expiration
  *
  * Description:
  *   Check if the timer for the watchdog at the head of list is ready to
  *   run.  If so, remove the watchdog from the list and execute it.
+ *   With CONFIG_WDOG_TIMING_WHEEL, execute all the watchdogs expiring at
+ *   the current time of the wheel.
  *
  * Parameters:
  *   None
@@ -128,6 +183,24 @@ typedef void (*wdentry4_t)(int argc, uint32_t arg1, uint32_t arg2, uint32_t arg3
  *
  ****************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+static inline void wd_expiration(void)
+{
+	FAR struct wdog_s *wdog;
+
+	/* Watchdogs started by the functions expire one tick later at the
+	 * earliest, so this ends.
+	 */
+
+	while ((wdog = wd_wheel_expired()) != NULL) {
+		/* Indicate that the watchdog is no longer active. */
+
+		WDOG_CLRACTIVE(wdog);
+
+		wd_dispatch(wdog);
+	}
+}
+#else
 static inline void wd_expiration(void)
 {
 	FAR struct wdog_s *wdog;
@@ -156,42 +229,11 @@ static inline void wd_expiration(void)
 
 			WDOG_CLRACTIVE(wdog);
 
-			/* Execute the watchdog function */
-
-			up_setpicbase(wdog->picbase);
-			switch (wdog->argc) {
-			default:
-				DEBUGPANIC();
-				break;
-
-			case 0:
-				(*((wdentry0_t)(wdog->func)))(0);
-				break;
-
-#if CONFIG_MAX_WDOGPARMS > 0
-			case 1:
-				(*((wdentry1_t)(wdog->func)))(1, wdog->parm[0]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 1
-			case 2:
-				(*((wdentry2_t)(wdog->func)))(2, wdog->parm[0], wdog->parm[1]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 2
-			case 3:
-				(*((wdentry3_t)(wdog->func)))(3, wdog->parm[0], wdog->parm[1], wdog->parm[2]);
-				break;
-#endif
-#if CONFIG_MAX_WDOGPARMS > 3
-			case 4:
-				(*((wdentry4_t)(wdog->func)))(4, wdog->parm[0], wdog->parm[1], wdog->parm[2], wdog->parm[3]);
-				break;
-#endif
-			}
+			wd_dispatch(wdog);
 		}
 	}
 }
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -233,10 +275,12 @@ static inline void wd_expiration(void)
 int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 {
 	va_list ap;
+#ifndef CONFIG_WDOG_TIMING_WHEEL
 	FAR struct wdog_s *curr;
 	FAR struct wdog_s *prev;
 	FAR struct wdog_s *next;
 	int32_t now;
+#endif
 	irqstate_t state;
 	int i;
 
@@ -292,6 +336,11 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 	(void)sched_timer_cancel();
 #endif
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+	/* Add the watchdog to the timing wheel slot of its expiration time */
+
+	wd_wheel_insert(wdog, delay);
+#else
 	/* Do the easy case first -- when the watchdog timer queue is empty. */
 
 	if (g_wdactivelist.head == NULL) {
@@ -363,9 +412,13 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
 		}
 	}
 
-	/* Put the lag into the watchdog structure and mark it as active. */
+	/* Put the lag into the watchdog structure */
 
 	wdog->lag = delay;
+#endif
+
+	/* Mark the watchdog as active. */
+
 	WDOG_SETACTIVE(wdog);
 
 #ifdef CONFIG_SCHED_TICKLESS
@@ -406,7 +459,31 @@ int wd_start(WDOG_ID wdog, int delay, wdentry_t wdentry, int argc, ...)
  *
  ****************************************************************************/
 
-#ifdef CONFIG_SCHED_TICKLESS
+#if defined(CONFIG_WDOG_TIMING_WHEEL) && defined(CONFIG_SCHED_TICKLESS)
+unsigned int wd_timer(int ticks)
+{
+	/* Advance the wheel over the interval that expired, stopping at each
+	 * tick on which watchdogs expire.
+	 */
+
+	while (ticks > 0) {
+		ticks -= wd_wheel_advance(ticks);
+		wd_expiration();
+	}
+
+	/* Return the delay for the next watchdog to expire */
+
+	return wd_wheel_next();
+}
+
+#elif defined(CONFIG_WDOG_TIMING_WHEEL)
+void wd_timer(void)
+{
+	(void)wd_wheel_advance(1);
+	wd_expiration();
+}
+
+#elif defined(CONFIG_SCHED_TICKLESS)
 unsigned int wd_timer(int ticks)
 {
 	FAR struct wdog_s *wdog;
@@ -463,7 +540,15 @@ void wd_timer(void)
 }
 #endif							/* CONFIG_SCHED_TICKLESS */
 
-#ifdef CONFIG_SCHED_TICKSUPPRESS
+#if defined(CONFIG_SCHED_TICKSUPPRESS) && defined(CONFIG_WDOG_TIMING_WHEEL)
+void wd_timer_nohz(int ticks)
+{
+	while (ticks > 0) {
+		ticks -= wd_wheel_advance(ticks);
+		wd_expiration();
+	}
+}
+#elif defined(CONFIG_SCHED_TICKSUPPRESS)
 void wd_timer_nohz(int ticks)
 {
 	int ret;
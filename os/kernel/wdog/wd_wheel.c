@@ -0,0 +1,339 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <assert.h>
+
+#include <tinyara/wdog.h>
+
+#include "wdog/wdog.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The wheel has WD_WHEEL_LEVELS levels of WD_WHEEL_SIZE slots.  A slot of
+ * level n spans WD_WHEEL_SIZE^n ticks, so level 0 holds the watchdogs
+ * expiring in the next WD_WHEEL_SIZE ticks, one slot per tick, and the
+ * wheel covers WD_WHEEL_RANGE ticks.  The slots in use are tracked in one
+ * 32-bit map per level.
+ */
+
+#if WD_WHEEL_SIZE != 32
+#error "The slot maps of the timing wheel need WD_WHEEL_SIZE == 32"
+#endif
+
+#define WD_WHEEL_RANGE     ((uint32_t)1 << (WD_WHEEL_BITS * WD_WHEEL_LEVELS))
+#define WD_WHEEL_SHIFT(l)  (WD_WHEEL_BITS * (l))
+#define WD_WHEEL_SLOT(l, i) (((l) << WD_WHEEL_BITS) + (i))
+
+/****************************************************************************
+ * Public Variables
+ ****************************************************************************/
+
+/* The number of ticks the wheel has been advanced by.  The lag of an active
+ * watchdog holds the value this reaches when it expires.
+ */
+
+uint32_t g_wdtime;
+
+/****************************************************************************
+ * Private Variables
+ ****************************************************************************/
+
+/* The watchdogs of each slot, doubly linked through next and prev */
+
+static FAR struct wdog_s *g_wdwheel[WD_WHEEL_LEVELS * WD_WHEEL_SIZE];
+
+/* Bit i of g_wdwheelmap[n] is set when slot i of level n is not empty */
+
+static uint32_t g_wdwheelmap[WD_WHEEL_LEVELS];
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_link
+ *
+ * Description:
+ *   Add an active watchdog to the slot of its expiration time.  Watchdogs
+ *   expiring beyond the range of the wheel are put in the farthest slot of
+ *   the last level and are linked again when that slot is cascaded.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_link(FAR struct wdog_s *wdog)
+{
+	FAR struct wdog_s **head;
+	uint32_t expiry = (uint32_t)wdog->lag;
+	uint32_t delta = expiry - g_wdtime;
+	int level;
+	int index;
+
+	if (delta >= WD_WHEEL_RANGE) {
+		delta = WD_WHEEL_RANGE - 1;
+		expiry = g_wdtime + delta;
+	}
+
+	for (level = 0; level < WD_WHEEL_LEVELS - 1 && (delta >> WD_WHEEL_SHIFT(level + 1)) != 0; level++) ;
+
+	index = (expiry >> WD_WHEEL_SHIFT(level)) & WD_WHEEL_MASK;
+	wdog->slot = WD_WHEEL_SLOT(level, index);
+
+	head = &g_wdwheel[wdog->slot];
+	wdog->prev = NULL;
+	wdog->next = *head;
+	if (*head) {
+		(*head)->prev = wdog;
+	}
+	*head = wdog;
+
+	g_wdwheelmap[level] |= (uint32_t)1 << index;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_cascade
+ *
+ * Description:
+ *   Move the watchdogs of the current slot of a level to the lower levels.
+ *   Called when all the lower levels have wrapped around.
+ *
+ ****************************************************************************/
+
+static void wd_wheel_cascade(int level)
+{
+	FAR struct wdog_s *wdog;
+	FAR struct wdog_s *next;
+	int index;
+
+	index = (g_wdtime >> WD_WHEEL_SHIFT(level)) & WD_WHEEL_MASK;
+	wdog = g_wdwheel[WD_WHEEL_SLOT(level, index)];
+	if (wdog == NULL) {
+		return;
+	}
+
+	g_wdwheel[WD_WHEEL_SLOT(level, index)] = NULL;
+	g_wdwheelmap[level] &= ~((uint32_t)1 << index);
+
+	for (; wdog; wdog = next) {
+		next = wdog->next;
+		wd_wheel_link(wdog);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: wd_wheel_initialize
+ *
+ * Description:
+ *   Empty the timing wheel.
+ *
+ ****************************************************************************/
+
+void wd_wheel_initialize(void)
+{
+	memset(g_wdwheel, 0, sizeof(g_wdwheel));
+	memset(g_wdwheelmap, 0, sizeof(g_wdwheelmap));
+	g_wdtime = 0;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_insert
+ *
+ * Description:
+ *   Add a watchdog which expires after delay ticks (at least one) to the
+ *   timing wheel.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+void wd_wheel_insert(FAR struct wdog_s *wdog, int delay)
+{
+	DEBUGASSERT(delay > 0);
+
+	wdog->lag = (int)(g_wdtime + (uint32_t)delay);
+	wd_wheel_link(wdog);
+}
+
+/****************************************************************************
+ * Name: wd_wheel_remove
+ *
+ * Description:
+ *   Remove an active watchdog from the timing wheel.
+ *
+ * Return Value:
+ *   True if this emptied its slot, which may change the time of the next
+ *   timer event.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+bool wd_wheel_remove(FAR struct wdog_s *wdog)
+{
+	bool emptied = false;
+
+	if (wdog->prev) {
+		wdog->prev->next = wdog->next;
+	} else {
+		g_wdwheel[wdog->slot] = wdog->next;
+		if (wdog->next == NULL) {
+			g_wdwheelmap[wdog->slot >> WD_WHEEL_BITS] &= ~((uint32_t)1 << (wdog->slot & WD_WHEEL_MASK));
+			emptied = true;
+		}
+	}
+
+	if (wdog->next) {
+		wdog->next->prev = wdog->prev;
+	}
+
+	wdog->next = NULL;
+	wdog->prev = NULL;
+	return emptied;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_next
+ *
+ * Description:
+ *   Return the number of ticks until the wheel must be advanced next, zero
+ *   if it is empty.  That is the expiration of the next watchdog when it is
+ *   on level 0 and otherwise the time at which it is cascaded, which may be
+ *   earlier than its expiration.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_next(void)
+{
+	unsigned int next = 0;
+	unsigned int ticks;
+	uint32_t base;
+	uint32_t map;
+	int level;
+	int index;
+
+	for (level = 0; level < WD_WHEEL_LEVELS; level++) {
+		map = g_wdwheelmap[level];
+		if (map == 0) {
+			continue;
+		}
+
+		/* Rotate the map so that bit 0 is the slot after the current one.
+		 * The current slot itself is reached again after a full turn.
+		 */
+
+		base = g_wdtime >> WD_WHEEL_SHIFT(level);
+		index = (base + 1) & WD_WHEEL_MASK;
+		if (index != 0) {
+			map = (map >> index) | (map << (WD_WHEEL_SIZE - index));
+		}
+
+		ticks = ((base + 1 + __builtin_ctz(map)) << WD_WHEEL_SHIFT(level)) - g_wdtime;
+		if (next == 0 || ticks < next) {
+			next = ticks;
+		}
+	}
+
+	return next;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_advance
+ *
+ * Description:
+ *   Advance the wheel by up to ticks ticks, stopping at the next tick on
+ *   which a slot must be cascaded or watchdogs expire.  The watchdogs
+ *   expiring at the new time are then returned by wd_wheel_expired().
+ *
+ * Return Value:
+ *   The number of ticks the wheel was advanced by.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+unsigned int wd_wheel_advance(unsigned int ticks)
+{
+	unsigned int step = 1;
+	int level;
+
+	if (ticks > 1) {
+		step = wd_wheel_next();
+		if (step == 0 || step > ticks) {
+			step = ticks;
+		}
+	}
+
+	g_wdtime += step;
+
+	/* Cascade from the top, a watchdog may move down more than one level */
+
+	if ((g_wdtime & WD_WHEEL_MASK) == 0) {
+		for (level = WD_WHEEL_LEVELS - 1; level > 0; level--) {
+			if ((g_wdtime & (((uint32_t)1 << WD_WHEEL_SHIFT(level)) - 1)) == 0) {
+				wd_wheel_cascade(level);
+			}
+		}
+	}
+
+	return step;
+}
+
+/****************************************************************************
+ * Name: wd_wheel_expired
+ *
+ * Description:
+ *   Remove and return a watchdog which expires at the current time of the
+ *   wheel, NULL if there are no more.
+ *
+ * Assumptions:
+ *   Interrupts are disabled.
+ *
+ ****************************************************************************/
+
+FAR struct wdog_s *wd_wheel_expired(void)
+{
+	FAR struct wdog_s *wdog;
+
+	wdog = g_wdwheel[WD_WHEEL_SLOT(0, g_wdtime & WD_WHEEL_MASK)];
+	if (wdog) {
+		DEBUGASSERT((uint32_t)wdog->lag == g_wdtime);
+		(void)wd_wheel_remove(wdog);
+	}
+
+	return wdog;
+}
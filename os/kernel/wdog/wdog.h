@@ -69,6 +69,19 @@
  * Pre-processor Definitions
  ************************************************************************/
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+/* Geometry of the timing wheel, see wd_wheel.c */
+
+#define WD_WHEEL_BITS    5
+#define WD_WHEEL_SIZE    (1 << WD_WHEEL_BITS)
+#define WD_WHEEL_MASK    (WD_WHEEL_SIZE - 1)
+#define WD_WHEEL_LEVELS  5
+
+/* Ticks until an active watchdog expires */
+
+#define wd_wheel_remaining(w) ((int)((uint32_t)(w)->lag - g_wdtime))
+#endif
+
 /************************************************************************
  * Public Type Declarations
  ************************************************************************/
@@ -90,12 +103,21 @@ extern "C" {
 
 extern sq_queue_t g_wdfreelist;
 
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+/* With CONFIG_WDOG_TIMING_WHEEL active watchdogs are hashed into the slots
+ * of a hierarchical timing wheel by their expiration time.  g_wdtime is the
+ * number of ticks the wheel has been advanced by.
+ */
+
+extern uint32_t g_wdtime;
+#else
 /* The g_wdactivelist data structure is a singly linked list ordered by
  * watchdog expiration time. When watchdog timers expire,the functions on
  * this linked list are removed and the function is called.
  */
 
 extern sq_queue_t g_wdactivelist;
+#endif
 
 /* This is the number of free, pre-allocated watchdog structures in the
  * g_wdfreelist.  This value is used to enforce a reserve for interrupt
@@ -184,6 +206,25 @@ void wd_timer_nohz(int ticks);
 struct tcb_s;
 void wd_recover(FAR struct tcb_s *tcb);
 
+/****************************************************************************
+ * Name: wd_wheel_*
+ *
+ * Description:
+ *   Timing wheel operations used by wd_start(), wd_cancel() and wd_timer()
+ *   with CONFIG_WDOG_TIMING_WHEEL.  All are called with interrupts
+ *   disabled and are described in wd_wheel.c.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_WDOG_TIMING_WHEEL
+void wd_wheel_initialize(void);
+void wd_wheel_insert(FAR struct wdog_s *wdog, int delay);
+bool wd_wheel_remove(FAR struct wdog_s *wdog);
+unsigned int wd_wheel_next(void);
+unsigned int wd_wheel_advance(unsigned int ticks);
+FAR struct wdog_s *wd_wheel_expired(void);
+#endif
+
 #undef EXTERN
 #ifdef __cplusplus
 }
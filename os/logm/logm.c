@@ -53,7 +53,7 @@ static void logm_outstream(FAR struct lib_outstream_s *outstream)
 	outstream->nput = 0;
 }
 
-#ifdef CONFIG_ARCH_LOWPUTC
+#if defined(CONFIG_ARCH_LOWPUTC) && !defined(CONFIG_LOGM_BINARY)
 static void logm_flush(struct lib_outstream_s *stream)
 {
 	sched_lock();
@@ -84,6 +84,19 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 	struct timespec ts;
 #endif
 
+#ifdef CONFIG_LOGM_BINARY
+	/* Binary mode only reserves records with interrupts disabled, so it is
+	 * usable from interrupt handlers too.
+	 */
+
+	if (LOGM_STATUS(LOGM_READY) && !LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) && flag == LOGM_NORMAL) {
+		if (indx == LOGM_PRINTF) {
+			return logm_text_put(priority, fmt, ap);
+		}
+		return logm_binary_put(priority, fmt, ap);
+	}
+#endif
+
 	if (LOGM_STATUS(LOGM_READY) && !LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ) \
 		&& flag == LOGM_NORMAL && !up_interrupt_context()) {
 
@@ -118,7 +131,11 @@ int logm_internal(int flag, int indx, int priority, const char *fmt, va_list ap)
 		/* Low Output: Sytem is not yet completely ready or this is called from interrupt handler */
 #ifdef CONFIG_ARCH_LOWPUTC
 		lib_lowoutstream(&strm);
+#ifndef CONFIG_LOGM_BINARY
+		/* Binary records are left to the logm task */
+
 		logm_flush(&strm);
+#endif
 		ret = lib_vsprintf(&strm, fmt, ap);
 #endif
 	}
@@ -20,6 +20,8 @@
 
 #include <tinyara/config.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <stdarg.h>
 
 /****************************************************************************
  * Preprocessor Definitions
@@ -51,6 +53,51 @@
 #define LOGM_STATUS_SET(a) (logm_status |= (a))
 #define LOGM_STATUS_CLEAR(a) (logm_status &= ~(a))
 
+#ifdef CONFIG_LOGM_BINARY
+/* Record types in binary mode.  A record is reserved as PENDING and the
+ * type is written last, so the logm task stops at records which are still
+ * being filled.  WRAP pads the end of the buffer, the next record starts
+ * at offset 0.
+ */
+
+#define LOGM_REC_PENDING 0
+#define LOGM_REC_BINARY 1
+#define LOGM_REC_TEXT 2
+#define LOGM_REC_WRAP 3
+
+#define LOGM_REC_ALIGN(n) (((n) + 3) & ~3)
+#define LOGM_REC_HDRSIZE sizeof(struct logm_rec_s)
+
+/* Header of the buffer image written by logm -d */
+
+#define LOGM_DUMP_MAGIC "LOGM"
+#define LOGM_DUMP_VERSION 1
+#endif
+
+/****************************************************************************
+ * Public Types
+ ****************************************************************************/
+
+#ifdef CONFIG_LOGM_BINARY
+struct logm_rec_s {
+	uint16_t len;				/* Record size including this header, 4-byte aligned */
+	volatile uint8_t type;		/* LOGM_REC_* */
+	uint8_t priority;			/* Log priority of the message */
+	uint32_t timestamp;			/* up_perf_gettime() or system ticks */
+	FAR const char *fmt;		/* Format string, NULL for text records */
+	/* Followed by the packed arguments or the formatted text */
+};
+
+struct logm_dump_s {
+	char magic[4];				/* LOGM_DUMP_MAGIC */
+	uint32_t version;			/* LOGM_DUMP_VERSION */
+	uint32_t freq;				/* Timestamp frequency in Hz */
+	uint32_t bufsize;			/* Size of the buffer image which follows */
+	uint32_t head;				/* Offset of the oldest record */
+	uint32_t tail;				/* Offset after the newest record */
+};
+#endif
+
 /****************************************************************************
  * Private Declarations
  ****************************************************************************/
@@ -80,6 +127,12 @@ EXTERN volatile int logm_print_interval;
  ************************************************************************************/
 int logm_task(int argc, char *argv[]);
 void logm_register_tashcmds(void);
+#ifdef CONFIG_LOGM_BINARY
+int logm_binary_put(int priority, FAR const char *fmt, va_list ap);
+int logm_text_put(int priority, FAR const char *fmt, va_list ap);
+void logm_binary_flush(FAR FILE *stream);
+int logm_binary_dump(FAR const char *path);
+#endif
 
 #undef EXTERN
 #if defined(__cplusplus)
@@ -0,0 +1,754 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#include <arch/irq.h>
+#include <tinyara/arch.h>
+#include <tinyara/clock.h>
+#include <tinyara/kmalloc.h>
+#include <tinyara/logm.h>
+#include <tinyara/streams.h>
+#include "logm.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Records are 4-byte aligned, so only use a multiple of 4 of the buffer */
+
+#define LOGM_RINGSIZE (logm_bufsize & ~3)
+
+/* Prefer the end of the buffer for text records unless less than this is
+ * left there.
+ */
+
+#define LOGM_TEXT_MIN 64
+
+/* Longest conversion specification which is decoded, e.g. "%-08.3lld" */
+
+#define LOGM_SPEC_MAX 15
+
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+#define logm_timestamp() up_perf_gettime()
+#define logm_timefreq() up_perf_getfreq()
+#else
+#define logm_timestamp() ((uint32_t)clock_systimer())
+#define logm_timefreq() TICK_PER_SEC
+#endif
+
+#define LOGM_PRINTARG(stream, spec, nstar, star, value) \
+	((nstar) == 0 ? fprintf(stream, spec, value) : \
+	 (nstar) == 1 ? fprintf(stream, spec, star[0], value) : \
+	 fprintf(stream, spec, star[0], star[1], value))
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* How a conversion consumes its argument */
+
+enum logm_arg_e {
+	LOGM_ARG_NONE,				/* %% or unsupported conversion */
+	LOGM_ARG_INT,
+	LOGM_ARG_LONG,
+	LOGM_ARG_LLONG,
+	LOGM_ARG_SIZE,
+	LOGM_ARG_DOUBLE,
+	LOGM_ARG_PTR,
+	LOGM_ARG_STR,				/* Copied into the record */
+	LOGM_ARG_COUNT				/* %n, consumed but not stored */
+};
+
+struct logm_spec_s {
+	FAR const char *start;		/* The '%' */
+	uint8_t len;				/* Length of the specification */
+	uint8_t nstar;				/* Number of '*' width/precision arguments */
+	uint8_t type;				/* enum logm_arg_e */
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+#ifdef CONFIG_LOGM_TIMESTAMP
+/* Unwrapped timestamp of the last decoded record */
+
+static uint32_t g_logm_lastts;
+static uint64_t g_logm_elapsed;
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: logm_parsespec
+ *
+ * Description:
+ *   Parse the conversion specification at 'fmt' (which points to a '%')
+ *   the same way lib_vsprintf() consumes arguments.  Used both when
+ *   packing and when decoding, so both sides always agree on the layout
+ *   of the arguments.
+ *
+ * Returned Value:
+ *   Pointer to the character after the specification.
+ *
+ ****************************************************************************/
+
+static FAR const char *logm_parsespec(FAR const char *fmt, FAR struct logm_spec_s *spec)
+{
+	FAR const char *ptr = fmt + 1;
+	bool size = false;
+	int lflag = 0;
+
+	spec->start = fmt;
+	spec->nstar = 0;
+	spec->type = LOGM_ARG_NONE;
+
+	while (*ptr == '-' || *ptr == '+' || *ptr == ' ' || *ptr == '#' || *ptr == '0') {
+		ptr++;
+	}
+
+	if (*ptr == '*') {
+		spec->nstar++;
+		ptr++;
+	} else {
+		while (*ptr >= '0' && *ptr <= '9') {
+			ptr++;
+		}
+	}
+
+	if (*ptr == '.') {
+		ptr++;
+		if (*ptr == '*') {
+			spec->nstar++;
+			ptr++;
+		} else {
+			while (*ptr >= '0' && *ptr <= '9') {
+				ptr++;
+			}
+		}
+	}
+
+	for (;; ptr++) {
+		if (*ptr == 'l') {
+			lflag++;
+		} else if (*ptr == 'q' || *ptr == 'j' || *ptr == 'L') {
+			lflag = 2;
+		} else if (*ptr == 'z' || *ptr == 't') {
+			size = true;
+		} else if (*ptr != 'h') {
+			break;
+		}
+	}
+
+	switch (*ptr) {
+	case 'd':
+	case 'i':
+	case 'u':
+	case 'o':
+	case 'x':
+	case 'X':
+	case 'c':
+		if (lflag >= 2) {
+			spec->type = LOGM_ARG_LLONG;
+		} else if (lflag == 1) {
+			spec->type = LOGM_ARG_LONG;
+		} else if (size) {
+			spec->type = LOGM_ARG_SIZE;
+		} else {
+			spec->type = LOGM_ARG_INT;
+		}
+		break;
+
+	case 'f':
+	case 'F':
+	case 'e':
+	case 'E':
+	case 'g':
+	case 'G':
+		spec->type = LOGM_ARG_DOUBLE;
+		break;
+
+	case 'p':
+		spec->type = LOGM_ARG_PTR;
+		break;
+
+	case 's':
+		spec->type = LOGM_ARG_STR;
+		break;
+
+	case 'n':
+		spec->type = LOGM_ARG_COUNT;
+		break;
+
+	case '\0':
+		/* Incomplete specification at the end of the string */
+
+		spec->len = ptr - fmt;
+		return ptr;
+
+	default:
+		/* "%%" or a conversion lib_vsprintf does not know either */
+
+		spec->nstar = 0;
+		break;
+	}
+
+	ptr++;
+	spec->len = ptr - fmt;
+	return ptr;
+}
+
+/****************************************************************************
+ * Name: logm_packargs
+ *
+ * Description:
+ *   Copy the raw arguments described by 'fmt' into 'args'.  Packing stops
+ *   at the first argument which does not fit; the decoder then prints
+ *   "..." in its place.
+ *
+ * Returned Value:
+ *   Number of bytes used in 'args'.
+ *
+ ****************************************************************************/
+
+static int logm_packargs(FAR const char *fmt, va_list ap, FAR uint8_t *args)
+{
+	struct logm_spec_s spec;
+	FAR const char *str;
+	union {
+		int i;
+		long l;
+		long long ll;
+		size_t z;
+		double d;
+		FAR void *p;
+	} value;
+	int used = 0;
+	int size;
+	int i;
+
+	while ((fmt = strchr(fmt, '%')) != NULL) {
+		fmt = logm_parsespec(fmt, &spec);
+
+		for (i = 0; i < spec.nstar; i++) {
+			value.i = va_arg(ap, int);
+			if (used + sizeof(int) > CONFIG_LOGM_BINARY_ARGSIZE) {
+				return used;
+			}
+			memcpy(&args[used], &value.i, sizeof(int));
+			used += sizeof(int);
+		}
+
+		switch (spec.type) {
+		case LOGM_ARG_INT:
+			value.i = va_arg(ap, int);
+			size = sizeof(int);
+			break;
+
+		case LOGM_ARG_LONG:
+			value.l = va_arg(ap, long);
+			size = sizeof(long);
+			break;
+
+		case LOGM_ARG_LLONG:
+			value.ll = va_arg(ap, long long);
+			size = sizeof(long long);
+			break;
+
+		case LOGM_ARG_SIZE:
+			value.z = va_arg(ap, size_t);
+			size = sizeof(size_t);
+			break;
+
+		case LOGM_ARG_DOUBLE:
+			value.d = va_arg(ap, double);
+			size = sizeof(double);
+			break;
+
+		case LOGM_ARG_PTR:
+			value.p = va_arg(ap, FAR void *);
+			size = sizeof(FAR void *);
+			break;
+
+		case LOGM_ARG_STR:
+			str = va_arg(ap, FAR const char *);
+			if (str == NULL) {
+				str = "(null)";
+			}
+			size = strnlen(str, CONFIG_LOGM_BINARY_STRMAX - 1);
+			if (used + size + 1 > CONFIG_LOGM_BINARY_ARGSIZE) {
+				return used;
+			}
+			memcpy(&args[used], str, size);
+			args[used + size] = '\0';
+			used += size + 1;
+			continue;
+
+		case LOGM_ARG_COUNT:
+			(void)va_arg(ap, FAR int *);
+			continue;
+
+		default:
+			continue;
+		}
+
+		if (used + size > CONFIG_LOGM_BINARY_ARGSIZE) {
+			return used;
+		}
+		memcpy(&args[used], &value, size);
+		used += size;
+	}
+
+	return used;
+}
+
+/****************************************************************************
+ * Name: logm_reserve
+ *
+ * Description:
+ *   Reserve a record of 'len' bytes at the tail of the buffer.  The record
+ *   is returned as PENDING, so the logm task will not pass it until it is
+ *   committed.  Must be called with interrupts disabled.
+ *
+ ****************************************************************************/
+
+static FAR struct logm_rec_s *logm_reserve(int len, int priority)
+{
+	FAR struct logm_rec_s *rec;
+	int size = LOGM_RINGSIZE;
+	int tail = g_logm_tail;
+	int alen = LOGM_REC_ALIGN(len);
+	int avail;
+
+	/* Keep 4 bytes unused so that a full buffer is not seen as empty */
+
+	avail = (g_logm_head - tail - 4 + size) % size;
+
+	if (tail + alen > size) {
+		/* Does not fit before the end: pad the end and start over */
+
+		if (avail < size - tail + alen) {
+			goto errout;
+		}
+
+		rec = (FAR struct logm_rec_s *)&g_logm_rsvbuf[tail];
+		rec->type = LOGM_REC_WRAP;
+		tail = 0;
+	} else if (avail < alen) {
+		goto errout;
+	}
+
+	rec = (FAR struct logm_rec_s *)&g_logm_rsvbuf[tail];
+	rec->len = len;
+	rec->type = LOGM_REC_PENDING;
+	rec->priority = priority;
+	rec->timestamp = logm_timestamp();
+	rec->fmt = NULL;
+
+	tail += alen;
+	g_logm_tail = (tail == size) ? 0 : tail;
+	return rec;
+
+errout:
+	g_logm_dropmsg_count++;
+	return NULL;
+}
+
+/****************************************************************************
+ * Name: logm_decode
+ *
+ * Description:
+ *   Format a binary record to 'stream'.
+ *
+ ****************************************************************************/
+
+static void logm_decode(FAR FILE *stream, FAR struct logm_rec_s *rec)
+{
+	FAR const uint8_t *args = (FAR const uint8_t *)(rec + 1);
+	FAR const uint8_t *end = (FAR const uint8_t *)rec + rec->len;
+	FAR const char *fmt = rec->fmt;
+	FAR const char *next;
+	struct logm_spec_s spec;
+	char specbuf[LOGM_SPEC_MAX + 1];
+	union {
+		int i;
+		long l;
+		long long ll;
+		size_t z;
+		double d;
+		FAR void *p;
+	} value;
+	int star[2];
+	int size;
+	int i;
+
+	while ((next = strchr(fmt, '%')) != NULL) {
+		fwrite(fmt, 1, next - fmt, stream);
+		fmt = logm_parsespec(next, &spec);
+
+		if (spec.type == LOGM_ARG_NONE || spec.type == LOGM_ARG_COUNT) {
+			if (spec.len == 2 && spec.start[1] == '%') {
+				fputc('%', stream);
+			} else if (spec.type == LOGM_ARG_NONE) {
+				fwrite(spec.start, 1, spec.len, stream);
+			}
+			continue;
+		}
+
+		for (i = 0; i < spec.nstar; i++) {
+			if (args + sizeof(int) > end) {
+				goto truncated;
+			}
+			memcpy(&star[i], args, sizeof(int));
+			args += sizeof(int);
+		}
+
+		switch (spec.type) {
+		case LOGM_ARG_INT:
+			size = sizeof(int);
+			break;
+		case LOGM_ARG_LONG:
+			size = sizeof(long);
+			break;
+		case LOGM_ARG_LLONG:
+			size = sizeof(long long);
+			break;
+		case LOGM_ARG_SIZE:
+			size = sizeof(size_t);
+			break;
+		case LOGM_ARG_DOUBLE:
+			size = sizeof(double);
+			break;
+		case LOGM_ARG_PTR:
+			size = sizeof(FAR void *);
+			break;
+		default:
+			/* String: up to and including the terminator */
+
+			next = memchr(args, '\0', end - args);
+			if (next == NULL) {
+				goto truncated;
+			}
+			size = (FAR const uint8_t *)next - args + 1;
+			value.p = (FAR void *)args;
+			break;
+		}
+
+		if (args + size > end) {
+			goto truncated;
+		}
+
+		if (spec.type != LOGM_ARG_STR) {
+			memcpy(&value, args, size);
+		}
+		args += size;
+
+		if (spec.len > LOGM_SPEC_MAX) {
+			fwrite(spec.start, 1, spec.len, stream);
+			continue;
+		}
+
+		memcpy(specbuf, spec.start, spec.len);
+		specbuf[spec.len] = '\0';
+
+		switch (spec.type) {
+		case LOGM_ARG_INT:
+			LOGM_PRINTARG(stream, specbuf, spec.nstar, star, value.i);
+			break;
+		case LOGM_ARG_LONG:
+			LOGM_PRINTARG(stream, specbuf, spec.nstar, star, value.l);
+			break;
+		case LOGM_ARG_LLONG:
+			LOGM_PRINTARG(stream, specbuf, spec.nstar, star, value.ll);
+			break;
+		case LOGM_ARG_SIZE:
+			LOGM_PRINTARG(stream, specbuf, spec.nstar, star, value.z);
+			break;
+		case LOGM_ARG_DOUBLE:
+			LOGM_PRINTARG(stream, specbuf, spec.nstar, star, value.d);
+			break;
+		default:
+			LOGM_PRINTARG(stream, specbuf, spec.nstar, star, value.p);
+			break;
+		}
+	}
+
+	fputs(fmt, stream);
+	return;
+
+truncated:
+	fputs("...\n", stream);
+}
+
+#ifdef CONFIG_LOGM_TIMESTAMP
+static void logm_print_timestamp(FAR FILE *stream, uint32_t timestamp)
+{
+	uint32_t freq = logm_timefreq();
+	uint32_t sec;
+	uint32_t usec;
+
+	/* Unwrap the 32-bit counter.  Absolute times drift if two consecutive
+	 * messages are further apart than one counter period, intervals
+	 * between close messages stay exact.
+	 */
+
+	if (g_logm_elapsed == 0) {
+		g_logm_elapsed = timestamp;
+	} else {
+		g_logm_elapsed += (uint32_t)(timestamp - g_logm_lastts);
+	}
+	g_logm_lastts = timestamp;
+
+	sec = (uint32_t)(g_logm_elapsed / freq);
+	usec = (uint32_t)(((g_logm_elapsed % freq) * 1000000) / freq);
+	fprintf(stream, "[%4u.%06u] ", sec, usec);
+}
+#endif
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: logm_binary_put
+ *
+ * Description:
+ *   Queue a message without formatting it.  Interrupts are only disabled
+ *   while the record is reserved and committed, so this may be called from
+ *   interrupt handlers.
+ *
+ ****************************************************************************/
+
+int logm_binary_put(int priority, FAR const char *fmt, va_list ap)
+{
+	uint8_t args[CONFIG_LOGM_BINARY_ARGSIZE];
+	FAR struct logm_rec_s *rec;
+	irqstate_t flags;
+	int nargs;
+
+	nargs = logm_packargs(fmt, ap, args);
+
+	flags = irqsave();
+	rec = logm_reserve(LOGM_REC_HDRSIZE + nargs, priority);
+	irqrestore(flags);
+
+	if (rec == NULL) {
+		return 0;
+	}
+
+	rec->fmt = fmt;
+	memcpy(rec + 1, args, nargs);
+
+	/* irqsave() orders the stores above before the commit */
+
+	flags = irqsave();
+	rec->type = LOGM_REC_BINARY;
+	irqrestore(flags);
+
+	return 0;
+}
+
+/****************************************************************************
+ * Name: logm_text_put
+ *
+ * Description:
+ *   Format a message into a text record with interrupts disabled, as in
+ *   text mode.  Used for printf(), whose format strings may be temporary.
+ *
+ ****************************************************************************/
+
+int logm_text_put(int priority, FAR const char *fmt, va_list ap)
+{
+	struct lib_memoutstream_s strm;
+	FAR struct logm_rec_s *rec;
+	irqstate_t flags;
+	int size = LOGM_RINGSIZE;
+	int head;
+	int tail;
+	int avail;
+	int ret;
+
+	flags = irqsave();
+
+	head = g_logm_head;
+	tail = g_logm_tail;
+	if (tail >= head) {
+		avail = size - tail - (head == 0 ? 4 : 0);
+		if (avail < LOGM_REC_HDRSIZE + LOGM_TEXT_MIN && head - 4 > avail) {
+			rec = (FAR struct logm_rec_s *)&g_logm_rsvbuf[tail];
+			rec->type = LOGM_REC_WRAP;
+			tail = 0;
+			avail = head - 4;
+		}
+	} else {
+		avail = head - tail - 4;
+	}
+
+	/* The record length must fit in 16 bits */
+
+	if (avail > 0xfffc) {
+		avail = 0xfffc;
+	}
+
+	if (avail <= (int)LOGM_REC_HDRSIZE) {
+		g_logm_dropmsg_count++;
+		irqrestore(flags);
+		return 0;
+	}
+
+	rec = (FAR struct logm_rec_s *)&g_logm_rsvbuf[tail];
+	lib_memoutstream(&strm, (FAR char *)(rec + 1), avail - LOGM_REC_HDRSIZE);
+	ret = lib_vsprintf(&strm.public, fmt, ap);
+
+	rec->len = LOGM_REC_HDRSIZE + strm.public.nput + 1;
+	rec->type = LOGM_REC_TEXT;
+	rec->priority = priority;
+	rec->timestamp = logm_timestamp();
+	rec->fmt = NULL;
+
+	tail += LOGM_REC_ALIGN(rec->len);
+	g_logm_tail = (tail == size) ? 0 : tail;
+
+	irqrestore(flags);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: logm_binary_flush
+ *
+ * Description:
+ *   Decode and print all committed records.  Called by the logm task.
+ *
+ ****************************************************************************/
+
+void logm_binary_flush(FAR FILE *stream)
+{
+	FAR struct logm_rec_s *rec;
+	irqstate_t flags;
+	int size = LOGM_RINGSIZE;
+	int dropped;
+	int head;
+
+	head = g_logm_head;
+	while (head != g_logm_tail) {
+		rec = (FAR struct logm_rec_s *)&g_logm_rsvbuf[head];
+		if (rec->type == LOGM_REC_PENDING) {
+			/* Still being written by a preempted task */
+
+			break;
+		}
+
+		if (rec->type == LOGM_REC_WRAP) {
+			head = 0;
+		} else {
+#ifdef CONFIG_LOGM_TIMESTAMP
+			logm_print_timestamp(stream, rec->timestamp);
+#endif
+			if (rec->type == LOGM_REC_TEXT) {
+				fputs((FAR const char *)(rec + 1), stream);
+			} else {
+				logm_decode(stream, rec);
+			}
+
+			head += LOGM_REC_ALIGN(rec->len);
+			if (head >= size) {
+				head = 0;
+			}
+		}
+
+		g_logm_head = head;
+	}
+
+	if (g_logm_dropmsg_count > 0) {
+		flags = irqsave();
+		dropped = g_logm_dropmsg_count;
+		g_logm_dropmsg_count = 0;
+		irqrestore(flags);
+
+		fprintf(stream, "\n[LOGM BUFFER OVERFLOW] %d messages are dropped\n", dropped);
+	}
+}
+
+/****************************************************************************
+ * Name: logm_binary_dump
+ *
+ * Description:
+ *   Write a snapshot of the buffer to 'path' for tools/logm_decode.py.
+ *   Format strings are resolved on the host from the ELF image.
+ *
+ ****************************************************************************/
+
+int logm_binary_dump(FAR const char *path)
+{
+	struct logm_dump_s hdr;
+	FAR char *image;
+	irqstate_t flags;
+	int size = LOGM_RINGSIZE;
+	int fd;
+	int ret = OK;
+
+	image = (FAR char *)kmm_malloc(size);
+	if (image == NULL) {
+		return -ENOMEM;
+	}
+
+	memcpy(hdr.magic, LOGM_DUMP_MAGIC, sizeof(hdr.magic));
+	hdr.version = LOGM_DUMP_VERSION;
+	hdr.freq = logm_timefreq();
+
+	flags = irqsave();
+	if (size != LOGM_RINGSIZE) {
+		/* Resized meanwhile */
+
+		irqrestore(flags);
+		kmm_free(image);
+		return -EAGAIN;
+	}
+	memcpy(image, g_logm_rsvbuf, size);
+	hdr.bufsize = size;
+	hdr.head = g_logm_head;
+	hdr.tail = g_logm_tail;
+	irqrestore(flags);
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+	if (fd < 0) {
+		kmm_free(image);
+		return -errno;
+	}
+
+	if (write(fd, &hdr, sizeof(hdr)) != sizeof(hdr) || write(fd, image, size) != size) {
+		ret = -EIO;
+	}
+
+	close(fd);
+	kmm_free(image);
+	return ret;
+}
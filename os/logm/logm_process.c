@@ -78,6 +78,9 @@ int logm_task(int argc, char *argv[])
 #endif
 
 	while (1) {
+#ifdef CONFIG_LOGM_BINARY
+		logm_binary_flush(stdout);
+#else
 		while (g_logm_head != g_logm_tail) {
 			fputc(g_logm_rsvbuf[g_logm_head], stdout);
 			g_logm_head = (g_logm_head + 1) % logm_bufsize;
@@ -89,9 +92,19 @@ int logm_task(int argc, char *argv[])
 				g_logm_overflow_offset = -1;
 			}
 		}
+#endif
 
 		if (LOGM_STATUS(LOGM_BUFFER_RESIZE_REQ)) {
 			flags = irqsave();
+#ifdef CONFIG_LOGM_BINARY
+			/* Wait until records reserved before the request are flushed */
+
+			if (g_logm_head != g_logm_tail) {
+				irqrestore(flags);
+				usleep(logm_print_interval);
+				continue;
+			}
+#endif
 			if (logm_change_bufsize(new_logm_bufsize) != OK) {
 				fprintf(stdout, "\n[LOGM] Failed to change buffer size\n");
 			}
@@ -38,13 +38,21 @@ void logm_register_tashcmds(void)
 static void logm_usage(void)
 {
 	fprintf(stdout, "[LOGM USAGE]\n");
+#ifdef CONFIG_LOGM_BINARY
+	fprintf(stdout, "usage: logm [-b <BUFSIZE>] [-i <TIME>] [-d <FILE>]\n");
+#else
 	fprintf(stdout, "usage: logm [-b <BUFSIZE>] [-i <TIME>]\n");
+#endif
 
 	fprintf(stdout, "options:\n");
 	fprintf(stdout, "    -b BUFSIZE\n");
 	fprintf(stdout, "        Set logm buffer size (bytes)\n");
 	fprintf(stdout, "    -i TIME\n");
 	fprintf(stdout, "        Set buffer flusing interval (ms)\n");
+#ifdef CONFIG_LOGM_BINARY
+	fprintf(stdout, "    -d FILE\n");
+	fprintf(stdout, "        Save the binary log buffer for tools/logm_decode.py\n");
+#endif
 
 }
 
@@ -82,8 +90,9 @@ static int logm_tash(int argc, char **args)
 	/*
 	 * -b [bufsize] : set buffer size (bytes)
 	 * -i [time] : set buffer flushing interval (ms)
+	 * -d [file] : save the binary log buffer
 	 */
-	while ((opt = getopt(argc, args, "b:i:")) != -1) {
+	while ((opt = getopt(argc, args, "b:i:d:")) != -1) {
 		switch (opt) {
 		case 'b':
 			/* TASH>> logm -b 10240 */
@@ -100,6 +109,15 @@ static int logm_tash(int argc, char **args)
 				logm_set_values(LOGM_INTERVAL, atoi(optarg));
 			}
 			break;
+#ifdef CONFIG_LOGM_BINARY
+		case 'd':
+			/* TASH>> logm -d /mnt/logm.bin */
+			/* saves the binary log buffer to decode it on the host */
+			if (optarg != NULL && logm_binary_dump(optarg) != OK) {
+				fprintf(stdout, "[LOGM] Failed to save buffer to %s\n", optarg);
+			}
+			break;
+#endif
 		default:
 			logm_usage();
 			return 0;
@@ -77,6 +77,9 @@
  *   Add a free chunk to the node next.  It is assumed that the caller holds
  *   the mm semaphore
  *
+ *   With CONFIG_MM_TLSF this takes constant time: the chunk is pushed at
+ *   the head of its second level list.
+ *
  ****************************************************************************/
 
 void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
@@ -88,9 +91,16 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 	int ndx = mm_size2ndx(node->size);
 
+#ifdef CONFIG_MM_TLSF
+	/* Second level lists are not sorted, just put it at the head */
+
+	prev = &heap->mm_nodelist[ndx];
+	next = prev->flink;
+#else
 	/* Now put the new free node in a descending order */
 
 	for (prev = &heap->mm_nodelist[ndx], next = prev->flink; next && next->size > node->size; prev = next, next = next->flink) ;
+#endif
 
 	/* Does it go in mid next or at the end? */
 
@@ -103,4 +113,11 @@ void mm_addfreechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
 
 		next->blink = node;
 	}
+
+#ifdef CONFIG_MM_TLSF
+	/* Mark the list and its power-of-two class as non-empty */
+
+	heap->mm_sl_bitmap[ndx >> MM_TLSF_SL_SHIFT] |= 1U << (ndx & (MM_TLSF_SL_COUNT - 1));
+	heap->mm_fl_bitmap |= 1U << (ndx >> MM_TLSF_SL_SHIFT);
+#endif
 }
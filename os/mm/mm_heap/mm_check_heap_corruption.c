@@ -68,6 +68,13 @@
 #define IS_ALLOCATED_NODE(x)		((x)->preceding & MM_ALLOC_BIT)
 #define IS_FREE_NODE(x)			(!IS_ALLOCATED_NODE(x))
 
+#ifdef CONFIG_MM_TLSF
+/* A free node must sit in a list which is marked non-empty */
+#define IS_LISTED_FREE_NODE(h, x) \
+	((h)->mm_sl_bitmap[mm_size2ndx((x)->size) >> MM_TLSF_SL_SHIFT] & \
+	 (1U << (mm_size2ndx((x)->size) & (MM_TLSF_SL_COUNT - 1))))
+#endif
+
 /****************************************************************************
  * Public data
  ****************************************************************************/
@@ -242,6 +249,24 @@ int mm_check_heap_corruption(struct mm_heap_s *heap)
 					}
 					return -1;
 				}
+#ifdef CONFIG_MM_TLSF
+				else if (!IS_LISTED_FREE_NODE(heap, node)) {
+					mfdbg("#########################################################################################\n");
+					mfdbg("ERROR: Heap node corruption detected in free list bitmap\n");
+					dump_node(prev, TYPE_OVERFLOWED);
+					dump_node(node, TYPE_CORRUPTED);
+					mfdbg("Free list %d of the node is not marked in the bitmap\n", mm_size2ndx(node->size));
+					mfdbg("#########################################################################################\n");
+					if (!aborted
+#if defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__)
+						 && !up_interrupt_context()
+#endif
+					) {
+						mm_givesemaphore(heap);
+					}
+					return -1;
+				}
+#endif
 			}
 		}
 
@@ -155,7 +155,7 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		 * but there may not be a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(next);
+		REMOVE_NODE_FROM_LIST(heap, next);
 
 		/* Then merge the two chunks */
 
@@ -174,7 +174,7 @@ void mm_free(FAR struct mm_heap_s *heap, FAR void *mem)
 		 * not be a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(prev);
+		REMOVE_NODE_FROM_LIST(heap, prev);
 
 		/* Then merge the two chunks */
 
@@ -38,6 +38,25 @@ static size_t mm_get_largest_freesize_from_specific_heap(struct mm_heap_s *heap)
 	struct mm_freenode_s *fnode;
 	int nodelist_idx = 0;
 
+#ifdef CONFIG_MM_TLSF
+	int fl;
+
+	/* Second level lists are not sorted.  The largest free node is in the
+	 * highest non-empty list, so only that list has to be scanned.
+	 */
+	if (!heap->mm_fl_bitmap) {
+		return 0;
+	}
+
+	fl = 31 - __builtin_clz(heap->mm_fl_bitmap);
+	nodelist_idx = (fl << MM_TLSF_SL_SHIFT) + (31 - __builtin_clz(heap->mm_sl_bitmap[fl]));
+	for (fnode = heap->mm_nodelist[nodelist_idx].flink; fnode; fnode = fnode->flink) {
+		if (largest_size < fnode->size) {
+			largest_size = fnode->size;
+		}
+	}
+	return largest_size;
+#else
 	/* Free nodes are sorted in a descending order,
 	 * so the first node in each nodelist is the largest within its nodelist.
 	 */
@@ -50,6 +69,7 @@ static size_t mm_get_largest_freesize_from_specific_heap(struct mm_heap_s *heap)
 		}
 	}
 	return largest_size;
+#endif
 }
 
 /****************************************************************************
@@ -246,17 +246,21 @@ void heapinfo_parse_heap(FAR struct mm_heap_s *heap, int mode, pid_t pid)
 
 	mm_takesemaphore(heap);
 
-	for (ndx = 0; ndx < MM_NNODES; ++ndx) {
+	for (ndx = 0; ndx < MM_NFREELISTS; ++ndx) {
 		for (fnode = heap->mm_nodelist[ndx].flink; fnode && fnode->size; fnode = fnode->flink) {
-			++nodelist_cnt[ndx];
-			nodelist_size[ndx] += fnode->size;
+			++nodelist_cnt[MM_FREELIST_CLASS(ndx)];
+			nodelist_size[MM_FREELIST_CLASS(ndx)] += fnode->size;
 		}
 	}
 
 	mm_givesemaphore(heap);
 
 	for (ndx = 0; ndx < MM_NNODES; ++ndx) {
+#ifdef CONFIG_MM_TLSF
+		heapinfo_dbg("Nodelist[%d] ranging [%u, %u] : num %d, size %u [Bytes]\n", ndx, (ndx > 0 ? (1 << (ndx + MM_MIN_SHIFT)) : 0), (1 << (ndx + MM_MIN_SHIFT + 1)) - 1, nodelist_cnt[ndx], nodelist_size[ndx]);
+#else
 		heapinfo_dbg("Nodelist[%d] ranging [%u, %u] : num %d, size %u [Bytes]\n", ndx, ((ndx > 0 ? (1 << (ndx + MM_MIN_SHIFT)) : 0) + 1), 1 << (ndx + MM_MIN_SHIFT + 1), nodelist_cnt[ndx], nodelist_size[ndx]);
+#endif
 	}
 #endif
 
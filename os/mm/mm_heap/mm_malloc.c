@@ -133,6 +133,32 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 
 	mm_takesemaphore(heap);
 
+#ifdef CONFIG_MM_TLSF
+	/* Pick the first chunk of the smallest non-empty list in which every
+	 * chunk fits.  Only the last list (which also holds the chunks beyond
+	 * the largest class) can contain chunks which are too small.
+	 */
+
+	node = NULL;
+	ndx = mm_tlsf_findlist(heap, size);
+	if (ndx >= 0) {
+		for (node = heap->mm_nodelist[ndx].flink; node && node->size < size; node = node->flink) ;
+	}
+
+	/* The rounded up search skips the list of the requested size itself.
+	 * Before failing, look for a fitting chunk there as well.  This is only
+	 * reached when the heap is (nearly) exhausted.
+	 */
+
+	if (!node) {
+		ndx = mm_size2ndx(size);
+		for (node = heap->mm_nodelist[ndx].flink; node && node->size < size; node = node->flink) ;
+	}
+
+	if (!node) {
+		node = &heap->mm_nodelist[0];
+	}
+#else
 	/* Get the location in the node list to start the search
 	 * by converting the request size into a nodelist index.
 	 */
@@ -156,10 +182,11 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 	if (!(node && node->size == size)) {
 		node = prev;
 	}
+#endif
 
 	/* If we found a node with non-zero size, then this is one to use. Since
 	 * the list is ordered, we know that is must be best fitting chunk
-	 * available.
+	 * available (with CONFIG_MM_TLSF, a good fitting one).
 	 */
 
 	if (node->size) {
@@ -171,7 +198,7 @@ FAR void *mm_malloc(FAR struct mm_heap_s *heap, size_t size)
 		 * a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(node);
+		REMOVE_NODE_FROM_LIST(heap, node);
 
 		/* Check if we have to split the free node into one of the allocated
 		 * size and another smaller freenode.  In some cases, the remaining
@@ -90,6 +90,38 @@
  * Private Functions
  ****************************************************************************/
 
+/****************************************************************************
+ * Name: mm_findalignchunk
+ *
+ * Description:
+ *   Search the suitable aligned address in the free node.  Returns NULL if
+ *   the node cannot hold 'size' bytes at the requested alignment.
+ *
+ ****************************************************************************/
+
+static FAR struct mm_allocnode_s *mm_findalignchunk(FAR struct mm_freenode_s *node, size_t alignment, size_t size)
+{
+	FAR struct mm_allocnode_s *alignchunk;
+	size_t mask = (size_t)(alignment - 1);
+
+	for (alignchunk = (FAR struct mm_allocnode_s *)(((size_t)node + SIZEOF_MM_ALLOCNODE + mask) & ~mask);
+		(uintptr_t)(alignchunk + alignment) < (uintptr_t)(node + node->size);
+		alignchunk = alignchunk + alignment) {
+
+		size_t alignsize = (size_t)alignchunk - (size_t)node + size;
+		size_t remainsize = (size_t)alignchunk - SIZEOF_MM_ALLOCNODE - (size_t)node;
+
+		/* We found a suitable node if node size is more than required size after alignment and
+		 * if the remaining bytes before the alignment point is either zero or bigger than freenode.
+		 */
+		if (node->size >= alignsize && (remainsize == 0 || remainsize >= SIZEOF_MM_FREENODE)) {
+			return alignchunk;
+		}
+	}
+
+	return NULL;
+}
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -117,7 +149,6 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 	size_t newsize;
 	FAR struct mm_allocnode_s *alignchunk = NULL;
 	bool found_align = false;
-	size_t mask = (size_t)(alignment - 1);
 
 	/* If this requested alinement's less than or equal to the natural alignment
 	 * of malloc, then just let malloc do the work.
@@ -154,6 +185,24 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 
 	ndx = mm_size2ndx(newsize);
 
+#ifdef CONFIG_MM_TLSF
+	/* Second level lists are not sorted, so every chunk of every list which
+	 * may hold a large enough chunk has to be tried.  Aligned allocations
+	 * are rare, so this search is not bounded like mm_malloc().
+	 */
+
+	for (; ndx < MM_NFREELISTS && !found_align; ndx++) {
+		for (node = heap->mm_nodelist[ndx].flink; node; node = node->flink) {
+			if (node->size >= newsize) {
+				alignchunk = mm_findalignchunk(node, alignment, size);
+				if (alignchunk) {
+					found_align = true;
+					break;
+				}
+			}
+		}
+	}
+#else
 	/* Search for a large enough chunk in the list of nodes.
 	 * mm_nodelist is an array of lists. The array is arranged in ascending order of size.
 	 * Each list is ordered by size in a descending order.
@@ -182,23 +231,9 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 		/* Now, traverse the list in reverse direction, towards bigger size nodes */
 		for ( ; node; node = node->blink) {
 			/* Search the suitable aligned address in the same node. */
-			for (alignchunk = (FAR struct mm_allocnode_s *)(((size_t)node + SIZEOF_MM_ALLOCNODE + mask) & ~mask);
-				(uintptr_t)(alignchunk + alignment) < (uintptr_t)(node + node->size);
-				alignchunk = alignchunk + alignment) {
-
-				size_t alignsize = (size_t)alignchunk - (size_t)node + size;
-				size_t remainsize = (size_t)alignchunk - SIZEOF_MM_ALLOCNODE - (size_t)node;
-
-				/* We found a suitable node if node size is more than required size after alignment and
-				 * if the remaining bytes before the alignment point is either zero or bigger than freenode.
-				 */
-				if (node->size >= alignsize && (remainsize == 0 || remainsize >= SIZEOF_MM_FREENODE)) {
-					found_align = true;
-					break;
-				}
-			}
-
-			if (found_align) {
+			alignchunk = mm_findalignchunk(node, alignment, size);
+			if (alignchunk) {
+				found_align = true;
 				break;
 			}
 		}
@@ -207,6 +242,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 			break;
 		}
 	}
+#endif
 
 	if (found_align) {
 		FAR struct mm_allocnode_s *newnode = (FAR struct mm_allocnode_s *)((size_t)alignchunk - SIZEOF_MM_ALLOCNODE);
@@ -217,7 +253,7 @@ FAR void *mm_memalign(FAR struct mm_heap_s *heap, size_t alignment, size_t size)
 		 * a successor node.
 		 */
 
-		REMOVE_NODE_FROM_LIST(node);
+		REMOVE_NODE_FROM_LIST(heap, node);
 
 		/* Check if there is free space at the beginning of the aligned chunk */
 		if ((size_t)newnode - (size_t)node >= SIZEOF_MM_FREENODE) {
@@ -23,13 +23,25 @@
  * Included Files
  ****************************************************************************/
 
+#include <tinyara/config.h>
+
 #include <assert.h>
 
+#include <tinyara/mm/mm.h>
+
 /****************************************************************************
  * Pre-processor Definitions
  ****************************************************************************/
 
-#define REMOVE_NODE_FROM_LIST(node)				\
+/* Unlink a free node from its free list.  With CONFIG_MM_TLSF the list
+ * bitmaps of the heap must be kept in sync, so the heap is needed too.
+ */
+
+#ifdef CONFIG_MM_TLSF
+#define REMOVE_NODE_FROM_LIST(heap, node)			\
+	mm_tlsf_removechunk(heap, node)
+#else
+#define REMOVE_NODE_FROM_LIST(heap, node)			\
 	do {							\
 		DEBUGASSERT((node)->blink);			\
 		(node)->blink->flink = (node)->flink;		\
@@ -37,6 +49,7 @@
 			(node)->flink->blink = (node)->blink;	\
 		}						\
 	} while (0)
+#endif
 
 /****************************************************************************
  * Public Functions
@@ -72,8 +72,36 @@
  * Description:
  *    Convert the size to a nodelist index.
  *
+ *    With CONFIG_MM_TLSF, the index is the second level free list which
+ *    holds chunks of this size: the power-of-two class selects the first
+ *    level and the next MM_TLSF_SL_SHIFT bits below the leading one select
+ *    the second level.  Every chunk in list ndx is at least as large as the
+ *    smallest size mapping to ndx.
+ *
  ****************************************************************************/
 
+#ifdef CONFIG_MM_TLSF
+int mm_size2ndx(size_t size)
+{
+	int fl;
+	int sl;
+
+	if (size < MM_MIN_CHUNK) {
+		return 0;
+	}
+
+	if ((size >> MM_MAX_SHIFT) > 1) {
+		return MM_NFREELISTS - 1;
+	}
+
+	/* Position of the leading one, counted from MM_MIN_SHIFT */
+
+	fl = (31 - __builtin_clz((uint32_t)size)) - MM_MIN_SHIFT;
+	sl = (int)(size >> (fl + MM_MIN_SHIFT - MM_TLSF_SL_SHIFT)) - MM_TLSF_SL_COUNT;
+
+	return (fl << MM_TLSF_SL_SHIFT) + sl;
+}
+#else
 int mm_size2ndx(size_t size)
 {
 	int ndx = 0;
@@ -104,3 +132,4 @@ int mm_size2ndx(size_t size)
 		return ndx;
 	}
 }
+#endif
@@ -0,0 +1,127 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <assert.h>
+#include <stdint.h>
+
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define TLSF_FL(ndx)        ((ndx) >> MM_TLSF_SL_SHIFT)
+#define TLSF_SL(ndx)        ((ndx) & (MM_TLSF_SL_COUNT - 1))
+#define TLSF_FLS(x)         (31 - __builtin_clz((uint32_t)(x)))
+#define TLSF_FFS(x)         (__builtin_ctz((uint32_t)(x)))
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: mm_tlsf_findlist
+ *
+ * Description:
+ *   Find a non-empty free list whose chunks are all large enough for a
+ *   chunk of 'size' bytes.  The size is rounded up to the next second level
+ *   boundary first so that any chunk of the returned list fits, then the
+ *   list bitmaps are searched for the first non-empty list at or above it.
+ *
+ *   The last list also collects all chunks beyond the largest class, so a
+ *   chunk taken from it must still be checked against the size.
+ *
+ *   The caller must hold the mm semaphore.
+ *
+ * Return Value:
+ *   The index of the list in mm_nodelist[], or -1 if there is none.
+ *
+ ****************************************************************************/
+
+int mm_tlsf_findlist(FAR struct mm_heap_s *heap, size_t size)
+{
+	uint32_t slmap;
+	uint32_t flmap;
+	int ndx;
+	int fl;
+
+	if (size >= MM_MIN_CHUNK && (size >> MM_MAX_SHIFT) <= 1) {
+		size += (1 << (TLSF_FLS(size) - MM_TLSF_SL_SHIFT)) - 1;
+	}
+
+	ndx = mm_size2ndx(size);
+	fl = TLSF_FL(ndx);
+
+	/* Any larger second level list in the same class? */
+
+	slmap = heap->mm_sl_bitmap[fl] & (~0U << TLSF_SL(ndx));
+	if (!slmap) {
+		/* No.. take the smallest non-empty list of a larger class */
+
+		flmap = heap->mm_fl_bitmap & (~0U << (fl + 1));
+		if (!flmap) {
+			return -1;
+		}
+
+		fl = TLSF_FFS(flmap);
+		slmap = heap->mm_sl_bitmap[fl];
+		DEBUGASSERT(slmap);
+	}
+
+	return (fl << MM_TLSF_SL_SHIFT) + TLSF_FFS(slmap);
+}
+
+/****************************************************************************
+ * Name: mm_tlsf_removechunk
+ *
+ * Description:
+ *   Unlink a free chunk from its free list and clear the list bits when
+ *   that list becomes empty.  The chunk size must not have been changed
+ *   since it was added with mm_addfreechunk().
+ *
+ *   The caller must hold the mm semaphore.
+ *
+ ****************************************************************************/
+
+void mm_tlsf_removechunk(FAR struct mm_heap_s *heap, FAR struct mm_freenode_s *node)
+{
+	int ndx;
+	int fl;
+
+	DEBUGASSERT(node->blink);
+
+	node->blink->flink = node->flink;
+	if (node->flink) {
+		node->flink->blink = node->blink;
+	}
+
+	ndx = mm_size2ndx(node->size);
+	if (!heap->mm_nodelist[ndx].flink) {
+		fl = TLSF_FL(ndx);
+		heap->mm_sl_bitmap[fl] &= ~(1U << TLSF_SL(ndx));
+		if (!heap->mm_sl_bitmap[fl]) {
+			heap->mm_fl_bitmap &= ~(1U << fl);
+		}
+	}
+}
@@ -0,0 +1,451 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
+#include <debug.h>
+
+#include <tinyara/arch.h>
+#include <tinyara/irq.h>
+#include <tinyara/sched.h>
+#include <tinyara/mm/mm.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* Size classes are 16, 32, 64, 128 and 256 bytes of payload */
+
+#define UMM_CACHE_MINSHIFT   4
+#define UMM_CACHE_NCLASSES   5
+#define UMM_CACHE_MAXSIZE    (1 << (UMM_CACHE_MINSHIFT + UMM_CACHE_NCLASSES - 1))
+
+/* The whole chunk size (payload and header) of the class */
+
+#define UMM_CACHE_CHUNKSIZE(c) \
+	MM_ALIGN_UP((1 << ((c) + UMM_CACHE_MINSHIFT)) + SIZEOF_MM_ALLOCNODE)
+
+#if CONFIG_MM_SMALL_CACHE_BATCH > CONFIG_MM_SMALL_CACHE_DEPTH
+#error CONFIG_MM_SMALL_CACHE_BATCH must not be larger than CONFIG_MM_SMALL_CACHE_DEPTH
+#endif
+
+/****************************************************************************
+ * Private Types
+ ****************************************************************************/
+
+/* One magazine per size class.  Each entry is the payload address of an
+ * allocated chunk of exactly UMM_CACHE_CHUNKSIZE(class) bytes.
+ */
+
+struct umm_cache_s {
+	uint8_t count[UMM_CACHE_NCLASSES];
+	FAR void *obj[UMM_CACHE_NCLASSES][CONFIG_MM_SMALL_CACHE_DEPTH];
+};
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* Total size of the chunks held by all magazines */
+
+static size_t g_umm_cache_size;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static inline int umm_cache_size2class(size_t size)
+{
+	if (size <= (1 << UMM_CACHE_MINSHIFT)) {
+		return 0;
+	}
+
+	return (31 - __builtin_clz((uint32_t)(size - 1))) + 1 - UMM_CACHE_MINSHIFT;
+}
+
+static inline int umm_cache_chunk2class(size_t chunksize)
+{
+	int cls;
+
+	for (cls = 0; cls < UMM_CACHE_NCLASSES; cls++) {
+		if (chunksize == UMM_CACHE_CHUNKSIZE(cls)) {
+			return cls;
+		}
+	}
+
+	return ERROR;
+}
+
+static inline FAR struct mm_heap_s *umm_cache_heap(void)
+{
+#ifdef CONFIG_RAM_MALLOC_PRIOR_INDEX
+	return &BASE_HEAP[CONFIG_RAM_MALLOC_PRIOR_INDEX];
+#else
+	return &BASE_HEAP[HEAP_START_IDX];
+#endif
+}
+
+static FAR struct task_group_s *umm_cache_group(void)
+{
+	FAR struct tcb_s *tcb;
+
+	/* Interrupt handlers have no group of their own */
+
+	if (up_interrupt_context()) {
+		return NULL;
+	}
+
+	tcb = sched_self();
+	return tcb ? tcb->group : NULL;
+}
+
+/****************************************************************************
+ * Name: umm_cache_drain
+ *
+ * Description:
+ *   Give a cached chunk back to the heap.  Chunks in a magazine are not
+ *   accounted to anybody, so account the chunk to the caller again for
+ *   mm_free() to subtract it.  The caller holds the heap semaphore.
+ *
+ ****************************************************************************/
+
+static void umm_cache_drain(FAR void *mem)
+{
+	FAR struct mm_heap_s *heap = mm_get_heap(mem);
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	FAR struct mm_allocnode_s *node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+	heapinfo_update_node(node, (mmaddress_t)umm_cache_drain);
+	heapinfo_add_size(heap, node->pid, node->size);
+	heapinfo_update_total_size(heap, node->size, node->pid);
+#endif
+	mm_free(heap, mem);
+}
+
+/****************************************************************************
+ * Name: umm_cache_refill
+ *
+ * Description:
+ *   Allocate CONFIG_MM_SMALL_CACHE_BATCH chunks of the class under one hold
+ *   of the heap semaphore.  The first one is returned to the caller and the
+ *   rest is pushed to the magazine of the group.
+ *
+ ****************************************************************************/
+
+static FAR void *umm_cache_refill(FAR struct task_group_s *group, int cls)
+{
+	FAR struct mm_heap_s *heap = umm_cache_heap();
+	FAR struct umm_cache_s *cache;
+	FAR void *batch[CONFIG_MM_SMALL_CACHE_BATCH];
+	FAR void *ret;
+	irqstate_t flags;
+	size_t size = 1 << (cls + UMM_CACHE_MINSHIFT);
+	int nobjs;
+	int i;
+
+	mm_takesemaphore(heap);
+
+	cache = group->tg_mmcache;
+	if (!cache) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		cache = (FAR struct umm_cache_s *)mm_zalloc(heap, sizeof(struct umm_cache_s), (mmaddress_t)umm_cache_refill);
+#else
+		cache = (FAR struct umm_cache_s *)mm_zalloc(heap, sizeof(struct umm_cache_s));
+#endif
+		group->tg_mmcache = cache;
+	}
+
+	for (nobjs = 0; nobjs < CONFIG_MM_SMALL_CACHE_BATCH; nobjs++) {
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		batch[nobjs] = mm_malloc(heap, size, 0);
+#else
+		batch[nobjs] = mm_malloc(heap, size);
+#endif
+		if (!batch[nobjs]) {
+			break;
+		}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+		/* Chunks in a magazine are not owned by anybody */
+
+		FAR struct mm_allocnode_s *node = (FAR struct mm_allocnode_s *)((FAR char *)batch[nobjs] - SIZEOF_MM_ALLOCNODE);
+		heapinfo_subtract_size(heap, node->pid, node->size);
+		heapinfo_update_total_size(heap, (-1) * node->size, node->pid);
+		heapinfo_update_node(node, (mmaddress_t)umm_cache_refill);
+#endif
+	}
+
+	mm_givesemaphore(heap);
+
+	if (nobjs == 0) {
+		return NULL;
+	}
+
+	ret = batch[--nobjs];
+
+	/* Chunks which could not be split exactly are not cacheable */
+
+	flags = irqsave();
+	for (i = 0; i < nobjs; i++) {
+		FAR struct mm_allocnode_s *node = (FAR struct mm_allocnode_s *)((FAR char *)batch[i] - SIZEOF_MM_ALLOCNODE);
+		if (!cache || cache->count[cls] >= CONFIG_MM_SMALL_CACHE_DEPTH || node->size != UMM_CACHE_CHUNKSIZE(cls)) {
+			break;
+		}
+
+		cache->obj[cls][cache->count[cls]++] = batch[i];
+		g_umm_cache_size += node->size;
+	}
+	irqrestore(flags);
+
+	/* Give back whatever did not fit */
+
+	if (i < nobjs) {
+		mm_takesemaphore(heap);
+		for (; i < nobjs; i++) {
+			umm_cache_drain(batch[i]);
+		}
+		mm_givesemaphore(heap);
+	}
+
+	return ret;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: umm_cache_alloc
+ *
+ * Description:
+ *   Allocate a small object from the magazine of the calling task group,
+ *   refilling the magazine from the user heap when it is empty.
+ *
+ * Return Value:
+ *   The address of the allocated memory.  NULL if the size is not cached
+ *   or the caller has to fall back to the heap.
+ *
+ ****************************************************************************/
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+FAR void *umm_cache_alloc(size_t size, mmaddress_t caller_retaddr)
+#else
+FAR void *umm_cache_alloc(size_t size)
+#endif
+{
+	FAR struct task_group_s *group;
+	FAR struct umm_cache_s *cache;
+	FAR void *ret = NULL;
+	irqstate_t flags;
+	int cls;
+
+	if (size == 0 || size > UMM_CACHE_MAXSIZE) {
+		return NULL;
+	}
+
+	group = umm_cache_group();
+	if (!group) {
+		return NULL;
+	}
+
+	cls = umm_cache_size2class(size);
+
+	flags = irqsave();
+	cache = group->tg_mmcache;
+	if (cache && cache->count[cls] > 0) {
+		ret = cache->obj[cls][--cache->count[cls]];
+		g_umm_cache_size -= UMM_CACHE_CHUNKSIZE(cls);
+	}
+	irqrestore(flags);
+
+	if (!ret) {
+		ret = umm_cache_refill(group, cls);
+		if (!ret) {
+			return NULL;
+		}
+	}
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* Account the chunk to the new owner.  The heap counters are shared
+	 * with mm_malloc(), so they are only updated under the semaphore.
+	 */
+
+	FAR struct mm_allocnode_s *node = (FAR struct mm_allocnode_s *)((FAR char *)ret - SIZEOF_MM_ALLOCNODE);
+	FAR struct mm_heap_s *heap = mm_get_heap(ret);
+
+	mm_takesemaphore(heap);
+	heapinfo_update_node(node, caller_retaddr);
+	heapinfo_add_size(heap, node->pid, node->size);
+	heapinfo_update_total_size(heap, node->size, node->pid);
+	mm_givesemaphore(heap);
+#endif
+
+	mvdbg("Allocated %p, size %u from cache\n", ret, size);
+	return ret;
+}
+
+/****************************************************************************
+ * Name: umm_cache_free
+ *
+ * Description:
+ *   Keep a freed small chunk in the magazine of the calling task group.
+ *   When the magazine is full, CONFIG_MM_SMALL_CACHE_BATCH chunks are given
+ *   back to the heap under one hold of the semaphore.
+ *
+ * Return Value:
+ *   true if the chunk was consumed, false if the caller has to free it.
+ *
+ ****************************************************************************/
+
+bool umm_cache_free(FAR struct mm_heap_s *heap, FAR void *mem)
+{
+	FAR struct task_group_s *group;
+	FAR struct umm_cache_s *cache;
+	FAR struct mm_allocnode_s *node;
+	FAR void *batch[CONFIG_MM_SMALL_CACHE_BATCH];
+	irqstate_t flags;
+	int nobjs = 0;
+	int cls;
+	int i;
+
+	node = (FAR struct mm_allocnode_s *)((FAR char *)mem - SIZEOF_MM_ALLOCNODE);
+
+	/* Let mm_free() report double frees and foreign pointers */
+
+	if ((node->preceding & MM_ALLOC_BIT) == 0) {
+		return false;
+	}
+
+	cls = umm_cache_chunk2class(node->size);
+	if (cls < 0) {
+		return false;
+	}
+
+	group = umm_cache_group();
+	if (!group || !group->tg_mmcache) {
+		return false;
+	}
+
+	cache = group->tg_mmcache;
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	/* Chunks in a magazine are not owned by anybody, the pid of the last
+	 * owner is replaced by the one of the caching task.
+	 */
+
+	mm_takesemaphore(heap);
+	heapinfo_subtract_size(heap, node->pid, node->size);
+	heapinfo_update_total_size(heap, (-1) * node->size, node->pid);
+	heapinfo_update_node(node, (mmaddress_t)umm_cache_free);
+	mm_givesemaphore(heap);
+#endif
+
+	flags = irqsave();
+
+#ifdef CONFIG_DEBUG_MM
+	/* Catch the common double free of a chunk which is still cached */
+
+	for (i = 0; i < cache->count[cls]; i++) {
+		DEBUGASSERT(cache->obj[cls][i] != mem);
+	}
+#endif
+
+	if (cache->count[cls] >= CONFIG_MM_SMALL_CACHE_DEPTH) {
+		/* Full.. take a batch out and free it outside of the critical section */
+
+		for (nobjs = 0; nobjs < CONFIG_MM_SMALL_CACHE_BATCH; nobjs++) {
+			batch[nobjs] = cache->obj[cls][--cache->count[cls]];
+			g_umm_cache_size -= node->size;
+		}
+	}
+
+	cache->obj[cls][cache->count[cls]++] = mem;
+	g_umm_cache_size += node->size;
+	irqrestore(flags);
+
+	if (nobjs > 0) {
+		mm_takesemaphore(heap);
+		for (i = 0; i < nobjs; i++) {
+			umm_cache_drain(batch[i]);
+		}
+		mm_givesemaphore(heap);
+	}
+
+	return true;
+}
+
+/****************************************************************************
+ * Name: umm_cache_release
+ *
+ * Description:
+ *   Give all cached chunks of the task group and the magazines themselves
+ *   back to the heap.  Called when the task group is destroyed.
+ *
+ ****************************************************************************/
+
+void umm_cache_release(FAR struct task_group_s *group)
+{
+	FAR struct umm_cache_s *cache;
+	irqstate_t flags;
+	int cls;
+
+	flags = irqsave();
+	cache = group->tg_mmcache;
+	group->tg_mmcache = NULL;
+	if (cache) {
+		for (cls = 0; cls < UMM_CACHE_NCLASSES; cls++) {
+			g_umm_cache_size -= cache->count[cls] * UMM_CACHE_CHUNKSIZE(cls);
+		}
+	}
+	irqrestore(flags);
+
+	if (!cache) {
+		return;
+	}
+
+	mm_takesemaphore(umm_cache_heap());
+	for (cls = 0; cls < UMM_CACHE_NCLASSES; cls++) {
+		while (cache->count[cls] > 0) {
+			umm_cache_drain(cache->obj[cls][--cache->count[cls]]);
+		}
+	}
+	mm_givesemaphore(umm_cache_heap());
+
+	mm_free(mm_get_heap(cache), cache);
+}
+
+/****************************************************************************
+ * Name: umm_cache_get_size
+ *
+ * Description:
+ *   Return the total size of the chunks currently held by all magazines.
+ *   Those chunks look allocated to the heap, but are free for the users.
+ *
+ ****************************************************************************/
+
+size_t umm_cache_get_size(void)
+{
+	return g_umm_cache_size;
+}
@@ -84,6 +84,11 @@ void free(FAR void *mem)
 	struct mm_heap_s *heap;
 	heap = mm_get_heap(mem);
 	if (heap) {
+#ifdef CONFIG_MM_SMALL_CACHE
+		if (umm_cache_free(heap, mem)) {
+			return;
+		}
+#endif
 		mm_free(heap, mem);
 		return;
 	}
@@ -71,6 +71,24 @@
  * Private Functions
  ****************************************************************************/
 
+#ifdef CONFIG_MM_SMALL_CACHE
+/* Chunks kept in the small object caches are allocated as far as the heap
+ * is concerned, but they are free memory for the users.
+ */
+
+static void umm_mallinfo_exclude_cache(FAR struct mallinfo *info)
+{
+	size_t cached = umm_cache_get_size();
+
+	if (cached > (size_t)info->uordblks) {
+		cached = info->uordblks;
+	}
+
+	info->uordblks -= cached;
+	info->fordblks += cached;
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -103,6 +121,9 @@ struct mallinfo mallinfo(void)
 	for (heap_idx = 0; heap_idx < CONFIG_KMM_NHEAPS; heap_idx++) {
 		mm_mallinfo(&BASE_HEAP[heap_idx], &info);
 	}
+#endif
+#ifdef CONFIG_MM_SMALL_CACHE
+	umm_mallinfo_exclude_cache(&info);
 #endif
 	return info;
 }
@@ -131,6 +152,9 @@ int mallinfo(struct mallinfo *info)
 	for (heap_idx = 0; heap_idx < CONFIG_KMM_NHEAPS; heap_idx++) {
 		mm_mallinfo(&BASE_HEAP[heap_idx], info);
 	}
+#endif
+#ifdef CONFIG_MM_SMALL_CACHE
+	umm_mallinfo_exclude_cache(info);
 #endif
 	return OK;
 }
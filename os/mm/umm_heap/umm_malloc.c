@@ -222,6 +222,19 @@ FAR void *malloc(size_t size)
 	ARCH_GET_RET_ADDRESS(caller_retaddr)
 #endif
 
+#ifdef CONFIG_MM_SMALL_CACHE
+	/* Small objects come from the magazine of the task group first */
+
+#ifdef CONFIG_DEBUG_MM_HEAPINFO
+	ret = umm_cache_alloc(size, caller_retaddr);
+#else
+	ret = umm_cache_alloc(size);
+#endif
+	if (ret != NULL) {
+		return ret;
+	}
+#endif
+
 #ifdef CONFIG_RAM_MALLOC_PRIOR_INDEX
 	heap_idx = CONFIG_RAM_MALLOC_PRIOR_INDEX;
 #endif
@@ -65,6 +65,7 @@
 #include "lwip/netif.h"
 #include "lwip/opt.h"
 #include <tinyara/net/net.h>
+#include <tinyara/fs/fs.h>
 #include <tinyara/net/ioctl.h>
 #include <tinyara/sched.h>
 
@@ -257,6 +258,8 @@ struct lwip_select_cb {
 #else
 	/** Pointer to semaphore used post output event */
 	sys_sem_t *poll_sem;
+	/** Pointer to the pollfd structure of the waiter */
+	struct pollfd *fds;
 	/** Pointer to event-set of requested poll events */
 	pollevent_t events;
 	/** socket descriptor value */
@@ -833,6 +836,40 @@ int lwip_listen(int s, int backlog)
 	return 0;
 }
 
+/* Returns the address of the sender of buf, a netbuf for UDP and RAW
+   sockets or a pbuf for TCP sockets */
+static void lwip_recv_fromaddr(struct lwip_sock *sock, void *buf, struct sockaddr *from, socklen_t *fromlen)
+{
+	u16_t port;
+	ip_addr_t tmpaddr;
+	ip_addr_t *fromaddr;
+	union sockaddr_aligned saddr;
+
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+		fromaddr = &tmpaddr;
+		netconn_getaddr(sock->conn, fromaddr, &port, 0);
+	} else {
+		port = netbuf_fromport((struct netbuf *)buf);
+		fromaddr = netbuf_fromaddr((struct netbuf *)buf);
+	}
+
+#if LWIP_IPV4 && LWIP_IPV6
+	/* Dual-stack: Map IPv4 addresses to IPv4 mapped IPv6 */
+	if (NETCONNTYPE_ISIPV6(netconn_type(sock->conn)) && IP_IS_V4(fromaddr)) {
+		ip4_2_ipv4_mapped_ipv6(ip_2_ip6(fromaddr), ip_2_ip4(fromaddr));
+		IP_SET_TYPE(fromaddr, IPADDR_TYPE_V6);
+	}
+#endif							/* LWIP_IPV4 && LWIP_IPV6 */
+
+	IPADDR_PORT_TO_SOCKADDR(&saddr, fromaddr, port);
+	ip_addr_debug_print(SOCKETS_DEBUG, fromaddr);
+	LWIP_DEBUGF(SOCKETS_DEBUG, (" port=%" U16_F "\n", port));
+	if (*fromlen > saddr.sa.sa_len) {
+		*fromlen = saddr.sa.sa_len;
+	}
+	MEMCPY(from, &saddr, *fromlen);
+}
+
 int lwip_recvfrom(int s, void *mem, size_t len, int flags, struct sockaddr *from, socklen_t *fromlen)
 {
 	struct lwip_sock *sock;
@@ -935,37 +972,9 @@ int lwip_recvfrom(int s, void *mem, size_t len, int flags, struct sockaddr *from
 		}
 
 		/* Check to see from where the data was. */
-		if (done) {
-			if (from && fromlen) {
-				u16_t port;
-				ip_addr_t tmpaddr;
-				ip_addr_t *fromaddr;
-				union sockaddr_aligned saddr;
-				LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recvfrom(%d): addr=", s));
-				if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
-					fromaddr = &tmpaddr;
-					netconn_getaddr(sock->conn, fromaddr, &port, 0);
-				} else {
-					port = netbuf_fromport((struct netbuf *)buf);
-					fromaddr = netbuf_fromaddr((struct netbuf *)buf);
-				}
-
-#if LWIP_IPV4 && LWIP_IPV6
-				/* Dual-stack: Map IPv4 addresses to IPv4 mapped IPv6 */
-				if (NETCONNTYPE_ISIPV6(netconn_type(sock->conn)) && IP_IS_V4(fromaddr)) {
-					ip4_2_ipv4_mapped_ipv6(ip_2_ip6(fromaddr), ip_2_ip4(fromaddr));
-					IP_SET_TYPE(fromaddr, IPADDR_TYPE_V6);
-				}
-#endif							/* LWIP_IPV4 && LWIP_IPV6 */
-
-				IPADDR_PORT_TO_SOCKADDR(&saddr, fromaddr, port);
-				ip_addr_debug_print(SOCKETS_DEBUG, fromaddr);
-				LWIP_DEBUGF(SOCKETS_DEBUG, (" port=%" U16_F " len=%d\n", port, off));
-				if (*fromlen > saddr.sa.sa_len) {
-					*fromlen = saddr.sa.sa_len;
-				}
-				MEMCPY(from, &saddr, *fromlen);
-			}
+		if (done && from && fromlen) {
+			LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recvfrom(%d): len=%d addr=", s, off));
+			lwip_recv_fromaddr(sock, buf, from, fromlen);
 		}
 
 		/* If we don't peek the incoming message... */
@@ -1275,6 +1284,250 @@ int lwip_sendto(int s, const void *data, size_t size, int flags, const struct so
 	return (err == ERR_OK ? short_size : -1);
 }
 
+#if LWIP_SOCKET_ZEROCOPY
+/** A pbuf which refers to memory of the application, see lwip_sendto_zc() */
+struct lwip_zc_pbuf {
+	struct pbuf_custom pc;
+	void (*done)(void *arg);
+	void *arg;
+};
+
+/* Drops the first off bytes of the chain p, which recv() has already copied */
+static struct pbuf *lwip_zc_skip(struct pbuf *p, u16_t off)
+{
+	struct pbuf *q;
+
+	while (p != NULL && off >= p->len) {
+		off -= p->len;
+		q = p->next;
+		/* the reference of p on q is handed over to the caller */
+		p->next = NULL;
+		pbuf_free(p);
+		p = q;
+	}
+
+	if (p != NULL && off > 0) {
+		pbuf_header(p, -(s16_t)off);
+	}
+
+	return p;
+}
+
+/* Lets zbuf refer to the first SOCK_ZC_MAXIOV pbufs of the chain p and
+   returns the rest of the chain, or NULL if it all fits */
+static struct pbuf *lwip_zc_fill(struct sock_zcbuf *zbuf, struct pbuf *p)
+{
+	struct pbuf *q = p;
+	struct pbuf *rest;
+	int i = 0;
+
+	for (;;) {
+		zbuf->iov[i].iov_base = q->payload;
+		zbuf->iov[i].iov_len = q->len;
+		i++;
+		if (q->next == NULL || i == SOCK_ZC_MAXIOV) {
+			break;
+		}
+		q = q->next;
+	}
+
+	zbuf->iovcnt = i;
+	zbuf->priv = p;
+
+	rest = q->next;
+	if (rest != NULL) {
+		/* the reference of q on rest is handed over to the caller */
+		q->next = NULL;
+		for (q = p; q != NULL; q = q->next) {
+			q->tot_len -= rest->tot_len;
+		}
+	}
+
+	return rest;
+}
+
+static void lwip_zc_free(struct pbuf *p)
+{
+	struct lwip_zc_pbuf *zc = (struct lwip_zc_pbuf *)p;
+
+	if (zc->done) {
+		zc->done(zc->arg);
+	}
+	mem_free(zc);
+}
+
+/**
+ * Receives data without copying it.  zbuf refers to the pbufs which hold the
+ * data until it is given back by lwip_release_zc().  A datagram is returned
+ * whole, while the data of a TCP socket which does not fit in zbuf is left
+ * for the next receive.  zbuf is emptied first, so that lwip_release_zc()
+ * may be called whatever the result.
+ */
+int lwip_recvfrom_zc(int s, struct sock_zcbuf *zbuf, int flags, struct sockaddr *from, socklen_t *fromlen)
+{
+	struct lwip_sock *sock;
+	void *buf;
+	struct pbuf *p;
+	struct pbuf *q;
+	err_t err;
+
+	if (zbuf != NULL) {
+		zbuf->iovcnt = 0;
+		zbuf->priv = NULL;
+	}
+
+	sock = get_socket_by_pid(s, getpid());
+	if (!sock) {
+		return -1;
+	}
+
+	LWIP_ERROR("lwip_recvfrom_zc: invalid arguments", (zbuf != NULL && (flags & MSG_PEEK) == 0), sock_set_errno(sock, err_to_errno(ERR_ARG)); return -1;);
+
+	if (sock->lastdata) {
+		buf = sock->lastdata;
+	} else {
+		/* If this is non-blocking call, then check first */
+		if (((flags & MSG_DONTWAIT) || netconn_is_nonblocking(sock->conn)) && (sock->rcvevent <= 0)) {
+			set_errno(EWOULDBLOCK);
+			return -1;
+		}
+
+		if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+			err = netconn_recv_tcp_pbuf(sock->conn, (struct pbuf **)&buf);
+		} else {
+			err = netconn_recv(sock->conn, (struct netbuf **)&buf);
+		}
+
+		if (err != ERR_OK) {
+			sock_set_errno(sock, err_to_errno(err));
+			if (err == ERR_CLSD) {
+				/* Normal operation, peer ended */
+				sock->conn->last_err = ERR_OK;
+				return 0;
+			}
+			return -1;
+		}
+	}
+
+	if (from && fromlen) {
+		LWIP_DEBUGF(SOCKETS_DEBUG, ("lwip_recvfrom_zc(%d): addr=", s));
+		lwip_recv_fromaddr(sock, buf, from, fromlen);
+	}
+
+	if (NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+		p = lwip_zc_skip((struct pbuf *)buf, sock->lastoffset);
+		sock->lastdata = lwip_zc_fill(zbuf, p);
+		sock->lastoffset = 0;
+	} else {
+		p = ((struct netbuf *)buf)->p;
+		if (pbuf_clen(p) > SOCK_ZC_MAXIOV) {
+			/* A datagram is not split, so a long chain is copied once */
+			q = pbuf_coalesce(p, PBUF_RAW);
+			if (q == p) {
+				sock->lastdata = buf;
+				sock_set_errno(sock, err_to_errno(ERR_MEM));
+				return -1;
+			}
+			p = q;
+		}
+		((struct netbuf *)buf)->p = ((struct netbuf *)buf)->ptr = NULL;
+		netbuf_delete((struct netbuf *)buf);
+		sock->lastdata = NULL;
+		sock->lastoffset = 0;
+		lwip_zc_fill(zbuf, p);
+	}
+
+	sock_set_errno(sock, 0);
+	return p->tot_len;
+}
+
+/** Gives back the pbufs of a lwip_recvfrom_zc() */
+void lwip_release_zc(struct sock_zcbuf *zbuf)
+{
+	if (zbuf != NULL && zbuf->priv != NULL) {
+		pbuf_free((struct pbuf *)zbuf->priv);
+		zbuf->priv = NULL;
+		zbuf->iovcnt = 0;
+	}
+}
+
+/**
+ * Sends the data of a datagram from a PBUF_REF pbuf, so that the memory of
+ * the application is given to the driver.  done is called once the stack
+ * does not refer to the memory any more, which may be after this returns,
+ * and from the tcpip thread or the driver.  It is called on failure as well.
+ * The data of a TCP socket is copied as by lwip_send(), since it has to be
+ * kept until it is acknowledged, so done is called before this returns.
+ */
+int lwip_sendto_zc(int s, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen, void (*done)(void *arg), void *arg)
+{
+	struct lwip_sock *sock;
+	struct lwip_zc_pbuf *zc;
+	struct netbuf buf;
+	u16_t remote_port;
+	err_t err;
+	int ret;
+
+	sock = get_socket_by_pid(s, getpid());
+	if (!sock) {
+		ret = -1;
+		goto copied;
+	}
+
+	/* The drivers which need the whole packet in a single pbuf copy it anyway */
+	if (LWIP_NETIF_TX_SINGLE_PBUF || NETCONNTYPE_GROUP(netconn_type(sock->conn)) == NETCONN_TCP) {
+		ret = lwip_sendto(s, data, size, flags, to, tolen);
+		goto copied;
+	}
+
+	LWIP_ERROR("lwip_sendto_zc: size must fit in u16_t", size <= 0xffff, sock_set_errno(sock, err_to_errno(ERR_VAL)); ret = -1; goto copied;);
+	LWIP_ERROR("lwip_sendto_zc: invalid address", (((to == NULL) && (tolen == 0)) || (IS_SOCK_ADDR_LEN_VALID(tolen) && IS_SOCK_ADDR_TYPE_VALID(to) && IS_SOCK_ADDR_ALIGNED(to))), sock_set_errno(sock, err_to_errno(ERR_ARG)); ret = -1; goto copied;);
+
+	zc = (struct lwip_zc_pbuf *)mem_malloc(sizeof(struct lwip_zc_pbuf));
+	if (zc == NULL) {
+		sock_set_errno(sock, err_to_errno(ERR_MEM));
+		ret = -1;
+		goto copied;
+	}
+
+	zc->pc.custom_free_function = lwip_zc_free;
+	zc->done = done;
+	zc->arg = arg;
+
+	memset(&buf, 0, sizeof(struct netbuf));
+	buf.p = buf.ptr = pbuf_alloced_custom(PBUF_RAW, (u16_t)size, PBUF_REF, &zc->pc, (void *)data, (u16_t)size);
+	if (to) {
+		SOCKADDR_TO_IPADDR_PORT(to, &buf.addr, remote_port);
+	} else {
+		remote_port = 0;
+		ip_addr_set_any(NETCONNTYPE_ISIPV6(netconn_type(sock->conn)), &buf.addr);
+	}
+	netbuf_fromport(&buf) = remote_port;
+
+#if LWIP_IPV4 && LWIP_IPV6
+	/* Dual-stack: Unmap IPv4 mapped IPv6 addresses */
+	if (IP_IS_V6_VAL(buf.addr) && ip6_addr_isipv4mappedipv6(ip_2_ip6(&buf.addr))) {
+		unmap_ipv4_mapped_ipv6(ip_2_ip4(&buf.addr), ip_2_ip6(&buf.addr));
+		IP_SET_TYPE_VAL(buf.addr, IPADDR_TYPE_V4);
+	}
+#endif							/* LWIP_IPV4 && LWIP_IPV6 */
+
+	err = netconn_send(sock->conn, &buf);
+
+	/* drop our reference, done is called when the driver drops its own */
+	netbuf_free(&buf);
+
+	sock_set_errno(sock, err_to_errno(err));
+	return (err == ERR_OK ? (int)size : -1);
+
+copied:
+	if (done) {
+		done(arg);
+	}
+	return ret;
+}
+#endif							/* LWIP_SOCKET_ZEROCOPY */
+
 int lwip_socket(int domain, int type, int protocol)
 {
 	struct netconn *conn;
@@ -1613,6 +1866,24 @@ return_copy_fdsets:
 
 #else							/* LWIP_SELECT */
 
+/* Return the events in effect on the socket.  Called with SYS_ARCH protected */
+static pollevent_t lwip_poll_eventset(struct lwip_sock *sock)
+{
+	pollevent_t eventset = 0;
+
+	if ((sock->lastdata != NULL) || (sock->rcvevent > 0)) {
+		eventset |= POLLIN;
+	}
+	if (sock->sendevent != 0) {
+		eventset |= POLLOUT;
+	}
+	if (sock->errevent != 0) {
+		eventset |= POLLERR;
+	}
+
+	return eventset;
+}
+
 static int lwip_poll_scan(int fd, struct lwip_sock *sock, struct pollfd *fds)
 {
 	void *lastdata = NULL;
@@ -1671,8 +1942,14 @@ static int lwip_poll_setup(int fd, struct lwip_sock *sock, struct pollfd *fds)
 	/* Check if any requested events are already in effect */
 	if (nready > 0 && fds->revents != 0) {
 		/* Yes.. then signal the poll logic */
-		sys_sem_signal(fds->sem);
-		return 0;
+		poll_post(fds);
+#ifdef CONFIG_EPOLL
+		/* A waiter of epoll() stays on the list for the later events */
+		if (fds->cb == NULL)
+#endif
+		{
+			return 0;
+		}
 	}
 
 	scb_size = LWIP_MEM_ALIGN_SIZE(sizeof(struct lwip_select_cb));
@@ -1690,6 +1967,7 @@ static int lwip_poll_setup(int fd, struct lwip_sock *sock, struct pollfd *fds)
 	select_cb->prev = NULL;
 	select_cb->sem_signalled = 0;
 	select_cb->poll_sem = fds->sem;
+	select_cb->fds = fds;
 	select_cb->events = fds->events;
 	select_cb->sfd = fd;
 
@@ -1722,7 +2000,7 @@ static int lwip_poll_setup(int fd, struct lwip_sock *sock, struct pollfd *fds)
 	if (nready > 0 && fds->revents != 0) {
 		/* Yes.. then signal the poll logic */
 
-		sys_sem_signal(fds->sem);
+		poll_post(fds);
 	}
 
 	return 0;
@@ -1944,7 +2222,14 @@ again:
 #if LWIP_SELECT
 				sys_sem_signal(&scb->sem);
 #else
-				sys_sem_signal(scb->poll_sem);
+#ifdef CONFIG_EPOLL
+				/* A waiter of epoll() is signalled on every event */
+				if (scb->fds->cb != NULL) {
+					scb->sem_signalled = 0;
+				}
+#endif
+				scb->fds->revents |= (scb->events & lwip_poll_eventset(sock));
+				poll_post(scb->fds);
 #endif
 			}
 		}
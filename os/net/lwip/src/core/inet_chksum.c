@@ -27,7 +27,7 @@
  * \#define LWIP_CHKSUM your_checksum_routine
  *
  * Or you can select from the implementations below by defining
- * LWIP_CHKSUM_ALGORITHM to 1, 2 or 3.
+ * LWIP_CHKSUM_ALGORITHM to 1, 2, 3 or 4.
  */
 
 /*
@@ -68,6 +68,7 @@
 #include "lwip/def.h"
 #include "lwip/ip_addr.h"
 
+#include <stdint.h>
 #include <string.h>
 
 #ifndef LWIP_CHKSUM
@@ -269,6 +270,138 @@ u16_t lwip_standard_chksum(const void *dataptr, int len)
 }
 #endif
 
+#if (LWIP_CHKSUM_ALGORITHM == 4) || (LWIP_CHKSUM_COPY_ALGORITHM == 2)
+#if !(defined(__GNUC__) && defined(__thumb2__))
+/** Fold the carries of a 64-bit accumulator back into 32 bits */
+static inline u32_t lwip_chksum_fold64(uint64_t acc)
+{
+	acc = (acc >> 32) + (acc & 0xffffffffUL);
+	acc = (acc >> 32) + (acc & 0xffffffffUL);
+	return (u32_t) acc;
+}
+#endif
+#endif
+
+#if (LWIP_CHKSUM_ALGORITHM == 4)	/* Alternative version #4 */
+/**
+ * Add the 32-bit words of src to sum with end-around carry.
+ * len is a multiple of 4 and src is 32-bit aligned.
+ *
+ * Thumb-2 adds 16 bytes per iteration by a chain of ADCS, which carries
+ * each word into the next one. Other targets sum into a 64-bit accumulator
+ * and fold the carries once at the end.
+ */
+static u32_t lwip_chksum_words(u32_t sum, const u32_t *src, int len)
+{
+#if defined(__GNUC__) && defined(__thumb2__)
+	u32_t a, b, c, d;
+
+	while (len >= 16) {
+		__asm__("ldr %[a], [%[src]]\n\t"
+				"ldr %[b], [%[src], #4]\n\t"
+				"ldr %[c], [%[src], #8]\n\t"
+				"ldr %[d], [%[src], #12]\n\t"
+				"adds %[sum], %[sum], %[a]\n\t"
+				"adcs %[sum], %[sum], %[b]\n\t"
+				"adcs %[sum], %[sum], %[c]\n\t"
+				"adcs %[sum], %[sum], %[d]\n\t"
+				"adc %[sum], %[sum], #0"
+				: [sum] "+r"(sum), [a] "=&r"(a), [b] "=&r"(b), [c] "=&r"(c), [d] "=&r"(d)
+				: [src] "r"(src), "m"(*(const u32_t (*)[4])src)
+				: "cc");
+		src += 4;
+		len -= 16;
+	}
+	while (len >= 4) {
+		__asm__("adds %[sum], %[sum], %[w]\n\t"
+				"adc %[sum], %[sum], #0"
+				: [sum] "+r"(sum)
+				: [w] "r"(*src)
+				: "cc");
+		src++;
+		len -= 4;
+	}
+	return sum;
+#else
+	uint64_t acc = sum;
+
+	while (len >= 16) {
+		acc += src[0];
+		acc += src[1];
+		acc += src[2];
+		acc += src[3];
+		src += 4;
+		len -= 16;
+	}
+	while (len >= 4) {
+		acc += *src++;
+		len -= 4;
+	}
+	return lwip_chksum_fold64(acc);
+#endif
+}
+
+/**
+ * Word at a time checksum. The head bytes are summed until the data is
+ * 32-bit aligned, the bulk is summed by lwip_chksum_words() and the tail
+ * bytes are summed as in version #3.
+ *
+ * @param dataptr points to start of data to be summed at any boundary
+ * @param len length of data to be summed
+ * @return host order (!) lwip checksum (non-inverted Internet sum)
+ */
+u16_t lwip_standard_chksum(const void *dataptr, int len)
+{
+	const u8_t *pb = (const u8_t *)dataptr;
+	u16_t t = 0;
+	u32_t sum = 0;
+	int words;
+	/* starts at odd byte address? */
+	int odd = ((mem_ptr_t) pb & 1);
+
+	if (odd && len > 0) {
+		((u8_t *)&t)[1] = *pb++;
+		len--;
+	}
+
+	if (((mem_ptr_t) pb & 2) && len > 1) {
+		sum += *(const u16_t *)(const void *)pb;
+		pb += 2;
+		len -= 2;
+	}
+
+	words = len & ~3;
+	sum = lwip_chksum_words(sum, (const u32_t *)(const void *)pb, words);
+	pb += words;
+	len -= words;
+
+	/* make room in upper bits */
+	sum = FOLD_U32T(sum);
+
+	if (len > 1) {
+		sum += *(const u16_t *)(const void *)pb;
+		pb += 2;
+		len -= 2;
+	}
+
+	/* dangling tail byte remaining? */
+	if (len > 0) {
+		((u8_t *)&t)[0] = *pb;
+	}
+
+	sum += t;
+
+	sum = FOLD_U32T(sum);
+	sum = FOLD_U32T(sum);
+
+	if (odd) {
+		sum = SWAP_BYTES_IN_WORD(sum);
+	}
+
+	return (u16_t) sum;
+}
+#endif
+
 /** Parts of the pseudo checksum which are common to IPv4 and IPv6 */
 static u16_t inet_cksum_pseudo_base(struct pbuf *p, u8_t proto, u16_t proto_len, u32_t acc)
 {
@@ -601,3 +734,148 @@ u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len)
 	return LWIP_CHKSUM(dst, len);
 }
 #endif							/* (LWIP_CHKSUM_COPY_ALGORITHM == 1) */
+
+#if (LWIP_CHKSUM_COPY_ALGORITHM == 2)	/* Version #2 */
+/**
+ * Copy the 32-bit words of src to dst and add them to sum with end-around
+ * carry, so that the data is read only once. len is a multiple of 4 and
+ * both pointers are 32-bit aligned.
+ */
+static u32_t lwip_chksum_copy_words(u32_t sum, u32_t *dst, const u32_t *src, int len)
+{
+#if defined(__GNUC__) && defined(__thumb2__)
+	u32_t a, b, c, d;
+
+	while (len >= 16) {
+		__asm__("ldr %[a], [%[src]]\n\t"
+				"ldr %[b], [%[src], #4]\n\t"
+				"ldr %[c], [%[src], #8]\n\t"
+				"ldr %[d], [%[src], #12]\n\t"
+				"str %[a], [%[dst]]\n\t"
+				"str %[b], [%[dst], #4]\n\t"
+				"str %[c], [%[dst], #8]\n\t"
+				"str %[d], [%[dst], #12]\n\t"
+				"adds %[sum], %[sum], %[a]\n\t"
+				"adcs %[sum], %[sum], %[b]\n\t"
+				"adcs %[sum], %[sum], %[c]\n\t"
+				"adcs %[sum], %[sum], %[d]\n\t"
+				"adc %[sum], %[sum], #0"
+				: [sum] "+r"(sum), [a] "=&r"(a), [b] "=&r"(b), [c] "=&r"(c), [d] "=&r"(d), "=m"(*(u32_t (*)[4])dst)
+				: [src] "r"(src), [dst] "r"(dst), "m"(*(const u32_t (*)[4])src)
+				: "cc");
+		src += 4;
+		dst += 4;
+		len -= 16;
+	}
+	while (len >= 4) {
+		a = *src++;
+		*dst++ = a;
+		__asm__("adds %[sum], %[sum], %[w]\n\t"
+				"adc %[sum], %[sum], #0"
+				: [sum] "+r"(sum)
+				: [w] "r"(a)
+				: "cc");
+		len -= 4;
+	}
+	return sum;
+#else
+	uint64_t acc = sum;
+	u32_t a, b, c, d;
+
+	while (len >= 16) {
+		a = src[0];
+		b = src[1];
+		c = src[2];
+		d = src[3];
+		dst[0] = a;
+		dst[1] = b;
+		dst[2] = c;
+		dst[3] = d;
+		acc += a;
+		acc += b;
+		acc += c;
+		acc += d;
+		src += 4;
+		dst += 4;
+		len -= 16;
+	}
+	while (len >= 4) {
+		a = *src++;
+		*dst++ = a;
+		acc += a;
+		len -= 4;
+	}
+	return lwip_chksum_fold64(acc);
+#endif
+}
+
+/** Copy and checksum in one pass, see lwip_standard_chksum() version #4.
+ * If src and dst can not be 32-bit aligned together, this falls back to
+ * version #1.
+ */
+u16_t lwip_chksum_copy(void *dst, const void *src, u16_t len)
+{
+	u8_t *db = (u8_t *)dst;
+	const u8_t *sb = (const u8_t *)src;
+	int n = len;
+	u16_t t = 0;
+	u16_t w;
+	u32_t sum = 0;
+	int words;
+	int odd;
+
+	if ((((mem_ptr_t) db ^ (mem_ptr_t) sb) & 3) != 0) {
+		MEMCPY(dst, src, len);
+		return LWIP_CHKSUM(dst, len);
+	}
+
+	odd = ((mem_ptr_t) sb & 1);
+	if (odd && n > 0) {
+		((u8_t *)&t)[1] = *sb;
+		*db++ = *sb++;
+		n--;
+	}
+
+	if (((mem_ptr_t) sb & 2) && n > 1) {
+		w = *(const u16_t *)(const void *)sb;
+		*(u16_t *)(void *)db = w;
+		sum += w;
+		sb += 2;
+		db += 2;
+		n -= 2;
+	}
+
+	words = n & ~3;
+	sum = lwip_chksum_copy_words(sum, (u32_t *)(void *)db, (const u32_t *)(const void *)sb, words);
+	sb += words;
+	db += words;
+	n -= words;
+
+	sum = FOLD_U32T(sum);
+
+	if (n > 1) {
+		w = *(const u16_t *)(const void *)sb;
+		*(u16_t *)(void *)db = w;
+		sum += w;
+		sb += 2;
+		db += 2;
+		n -= 2;
+	}
+
+	if (n > 0) {
+		((u8_t *)&t)[0] = *sb;
+		*db = *sb;
+	}
+
+	sum += t;
+
+	sum = FOLD_U32T(sum);
+	sum = FOLD_U32T(sum);
+
+	if (odd) {
+		sum = SWAP_BYTES_IN_WORD(sum);
+	}
+
+	return (u16_t) sum;
+}
+#endif							/* (LWIP_CHKSUM_COPY_ALGORITHM == 2) */
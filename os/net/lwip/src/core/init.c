@@ -169,6 +169,12 @@ PACK_STRUCT_END
 #error "If you want to use TCP, TCP_WND must fit in an u16_t, so, you have to reduce it in your lwipopts.h (or enable window scaling)"
 #endif
 #endif							/* LWIP_WND_SCALE */
+#if (LWIP_TCP && LWIP_TCP_SACK && ((LWIP_TCP_SACK_NUM < 1) || (LWIP_TCP_SACK_NUM > 4)))
+#error "LWIP_TCP_SACK_NUM must be in the range of [1..4]"
+#endif
+#if (LWIP_TCP && LWIP_TCP_SACK && LWIP_TCP_TIMESTAMPS && (LWIP_TCP_SACK_NUM > 3))
+#error "Only 3 SACK blocks fit in the TCP options together with timestamps, reduce LWIP_TCP_SACK_NUM"
+#endif
 #if (LWIP_TCP && (TCP_SND_QUEUELEN > 0xffff))
 #error "If you want to use TCP, TCP_SND_QUEUELEN must fit in an u16_t, so, you have to reduce it in your lwipopts.h"
 #endif
@@ -700,6 +700,9 @@ struct tcp_pcb *tcp_listen_with_backlog_and_err(struct tcp_pcb *pcb, u8_t backlo
 	lpcb->so_options = pcb->so_options;
 	lpcb->ttl = pcb->ttl;
 	lpcb->tos = pcb->tos;
+#if LWIP_TCP_SACK
+	lpcb->flags = pcb->flags & TF_NOSACK;
+#endif							/* LWIP_TCP_SACK */
 #if LWIP_IPV4 && LWIP_IPV6
 	IP_SET_TYPE_VAL(lpcb->remote_ip, pcb->local_ip.type);
 #endif							/* LWIP_IPV4 && LWIP_IPV6 */
@@ -903,6 +906,9 @@ err_t tcp_connect(struct tcp_pcb *pcb, const ip_addr_t *ipaddr, u16_t port, tcp_
 	pcb->lastack = iss - 1;
 	pcb->snd_wl2 = iss - 1;
 	pcb->snd_lbb = iss - 1;
+#if LWIP_TCP_SACK
+	pcb->recover = iss - 1;
+#endif							/* LWIP_TCP_SACK */
 	/* Start with a window that does not need scaling. When window scaling is
 	   enabled and used, the window is enlarged when both sides agree on scaling. */
 	pcb->rcv_wnd = pcb->rcv_ann_wnd = TCPWND_MIN16(TCP_WND);
@@ -1007,6 +1013,18 @@ tcp_slowtmr_start:
 					++pcb->rtime;
 				}
 
+#if LWIP_TCP_TLP
+				/* Probe the tail of the data in flight once after two smoothed
+				 * round-trip times (but at least two ticks) without an ACK, if
+				 * that comes before the retransmission time-out. */
+				if (pcb->unacked != NULL && pcb->state >= ESTABLISHED && !(pcb->flags & (TF_TLP | TF_INFR))) {
+					s16_t pto = (s16_t)LWIP_MAX(2 * (pcb->sa >> 3), 2);
+					if (pcb->rtime >= pto && pto < pcb->rto) {
+						tcp_send_tlp(pcb);
+					}
+				}
+#endif							/* LWIP_TCP_TLP */
+
 				if (pcb->unacked != NULL && pcb->rtime >= pcb->rto) {
 					/* Time for a retransmission. */
 					LWIP_DEBUGF(TCP_RTO_DEBUG, ("tcp_slowtmr: rtime %" S16_F " pcb->rto %" S16_F "\n", pcb->rtime, pcb->rto));
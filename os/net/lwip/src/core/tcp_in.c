@@ -95,6 +95,12 @@ static u32_t seqno, ackno;
 static tcpwnd_size_t recv_acked;
 static u16_t tcplen;
 static u8_t flags;
+#if LWIP_TCP_SACK
+/* At most 4 SACK blocks fit in the option space */
+#define TCP_SACK_BLOCKS_MAX 4
+static u32_t sack_blocks[2 * TCP_SACK_BLOCKS_MAX];
+static u8_t sack_num;
+#endif							/* LWIP_TCP_SACK */
 
 static u8_t recv_flags;
 static struct pbuf *recv_data;
@@ -105,6 +111,10 @@ struct tcp_pcb *tcp_input_pcb;
 static err_t tcp_process(struct tcp_pcb *pcb);
 static void tcp_receive(struct tcp_pcb *pcb);
 static void tcp_parseopt(struct tcp_pcb *pcb);
+#if LWIP_TCP_SACK
+static void tcp_sack_mark(struct tcp_pcb *pcb);
+static u8_t tcp_sack_lost(struct tcp_pcb *pcb);
+#endif
 
 static void tcp_listen_input(struct tcp_pcb_listen *pcb);
 static void tcp_timewait_input(struct tcp_pcb *pcb);
@@ -601,6 +611,9 @@ static void tcp_listen_input(struct tcp_pcb_listen *pcb)
 		npcb->snd_nxt = iss;
 		npcb->lastack = iss;
 		npcb->snd_lbb = iss;
+#if LWIP_TCP_SACK
+		npcb->recover = iss;
+#endif							/* LWIP_TCP_SACK */
 		npcb->snd_wl1 = seqno - 1;	/* initialise to seqno-1 to force window update */
 		npcb->callback_arg = pcb->callback_arg;
 #if LWIP_CALLBACK_API || TCP_LISTEN_BACKLOG
@@ -608,6 +621,9 @@ static void tcp_listen_input(struct tcp_pcb_listen *pcb)
 #endif							/* LWIP_CALLBACK_API || TCP_LISTEN_BACKLOG */
 		/* inherit socket options */
 		npcb->so_options = pcb->so_options & SOF_INHERITED;
+#if LWIP_TCP_SACK
+		npcb->flags |= pcb->flags & TF_NOSACK;
+#endif							/* LWIP_TCP_SACK */
 		/* Register the new PCB so that we can begin receiving segments
 		   for it. */
 		TCP_REG_ACTIVE(npcb);
@@ -988,6 +1004,9 @@ static void tcp_receive(struct tcp_pcb *pcb)
 	u32_t right_wnd_edge;
 	u16_t new_tot_len;
 	int found_dupack = 0;
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+	u8_t ooseq_gap;
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 #if TCP_OOSEQ_MAX_BYTES || TCP_OOSEQ_MAX_PBUFS
 	u32_t ooseq_blen;
 	u16_t ooseq_qlen;
@@ -1027,6 +1046,12 @@ static void tcp_receive(struct tcp_pcb *pcb)
 #endif							/* TCP_WND_DEBUG */
 		}
 
+#if LWIP_TCP_SACK
+		if ((pcb->flags & TF_SACK) && sack_num > 0) {
+			tcp_sack_mark(pcb);
+		}
+#endif							/* LWIP_TCP_SACK */
+
 		/* (From Stevens TCP/IP Illustrated Vol II, p970.) Its only a
 		 * duplicate ack if:
 		 * 1) It doesn't ACK new data
@@ -1061,15 +1086,29 @@ static void tcp_receive(struct tcp_pcb *pcb)
 							if ((u8_t)(pcb->dupacks + 1) > pcb->dupacks) {
 								++pcb->dupacks;
 							}
-							if (pcb->dupacks > 3) {
-								/* Inflate the congestion window, but not if it means that
-								   the value overflows. */
+#if LWIP_TCP_SACK
+							if ((pcb->flags & (TF_SACK | TF_INFR)) == TF_SACK && pcb->dupacks < 3 && tcp_sack_lost(pcb)) {
+								/* The SACK blocks tell that the first unacked segment is
+								   lost: recover without waiting for more dupacks */
+								pcb->dupacks = 3;
+							}
+#endif							/* LWIP_TCP_SACK */
+							if (pcb->dupacks > 3 && (pcb->flags & TF_INFR)) {
+								/* Inflate the congestion window during fast recovery only,
+								   but not if it means that the value overflows. */
 								if ((tcpwnd_size_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
 									pcb->cwnd += pcb->mss;
 								}
-							} else if (pcb->dupacks == 3) {
-								/* Do fast retransmit */
+							}
+							if (pcb->dupacks == 3 && !(pcb->flags & TF_INFR)) {
+								/* Do fast retransmit, which sends the first missing segment */
 								tcp_rexmit_fast(pcb);
+#if LWIP_TCP_SACK
+							} else if ((pcb->flags & (TF_SACK | TF_INFR)) == (TF_SACK | TF_INFR)) {
+								/* Each dupack tells that a segment has left the
+								   network: send the next missing one in its place */
+								tcp_rexmit_sack(pcb);
+#endif							/* LWIP_TCP_SACK */
 							}
 						}
 					}
@@ -1087,9 +1126,19 @@ static void tcp_receive(struct tcp_pcb *pcb)
 			   in fast retransmit. Also reset the congestion window to the
 			   slow start threshold. */
 			if (pcb->flags & TF_INFR) {
-				pcb->flags &= ~TF_INFR;
-				pcb->cwnd = pcb->ssthresh;
+#if LWIP_TCP_SACK
+				/* With SACK, fast recovery lasts until all the data sent
+				   before it began is acknowledged (RFC 6675) */
+				if (!(pcb->flags & TF_SACK) || !TCP_SEQ_LT(ackno, pcb->recover))
+#endif							/* LWIP_TCP_SACK */
+				{
+					pcb->flags &= ~TF_INFR;
+					pcb->cwnd = pcb->ssthresh;
+				}
 			}
+#if LWIP_TCP_TLP
+			pcb->flags &= ~TF_TLP;
+#endif							/* LWIP_TCP_TLP */
 
 			/* Reset the number of retransmissions. */
 			pcb->nrtx = 0;
@@ -1103,7 +1152,7 @@ static void tcp_receive(struct tcp_pcb *pcb)
 
 			/* Update the congestion control variables (cwnd and
 			   ssthresh). */
-			if (pcb->state >= ESTABLISHED) {
+			if (pcb->state >= ESTABLISHED && !(pcb->flags & TF_INFR)) {
 				if (pcb->cwnd < pcb->ssthresh) {
 					if ((tcpwnd_size_t)(pcb->cwnd + pcb->mss) > pcb->cwnd) {
 						pcb->cwnd += pcb->mss;
@@ -1147,6 +1196,12 @@ static void tcp_receive(struct tcp_pcb *pcb)
 			} else {
 				pcb->rtime = 0;
 			}
+#if LWIP_TCP_SACK
+			if (pcb->flags & TF_INFR) {
+				/* Partial ACK: the next missing segment is at the left edge now */
+				tcp_rexmit_sack(pcb);
+			}
+#endif							/* LWIP_TCP_SACK */
 
 			pcb->polltmr = 0;
 
@@ -1321,6 +1376,9 @@ static void tcp_receive(struct tcp_pcb *pcb)
 				/* The incoming segment is the next in sequence. We check if
 				   we have to trim the end of the segment and update rcv_nxt
 				   and pass the data to the application. */
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+				ooseq_gap = (pcb->ooseq != NULL);
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 				tcplen = TCP_TCPLEN(&inseg);
 
 				if (tcplen > pcb->rcv_wnd) {
@@ -1453,6 +1511,13 @@ static void tcp_receive(struct tcp_pcb *pcb)
 
 				/* Acknowledge the segment(s). */
 				tcp_ack(pcb);
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+				if ((pcb->flags & TF_SACK) && ooseq_gap) {
+					/* The segment filled (part of) a gap: let the sender know
+					   at once (RFC 5681, section 4.2) */
+					tcp_ack_now(pcb);
+				}
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
 #if LWIP_IPV6 && LWIP_ND6_TCP_REACHABILITY_HINTS
 				if (ip_current_is_v6()) {
@@ -1463,7 +1528,17 @@ static void tcp_receive(struct tcp_pcb *pcb)
 
 			} else {
 				/* We get here if the incoming segment is out-of-sequence. */
-				tcp_send_empty_ack(pcb);
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+				if (pcb->flags & TF_SACK) {
+					/* ACK once the segment is queued, so that the SACK option
+					   reports it first */
+					pcb->rcv_sack_last = seqno;
+					tcp_ack_now(pcb);
+				} else
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
+				{
+					tcp_send_empty_ack(pcb);
+				}
 #if TCP_QUEUE_OOSEQ
 				/* We queue the segment on the ->ooseq queue. */
 				if (pcb->ooseq == NULL) {
@@ -1630,6 +1705,81 @@ static u8_t tcp_getoptbyte(void)
 	}
 }
 
+#if LWIP_TCP_SACK
+/* Read a 32-bit option field, returned in host byte order */
+static u32_t tcp_getoptlong(void)
+{
+	u32_t val;
+
+	val = (u32_t)tcp_getoptbyte() << 24;
+	val |= (u32_t)tcp_getoptbyte() << 16;
+	val |= (u32_t)tcp_getoptbyte() << 8;
+	val |= tcp_getoptbyte();
+	return val;
+}
+
+/**
+ * Marks the unacknowledged segments covered by the SACK blocks of the
+ * incoming segment. Blocks which do not lie within the data in flight
+ * are ignored.
+ *
+ * Called from tcp_receive() before the ACK is processed.
+ *
+ * @param pcb the tcp_pcb for which a segment arrived
+ */
+static void tcp_sack_mark(struct tcp_pcb *pcb)
+{
+	struct tcp_seg *seg;
+	u32_t left, right, seg_seqno;
+	u8_t i;
+
+	for (i = 0; i < sack_num; i++) {
+		left = sack_blocks[2 * i];
+		right = sack_blocks[2 * i + 1];
+		if (!TCP_SEQ_LT(left, right) || TCP_SEQ_LEQ(left, ackno) || TCP_SEQ_GT(right, pcb->snd_nxt)) {
+			continue;
+		}
+		for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+			seg_seqno = lwip_ntohl(seg->tcphdr->seqno);
+			if (!TCP_SEQ_LT(seg_seqno, right)) {
+				break;
+			}
+			if (TCP_SEQ_GEQ(seg_seqno, left) && TCP_SEQ_LEQ(seg_seqno + TCP_TCPLEN(seg), right)) {
+				seg->flags |= TF_SEG_SACKED;
+			}
+		}
+	}
+}
+
+/**
+ * Tells whether the first unacknowledged segment is considered lost: at
+ * least three segments sent after it were selectively acknowledged
+ * (RFC 6675), or the tail loss probe was.
+ *
+ * @param pcb the tcp_pcb for which a duplicate ACK arrived
+ * @return 1 if the segment is lost, 0 otherwise
+ */
+static u8_t tcp_sack_lost(struct tcp_pcb *pcb)
+{
+	struct tcp_seg *seg;
+	u8_t sacked = 0;
+
+	for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+		if (seg->flags & TF_SEG_SACKED) {
+			if (++sacked >= 3) {
+				return 1;
+			}
+#if LWIP_TCP_TLP
+			if ((pcb->flags & TF_TLP) && seg->next == NULL) {
+				return 1;
+			}
+#endif							/* LWIP_TCP_TLP */
+		}
+	}
+	return 0;
+}
+#endif							/* LWIP_TCP_SACK */
+
 /**
  * Parses the options contained in the incoming segment.
  *
@@ -1645,6 +1795,12 @@ static void tcp_parseopt(struct tcp_pcb *pcb)
 #if LWIP_TCP_TIMESTAMPS
 	u32_t tsval;
 #endif
+#if LWIP_TCP_SACK
+	u32_t left, right;
+	u8_t i;
+
+	sack_num = 0;
+#endif
 
 	/* Parse the TCP MSS option, if present. */
 	if (tcphdr_optlen != 0) {
@@ -1722,6 +1878,41 @@ static void tcp_parseopt(struct tcp_pcb *pcb)
 				/* Advance to next option (6 bytes already read) */
 				tcp_optidx += LWIP_TCP_OPT_LEN_TS - 6;
 				break;
+#endif
+#if LWIP_TCP_SACK
+			case LWIP_TCP_OPT_SACK_PERM:
+				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK_PERM\n"));
+				if (tcp_getoptbyte() != LWIP_TCP_OPT_LEN_SACK_PERM || (tcp_optidx - 2 + LWIP_TCP_OPT_LEN_SACK_PERM) > tcphdr_optlen) {
+					/* Bad length */
+					LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+					return;
+				}
+				/* The option is only valid in a SYN. Use SACK if this pcb
+				   does not decline it: a <SYN,ACK> then offers it too. */
+				if ((flags & TCP_SYN) && !(pcb->flags & TF_NOSACK)) {
+					pcb->flags |= TF_SACK;
+				}
+				break;
+			case LWIP_TCP_OPT_SACK:
+				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: SACK\n"));
+				data = tcp_getoptbyte();
+				if (data < LWIP_TCP_OPT_LEN_SACK(1) || ((data - 2) % 8) != 0 || (tcp_optidx - 2 + data) > tcphdr_optlen) {
+					/* Bad length */
+					LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: bad length\n"));
+					return;
+				}
+				/* Store the left and right edges, tcp_receive() marks the
+				   segments they cover */
+				for (i = 0; i < (data - 2) / 8; i++) {
+					left = tcp_getoptlong();
+					right = tcp_getoptlong();
+					if (sack_num < TCP_SACK_BLOCKS_MAX) {
+						sack_blocks[2 * sack_num] = left;
+						sack_blocks[2 * sack_num + 1] = right;
+						sack_num++;
+					}
+				}
+				break;
 #endif
 			default:
 				LWIP_DEBUGF(TCP_INPUT_DEBUG, ("tcp_parseopt: other\n"));
@@ -781,6 +781,12 @@ err_t tcp_enqueue_flags(struct tcp_pcb *pcb, u8_t flags)
 			optflags |= TF_SEG_OPTS_WND_SCALE;
 		}
 #endif							/* LWIP_WND_SCALE */
+#if LWIP_TCP_SACK
+		if ((pcb->state != SYN_RCVD) ? !(pcb->flags & TF_NOSACK) : (pcb->flags & TF_SACK)) {
+			/* Likewise, a <SYN,ACK> only permits SACK if the remote host did. */
+			optflags |= TF_SEG_OPTS_SACK_PERM;
+		}
+#endif							/* LWIP_TCP_SACK */
 	}
 #if LWIP_TCP_TIMESTAMPS
 	if ((pcb->flags & TF_TIMESTAMP)) {
@@ -869,6 +875,71 @@ static void tcp_build_wnd_scale_option(u32_t *opts)
 }
 #endif
 
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+/** Collect the blocks of out-of-sequence data to report in a SACK option.
+ * The block holding the most recently received segment comes first
+ * (RFC 2018, section 4), the others follow in sequence order.
+ *
+ * @param pcb tcp_pcb
+ * @param blocks where to store the left and right edges (host byte order)
+ * @return the number of blocks
+ */
+static u8_t tcp_get_sack_blocks(struct tcp_pcb *pcb, u32_t *blocks)
+{
+	struct tcp_seg *seg;
+	u32_t left, right;
+	u8_t num = 0;
+	u8_t i;
+
+	seg = pcb->ooseq;
+	while (seg != NULL) {
+		/* merge the segments which follow each other into one block */
+		left = seg->tcphdr->seqno;
+		right = left + TCP_TCPLEN(seg);
+		for (seg = seg->next; seg != NULL && TCP_SEQ_LEQ(seg->tcphdr->seqno, right); seg = seg->next) {
+			if (TCP_SEQ_GT(seg->tcphdr->seqno + TCP_TCPLEN(seg), right)) {
+				right = seg->tcphdr->seqno + TCP_TCPLEN(seg);
+			}
+		}
+
+		if (TCP_SEQ_GEQ(pcb->rcv_sack_last, left) && TCP_SEQ_LT(pcb->rcv_sack_last, right)) {
+			if (num == LWIP_TCP_SACK_NUM) {
+				num--;
+			}
+			for (i = num; i > 0; i--) {
+				blocks[2 * i] = blocks[2 * i - 2];
+				blocks[2 * i + 1] = blocks[2 * i - 1];
+			}
+			blocks[0] = left;
+			blocks[1] = right;
+			num++;
+		} else if (num < LWIP_TCP_SACK_NUM) {
+			blocks[2 * num] = left;
+			blocks[2 * num + 1] = right;
+			num++;
+		}
+	}
+	return num;
+}
+
+/** Build a SACK option (2 + 8 * num bytes long) at the specified options pointer
+ *
+ * @param opts option pointer where to store the SACK option
+ * @param blocks left and right edges of the blocks (host byte order)
+ * @param num number of blocks
+ */
+static void tcp_build_sack_option(u32_t *opts, const u32_t *blocks, u8_t num)
+{
+	u8_t i;
+
+	/* Pad with two NOP options to make everything nicely aligned */
+	opts[0] = lwip_htonl(0x01010500 | LWIP_TCP_OPT_LEN_SACK(num));
+	for (i = 0; i < 2 * num; i++) {
+		opts[1 + i] = lwip_htonl(blocks[i]);
+	}
+}
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
+
 /**
  * Send an ACK without data.
  *
@@ -880,15 +951,27 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 	struct pbuf *p;
 	u8_t optlen = 0;
 	struct netif *netif;
-#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP
+#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || (LWIP_TCP_SACK && TCP_QUEUE_OOSEQ)
 	struct tcp_hdr *tcphdr;
-#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP */
+#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || (LWIP_TCP_SACK && TCP_QUEUE_OOSEQ) */
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+	u32_t sack_blocks[2 * LWIP_TCP_SACK_NUM];
+	u8_t sack_num = 0;
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
 #if LWIP_TCP_TIMESTAMPS
 	if (pcb->flags & TF_TIMESTAMP) {
 		optlen = LWIP_TCP_OPT_LENGTH(TF_SEG_OPTS_TS);
 	}
 #endif
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+	if (pcb->flags & TF_SACK) {
+		sack_num = tcp_get_sack_blocks(pcb, sack_blocks);
+		if (sack_num > 0) {
+			optlen += LWIP_TCP_OPT_LEN_SACK_OUT(sack_num);
+		}
+	}
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
 	p = tcp_output_alloc_header(pcb, optlen, 0, lwip_htonl(pcb->snd_nxt));
 	if (p == NULL) {
@@ -897,9 +980,9 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 		LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_output: (ACK) could not allocate pbuf\n"));
 		return ERR_BUF;
 	}
-#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP
+#if LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || (LWIP_TCP_SACK && TCP_QUEUE_OOSEQ)
 	tcphdr = (struct tcp_hdr *)p->payload;
-#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP */
+#endif							/* LWIP_TCP_TIMESTAMPS || CHECKSUM_GEN_TCP || (LWIP_TCP_SACK && TCP_QUEUE_OOSEQ) */
 	LWIP_DEBUGF(TCP_OUTPUT_DEBUG, ("tcp_output: sending ACK for %" U32_F "\n", pcb->rcv_nxt));
 
 	/* NB. MSS option is only sent on SYNs, so ignore it here */
@@ -910,6 +993,12 @@ err_t tcp_send_empty_ack(struct tcp_pcb *pcb)
 		tcp_build_timestamp_option(pcb, (u32_t *)(tcphdr + 1));
 	}
 #endif
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+	if (sack_num > 0) {
+		/* the SACK option follows the timestamp option, if any */
+		tcp_build_sack_option((u32_t *)(void *)((u8_t *)(tcphdr + 1) + optlen - LWIP_TCP_OPT_LEN_SACK_OUT(sack_num)), sack_blocks, sack_num);
+	}
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
 	netif = ip_route(&pcb->local_ip, &pcb->remote_ip);
 	if (netif == NULL) {
@@ -978,6 +1067,13 @@ err_t tcp_output(struct tcp_pcb *pcb)
 	if (pcb->flags & TF_ACK_NOW && (seg == NULL || lwip_ntohl(seg->tcphdr->seqno) - pcb->lastack + seg->len > wnd)) {
 		return tcp_send_empty_ack(pcb);
 	}
+#if LWIP_TCP_SACK && TCP_QUEUE_OOSEQ
+	/* Data segments have no room for SACK blocks: report out-of-sequence
+	 * data in an empty ACK before sending them. */
+	if ((pcb->flags & TF_ACK_NOW) && (pcb->flags & TF_SACK) && pcb->ooseq != NULL) {
+		tcp_send_empty_ack(pcb);
+	}
+#endif							/* LWIP_TCP_SACK && TCP_QUEUE_OOSEQ */
 
 	/* useg should point to last segment on unacked queue */
 	useg = pcb->unacked;
@@ -1173,6 +1269,13 @@ static err_t tcp_output_segment(struct tcp_seg *seg, struct tcp_pcb *pcb, struct
 		opts += 1;
 	}
 #endif
+#if LWIP_TCP_SACK
+	if (seg->flags & TF_SEG_OPTS_SACK_PERM) {
+		/* Pad with two NOP options to make everything nicely aligned */
+		*opts = PP_HTONL(0x01010402);
+		opts += 1;
+	}
+#endif
 
 	/* Set retransmission timer running if it is not currently enabled
 	   This must be set before checking the route. */
@@ -1319,7 +1422,16 @@ void tcp_rexmit_rto(struct tcp_pcb *pcb)
 	}
 
 	/* Move all unacked segments to the head of the unsent queue */
-	for (seg = pcb->unacked; seg->next != NULL; seg = seg->next) ;
+	for (seg = pcb->unacked; seg->next != NULL; seg = seg->next) {
+#if LWIP_TCP_SACK
+		/* The remote host may have discarded data it reported (RFC 2018,
+		   section 8), so everything is sent again. */
+		seg->flags &= ~TF_SEG_SACKED;
+#endif
+	}
+#if LWIP_TCP_SACK
+	seg->flags &= ~TF_SEG_SACKED;
+#endif
 	/* concatenate unsent queue after unacked queue */
 	seg->next = pcb->unsent;
 #if TCP_OVERSIZE_DBGCHECK
@@ -1340,6 +1452,18 @@ void tcp_rexmit_rto(struct tcp_pcb *pcb)
 
 	/* Don't take any RTT measurements after retransmitting. */
 	pcb->rttest = 0;
+#if LWIP_TCP_TLP
+	pcb->flags &= ~TF_TLP;
+#endif
+
+	/* The timeout ends fast recovery, everything is sent again */
+	pcb->flags &= ~TF_INFR;
+	pcb->dupacks = 0;
+#if LWIP_TCP_SACK
+	/* Don't recover again before the data sent so far is acknowledged
+	   (RFC 6675, section 5.1) */
+	pcb->recover = pcb->snd_nxt;
+#endif
 
 	/* Do the actual retransmission */
 	tcp_output(pcb);
@@ -1399,10 +1523,27 @@ void tcp_rexmit(struct tcp_pcb *pcb)
  */
 void tcp_rexmit_fast(struct tcp_pcb *pcb)
 {
+#if LWIP_TCP_SACK
+	if ((pcb->flags & TF_SACK) && TCP_SEQ_LT(pcb->lastack, pcb->recover)) {
+		/* Data sent before the last timeout or recovery is still missing */
+		return;
+	}
+#endif							/* LWIP_TCP_SACK */
 	if (pcb->unacked != NULL && !(pcb->flags & TF_INFR)) {
 		/* This is fast retransmit. Retransmit the first unacked segment. */
 		LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_receive: dupacks %" U16_F " (%" U32_F "), fast retransmit %" U32_F "\n", (u16_t) pcb->dupacks, pcb->lastack, lwip_ntohl(pcb->unacked->tcphdr->seqno)));
-		tcp_rexmit(pcb);
+#if LWIP_TCP_SACK
+		if (pcb->flags & TF_SACK) {
+			/* Recover until everything sent so far is acknowledged,
+			   starting with the first unacked segment */
+			pcb->recover = pcb->snd_nxt;
+			pcb->high_rxt = pcb->lastack;
+			tcp_rexmit_sack(pcb);
+		} else
+#endif							/* LWIP_TCP_SACK */
+		{
+			tcp_rexmit(pcb);
+		}
 
 		/* Set ssthresh to half of the minimum of the current
 		 * cwnd and the advertised window */
@@ -1422,6 +1563,94 @@ void tcp_rexmit_fast(struct tcp_pcb *pcb)
 	}
 }
 
+#if LWIP_TCP_SACK
+/**
+ * Retransmit the next segment missing at the remote host during fast recovery
+ *
+ * A segment is missing if data above it was selectively acknowledged, or
+ * if it is the first unacked segment. It is sent again in place, without
+ * going through the unsent queue, and only once per recovery: high_rxt
+ * marks the end of the data retransmitted so far.
+ *
+ * Called by tcp_receive() for the ACKs received in fast recovery.
+ *
+ * @param pcb the tcp_pcb for which to retransmit a missing segment
+ */
+void tcp_rexmit_sack(struct tcp_pcb *pcb)
+{
+	struct tcp_seg *seg;
+	struct tcp_seg *hole = NULL;
+	struct netif *netif;
+
+	for (seg = pcb->unacked; seg != NULL; seg = seg->next) {
+		if (seg->flags & TF_SEG_SACKED) {
+			if (hole != NULL) {
+				break;
+			}
+		} else if (hole == NULL && TCP_SEQ_GEQ(lwip_ntohl(seg->tcphdr->seqno), pcb->high_rxt)) {
+			hole = seg;
+		}
+	}
+	if (hole == NULL || (seg == NULL && hole != pcb->unacked)) {
+		/* nothing is known to be missing */
+		return;
+	}
+
+	netif = ip_route(&pcb->local_ip, &pcb->remote_ip);
+	if (netif == NULL) {
+		return;
+	}
+
+	LWIP_DEBUGF(TCP_FR_DEBUG, ("tcp_rexmit_sack: retransmit %" U32_F "\n", lwip_ntohl(hole->tcphdr->seqno)));
+	pcb->high_rxt = lwip_ntohl(hole->tcphdr->seqno) + TCP_TCPLEN(hole);
+	if (tcp_output_segment(hole, pcb, netif) == ERR_OK) {
+		MIB2_STATS_INC(mib2.tcpretranssegs);
+	}
+
+	/* Don't take any rtt measurements after retransmitting. */
+	pcb->rttest = 0;
+}
+#endif							/* LWIP_TCP_SACK */
+
+#if LWIP_TCP_TLP
+/**
+ * Send a tail loss probe: retransmit the last unacked segment in place.
+ * If data sent before it is missing, the ACK of the probe tells so and
+ * fast recovery starts without waiting for the retransmission timeout.
+ *
+ * Called by tcp_slowtmr()
+ *
+ * @param pcb the tcp_pcb for which to send a probe
+ */
+err_t tcp_send_tlp(struct tcp_pcb *pcb)
+{
+	struct tcp_seg *seg;
+	struct netif *netif;
+	err_t err;
+
+	if (pcb->unacked == NULL) {
+		return ERR_OK;
+	}
+	for (seg = pcb->unacked; seg->next != NULL; seg = seg->next) ;
+
+	netif = ip_route(&pcb->local_ip, &pcb->remote_ip);
+	if (netif == NULL) {
+		return ERR_RTE;
+	}
+
+	LWIP_DEBUGF(TCP_RTO_DEBUG, ("tcp_send_tlp: probe %" U32_F "\n", lwip_ntohl(seg->tcphdr->seqno)));
+	err = tcp_output_segment(seg, pcb, netif);
+	if (err == ERR_OK) {
+		pcb->flags |= TF_TLP;
+		MIB2_STATS_INC(mib2.tcpretranssegs);
+	}
+
+	/* Don't take any rtt measurements after retransmitting. */
+	pcb->rttest = 0;
+	return err;
+}
+#endif							/* LWIP_TCP_TLP */
+
 /**
  * Send keepalive packets to keep a connection active although
  * no data is sent over it.
@@ -227,6 +227,17 @@
 #define LWIP_IPV6_DHCP6			0
 #endif
 
+/* ---------- Checksum options ---------- */
+#ifdef CONFIG_NET_LWIP_CHKSUM_ALGORITHM
+#define LWIP_CHKSUM_ALGORITHM           CONFIG_NET_LWIP_CHKSUM_ALGORITHM
+#endif
+
+#ifdef CONFIG_NET_LWIP_CHECKSUM_ON_COPY
+#define LWIP_CHECKSUM_ON_COPY           1
+#define LWIP_CHKSUM_COPY_ALGORITHM      2
+#endif
+/* ---------- Checksum options ---------- */
+
 /* ---------- VLAN options ---------- */
 #ifdef CONFIG_NET_LWIP_VLAN
 #define ETHARP_SUPPORT_VLAN             1
@@ -434,6 +445,18 @@
 #define TCP_TIMESTAMPS	CONFIG_NET_TCP_TIMESTAMPS
 #endif
 
+#ifdef CONFIG_NET_TCP_SACK
+#define LWIP_TCP_SACK	1
+#endif
+
+#ifdef CONFIG_NET_TCP_SACK_NUM
+#define LWIP_TCP_SACK_NUM	CONFIG_NET_TCP_SACK_NUM
+#endif
+
+#ifdef CONFIG_NET_TCP_TLP
+#define LWIP_TCP_TLP	1
+#endif
+
 #ifdef CONFIG_NET_TCP_KEEPALIVE
 #define LWIP_TCP_KEEPALIVE              CONFIG_NET_TCP_KEEPALIVE
 #endif
@@ -654,6 +677,11 @@
 #define LWIP_SOCKET	CONFIG_NET_SOCKET
 #endif
 
+#ifdef CONFIG_NET_SOCKET_ZEROCOPY
+#define LWIP_SOCKET_ZEROCOPY            1
+#define LWIP_SUPPORT_CUSTOM_PBUF        1
+#endif
+
 #ifdef CONFIG_NET_SOCKET_OPTION_BROADCAST
 #define IP_SOF_BROADCAST                CONFIG_NET_SOCKET_OPTION_BROADCAST
 #endif
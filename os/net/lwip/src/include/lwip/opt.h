@@ -1277,6 +1277,34 @@
 #define LWIP_TCP_TIMESTAMPS             0
 #endif
 
+/**
+ * LWIP_TCP_SACK==1: support the TCP selective acknowledgment option
+ * (RFC 2018). The option is offered in SYN segments and, when both hosts
+ * agree, out-of-sequence data is reported in ACKs and the blocks received
+ * are used to retransmit only the missing segments during fast recovery.
+ */
+#ifndef LWIP_TCP_SACK
+#define LWIP_TCP_SACK                   0
+#endif
+
+/**
+ * LWIP_TCP_SACK_NUM: maximum number of SACK blocks sent in an ACK.
+ * The option space allows 4 blocks, or 3 if timestamps are used.
+ */
+#ifndef LWIP_TCP_SACK_NUM
+#define LWIP_TCP_SACK_NUM               3
+#endif
+
+/**
+ * LWIP_TCP_TLP==1: send a tail loss probe, the last unacknowledged
+ * segment, when no ACK arrived for two smoothed round-trip times. The
+ * ACK of the probe reveals a loss at the tail of a transfer long before
+ * the retransmission timer expires.
+ */
+#ifndef LWIP_TCP_TLP
+#define LWIP_TCP_TLP                    0
+#endif
+
 /**
  * TCP_WND_UPDATE_THRESHOLD: difference in window to trigger an
  * explicit window update
@@ -1845,6 +1873,15 @@
 #ifndef LWIP_FIONREAD_LINUXMODE
 #define LWIP_FIONREAD_LINUXMODE         0
 #endif
+
+/**
+ * LWIP_SOCKET_ZEROCOPY==1: Enable lwip_recvfrom_zc() and lwip_sendto_zc(),
+ * which hand the pbufs of the stack to the application instead of copying
+ * the data. Requires LWIP_SUPPORT_CUSTOM_PBUF for the completion of a send.
+ */
+#ifndef LWIP_SOCKET_ZEROCOPY
+#define LWIP_SOCKET_ZEROCOPY            0
+#endif
 /**
  * @}
  */
@@ -529,6 +529,13 @@ int lwip_fcntl(int s, int cmd, int val);
 
 int lwip_poll(int fd, struct pollfd *fds, bool setup);
 
+#if LWIP_SOCKET_ZEROCOPY
+struct sock_zcbuf;
+int lwip_recvfrom_zc(int s, struct sock_zcbuf *zbuf, int flags, struct sockaddr *from, socklen_t *fromlen);
+void lwip_release_zc(struct sock_zcbuf *zbuf);
+int lwip_sendto_zc(int s, const void *dataptr, size_t size, int flags, const struct sockaddr *to, socklen_t tolen, void (*done)(void *arg), void *arg);
+#endif
+
 /*  API for network manager only*/
 struct lwip_sock *get_socket_by_pid(int sd, pid_t pid);
 #ifdef __cplusplus
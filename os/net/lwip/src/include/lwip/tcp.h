@@ -154,7 +154,7 @@ typedef u32_t tcpwnd_size_t;
 typedef u16_t tcpwnd_size_t;
 #endif
 
-#if LWIP_WND_SCALE || TCP_LISTEN_BACKLOG || LWIP_TCP_TIMESTAMPS
+#if LWIP_WND_SCALE || TCP_LISTEN_BACKLOG || LWIP_TCP_TIMESTAMPS || LWIP_TCP_SACK || LWIP_TCP_TLP
 typedef u16_t tcpflags_t;
 #else
 typedef u8_t tcpflags_t;
@@ -201,6 +201,11 @@ struct tcp_pcb_listen {
 	u8_t backlog;
 	u8_t accepts_pending;
 #endif							/* TCP_LISTEN_BACKLOG */
+
+#if LWIP_TCP_SACK
+	/* TF_NOSACK, inherited by the accepted pcbs */
+	tcpflags_t flags;
+#endif							/* LWIP_TCP_SACK */
 };
 
 /** the TCP protocol control block */
@@ -230,6 +235,13 @@ struct tcp_pcb {
 #endif
 #if LWIP_TCP_TIMESTAMPS
 #define TF_TIMESTAMP   0x0400U	/* Timestamp option enabled */
+#endif
+#if LWIP_TCP_SACK
+#define TF_SACK        0x0800U	/* SACK option enabled */
+#define TF_NOSACK      0x1000U	/* Neither offer nor accept the SACK option */
+#endif
+#if LWIP_TCP_TLP
+#define TF_TLP         0x2000U	/* Tail loss probe sent, cleared by the next new ACK */
 #endif
 
 	/* the rest of the fields are in host byte order
@@ -262,6 +274,11 @@ struct tcp_pcb {
 	/* fast retransmit/recovery */
 	u8_t dupacks;
 	u32_t lastack;			/* Highest acknowledged seqno. */
+#if LWIP_TCP_SACK
+	u32_t recover;			/* snd_nxt when fast recovery was entered */
+	u32_t high_rxt;			/* end of the data retransmitted in this recovery */
+	u32_t rcv_sack_last;	/* seqno of the last out-of-sequence segment received */
+#endif							/* LWIP_TCP_SACK */
 
 	/* congestion avoidance/control variables */
 	tcpwnd_size_t cwnd;
@@ -377,6 +394,13 @@ void tcp_poll(struct tcp_pcb *pcb, tcp_poll_fn poll, u8_t interval);
 #define          tcp_nagle_enable(pcb)    ((pcb)->flags = (tcpflags_t)((pcb)->flags & ~TF_NODELAY))
 /** @ingroup tcp_raw */
 #define          tcp_nagle_disabled(pcb)  (((pcb)->flags & TF_NODELAY) != 0)
+#if LWIP_TCP_SACK
+/** @ingroup tcp_raw
+ * Do not use SACK on a connection, must be called before it is set up.
+ * On a listening pcb, or on a pcb before tcp_listen(), it applies to the
+ * connections accepted from then on. */
+#define          tcp_sack_disable(pcb)    ((pcb)->flags |= TF_NOSACK)
+#endif							/* LWIP_TCP_SACK */
 
 #if TCP_LISTEN_BACKLOG
 #define          tcp_backlog_set(pcb, new_backlog) do { \
@@ -0,0 +1,174 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "test_chksum.h"
+
+#include "lwip/inet_chksum.h"
+#include "lwip/def.h"
+
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+#if !LWIP_CHECKSUM_ON_COPY
+#error "This tests needs LWIP_CHECKSUM_ON_COPY enabled"
+#endif
+
+#define TEST_CHKSUM_MAXLEN  1500
+#define TEST_CHKSUM_GUARD   0xa5
+#define TEST_CHKSUM_SEGLEN  1460
+#define TEST_CHKSUM_ROUNDS  20000
+
+static u8_t chksum_src[TEST_CHKSUM_MAXLEN + 8];
+static u8_t chksum_dst[TEST_CHKSUM_MAXLEN + 8];
+
+/* Setups/teardown functions */
+
+static void chksum_setup(void)
+{
+	size_t i;
+
+	for (i = 0; i < sizeof(chksum_src); i++) {
+		chksum_src[i] = (u8_t)(i * 7 + (i >> 8));
+	}
+	/* a run of 0xff makes every addition carry */
+	memset(&chksum_src[200], 0xff, 600);
+}
+
+static void chksum_teardown(void)
+{
+}
+
+/** RFC 1071 checksum, one 16-bit word in network order at a time */
+static u16_t chksum_reference(const u8_t *data, int len)
+{
+	u32_t sum = 0;
+	int i;
+
+	for (i = 0; i + 1 < len; i += 2) {
+		sum += (u32_t)((data[i] << 8) | data[i + 1]);
+	}
+	if (len & 1) {
+		sum += (u32_t)(data[len - 1] << 8);
+	}
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+	return (u16_t)~sum;
+}
+
+static int chksum_next_len(int len)
+{
+	return (len < 80) ? len + 1 : len + 37;
+}
+
+/* Test functions */
+
+/** Compare inet_chksum() with the reference at every alignment */
+START_TEST(test_chksum_alignment)
+{
+	int off;
+	int len;
+	LWIP_UNUSED_ARG(_i);
+
+	for (off = 0; off < 4; off++) {
+		for (len = 0; len <= TEST_CHKSUM_MAXLEN; len = chksum_next_len(len)) {
+			fail_unless(lwip_ntohs(inet_chksum(&chksum_src[off], (u16_t)len)) == chksum_reference(&chksum_src[off], len));
+		}
+	}
+}
+
+END_TEST
+/** lwip_chksum_copy() copies exactly len bytes and returns their checksum,
+    whether or not the source and the destination share their alignment */
+START_TEST(test_chksum_copy)
+{
+	int soff;
+	int doff;
+	int len;
+	u16_t chksum;
+	LWIP_UNUSED_ARG(_i);
+
+	for (soff = 0; soff < 4; soff++) {
+		for (doff = 0; doff < 4; doff++) {
+			for (len = 0; len <= TEST_CHKSUM_MAXLEN; len = chksum_next_len(len)) {
+				memset(chksum_dst, TEST_CHKSUM_GUARD, sizeof(chksum_dst));
+				chksum = lwip_chksum_copy(&chksum_dst[doff], &chksum_src[soff], (u16_t)len);
+				fail_unless((u16_t)~lwip_ntohs(chksum) == chksum_reference(&chksum_src[soff], len));
+				fail_unless(memcmp(&chksum_dst[doff], &chksum_src[soff], len) == 0);
+				fail_unless(doff == 0 || chksum_dst[doff - 1] == TEST_CHKSUM_GUARD);
+				fail_unless(chksum_dst[doff + len] == TEST_CHKSUM_GUARD);
+			}
+		}
+	}
+}
+
+END_TEST
+/** Report the throughput of the checksum, of a copy followed by the
+    checksum and of lwip_chksum_copy() for full sized TCP segments */
+START_TEST(test_chksum_bench)
+{
+	volatile u16_t sink = 0;
+	clock_t start;
+	double secs[3];
+	int i;
+	LWIP_UNUSED_ARG(_i);
+
+	start = clock();
+	for (i = 0; i < TEST_CHKSUM_ROUNDS; i++) {
+		sink += inet_chksum(chksum_src, TEST_CHKSUM_SEGLEN);
+	}
+	secs[0] = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	for (i = 0; i < TEST_CHKSUM_ROUNDS; i++) {
+		MEMCPY(chksum_dst, chksum_src, TEST_CHKSUM_SEGLEN);
+		sink += inet_chksum(chksum_dst, TEST_CHKSUM_SEGLEN);
+	}
+	secs[1] = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	for (i = 0; i < TEST_CHKSUM_ROUNDS; i++) {
+		sink += lwip_chksum_copy(chksum_dst, chksum_src, TEST_CHKSUM_SEGLEN);
+	}
+	secs[2] = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	for (i = 0; i < 3; i++) {
+		if (secs[i] <= 0) {
+			secs[i] = 1.0 / CLOCKS_PER_SEC;
+		}
+	}
+
+	printf("chksum: %.1f MB/s, copy + chksum: %.1f MB/s, chksum_copy: %.1f MB/s\n",
+		   (double)TEST_CHKSUM_ROUNDS * TEST_CHKSUM_SEGLEN / 1e6 / secs[0],
+		   (double)TEST_CHKSUM_ROUNDS * TEST_CHKSUM_SEGLEN / 1e6 / secs[1],
+		   (double)TEST_CHKSUM_ROUNDS * TEST_CHKSUM_SEGLEN / 1e6 / secs[2]);
+	fail_unless(memcmp(chksum_dst, chksum_src, TEST_CHKSUM_SEGLEN) == 0);
+}
+
+END_TEST
+/** Create the suite including all tests for this module */
+Suite *chksum_suite(void)
+{
+	TFun tests[] = {
+		test_chksum_alignment,
+		test_chksum_copy,
+		test_chksum_bench
+	};
+	return create_suite("CHKSUM", tests, sizeof(tests) / sizeof(TFun), chksum_setup, chksum_teardown);
+}
@@ -21,7 +21,9 @@
 #include "udp/test_udp.h"
 #include "tcp/test_tcp.h"
 #include "tcp/test_tcp_oos.h"
+#include "tcp/test_tcp_sack.h"
 #include "core/test_mem.h"
+#include "core/test_chksum.h"
 #include "etharp/test_etharp.h"
 
 #include "lwip/init.h"
@@ -35,7 +37,9 @@ int main()
 		udp_suite,
 		tcp_suite,
 		tcp_oos_suite,
+		tcp_sack_suite,
 		mem_suite,
+		chksum_suite,
 		etharp_suite
 	};
 	size_t num = sizeof(suites) / sizeof(void *);
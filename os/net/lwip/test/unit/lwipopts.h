@@ -61,8 +61,15 @@
 #define MEMP_NUM_TCP_SEG                TCP_SND_QUEUELEN
 #define TCP_SND_BUF                     (12 * TCP_MSS)
 #define TCP_WND                         (10 * TCP_MSS)
+#define LWIP_TCP_SACK                   1
+#define LWIP_TCP_TLP                    1
 
 /* Minimal changes to opt.h required for etharp unit tests: */
 #define ETHARP_SUPPORT_STATIC_ENTRIES   1
 
+/* Checksum and copy-and-checksum implementations under test: */
+#define LWIP_CHKSUM_ALGORITHM           4
+#define LWIP_CHECKSUM_ON_COPY           1
+#define LWIP_CHKSUM_COPY_ALGORITHM      2
+
 #endif							/* __LWIPOPTS_H__ */
@@ -0,0 +1,475 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+#include "test_tcp_sack.h"
+
+#include "lwip/priv/tcp_priv.h"
+#include "lwip/stats.h"
+#include "tcp_helper.h"
+
+#include <string.h>
+#include <stdio.h>
+
+#if !LWIP_STATS || !TCP_STATS || !MEMP_STATS
+#error "This tests needs TCP- and MEMP-statistics enabled"
+#endif
+#if !LWIP_TCP_SACK
+#error "This tests needs LWIP_TCP_SACK enabled"
+#endif
+
+/* A client sends TEST_SACK_DATA_LEN bytes to a server over a netif which
+   loses the first transmission of some data segments. The loss pattern
+   only depends on the offset of the data, so that runs with and without
+   SACK see the same losses and the time they take can be compared.
+   Optionally, the first retransmission of the first lost segment is lost
+   as well, which only the retransmission timer recovers from. */
+
+#define TEST_SACK_DATA_LEN    (48 * TCP_MSS)
+#define TEST_SACK_LOSS        10	/* percentage of the data segments lost */
+#define TEST_SACK_QUEUE_LEN   64
+#define TEST_SACK_MAX_TICKS   2000
+#define TEST_SACK_CLIENT_PORT 0x100
+#define TEST_SACK_SERVER_PORT 0x101
+#define TEST_SACK_NO_OFF      0xFFFFFFFFUL
+
+static char sack_data[TEST_SACK_DATA_LEN];
+static struct netif sack_netif;
+static struct test_tcp_txcounters sack_txcounters;
+static ip_addr_t sack_client_ip, sack_server_ip;
+static struct tcp_pcb *sack_client;
+static struct tcp_pcb *sack_server;
+static struct pbuf *sack_queue[TEST_SACK_QUEUE_LEN];
+static u16_t sack_queue_head, sack_queue_count;
+static u32_t sack_data_seqno;	/* seqno of the first data byte */
+static u32_t sack_sent;			/* bytes written by the client */
+static u32_t sack_highest;		/* end of the data transmitted so far */
+static u32_t sack_lost;			/* data segments lost */
+static u8_t sack_tail_loss;		/* lose the last two segments instead */
+static u8_t sack_rexmit_loss;	/* lose a retransmission as well */
+static u32_t sack_rexmit_off;	/* offset of that retransmission */
+static u32_t sack_rtos;			/* retransmission timeouts of the client */
+static u8_t sack_listen_nosack;	/* disable SACK on the server instead */
+static u8_t test_tcp_timer;
+
+/* our own version of tcp_tmr so we can reset fast/slow timer state */
+static void test_tcp_tmr(void)
+{
+	tcp_fasttmr();
+	if (++test_tcp_timer & 1) {
+		tcp_slowtmr();
+	}
+}
+
+/** Whether the first transmission of the data at offset off is lost */
+static int test_sack_is_lost(u32_t off)
+{
+	u32_t hash;
+
+	if (sack_tail_loss) {
+		return off >= TEST_SACK_DATA_LEN - 2 * TCP_MSS;
+	}
+	hash = (off / TCP_MSS + 1) * 2654435761U;
+	return ((hash >> 16) % 100) < TEST_SACK_LOSS;
+}
+
+/** The lossy link: queue a copy of the packet for test_sack_deliver() */
+static err_t test_sack_netif_output(struct netif *netif, struct pbuf *p, const ip4_addr_t *ipaddr)
+{
+	struct ip_hdr *iphdr = (struct ip_hdr *)p->payload;
+	struct tcp_hdr *tcphdr = (struct tcp_hdr *)((u8_t *)p->payload + IPH_HL(iphdr) * 4);
+	u16_t len = p->tot_len - IPH_HL(iphdr) * 4 - TCPH_HDRLEN(tcphdr) * 4;
+	u32_t off;
+	struct pbuf *q;
+	LWIP_UNUSED_ARG(netif);
+	LWIP_UNUSED_ARG(ipaddr);
+
+	if (len > 0 && lwip_ntohs(tcphdr->src) == TEST_SACK_CLIENT_PORT) {
+		off = lwip_ntohl(tcphdr->seqno) - sack_data_seqno;
+		if (off >= sack_highest) {
+			sack_highest = off + len;
+			if (test_sack_is_lost(off)) {
+				if (sack_rexmit_loss && sack_rexmit_off == TEST_SACK_NO_OFF) {
+					sack_rexmit_off = off;
+				}
+				sack_lost++;
+				return ERR_OK;
+			}
+		} else if (off == sack_rexmit_off) {
+			/* lose the first retransmission only */
+			sack_rexmit_off = TEST_SACK_DATA_LEN;
+			sack_lost++;
+			return ERR_OK;
+		}
+	}
+
+	EXPECT_RETX(sack_queue_count < TEST_SACK_QUEUE_LEN, ERR_OK);
+	q = pbuf_alloc(PBUF_RAW, p->tot_len, PBUF_RAM);
+	EXPECT_RETX(q != NULL, ERR_MEM);
+	EXPECT(pbuf_copy(q, p) == ERR_OK);
+	sack_queue[(sack_queue_head + sack_queue_count) % TEST_SACK_QUEUE_LEN] = q;
+	sack_queue_count++;
+	return ERR_OK;
+}
+
+/** Pass the queued packets to tcp_input() until the link is idle */
+static void test_sack_deliver(void)
+{
+	struct pbuf *p;
+
+	while (sack_queue_count > 0) {
+		p = sack_queue[sack_queue_head];
+		sack_queue_head = (sack_queue_head + 1) % TEST_SACK_QUEUE_LEN;
+		sack_queue_count--;
+		test_tcp_input(p, &sack_netif);
+	}
+}
+
+/** Drop the packets still on the link */
+static void test_sack_flush(void)
+{
+	while (sack_queue_count > 0) {
+		pbuf_free(sack_queue[sack_queue_head]);
+		sack_queue_head = (sack_queue_head + 1) % TEST_SACK_QUEUE_LEN;
+		sack_queue_count--;
+	}
+}
+
+/** Write as much data as fits in the send buffer, one segment per write */
+static void test_sack_send(struct tcp_pcb *pcb)
+{
+	u16_t len;
+
+	while (sack_sent < TEST_SACK_DATA_LEN) {
+		len = (u16_t)LWIP_MIN(LWIP_MIN(tcp_sndbuf(pcb), TCP_MSS), TEST_SACK_DATA_LEN - sack_sent);
+		if (len == 0 || tcp_write(pcb, &sack_data[sack_sent], len, 0) != ERR_OK) {
+			break;
+		}
+		sack_sent += len;
+	}
+	tcp_output(pcb);
+}
+
+static err_t test_sack_sent(void *arg, struct tcp_pcb *pcb, u16_t len)
+{
+	LWIP_UNUSED_ARG(arg);
+	LWIP_UNUSED_ARG(len);
+	test_sack_send(pcb);
+	return ERR_OK;
+}
+
+static err_t test_sack_connected(void *arg, struct tcp_pcb *pcb, err_t err)
+{
+	LWIP_UNUSED_ARG(arg);
+	LWIP_UNUSED_ARG(pcb);
+	EXPECT(err == ERR_OK);
+	return ERR_OK;
+}
+
+static err_t test_sack_recv(void *arg, struct tcp_pcb *pcb, struct pbuf *p, err_t err)
+{
+	if (p != NULL) {
+		tcp_recved(pcb, p->tot_len);
+	}
+	return test_tcp_counters_recv(arg, pcb, p, err);
+}
+
+static err_t test_sack_accept(void *arg, struct tcp_pcb *newpcb, err_t err)
+{
+	EXPECT_RETX(err == ERR_OK, ERR_VAL);
+	sack_server = newpcb;
+	tcp_arg(newpcb, arg);
+	tcp_recv(newpcb, test_sack_recv);
+	tcp_err(newpcb, test_tcp_counters_err);
+	return ERR_OK;
+}
+
+/** Connect a client to a server, with or without SACK. Returns 0 if the
+    connection could not be established. */
+static int test_sack_connect(u8_t sack, struct test_tcp_counters *counters)
+{
+	struct tcp_pcb *pcb, *lpcb;
+
+	memset(counters, 0, sizeof(struct test_tcp_counters));
+	counters->expected_data = sack_data;
+	counters->expected_data_len = TEST_SACK_DATA_LEN;
+	sack_server = NULL;
+	sack_sent = 0;
+	sack_highest = 0;
+	sack_lost = 0;
+	sack_rexmit_off = TEST_SACK_NO_OFF;
+	sack_rtos = 0;
+	test_tcp_timer = 0;
+
+	pcb = tcp_new();
+	EXPECT_RETX(pcb != NULL, 0);
+	if (sack_listen_nosack) {
+		tcp_sack_disable(pcb);
+	}
+	EXPECT(tcp_bind(pcb, &sack_server_ip, TEST_SACK_SERVER_PORT) == ERR_OK);
+	lpcb = tcp_listen(pcb);
+	EXPECT_RETX(lpcb != NULL, 0);
+	tcp_arg(lpcb, counters);
+	tcp_accept(lpcb, test_sack_accept);
+
+	sack_client = tcp_new();
+	EXPECT_RETX(sack_client != NULL, 0);
+	if (!sack) {
+		tcp_sack_disable(sack_client);
+	}
+	tcp_sent(sack_client, test_sack_sent);
+	EXPECT(tcp_bind(sack_client, &sack_client_ip, TEST_SACK_CLIENT_PORT) == ERR_OK);
+	EXPECT(tcp_connect(sack_client, &sack_server_ip, TEST_SACK_SERVER_PORT, test_sack_connected) == ERR_OK);
+	sack_data_seqno = sack_client->snd_lbb;
+
+	/* three-way handshake */
+	test_sack_deliver();
+	tcp_close(lpcb);
+	EXPECT_RETX(sack_server != NULL, 0);
+	EXPECT(sack_client->state == ESTABLISHED);
+	EXPECT(((sack_server->flags & TF_NOSACK) != 0) == (sack_listen_nosack != 0));
+	EXPECT(((sack_client->flags & TF_SACK) != 0) == (sack && !sack_listen_nosack));
+	EXPECT(((sack_server->flags & TF_SACK) != 0) == (sack && !sack_listen_nosack));
+	return 1;
+}
+
+/** Connect a client to a server, with or without SACK, and transfer the
+    data. Returns the time the transfer took in calls of tcp_fasttmr(). */
+static u32_t test_sack_transfer(u8_t sack, struct test_tcp_counters *counters)
+{
+	u32_t ticks = 0;
+	u8_t nrtx;
+
+	if (!test_sack_connect(sack, counters)) {
+		return 0;
+	}
+
+	test_sack_send(sack_client);
+	test_sack_deliver();
+	while (counters->recved_bytes < TEST_SACK_DATA_LEN && ticks < TEST_SACK_MAX_TICKS) {
+		nrtx = sack_client->nrtx;
+		test_tcp_tmr();
+		ticks++;
+		if (sack_client->nrtx != nrtx) {
+			/* A timeout ends fast recovery, which must not start again
+			   before everything sent so far is acknowledged */
+			sack_rtos++;
+			EXPECT(!(sack_client->flags & TF_INFR));
+			EXPECT(sack_client->dupacks == 0);
+			EXPECT(!(sack_client->flags & TF_SACK) || sack_client->recover == sack_client->snd_nxt);
+		}
+		test_sack_send(sack_client);
+		test_sack_deliver();
+	}
+
+	EXPECT(counters->recved_bytes == TEST_SACK_DATA_LEN);
+	EXPECT(counters->err_calls == 0);
+	EXPECT(sack_lost > 0);
+	return ticks;
+}
+
+/** Abort both ends of the connection of test_sack_transfer() */
+static void test_sack_close(void)
+{
+	if (sack_server != NULL) {
+		tcp_abort(sack_server);
+		sack_server = NULL;
+	}
+	tcp_abort(sack_client);
+	sack_client = NULL;
+	test_sack_flush();
+}
+
+/* Setups/teardown functions */
+
+static void tcp_sack_setup(void)
+{
+	ip_addr_t netif_ip, netmask;
+	u32_t i;
+
+	/* reset iss to default (6510) */
+	tcp_ticks = 0;
+	tcp_ticks = 0 - (tcp_next_iss(NULL) - 6510);
+	tcp_next_iss(NULL);
+	tcp_ticks = 0;
+
+	test_tcp_timer = 0;
+	tcp_remove_all();
+
+	for (i = 0; i < TEST_SACK_DATA_LEN; i++) {
+		sack_data[i] = (char)(i * 7 + (i >> 8));
+	}
+	IP4_ADDR(&sack_client_ip, 192, 168, 1, 1);
+	IP4_ADDR(&sack_server_ip, 192, 168, 1, 2);
+	IP4_ADDR(&netif_ip, 192, 168, 1, 254);
+	IP4_ADDR(&netmask, 255, 255, 255, 0);
+	test_tcp_init_netif(&sack_netif, &sack_txcounters, &netif_ip, &netmask);
+	sack_netif.output = test_sack_netif_output;
+	sack_netif.flags |= NETIF_FLAG_LINK_UP;
+}
+
+static void tcp_sack_teardown(void)
+{
+	tcp_remove_all();
+	test_sack_flush();
+	netif_list = NULL;
+}
+
+/* Test functions */
+
+/** Transfer data over a link which loses about TEST_SACK_LOSS percent of
+    the data segments, without and with SACK, and compare the throughput */
+START_TEST(test_tcp_sack_lossy_link)
+{
+	struct test_tcp_counters counters;
+	u32_t ticks_nosack, ticks_sack;
+	u32_t lost_nosack;
+	LWIP_UNUSED_ARG(_i);
+
+	sack_tail_loss = 0;
+	sack_rexmit_loss = 0;
+	sack_listen_nosack = 0;
+	ticks_nosack = test_sack_transfer(0, &counters);
+	lost_nosack = sack_lost;
+	test_sack_close();
+
+	ticks_sack = test_sack_transfer(1, &counters);
+	test_sack_close();
+
+	printf("tcp_sack: %u segments lost, %u bytes in %u ms without SACK, in %u ms with SACK\n",
+		   (unsigned)sack_lost, (unsigned)TEST_SACK_DATA_LEN,
+		   (unsigned)(ticks_nosack * TCP_FAST_INTERVAL), (unsigned)(ticks_sack * TCP_FAST_INTERVAL));
+	EXPECT(lost_nosack == sack_lost);
+	EXPECT(ticks_sack < ticks_nosack);
+}
+
+END_TEST
+/** Lose the last two segments of the transfer: no dupacks are left to
+    start fast recovery, only the tail loss probe can avoid a time-out */
+START_TEST(test_tcp_sack_tail_loss)
+{
+	struct test_tcp_counters counters;
+	u32_t ticks_nosack, ticks_sack;
+	LWIP_UNUSED_ARG(_i);
+
+	sack_tail_loss = 1;
+	sack_rexmit_loss = 0;
+	sack_listen_nosack = 0;
+	ticks_nosack = test_sack_transfer(0, &counters);
+	test_sack_close();
+
+	ticks_sack = test_sack_transfer(1, &counters);
+	test_sack_close();
+
+	printf("tcp_sack: tail loss recovered in %u ms without SACK, in %u ms with SACK\n",
+		   (unsigned)(ticks_nosack * TCP_FAST_INTERVAL), (unsigned)(ticks_sack * TCP_FAST_INTERVAL));
+#if LWIP_TCP_TLP
+	EXPECT(ticks_sack < ticks_nosack);
+#else
+	EXPECT(ticks_sack <= ticks_nosack);
+#endif
+}
+
+END_TEST
+/** Lose the retransmission sent in fast recovery as well: the timeout
+    has to end the recovery and resend everything from the left edge */
+START_TEST(test_tcp_sack_lost_rexmit)
+{
+	struct test_tcp_counters counters;
+	LWIP_UNUSED_ARG(_i);
+
+	sack_tail_loss = 0;
+	sack_rexmit_loss = 1;
+	sack_listen_nosack = 0;
+	test_sack_transfer(1, &counters);
+	EXPECT(sack_rexmit_off == TEST_SACK_DATA_LEN);
+	EXPECT(sack_rtos > 0);
+	EXPECT(!(sack_client->flags & TF_INFR));
+	test_sack_close();
+}
+
+END_TEST
+/** Lose data and its retransmission by the timer: the dupacks which follow
+    acknowledge nothing sent after the timeout, so they must neither start
+    a fast recovery nor inflate cwnd */
+START_TEST(test_tcp_sack_rto_dupacks)
+{
+	struct test_tcp_counters counters;
+	struct pbuf *p;
+	tcpwnd_size_t cwnd;
+	u32_t ticks = 0;
+	u8_t nrtx;
+	int i;
+	LWIP_UNUSED_ARG(_i);
+
+	sack_tail_loss = 0;
+	sack_rexmit_loss = 0;
+	sack_listen_nosack = 0;
+	i = test_sack_connect(1, &counters);
+	EXPECT_RET(i);
+
+	test_sack_send(sack_client);
+	test_sack_flush();
+	nrtx = sack_client->nrtx;
+	while (sack_client->nrtx == nrtx && ticks < TEST_SACK_MAX_TICKS) {
+		test_tcp_tmr();
+		ticks++;
+	}
+	EXPECT(sack_client->nrtx != nrtx);
+	test_sack_flush();
+	EXPECT(TCP_SEQ_LT(sack_client->lastack, sack_client->recover));
+
+	cwnd = sack_client->cwnd;
+	for (i = 0; i < 6; i++) {
+		p = tcp_create_rx_segment_wnd(sack_client, NULL, 0, 0, 0, TCP_ACK, (u16_t)sack_client->snd_wnd);
+		EXPECT_RET(p != NULL);
+		test_tcp_input(p, &sack_netif);
+	}
+	EXPECT(sack_client->dupacks > 3);
+	EXPECT(!(sack_client->flags & TF_INFR));
+	EXPECT(sack_client->cwnd == cwnd);
+	test_sack_close();
+}
+
+END_TEST
+/** SACK disabled on the listening pcb is disabled on the accepted one */
+START_TEST(test_tcp_sack_listen_disable)
+{
+	struct test_tcp_counters counters;
+	LWIP_UNUSED_ARG(_i);
+
+	sack_tail_loss = 0;
+	sack_rexmit_loss = 0;
+	sack_listen_nosack = 1;
+	test_sack_transfer(1, &counters);
+	test_sack_close();
+	sack_listen_nosack = 0;
+}
+
+END_TEST
+/** Create the suite including all tests for this module */
+Suite *tcp_sack_suite(void)
+{
+	TFun tests[] = {
+		test_tcp_sack_lossy_link,
+		test_tcp_sack_tail_loss,
+		test_tcp_sack_lost_rexmit,
+		test_tcp_sack_rto_dupacks,
+		test_tcp_sack_listen_disable
+	};
+	return create_suite("TCP_SACK", tests, sizeof(tests) / sizeof(TFun), tcp_sack_setup, tcp_sack_teardown);
+}
@@ -122,6 +122,35 @@ ssize_t recvfrom(int sockfd, void *mem, size_t len, int flags, struct sockaddr *
 	return res;
 }
 
+#ifdef CONFIG_NET_SOCKET_ZEROCOPY
+ssize_t recv_zc(int sockfd, struct sock_zcbuf *zbuf, int flags, struct sockaddr *from, socklen_t *fromlen)
+{
+	/* Treat as a cancellation point */
+	(void)enter_cancellation_point();
+	int res = -1;
+	if (zbuf) {
+		/* Empty zbuf so that it can be released even if no stack is called */
+		zbuf->iovcnt = 0;
+		zbuf->priv = NULL;
+	}
+	NETSTACK_CALL_BYFD_RET(sockfd, recv_zc, (sockfd, zbuf, flags, from, fromlen), res);
+	if (res > 0) {
+		NETMGR_STATS_ADD(g_app_recv_byte, res);
+		NETMGR_STATS_INC(g_app_recv_cnt);
+	}
+	leave_cancellation_point();
+	return res;
+}
+
+void release_zc(struct sock_zcbuf *zbuf)
+{
+	struct netstack *stk = get_netstack(TR_SOCKET);
+	if (stk && stk->ops->release_zc) {
+		stk->ops->release_zc(zbuf);
+	}
+}
+#endif
+
 /****************************************************************************
  * Function: recvmsg
  *
@@ -166,6 +195,24 @@ ssize_t sendto(int sockfd, const void *data, size_t size, int flags, const struc
 	return res;
 }
 
+#ifdef CONFIG_NET_SOCKET_ZEROCOPY
+ssize_t send_zc(int sockfd, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen, sock_zcdone_t done, void *arg)
+{
+	/* Treat as a cancellation point */
+	(void)enter_cancellation_point();
+	struct netstack *stk = get_netstack_byfd(sockfd);
+	int res = -1;
+	if (stk && stk->ops->send_zc) {
+		res = stk->ops->send_zc(sockfd, data, size, flags, to, tolen, done, arg);
+	} else if (done) {
+		/* done is called even if the socket does not support it */
+		done(arg);
+	}
+	leave_cancellation_point();
+	return res;
+}
+#endif
+
 /****************************************************************************
  * Function: sendmsg
  *
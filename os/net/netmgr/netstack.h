@@ -89,6 +89,11 @@ struct netstack_ops {
 	int (*getstats)(void *arg);
 	void (*initlist)(struct socketlist *list);
 	void (*releaselist)(struct socketlist *list);
+#ifdef CONFIG_NET_SOCKET_ZEROCOPY
+	ssize_t (*recv_zc)(int s, struct sock_zcbuf *zbuf, int flags, struct sockaddr *from, socklen_t *fromlen);
+	void (*release_zc)(struct sock_zcbuf *zbuf);
+	ssize_t (*send_zc)(int s, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen, sock_zcdone_t done, void *arg);
+#endif
 };
 
 struct netstack {
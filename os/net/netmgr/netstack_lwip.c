@@ -606,6 +606,23 @@ static ssize_t lwip_ns_sendto(int s, const void *data, size_t size, int flags, c
 	return lwip_sendto(s, data, size, flags, to, tolen);
 }
 
+#ifdef CONFIG_NET_SOCKET_ZEROCOPY
+static ssize_t lwip_ns_recv_zc(int s, struct sock_zcbuf *zbuf, int flags, struct sockaddr *from, socklen_t *fromlen)
+{
+	return lwip_recvfrom_zc(s, zbuf, flags, from, fromlen);
+}
+
+static void lwip_ns_release_zc(struct sock_zcbuf *zbuf)
+{
+	lwip_release_zc(zbuf);
+}
+
+static ssize_t lwip_ns_send_zc(int s, const void *data, size_t size, int flags, const struct sockaddr *to, socklen_t tolen, sock_zcdone_t done, void *arg)
+{
+	return lwip_sendto_zc(s, data, size, flags, to, tolen, done, arg);
+}
+#endif
+
 static int lwip_ns_getsockname(int s, struct sockaddr *name, socklen_t *namelen)
 {
 	return lwip_getsockname(s, name, namelen);
@@ -801,7 +818,13 @@ struct netstack_ops g_lwip_stack_ops = {
 #endif
 	lwip_ns_getstats,
 	lwip_ns_initlist,
-	lwip_ns_releaselist};
+	lwip_ns_releaselist,
+#ifdef CONFIG_NET_SOCKET_ZEROCOPY
+	lwip_ns_recv_zc,
+	lwip_ns_release_zc,
+	lwip_ns_send_zc,
+#endif
+};
 
 struct netstack g_lwip_stack = {&g_lwip_stack_ops, NULL};
 
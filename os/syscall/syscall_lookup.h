@@ -204,6 +204,11 @@ SYSCALL_LOOKUP(aio_cancel,              2, SYS_aio_cancel)
 #  ifndef CONFIG_DISABLE_POLL
 SYSCALL_LOOKUP(poll,                    3, STUB_poll)
 SYSCALL_LOOKUP(select,                  5, STUB_select)
+#    ifdef CONFIG_EPOLL
+SYSCALL_LOOKUP(epoll_create,            1, STUB_epoll_create)
+SYSCALL_LOOKUP(epoll_ctl,               4, STUB_epoll_ctl)
+SYSCALL_LOOKUP(epoll_wait,              4, STUB_epoll_wait)
+#    endif
 #  endif
 #endif
 
@@ -225,7 +230,10 @@ SYSCALL_LOOKUP(lseek,                   3, STUB_lseek)
 #if defined(CONFIG_PIPES)
 SYSCALL_LOOKUP(mkfifo,                  2, STUB_mkfifo)
 #endif
-SYSCALL_LOOKUP(mmap,                    6, NULL)
+SYSCALL_LOOKUP(mmap,                    6, STUB_mmap)
+#if defined(CONFIG_FS_RAMMAP)
+SYSCALL_LOOKUP(munmap,                  2, STUB_munmap)
+#endif
 SYSCALL_LOOKUP(open,                    6, STUB_open)
 SYSCALL_LOOKUP(opendir,                 1, STUB_opendir)
 #if defined(CONFIG_PIPES)
@@ -311,6 +319,10 @@ SYSCALL_LOOKUP(mq_setattr,              3, STUB_mq_setattr)
 SYSCALL_LOOKUP(mq_timedreceive,         5, STUB_mq_timedreceive)
 SYSCALL_LOOKUP(mq_timedsend,            5, STUB_mq_timedsend)
 SYSCALL_LOOKUP(mq_unlink,               1, STUB_mq_unlink)
+#ifdef CONFIG_MQ_ZEROCOPY
+SYSCALL_LOOKUP(mq_send_buf,             4, STUB_mq_send_buf)
+SYSCALL_LOOKUP(mq_receive_buf,          3, STUB_mq_receive_buf)
+#endif
 #endif
 
 /* The following are defined only if environment variables are supported */
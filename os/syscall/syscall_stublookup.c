@@ -197,6 +197,11 @@ uintptr_t STUB_poll(int nbr, uintptr_t parm1, uintptr_t parm2,
 					uintptr_t parm3);
 uintptr_t STUB_select(int nbr, uintptr_t parm1, uintptr_t parm2,
 					  uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
+uintptr_t STUB_epoll_create(int nbr, uintptr_t parm1);
+uintptr_t STUB_epoll_ctl(int nbr, uintptr_t parm1, uintptr_t parm2,
+					  uintptr_t parm3, uintptr_t parm4);
+uintptr_t STUB_epoll_wait(int nbr, uintptr_t parm1, uintptr_t parm2,
+					  uintptr_t parm3, uintptr_t parm4);
 
 uintptr_t STUB_aio_read(int nbr, uintptr_t parm1);
 uintptr_t STUB_aio_write(int nbr, uintptr_t parm1);
@@ -223,6 +228,7 @@ uintptr_t STUB_mkfifo(int nbr, uintptr_t parm1, uintptr_t parm2);
 uintptr_t STUB_mmap(int nbr, uintptr_t parm1, uintptr_t parm2,
 					uintptr_t parm3, uintptr_t parm4, uintptr_t parm5,
 					uintptr_t parm6);
+uintptr_t STUB_munmap(int nbr, uintptr_t parm1, uintptr_t parm2);
 uintptr_t STUB_open(int nbr, uintptr_t parm1, uintptr_t parm2,
 					uintptr_t parm3, uintptr_t parm4, uintptr_t parm5,
 					uintptr_t parm6);
@@ -317,6 +323,10 @@ uintptr_t STUB_mq_timedreceive(int nbr, uintptr_t parm1, uintptr_t parm2,
 uintptr_t STUB_mq_timedsend(int nbr, uintptr_t parm1, uintptr_t parm2,
 							uintptr_t parm3, uintptr_t parm4, uintptr_t parm5);
 uintptr_t STUB_mq_unlink(int nbr, uintptr_t parm1);
+uintptr_t STUB_mq_send_buf(int nbr, uintptr_t parm1, uintptr_t parm2,
+						   uintptr_t parm3, uintptr_t parm4);
+uintptr_t STUB_mq_receive_buf(int nbr, uintptr_t parm1, uintptr_t parm2,
+							  uintptr_t parm3);
 
 /* The following are defined only if environment variables are supported */
 
@@ -0,0 +1,211 @@
+#!/usr/bin/env python
+###########################################################################
+#
+# Copyright 2022 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+#
+# Decode the logm buffer of a CONFIG_LOGM_BINARY image on the host.
+#
+# Binary records only hold the address of their format string and the raw
+# arguments, the format strings are read from the ELF file of the image.
+#
+# Example:
+#   TASH>> logm -d /mnt/logm.bin
+#   $ logm_decode.py -e ../build/output/bin/tinyara logm.bin
+#
+# A raw copy of g_logm_rsvbuf (e.g. from a RAM dump) can be decoded with
+# --raw, giving g_logm_head and g_logm_tail with --head and --tail.
+
+from __future__ import print_function
+from optparse import OptionParser
+import re
+import struct
+import sys
+
+LOGM_REC_PENDING = 0
+LOGM_REC_BINARY = 1
+LOGM_REC_TEXT = 2
+LOGM_REC_WRAP = 3
+
+LOGM_REC_HDRSIZE = 12
+LOGM_DUMP_HDRSIZE = 24
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 2
+
+# Same parsing as logm_parsespec() in os/logm/logm_binary.c
+SPEC_RE = re.compile(r'%([-+ #0]*)(\*|[0-9]*)(?:\.(\*|[0-9]*))?([hlqjLzt]*)(.?)', re.S)
+
+
+class Elf(object):
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        if self.data[:4] != b'\x7fELF' or self.data[4:5] != b'\x01':
+            raise ValueError('%s is not a 32-bit ELF file' % path)
+        shoff, = struct.unpack_from('<I', self.data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', self.data, 0x2e)
+        self.sections = []
+        for i in range(shnum):
+            (name, stype, flags, addr, offset, size) = struct.unpack_from('<IIIIII', self.data, shoff + i * shentsize)
+            if stype == SHT_PROGBITS and (flags & SHF_ALLOC) and size > 0:
+                self.sections.append((addr, size, offset))
+
+    def string(self, addr):
+        for (start, size, offset) in self.sections:
+            if start <= addr < start + size:
+                pos = offset + addr - start
+                end = self.data.index(b'\0', pos)
+                return self.data[pos:end].decode('latin-1')
+        return None
+
+
+class Args(object):
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def take(self, fmt):
+        size = struct.calcsize(fmt)
+        if self.pos + size > len(self.data):
+            raise IndexError
+        value, = struct.unpack_from(fmt, self.data, self.pos)
+        self.pos += size
+        return value
+
+    def string(self):
+        end = self.data.index(b'\0', self.pos)
+        value = self.data[self.pos:end].decode('latin-1')
+        self.pos = end + 1
+        return value
+
+
+def decode(fmt, args):
+    out = []
+    pos = 0
+    while True:
+        m = SPEC_RE.search(fmt, pos)
+        if m is None:
+            out.append(fmt[pos:])
+            return ''.join(out)
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, length, conv = m.groups()
+        if conv == '%':
+            out.append('%')
+            continue
+        if conv == '' or conv not in 'diuoxXcfFeEgGpsn':
+            out.append(m.group(0))
+            continue
+        try:
+            stars = []
+            if width == '*':
+                stars.append(args.take('<i'))
+            if prec == '*':
+                stars.append(args.take('<i'))
+            if conv == 'n':
+                continue
+            if conv in 'diuoxXc':
+                signed = conv in 'di'
+                if length in ('ll', 'q', 'j', 'L'):
+                    value = args.take('<q' if signed else '<Q')
+                else:
+                    value = args.take('<i' if signed else '<I')
+            elif conv in 'fFeEgG':
+                value = args.take('<d')
+            elif conv == 'p':
+                value = args.take('<I')
+            else:
+                value = args.string()
+        except (IndexError, ValueError):
+            out.append('...\n')
+            return ''.join(out)
+
+        spec = '%' + flags + width + ('.' + prec if prec is not None else '')
+        if conv == 'p':
+            out.append('0x%x' % value)
+        elif conv == 'c':
+            out.append((spec + 'c') % tuple(stars + [chr(value & 0xff)]))
+        else:
+            pyconv = {'i': 'd', 'u': 'd'}.get(conv, conv)
+            out.append((spec + pyconv) % tuple(stars + [value]))
+
+
+def records(image, head, tail):
+    size = len(image) & ~3
+    while head != tail:
+        (length, rtype, prio, ts, fmt) = struct.unpack_from('<HBBII', image, head)
+        if rtype == LOGM_REC_PENDING:
+            return
+        if rtype == LOGM_REC_WRAP:
+            head = 0
+            continue
+        payload = image[head + LOGM_REC_HDRSIZE:head + length]
+        yield (rtype, prio, ts, fmt, payload)
+        head += (length + 3) & ~3
+        if head >= size:
+            head = 0
+
+
+def main():
+    parser = OptionParser(usage='%prog [options] DUMP')
+    parser.add_option('-e', '--elf', dest='elf', help='ELF file of the image (tinyara)')
+    parser.add_option('-t', '--timestamp', action='store_true', dest='timestamp', default=False,
+                      help='Prepend the timestamp to each message')
+    parser.add_option('--raw', action='store_true', dest='raw', default=False,
+                      help='DUMP is a raw copy of the logm buffer')
+    parser.add_option('--head', type='int', dest='head', default=0, help='g_logm_head of a raw dump')
+    parser.add_option('--tail', type='int', dest='tail', default=0, help='g_logm_tail of a raw dump')
+    parser.add_option('--freq', type='int', dest='freq', default=0, help='Timestamp frequency in Hz of a raw dump')
+    (options, args) = parser.parse_args()
+    if len(args) != 1 or not options.elf:
+        parser.print_help()
+        return 1
+
+    elf = Elf(options.elf)
+    with open(args[0], 'rb') as f:
+        data = f.read()
+
+    if options.raw:
+        image = data
+        head, tail, freq = options.head, options.tail, options.freq
+    else:
+        (magic, version, freq, bufsize, head, tail) = struct.unpack_from('<4sIIIII', data, 0)
+        if magic != b'LOGM' or version != 1:
+            print('%s is not a logm dump' % args[0], file=sys.stderr)
+            return 1
+        image = data[LOGM_DUMP_HDRSIZE:LOGM_DUMP_HDRSIZE + bufsize]
+
+    elapsed = None
+    last = 0
+    for (rtype, prio, ts, fmt, payload) in records(image, head, tail):
+        if options.timestamp and freq:
+            elapsed = ts if elapsed is None else elapsed + ((ts - last) & 0xffffffff)
+            last = ts
+            sys.stdout.write('[%4d.%06d] ' % (elapsed // freq, (elapsed % freq) * 1000000 // freq))
+        if rtype == LOGM_REC_TEXT:
+            sys.stdout.write(payload.split(b'\0', 1)[0].decode('latin-1'))
+            continue
+        string = elf.string(fmt)
+        if string is None:
+            sys.stdout.write('<unknown format 0x%08x>\n' % fmt)
+            continue
+        sys.stdout.write(decode(string, Args(payload)))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -250,9 +250,12 @@ static void generate_proxy(int nparms)
 	if (cond_parm[0] != '\0')
 		fprintf(stream, "#if %s\n\n", cond_parm);
 
-	/* Generate the function definition that matches standard function prototype */
+	/* Generate the function definition that matches standard function prototype.
+	 * The name is in parentheses so that a header may redirect calls of the
+	 * function with a function-like macro (see CONFIG_SEM_FASTPATH).
+	 */
 
-	fprintf(stream, "%s %s(", get_parm(RETTYPE_INDEX), get_parm(NAME_INDEX));
+	fprintf(stream, "%s (%s)(", get_parm(RETTYPE_INDEX), get_parm(NAME_INDEX));
 
 	/* Generate the formal parameter list */
 
@@ -430,13 +433,14 @@ static void generate_stub(int nparms)
 	fprintf(stream, ")\n{\n");
 
 	/* Then call the proxied function.  Functions that have no return value are
-	 * a special case.
+	 * a special case.  As in the proxies, the name is in parentheses so that
+	 * the real function is called even if a header redirects it.
 	 */
 
 	if (strcmp(get_parm(RETTYPE_INDEX), "void") == 0)
-		fprintf(stream, "  %s(", get_parm(NAME_INDEX));
+		fprintf(stream, "  (%s)(", get_parm(NAME_INDEX));
 	else
-		fprintf(stream, "  return (uintptr_t)%s(", get_parm(NAME_INDEX));
+		fprintf(stream, "  return (uintptr_t)(%s)(", get_parm(NAME_INDEX));
 
 	/* The pass all of the system call parameters, casting to the correct type
 	 * as necessary.
@@ -0,0 +1,197 @@
+#!/usr/bin/env python
+###########################################################################
+#
+# Copyright 2022 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+###########################################################################
+#
+# Convert a CONFIG_TTRACE_EVENTS capture into the Chrome trace event JSON
+# format, which both chrome://tracing and https://ui.perfetto.dev open.
+#
+# Every task gets a track with the intervals it was running, semaphore and
+# message queue events are marked on the track of the task and semaphore
+# wake-ups are drawn as arrows from the waking to the woken task.
+# Interrupts are shown on a track of their own.
+#
+# Example:
+#   TASH>> cat /dev/ttrace_ev > /mnt/trace.bin
+#   $ ttrace_to_json.py trace.bin -o trace.json
+
+from __future__ import print_function
+from optparse import OptionParser
+import json
+import struct
+import sys
+
+TTRACE_EV_SWITCH = 1
+TTRACE_EV_IRQ_ENTER = 2
+TTRACE_EV_IRQ_LEAVE = 3
+TTRACE_EV_SEM_BLOCK = 4
+TTRACE_EV_SEM_WAKE = 5
+TTRACE_EV_MQ_SEND = 6
+TTRACE_EV_MQ_RECV = 7
+
+HDR_FMT = '<4sIIIII'
+TASK_FMT = '<hBB12s'
+EVENT_FMT = '<IBBhI'
+
+# TCB_FLAG_TTYPE_* in include/tinyara/sched.h
+TTYPE_NAMES = {0: 'task', 1: 'pthread', 2: 'kthread'}
+
+PROCESS_PID = 1
+IRQ_TID = 0x10000
+
+
+def parse(data):
+    (magic, version, freq, nevents, ntasks, lost) = struct.unpack_from(HDR_FMT, data, 0)
+    if magic != b'TTEV' or version != 1:
+        raise ValueError('not a ttrace event capture')
+    pos = struct.calcsize(HDR_FMT)
+
+    tasks = {}
+    for i in range(ntasks):
+        (pid, prio, flags, name) = struct.unpack_from(TASK_FMT, data, pos)
+        name = name.split(b'\0', 1)[0].decode('latin-1')
+        tasks[pid] = (name, prio, TTYPE_NAMES.get(flags, 'task'))
+        pos += struct.calcsize(TASK_FMT)
+
+    events = []
+    size = struct.calcsize(EVENT_FMT)
+    for i in range(nevents):
+        if pos + size > len(data):
+            print('warning: capture truncated after %d events' % i, file=sys.stderr)
+            break
+        events.append(struct.unpack_from(EVENT_FMT, data, pos))
+        pos += size
+
+    return (freq, tasks, events, lost)
+
+
+def convert(freq, tasks, events, with_irq):
+    out = []
+    seen = set()
+
+    def thread(pid):
+        if pid not in seen:
+            seen.add(pid)
+            if pid in tasks:
+                (name, prio, ttype) = tasks[pid]
+                label = '%s (%d, %s)' % (name or 'pid %d' % pid, pid, ttype)
+            else:
+                label = 'pid %d (exited)' % pid
+            out.append({'ph': 'M', 'name': 'thread_name', 'pid': PROCESS_PID, 'tid': pid,
+                        'args': {'name': label}})
+            out.append({'ph': 'M', 'name': 'thread_sort_index', 'pid': PROCESS_PID, 'tid': pid,
+                        'args': {'sort_index': pid}})
+        return pid
+
+    out.append({'ph': 'M', 'name': 'process_name', 'pid': PROCESS_PID, 'args': {'name': 'TizenRT'}})
+
+    # Unwrap the 32-bit timestamps into microseconds from the first event
+    elapsed = 0
+    last = events[0][0] if events else 0
+    times = []
+    for ev in events:
+        elapsed += (ev[0] - last) & 0xffffffff
+        last = ev[0]
+        times.append(elapsed * 1000000.0 / freq)
+
+    running = None
+    since = 0.0
+    irqs = []
+    flow = 0
+    wakeups = {}
+
+    for (ev, ts) in zip(events, times):
+        (timestamp, etype, arg8, pid, arg) = ev
+
+        if etype == TTRACE_EV_SWITCH:
+            if running is not None and ts > since:
+                out.append({'ph': 'X', 'name': 'running', 'pid': PROCESS_PID, 'tid': thread(running),
+                            'ts': since, 'dur': ts - since})
+            running = pid
+            since = ts
+            thread(pid)
+            if pid in wakeups:
+                out.append({'ph': 'f', 'bp': 'e', 'name': 'wakeup', 'cat': 'sem', 'id': wakeups.pop(pid),
+                            'pid': PROCESS_PID, 'tid': pid, 'ts': ts})
+        elif etype == TTRACE_EV_IRQ_ENTER:
+            irqs.append((arg, ts))
+        elif etype == TTRACE_EV_IRQ_LEAVE:
+            if irqs and irqs[-1][0] == arg:
+                (irq, start) = irqs.pop()
+                if with_irq:
+                    if IRQ_TID not in seen:
+                        seen.add(IRQ_TID)
+                        out.append({'ph': 'M', 'name': 'thread_name', 'pid': PROCESS_PID, 'tid': IRQ_TID,
+                                    'args': {'name': 'IRQ'}})
+                    out.append({'ph': 'X', 'name': 'irq %d' % irq, 'pid': PROCESS_PID, 'tid': IRQ_TID,
+                                'ts': start, 'dur': ts - start})
+        elif etype in (TTRACE_EV_SEM_BLOCK, TTRACE_EV_SEM_WAKE):
+            name = 'sem wait' if etype == TTRACE_EV_SEM_BLOCK else 'sem wake'
+            out.append({'ph': 'i', 's': 't', 'name': name, 'cat': 'sem', 'pid': PROCESS_PID,
+                        'tid': thread(pid), 'ts': ts, 'args': {'sem': '0x%08x' % arg}})
+            if etype == TTRACE_EV_SEM_WAKE and running is not None and pid not in wakeups:
+                # Arrow from the task (or IRQ) which posted to the woken task
+                flow += 1
+                wakeups[pid] = flow
+                src = IRQ_TID if irqs and with_irq else running
+                out.append({'ph': 's', 'name': 'wakeup', 'cat': 'sem', 'id': flow,
+                            'pid': PROCESS_PID, 'tid': src, 'ts': ts})
+        elif etype in (TTRACE_EV_MQ_SEND, TTRACE_EV_MQ_RECV):
+            name = 'mq send' if etype == TTRACE_EV_MQ_SEND else 'mq receive'
+            out.append({'ph': 'i', 's': 't', 'name': name, 'cat': 'mq', 'pid': PROCESS_PID,
+                        'tid': thread(pid), 'ts': ts, 'args': {'mq': '0x%08x' % arg, 'prio': arg8}})
+
+    if running is not None and times and times[-1] > since:
+        out.append({'ph': 'X', 'name': 'running', 'pid': PROCESS_PID, 'tid': thread(running),
+                    'ts': since, 'dur': times[-1] - since})
+
+    return out
+
+
+def main():
+    parser = OptionParser(usage='%prog [options] CAPTURE')
+    parser.add_option('-o', '--output', dest='output', help='Output file (default: stdout)')
+    parser.add_option('--no-irq', action='store_false', dest='irq', default=True,
+                      help='Leave out the IRQ track')
+    (options, args) = parser.parse_args()
+    if len(args) != 1:
+        parser.print_help()
+        return 1
+
+    with open(args[0], 'rb') as f:
+        data = f.read()
+
+    try:
+        (freq, tasks, events, lost) = parse(data)
+    except (ValueError, struct.error) as e:
+        print('%s: %s' % (args[0], e), file=sys.stderr)
+        return 1
+
+    if lost:
+        print('note: %d older events were overwritten' % lost, file=sys.stderr)
+
+    trace = {'traceEvents': convert(freq, tasks, events, options.irq), 'displayTimeUnit': 'ns'}
+    if options.output:
+        with open(options.output, 'w') as f:
+            json.dump(trace, f)
+    else:
+        json.dump(trace, sys.stdout)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
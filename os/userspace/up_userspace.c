@@ -61,6 +61,10 @@ const struct userspace_s userspace __attribute__((section(".userspace"))) = {
 #ifndef CONFIG_DISABLE_SIGNALS
 	.signal_handler = up_signal_handler,
 #endif
+	/* Pid of the running task */
+#ifdef CONFIG_SEM_FASTPATH
+	.curpid = &g_sem_curpid,
+#endif
 
 };
 
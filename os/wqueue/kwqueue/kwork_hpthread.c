@@ -179,6 +179,7 @@ int work_hpstart(void)
 	/* Initialize work queue data structures */
 
 	dq_init(&g_hpwork.q);
+	g_hpwork.delayed = NULL;
 
 	/* Start the high-priority, kernel mode worker thread */
 
@@ -186,6 +186,7 @@ int work_usrstart(void)
 
 	struct wqueue_s *usrwq = get_usrwork();
 	dq_init(&usrwq->q);
+	usrwq->delayed = NULL;
 
 #ifdef CONFIG_BUILD_PROTECTED
 	{
@@ -0,0 +1,184 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <tinyara/config.h>
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <queue.h>
+#include <assert.h>
+
+#include <tinyara/clock.h>
+#include <tinyara/wqueue.h>
+
+#include "wqueue.h"
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+/* The delayed work is kept in a pairing heap.  Each node links to its first
+ * child through child and to its next sibling through dq.flink, while
+ * dq.blink points back to the previous sibling, or to the parent for a
+ * first child, so that any node can be unlinked in constant time.
+ */
+
+#define WORK_NEXT(w)       ((FAR struct work_s *)(w)->dq.flink)
+#define WORK_PREV(w)       ((FAR struct work_s *)(w)->dq.blink)
+
+/* True if work a is due before work b.  The due times may have wrapped
+ * around, so they are compared through their signed difference.
+ */
+
+#ifdef CONFIG_SYSTEM_TIME64
+#define WORK_BEFORE(a, b)  ((int64_t)(((a)->qtime + (a)->delay) - ((b)->qtime + (b)->delay)) < 0)
+#else
+#define WORK_BEFORE(a, b)  ((int32_t)(((a)->qtime + (a)->delay) - ((b)->qtime + (b)->delay)) < 0)
+#endif
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_heap_meld
+ *
+ * Description:
+ *   Meld two heaps, either of which may be empty but not both, and return
+ *   the root of the result with its sibling links cleared.
+ *
+ ****************************************************************************/
+
+static FAR struct work_s *work_heap_meld(FAR struct work_s *a, FAR struct work_s *b)
+{
+	FAR struct work_s *tmp;
+
+	if (a == NULL || (b != NULL && WORK_BEFORE(b, a))) {
+		tmp = a;
+		a = b;
+		b = tmp;
+	}
+
+	a->dq.flink = NULL;
+	a->dq.blink = NULL;
+
+	if (b != NULL) {
+		/* b becomes the first child of a */
+
+		b->dq.blink = (FAR dq_entry_t *)a;
+		b->dq.flink = (FAR dq_entry_t *)a->child;
+		if (a->child != NULL) {
+			a->child->dq.blink = (FAR dq_entry_t *)b;
+		}
+		a->child = b;
+	}
+
+	return a;
+}
+
+/****************************************************************************
+ * Name: work_heap_pairs
+ *
+ * Description:
+ *   Merge a list of sibling heaps into one, melding them in pairs from left
+ *   to right and then the pairs from right to left.
+ *
+ ****************************************************************************/
+
+static FAR struct work_s *work_heap_pairs(FAR struct work_s *first)
+{
+	FAR struct work_s *pairs = NULL;
+	FAR struct work_s *next;
+	FAR struct work_s *b;
+
+	while (first != NULL) {
+		b = WORK_NEXT(first);
+		next = b ? WORK_NEXT(b) : NULL;
+
+		first = work_heap_meld(first, b);
+		first->dq.flink = (FAR dq_entry_t *)pairs;
+		pairs = first;
+		first = next;
+	}
+
+	while (pairs != NULL) {
+		next = WORK_NEXT(pairs);
+		first = work_heap_meld(first, pairs);
+		pairs = next;
+	}
+
+	return first;
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+/****************************************************************************
+ * Name: work_heap_insert
+ ****************************************************************************/
+
+void work_heap_insert(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
+{
+	work->child = NULL;
+	wqueue->delayed = work_heap_meld(wqueue->delayed, work);
+}
+
+/****************************************************************************
+ * Name: work_heap_remove
+ ****************************************************************************/
+
+void work_heap_remove(FAR struct wqueue_s *wqueue, FAR struct work_s *work)
+{
+	FAR struct work_s *prev;
+	FAR struct work_s *sub;
+
+	sub = work_heap_pairs(work->child);
+	work->child = NULL;
+
+	if (work == wqueue->delayed) {
+		wqueue->delayed = sub;
+		return;
+	}
+
+	/* Unlink the work from its parent or previous sibling */
+
+	prev = WORK_PREV(work);
+	DEBUGASSERT(prev != NULL);
+
+	if (prev->child == work) {
+		prev->child = WORK_NEXT(work);
+	} else {
+		prev->dq.flink = work->dq.flink;
+	}
+
+	if (work->dq.flink != NULL) {
+		work->dq.flink->blink = (FAR dq_entry_t *)prev;
+	}
+
+	work->dq.flink = NULL;
+	work->dq.blink = NULL;
+
+	if (sub != NULL) {
+		wqueue->delayed = work_heap_meld(wqueue->delayed, sub);
+	}
+}
@@ -61,6 +61,7 @@
 #include <assert.h>
 #include <queue.h>
 
+#include <tinyara/arch.h>
 #include <tinyara/clock.h>
 #include <tinyara/wqueue.h>
 
@@ -72,6 +73,22 @@
  * Pre-processor Definitions
  ****************************************************************************/
 
+/* Statistics are kept for the queues which run in the kernel */
+
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && (defined(CONFIG_BUILD_FLAT) || defined(__KERNEL__))
+#define WORK_STATS 1
+#endif
+
+#ifdef WORK_STATS
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+#define work_timestamp()   up_perf_gettime()
+#define work_usec(t)       ((uint32_t)((uint64_t)(t) * 1000000 / up_perf_getfreq()))
+#else
+#define work_timestamp()   ((uint32_t)clock())
+#define work_usec(t)       ((t) * (uint32_t)USEC_PER_TICK)
+#endif
+#endif
+
 /****************************************************************************
  * Private Type Declarations
  ****************************************************************************/
@@ -93,6 +110,61 @@ static worker_t cur_worker;
  * Private Functions
  ****************************************************************************/
 
+#ifdef WORK_STATS
+/****************************************************************************
+ * Name: work_latency
+ *
+ * Description:
+ *   Return the time in microseconds between the time work was due and now.
+ *   The cycle counter wraps around within seconds, so it only measures
+ *   work queued less than a second ago.
+ *
+ ****************************************************************************/
+
+static uint32_t work_latency(FAR struct work_s *work, clock_t ctick)
+{
+	clock_t elapsed = ctick - work->qtime;
+#ifdef CONFIG_ARCH_HAVE_PERF_EVENTS
+	uint32_t delay = (uint32_t)work->delay * USEC_PER_TICK;
+	uint32_t usec;
+
+	if (elapsed < TICK_PER_SEC) {
+		usec = work_usec(up_perf_gettime() - work->qstamp);
+		return usec > delay ? usec - delay : 0;
+	}
+#endif
+
+	return (uint32_t)(elapsed - work->delay) * USEC_PER_TICK;
+}
+
+/****************************************************************************
+ * Name: work_account
+ *
+ * Description:
+ *   Add the latency and the run time of one work to the statistics of its
+ *   queue.
+ *
+ ****************************************************************************/
+
+static void work_account(FAR struct work_stats_s *stats, worker_t worker, uint32_t latency, uint32_t elapsed)
+{
+	uint32_t runtime = work_usec(elapsed);
+
+	stats->nrun++;
+
+	stats->latency_total += latency;
+	if (latency > stats->latency_max) {
+		stats->latency_max = latency;
+	}
+
+	stats->runtime_total += runtime;
+	if (runtime > stats->runtime_max) {
+		stats->runtime_max = runtime;
+		stats->runtime_maxworker = worker;
+	}
+}
+#endif
+
 /****************************************************************************
  * Public Functions
  ****************************************************************************/
@@ -123,12 +195,16 @@ worker_t work_get_current(void)
  ****************************************************************************/
 void work_process(FAR struct wqueue_s *wqueue, int wndx)
 {
-	volatile FAR struct work_s *work;
+	FAR struct work_s *work;
 	worker_t worker;
 	FAR void *arg;
 	clock_t elapsed;
 	clock_t ctick;
 	clock_t next;
+#ifdef WORK_STATS
+	uint32_t latency;
+	uint32_t start;
+#endif
 
 	/* Then process queued work.  We need to keep interrupts disabled while
 	 * we process items in the work list.
@@ -143,93 +219,95 @@ void work_process(FAR struct wqueue_s *wqueue, int wndx)
 	flags = irqsave();
 #endif
 
-
-	/* And check each entry in the work queue.  Since we have disabled
-	 * interrupts we know:  (1) we will not be suspended unless we do
-	 * so ourselves, and (2) there will be no changes to the work queue
+	/* Since we have disabled interrupts we know:  (1) we will not be
+	 * suspended unless we do so ourselves, and (2) there will be no changes
+	 * to the work queue.  Delayed work which is due runs first, then the
+	 * immediate work in order of arrival.
 	 */
 
-	work = (FAR struct work_s *)wqueue->q.head;
-	
-	while (work) {
-		
-		/* Is this work ready?  It is ready if there is no delay or if
-		 * the delay has elapsed. qtime is the time that the work was added
-		 * to the work queue.  It will always be greater than or equal to
-		 * zero.  Therefore a delay of zero will always execute immediately.
+	for (;;) {
+		ctick = clock();
+		work = wqueue->delayed;
+
+		/* Is the earliest delayed work ready?  It is ready if the delay has
+		 * elapsed.  qtime is the time that the work was added to the work
+		 * queue.
 		 */
 
-		ctick = clock();
-		elapsed = ctick - work->qtime;
+		if (work != NULL) {
+			elapsed = ctick - work->qtime;
+			if (elapsed >= work->delay) {
+				work_heap_remove(wqueue, work);
+			} else {
+				next = work->delay - elapsed;
+				work = NULL;
+			}
+		}
 
-		if (elapsed >= work->delay) {
-			/* Remove the ready-to-execute work from the list */
+		if (work == NULL) {
+			work = (FAR struct work_s *)dq_remfirst(&wqueue->q);
+			if (work == NULL) {
+				break;
+			}
+		}
 
-			(void)dq_rem((struct dq_entry_s *)work, &wqueue->q);
+		/* Extract the work description from the entry (in case the work
+		 * instance by the re-used after it has been de-queued).
+		 */
 
-			/* Extract the work description from the entry (in case the work
-			 * instance by the re-used after it has been de-queued).
-			 */
+		worker = work->worker;
+		DEBUGASSERT(worker != NULL);
 
-			worker = work->worker;
+		/* Extract the work argument (before re-enabling interrupts) */
 
-			/* Check for a race condition where the work may be nullified
-			 * before it is removed from the queue.
-			 */
+		arg = work->arg;
 
-			if (worker != NULL) {
-				/* Extract the work argument (before re-enabling interrupts) */
+#ifdef WORK_STATS
+		latency = work_latency(work, ctick);
+#endif
 
-				arg = work->arg;
+		/* Mark the work as no longer being queued */
 
-				/* Mark the work as no longer being queued */
+		work->worker = NULL;
 
-				work->worker = NULL;
+		/* Do the work.  Re-enable interrupts while the work is being
+		 * performed... we don't have any idea how long this will take!
+		 */
 
-				/* Do the work.  Re-enable interrupts while the work is being
-				 * performed... we don't have any idea how long this will take!
-				 */
-				
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				work_unlock();
+		work_unlock();
 #else
-				irqrestore(flags);
+		irqrestore(flags);
 #endif
 #if defined(CONFIG_DEBUG_WORKQUEUE)
 #if defined(CONFIG_BUILD_FLAT) || (defined(CONFIG_BUILD_PROTECTED) && defined(__KERNEL__))
-				cur_worker = worker;
+		cur_worker = worker;
 #endif
 #endif
-				worker(arg);
+#ifdef WORK_STATS
+		start = work_timestamp();
+		worker(arg);
+		start = work_timestamp() - start;
+#else
+		worker(arg);
+#endif
 
-				/* Now, unfortunately, since we re-enabled interrupts we don't
-				 * know the state of the work list and we will have to start
-				 * back at the head of the list.
-				 */
+		/* Now, unfortunately, since we re-enabled interrupts we don't
+		 * know the state of the work queue and we will have to start
+		 * over.
+		 */
 
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-				while (work_lock() < 0);
+		while (work_lock() < 0);
 #else
-				flags = irqsave();
+		flags = irqsave();
+#endif
+#ifdef WORK_STATS
+		work_account(&wqueue->stats, worker, latency, start);
 #endif
-				work = (FAR struct work_s *)wqueue->q.head;
-			} else {
-				/* Cancelled.. Just move to the next work in the list with
-				 * interrupts still disabled.
-				 */
-
-				work = (FAR struct work_s *)work->dq.flink;
-			}
-		} else {				/* elapsed < work->delay */
-
-			next = work->delay - elapsed;
-
-			/* Then break at while loop due to sorted list */
-			break;
-		}
 	}
 
-	if (wqueue->q.head == NULL) {
+	if (wqueue->delayed == NULL) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 		work_unlock();
 #endif
@@ -120,9 +120,6 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 {
 	DEBUGASSERT(work != NULL);
 
-	struct work_s *next_work = NULL;
-	struct work_s *cur_work;
-	clock_t elapsed;
 	clock_t ctick;
 	ctick = clock();
 
@@ -134,36 +131,32 @@ int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t w
 #endif
 
 	/* check whether requested work is in queue list or not */
-	cur_work = (struct work_s *)wqueue->q.head;
-	while (cur_work != NULL) {
-		if (cur_work == work) {
+	if (work->worker != NULL && work->wqueue == wqueue) {
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
-			work_unlock();
+		work_unlock();
 #else
-			irqrestore(flags);
+		irqrestore(flags);
 #endif
-			return -EALREADY;
-		}
-
-		if (next_work == NULL) {
-			elapsed = ctick - cur_work->qtime;
-			if (cur_work->delay > elapsed && cur_work->delay - elapsed > delay) {
-				next_work = cur_work;
-			}
-		}
-
-		cur_work = (struct work_s *)cur_work->dq.flink;
+		return -EALREADY;
 	}
 
 	work->worker = worker;		/* Work callback */
 	work->arg = arg;		/* Callback argument */
 	work->delay = delay;		/* Delay until work performed */
 	work->qtime = ctick;		/* Time work queued */
+	work->wqueue = wqueue;		/* Queue work is pending on */
+#if defined(CONFIG_SCHED_WORKQUEUE_STATS) && defined(CONFIG_ARCH_HAVE_PERF_EVENTS)
+	work->qstamp = up_perf_gettime();
+#endif
 
-	if (next_work) {
-		dq_addbefore((FAR dq_entry_t *)next_work, (FAR dq_entry_t *)work, &wqueue->q);
-	} else {
+	/* Immediate work is run in order of arrival, delayed work in order of
+	 * the time it is due.
+	 */
+
+	if (delay == 0) {
 		dq_addlast((FAR dq_entry_t *)work, &wqueue->q);
+	} else {
+		work_heap_insert(wqueue, work);
 	}
 #if defined(CONFIG_SCHED_USRWORK) && !defined(__KERNEL__)
 	work_unlock();
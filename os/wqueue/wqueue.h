@@ -82,7 +82,11 @@ struct worker_s {
 /* This structure defines the state of work queue */
 
 struct wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of immediate work */
+	FAR struct work_s *delayed;	/* The heap of delayed work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency statistics */
+#endif
 	struct worker_s worker[1];	/* Describes a worker thread */
 };
 
@@ -92,7 +96,11 @@ struct wqueue_s {
 
 #ifdef CONFIG_SCHED_HPWORK
 struct hp_wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of immediate work */
+	FAR struct work_s *delayed;	/* The heap of delayed work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency statistics */
+#endif
 	struct worker_s worker[1];	/* Describes the single high priority worker */
 };
 #endif
@@ -103,7 +111,11 @@ struct hp_wqueue_s {
 
 #ifdef CONFIG_SCHED_LPWORK
 struct lp_wqueue_s {
-	struct dq_queue_s q;		/* The queue of pending work */
+	struct dq_queue_s q;		/* The queue of immediate work */
+	FAR struct work_s *delayed;	/* The heap of delayed work */
+#ifdef CONFIG_SCHED_WORKQUEUE_STATS
+	struct work_stats_s stats;	/* Latency statistics */
+#endif
 
 	/* Describes each thread in the low priority queue's thread pool */
 	struct worker_s worker[CONFIG_SCHED_LPNTHREADS];
@@ -228,6 +240,35 @@ int work_qcancel(FAR struct wqueue_s *wqueue, FAR struct work_s *work);
 
 int work_qqueue(FAR struct wqueue_s *wqueue, FAR struct work_s *work, worker_t worker, FAR void *arg, clock_t delay);
 
+/****************************************************************************
+ * Name: work_heap_insert
+ *
+ * Description:
+ *   Add delayed work to the heap of a work queue.  The heap is ordered by
+ *   the time the work is due, qtime + delay, so that the next work to run
+ *   is always at its root.
+ *
+ * Assumptions:
+ *   The work queue is locked.
+ *
+ ****************************************************************************/
+
+void work_heap_insert(FAR struct wqueue_s *wqueue, FAR struct work_s *work);
+
+/****************************************************************************
+ * Name: work_heap_remove
+ *
+ * Description:
+ *   Remove delayed work, which need not be the root, from the heap of a
+ *   work queue.
+ *
+ * Assumptions:
+ *   The work queue is locked.
+ *
+ ****************************************************************************/
+
+void work_heap_remove(FAR struct wqueue_s *wqueue, FAR struct work_s *work);
+
 /****************************************************************************
  * Name: work_process
  *
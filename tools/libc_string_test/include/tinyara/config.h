@@ -0,0 +1,38 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/libc_string_test/include/tinyara/config.h
+ *
+ * Configuration of the string functions when they are built on the host.
+ *
+ ****************************************************************************/
+
+#ifndef __TOOLS_LIBC_STRING_TEST_CONFIG_H
+#define __TOOLS_LIBC_STRING_TEST_CONFIG_H
+
+#define FAR
+
+#define CONFIG_HAVE_LONG_LONG 1
+
+#define CONFIG_MEMCPY_OPTSPEED 1
+#define CONFIG_MEMSET_OPTSPEED 1
+#define CONFIG_MEMCMP_OPTSPEED 1
+#define CONFIG_STRLEN_OPTSPEED 1
+#define CONFIG_STRCHR_OPTSPEED 1
+
+#endif /* __TOOLS_LIBC_STRING_TEST_CONFIG_H */
@@ -0,0 +1,296 @@
+/****************************************************************************
+ *
+ * Copyright 2022 Samsung Electronics All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+ * either express or implied. See the License for the specific
+ * language governing permissions and limitations under the License.
+ *
+ ****************************************************************************/
+/****************************************************************************
+ * tools/libc_string_test/string_fuzz.c
+ *
+ * Checks the string functions of lib/libc/string, built on the host, for
+ * every combination of buffer alignments and of lengths up to MAX_EXHAUSTIVE
+ * and then for random longer lengths.  The results and the bytes around the
+ * destination are compared with reference byte loops.
+ *
+ ****************************************************************************/
+
+/****************************************************************************
+ * Included Files
+ ****************************************************************************/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+
+/****************************************************************************
+ * Pre-processor Definitions
+ ****************************************************************************/
+
+#define MAX_ALIGN      8		/* Offsets 0..7 cover every word alignment */
+#define MAX_EXHAUSTIVE 200		/* Lengths checked exhaustively */
+#define MAX_RANDOM_LEN 4096		/* Maximum length of random checks */
+#define GUARD          16		/* Bytes checked around the destination */
+#define BUFSIZE        (GUARD + MAX_ALIGN + MAX_RANDOM_LEN + GUARD)
+#define RANDOM_ROUNDS  20000
+
+#define GUARD_BYTE     0xa5
+
+/****************************************************************************
+ * Private Data
+ ****************************************************************************/
+
+/* The functions under test, renamed when they are compiled */
+
+void *libc_memcpy(void *dest, const void *src, size_t n);
+void *libc_memset(void *s, int c, size_t n);
+int libc_memcmp(const void *s1, const void *s2, size_t n);
+size_t libc_strlen(const char *s);
+char *libc_strchr(const char *s, int c);
+
+static unsigned char g_src[BUFSIZE] __attribute__((aligned(8)));
+static unsigned char g_dst[BUFSIZE] __attribute__((aligned(8)));
+static unsigned char g_ref[BUFSIZE] __attribute__((aligned(8)));
+static unsigned long g_nchecks;
+static unsigned long g_nfails;
+
+/****************************************************************************
+ * Private Functions
+ ****************************************************************************/
+
+static void fail(const char *name, size_t off1, size_t off2, size_t len, int c)
+{
+	if (g_nfails++ < 20) {
+		printf("FAIL %s: offsets %zu/%zu length %zu c 0x%02x\n", name, off1, off2, len, c & 0xff);
+	}
+}
+
+static void fill_random(unsigned char *buf, size_t len, int nonzero)
+{
+	size_t i;
+
+	for (i = 0; i < len; i++) {
+		buf[i] = (unsigned char)rand();
+		if (nonzero && buf[i] == 0) {
+			buf[i] = 0x80;
+		}
+	}
+}
+
+static void check_memcpy(size_t soff, size_t doff, size_t len)
+{
+	size_t i;
+	void *ret;
+
+	fill_random(g_src, BUFSIZE, 0);
+	for (i = 0; i < BUFSIZE; i++) {
+		g_dst[i] = g_ref[i] = GUARD_BYTE;
+	}
+
+	for (i = 0; i < len; i++) {
+		g_ref[GUARD + doff + i] = g_src[GUARD + soff + i];
+	}
+
+	ret = libc_memcpy(&g_dst[GUARD + doff], &g_src[GUARD + soff], len);
+	g_nchecks++;
+
+	for (i = 0; i < BUFSIZE; i++) {
+		if (g_dst[i] != g_ref[i]) {
+			break;
+		}
+	}
+
+	if (i != BUFSIZE || ret != &g_dst[GUARD + doff]) {
+		fail("memcpy", soff, doff, len, 0);
+	}
+}
+
+static void check_memset(size_t doff, size_t len, int c)
+{
+	size_t i;
+	void *ret;
+
+	for (i = 0; i < BUFSIZE; i++) {
+		g_dst[i] = g_ref[i] = GUARD_BYTE;
+	}
+
+	for (i = 0; i < len; i++) {
+		g_ref[GUARD + doff + i] = (unsigned char)c;
+	}
+
+	ret = libc_memset(&g_dst[GUARD + doff], c, len);
+	g_nchecks++;
+
+	for (i = 0; i < BUFSIZE; i++) {
+		if (g_dst[i] != g_ref[i]) {
+			break;
+		}
+	}
+
+	if (i != BUFSIZE || ret != &g_dst[GUARD + doff]) {
+		fail("memset", 0, doff, len, c);
+	}
+}
+
+static int ref_memcmp(const unsigned char *p1, const unsigned char *p2, size_t len)
+{
+	for (; len > 0; len--, p1++, p2++) {
+		if (*p1 != *p2) {
+			return *p1 < *p2 ? -1 : 1;
+		}
+	}
+	return 0;
+}
+
+static int sign(int v)
+{
+	return v < 0 ? -1 : v > 0;
+}
+
+static void check_memcmp(size_t off1, size_t off2, size_t len, size_t diff)
+{
+	unsigned char *p1 = &g_src[GUARD + off1];
+	unsigned char *p2 = &g_dst[GUARD + off2];
+
+	fill_random(p1, len, 0);
+	libc_memcpy(p2, p1, len);
+
+	/* Make the buffers differ at diff, or make them equal if diff >= len */
+
+	if (diff < len) {
+		p2[diff] = (unsigned char)rand();
+	}
+
+	/* Bytes past the end must not be compared */
+
+	p1[len] = 0x00;
+	p2[len] = 0xff;
+
+	g_nchecks++;
+	if (sign(libc_memcmp(p1, p2, len)) != ref_memcmp(p1, p2, len)) {
+		fail("memcmp", off1, off2, len, 0);
+	}
+}
+
+static void check_strlen(size_t off, size_t len)
+{
+	unsigned char *s = &g_src[GUARD + off];
+
+	fill_random(g_src, BUFSIZE, 1);
+	s[len] = '\0';
+
+	g_nchecks++;
+	if (libc_strlen((const char *)s) != len) {
+		fail("strlen", off, 0, len, 0);
+	}
+}
+
+static void check_strchr(size_t off, size_t len, size_t pos, int c)
+{
+	unsigned char *s = &g_src[GUARD + off];
+	const char *expect;
+	size_t i;
+
+	/* The string has len characters without c except at pos */
+
+	fill_random(g_src, BUFSIZE, 1);
+	for (i = 0; i < len; i++) {
+		if (s[i] == (unsigned char)c) {
+			s[i] = (unsigned char)c == 0x55 ? 0xaa : 0x55;
+		}
+	}
+	s[len] = '\0';
+
+	/* Bytes past the terminating null must not be found */
+
+	s[len + 1] = (unsigned char)c;
+
+	if (c == 0) {
+		expect = (const char *)&s[len];
+	} else if (pos < len) {
+		s[pos] = (unsigned char)c;
+		expect = (const char *)&s[pos];
+	} else {
+		expect = NULL;
+	}
+
+	g_nchecks++;
+	if (libc_strchr((const char *)s, c) != expect) {
+		fail("strchr", off, pos, len, c);
+	}
+}
+
+/****************************************************************************
+ * Public Functions
+ ****************************************************************************/
+
+int main(int argc, char *argv[])
+{
+	static const int chars[] = { 0x00, 0x01, 0x7f, 0x80, 0xfe, 0xff };
+	unsigned int seed;
+	size_t off1;
+	size_t off2;
+	size_t len;
+	size_t pos;
+	size_t i;
+	int round;
+
+	seed = argc > 1 ? (unsigned int)strtoul(argv[1], NULL, 0) : 1;
+	srand(seed);
+	printf("string_fuzz: seed %u\n", seed);
+
+	/* Every alignment with every short length */
+
+	for (off1 = 0; off1 < MAX_ALIGN; off1++) {
+		for (len = 0; len <= MAX_EXHAUSTIVE; len++) {
+			for (off2 = 0; off2 < MAX_ALIGN; off2++) {
+				check_memcpy(off1, off2, len);
+				check_memcmp(off1, off2, len, len);
+				for (pos = 0; pos < len && pos < 3 * MAX_ALIGN; pos++) {
+					check_memcmp(off1, off2, len, len - 1 - pos);
+					check_memcmp(off1, off2, len, pos);
+				}
+			}
+
+			for (i = 0; i < sizeof(chars) / sizeof(chars[0]); i++) {
+				check_memset(off1, len, chars[i]);
+				check_strchr(off1, len, len, chars[i]);
+				for (pos = 0; pos < len && pos < 3 * MAX_ALIGN; pos++) {
+					check_strchr(off1, len, len - 1 - pos, chars[i]);
+					check_strchr(off1, len, pos, chars[i]);
+				}
+			}
+
+			check_strlen(off1, len);
+		}
+	}
+
+	/* Random alignments, lengths and positions */
+
+	for (round = 0; round < RANDOM_ROUNDS; round++) {
+		off1 = rand() % MAX_ALIGN;
+		off2 = rand() % MAX_ALIGN;
+		len = rand() % (MAX_RANDOM_LEN - 2);
+		pos = len > 0 ? rand() % (len + 1) : 0;
+
+		check_memcpy(off1, off2, len);
+		check_memset(off2, len, rand() & 0xff);
+		check_memcmp(off1, off2, len, pos);
+		check_strlen(off1, len);
+		check_strchr(off1, len, pos, rand() & 0xff);
+	}
+
+	printf("string_fuzz: %lu checks, %lu failures\n", g_nchecks, g_nfails);
+	return g_nfails == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
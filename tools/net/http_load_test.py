@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+############################################################################
+#
+# Copyright 2022 Samsung Electronics All Rights Reserved.
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+# either express or implied. See the License for the specific
+# language governing permissions and limitations under the License.
+#
+############################################################################
+
+"""Load test client of the webserver, run on the host.
+
+Every connection sends its requests in batches of --pipeline, keeping the
+connection alive in between, and the client reports the requests served per
+second and the latency of the batches.  With --idle, connections which send
+nothing are held open as well, so that the RAM a connection costs on the
+target can be read with the 'free' command while they stay open.
+"""
+
+import argparse
+import asyncio
+import logging
+import time
+
+LOG = logging.getLogger(__name__)
+
+
+class Stats:
+    def __init__(self):
+        self.requests = 0
+        self.errors = 0
+        self.bytes = 0
+        self.latencies = []
+
+
+async def read_response(reader):
+    header = await reader.readuntil(b'\r\n\r\n')
+    lines = header.decode('latin-1').split('\r\n')
+    status = int(lines[0].split(' ')[1])
+    fields = {}
+    for line in lines[1:]:
+        if ':' in line:
+            key, value = line.split(':', 1)
+            fields[key.strip().lower()] = value.strip()
+
+    size = 0
+    if fields.get('transfer-encoding', '').lower() == 'chunked':
+        while True:
+            chunk = int((await reader.readuntil(b'\r\n')).split(b';')[0], 16)
+            await reader.readexactly(chunk + 2)
+            size += chunk
+            if chunk == 0:
+                break
+    elif 'content-length' in fields:
+        size = int(fields['content-length'])
+        await reader.readexactly(size)
+
+    keep_alive = fields.get('connection', '').lower() == 'keep-alive'
+    return status, size, keep_alive
+
+
+async def client(args, stats, deadline):
+    request = ('GET {} HTTP/1.1\r\nHost: {}\r\nConnection: Keep-Alive\r\n\r\n'
+               .format(args.path, args.address)).encode()
+    while time.monotonic() < deadline:
+        try:
+            reader, writer = await asyncio.open_connection(args.address, args.port)
+        except OSError as err:
+            LOG.debug("connect: %s", err)
+            stats.errors += 1
+            await asyncio.sleep(0.1)
+            continue
+
+        try:
+            keep_alive = True
+            while keep_alive and time.monotonic() < deadline:
+                start = time.monotonic()
+                writer.write(request * args.pipeline)
+                await writer.drain()
+                for _ in range(args.pipeline):
+                    status, size, keep_alive = await read_response(reader)
+                    if status != 200:
+                        stats.errors += 1
+                    stats.requests += 1
+                    stats.bytes += size
+                    if not keep_alive:
+                        break
+                stats.latencies.append(time.monotonic() - start)
+        except (OSError, asyncio.IncompleteReadError, ValueError) as err:
+            LOG.debug("request: %s", err)
+            stats.errors += 1
+        finally:
+            writer.close()
+
+
+async def hold(args, count, deadline):
+    conns = []
+    for _ in range(count):
+        try:
+            conns.append(await asyncio.open_connection(args.address, args.port))
+        except OSError as err:
+            LOG.info("%d idle connections opened: %s", len(conns), err)
+            break
+    LOG.info("%d idle connections open, read 'free' on the target now", len(conns))
+    await asyncio.sleep(max(0, deadline - time.monotonic()))
+    for _, writer in conns:
+        writer.close()
+
+
+async def run(args):
+    stats = Stats()
+    deadline = time.monotonic() + args.duration
+    tasks = [client(args, stats, deadline) for _ in range(args.connections)]
+    if args.idle:
+        tasks.append(hold(args, args.idle, deadline))
+
+    start = time.monotonic()
+    await asyncio.gather(*tasks)
+    elapsed = time.monotonic() - start
+
+    latencies = sorted(stats.latencies)
+    LOG.info("%d requests in %.1f s: %.1f requests/s, %.1f KiB/s, %d errors",
+             stats.requests, elapsed, stats.requests / elapsed,
+             stats.bytes / elapsed / 1024, stats.errors)
+    if latencies:
+        LOG.info("batch latency ms: p50 %.1f p90 %.1f p99 %.1f max %.1f",
+                 latencies[len(latencies) // 2] * 1000,
+                 latencies[len(latencies) * 9 // 10] * 1000,
+                 latencies[len(latencies) * 99 // 100] * 1000,
+                 latencies[-1] * 1000)
+
+
+if __name__ == '__main__':
+    logging.basicConfig(
+        format="%(asctime)s.%(msecs)03d %(levelname)-8s %(message)s",
+        level=logging.INFO,
+        datefmt="%Y-%m-%d %H:%M:%S",
+    )
+
+    parser = argparse.ArgumentParser(
+        description='HTTP load test -a target_addr [-p port] [-u path]')
+    parser.add_argument('-a', '--address', help='address', required=True)
+    parser.add_argument('-p', '--port', type=int, default=80, help='port')
+    parser.add_argument('-u', '--path', default='/', help='path to request')
+    parser.add_argument('-c', '--connections', type=int, default=4,
+                        help='concurrent connections')
+    parser.add_argument('-d', '--duration', type=float, default=10,
+                        help='seconds to run')
+    parser.add_argument('-P', '--pipeline', type=int, default=1,
+                        help='requests sent at once on a connection')
+    parser.add_argument('-i', '--idle', type=int, default=0,
+                        help='idle connections to hold open')
+
+    asyncio.run(run(parser.parse_args()))